@@ -894,6 +894,13 @@ qt_feature("stringlistmodel" PUBLIC
     CONDITION QT_FEATURE_itemmodel
 )
 qt_feature_definition("stringlistmodel" "QT_NO_STRINGLISTMODEL" NEGATE VALUE "1")
+qt_feature("columnartablemodel" PUBLIC
+    SECTION "ItemViews"
+    LABEL "QColumnarTableModel"
+    PURPOSE "Provides a compact column-oriented table model for large data sets."
+    CONDITION QT_FEATURE_itemmodel
+)
+qt_feature_definition("columnartablemodel" "QT_NO_COLUMNARTABLEMODEL" NEGATE VALUE "1")
 qt_feature("translation" PUBLIC
     SECTION "Internationalization"
     LABEL "Translation"
@@ -19,7 +19,9 @@
 #include <qdatetime.h>
 #include <qloggingcategory.h>
 
+#include <algorithm>
 #include <functional>
+#include <limits>
 
 #include <limits.h>
 
@@ -42,6 +44,7 @@ QPersistentModelIndexData *QPersistentModelIndexData::create(const QModelIndex &
     } else {
         d = new QPersistentModelIndexData(index);
         indexes.insert(index, d);
+        model->d_func()->persistent.addToLevel(d, &model->d_func()->persistent.unleveled);
     }
     Q_ASSERT(d);
     return d;
@@ -723,9 +726,13 @@ QAbstractItemModel *QAbstractItemModelPrivate::staticEmptyModel()
 
 void QAbstractItemModelPrivate::invalidatePersistentIndexes()
 {
-    for (QPersistentModelIndexData *data : std::as_const(persistent.indexes))
+    ++persistent.version;
+    for (QPersistentModelIndexData *data : std::as_const(persistent.indexes)) {
         data->index = QModelIndex();
+        data->level = nullptr;
+    }
     persistent.indexes.clear();
+    persistent.clearLevels();
 }
 
 /*!
@@ -734,12 +741,141 @@ void QAbstractItemModelPrivate::invalidatePersistentIndexes()
     To be used before an index is invalided
 */
 void QAbstractItemModelPrivate::invalidatePersistentIndex(const QModelIndex &index) {
+    ++persistent.version;
     const auto it = persistent.indexes.constFind(index);
     if (it != persistent.indexes.cend()) {
         QPersistentModelIndexData *data = *it;
         persistent.indexes.erase(it);
         data->index = QModelIndex();
+        persistent.removeFromLevel(data);
+    }
+}
+
+/*!
+    \internal
+
+    Sorts the persistent indexes that were created since the last change of
+    the model structure into the levels of their parents, and drops the levels
+    that no longer hold any index. Called before the structure changes, while
+    parent() still reports the old structure.
+*/
+void QAbstractItemModelPrivate::ensurePersistentLevels()
+{
+    // levels referenced by a move in progress must stay around
+    if (persistent.movedLevels.isEmpty()) {
+        while (!persistent.emptied.isEmpty()) {
+            QPersistentModelIndexLevel *level = *persistent.emptied.cbegin();
+            persistent.emptied.erase(persistent.emptied.cbegin());
+            if (level->isEmpty())
+                persistent.deleteLevel(level);
+        }
+
+        // The levels are keyed by the parents as they were when the indexes
+        // were sorted in. A layout change can move parents without changing
+        // any persistent index, and is only announced through signals the
+        // subclass emits itself; but it goes with changePersistentIndex(),
+        // which is where the check is asked for.
+        if (std::exchange(persistent.levelsUnchecked, false)) {
+            const QPersistentModelIndexLevel *root = persistent.levels.value(QModelIndex());
+            if (root && !persistent.levelMatchesModel(root))
+                persistent.resetLevels();
+        }
+    }
+
+    QPersistentModelIndexLevel &unleveled = persistent.unleveled;
+    if (unleveled.indexes.size() == unleveled.removed) {
+        unleveled.indexes.clear();
+        unleveled.removed = 0;
+        return;
+    }
+
+    const QList<QPersistentModelIndexData *> pending = std::exchange(unleveled.indexes, {});
+    unleveled.sorted = 0;
+    unleveled.removed = 0;
+    for (QPersistentModelIndexData *data : pending) {
+        if (data)
+            persistent.addToLevel(data, persistent.levelFor(data->index.parent()));
+    }
+}
+
+/*!
+    \internal
+
+    Returns the levels of the children of \a parent whose row (or column,
+    depending on \a orientation) is between \a first and \a last.
+*/
+QList<QPersistentModelIndexLevel *> QAbstractItemModelPrivate::persistentChildLevels(const QModelIndex &parent,
+                                                                                    int first, int last,
+                                                                                    Qt::Orientation orientation) const
+{
+    QList<QPersistentModelIndexLevel *> result;
+    if (const QPersistentModelIndexLevel *level = persistent.levels.value(parent)) {
+        for (QPersistentModelIndexLevel *child : level->children) {
+            const int position = orientation == Qt::Vertical ? child->parent.row() : child->parent.column();
+            if (position >= first && position <= last)
+                result.append(child);
+        }
+    }
+    return result;
+}
+
+/*!
+    \internal
+
+    Renames the levels in each of \a moves after their parent indexes were
+    moved by the move's change in row or column, depending on \a orientation,
+    and under the move's parent.
+*/
+void QAbstractItemModelPrivate::movePersistentLevels(const QList<PersistentLevelMove> &moves,
+                                                     Qt::Orientation orientation)
+{
+    Q_Q(QAbstractItemModel);
+    // Take all of them out first, the new parent of one level may still be
+    // the old parent of another.
+    for (const PersistentLevelMove &move : moves) {
+        for (QPersistentModelIndexLevel *level : move.levels) {
+            const auto it = persistent.levels.constFind(level->parent);
+            if (it != persistent.levels.cend() && *it == level)
+                persistent.levels.erase(it);
+        }
+    }
+
+    QList<QPersistentModelIndexLevel *> lost;
+    for (const PersistentLevelMove &move : moves) {
+        for (QPersistentModelIndexLevel *level : move.levels) {
+            int row = level->parent.row();
+            int column = level->parent.column();
+            if (orientation == Qt::Vertical)
+                row += move.change;
+            else
+                column += move.change;
+            level->parent = q->index(row, column, move.parent);
+            if (level->parent.isValid() && !persistent.levels.contains(level->parent)) {
+                persistent.levels.insert(level->parent, level);
+            } else {
+                // sorted in again from scratch on the next change
+                level->parent = QModelIndex();
+                lost.append(level);
+            }
+        }
     }
+
+    for (const PersistentLevelMove &move : moves) {
+        QPersistentModelIndexLevel *up = nullptr;
+        for (QPersistentModelIndexLevel *level : move.levels) {
+            if (!level->parent.isValid())
+                continue;
+            if (!up)
+                up = persistent.levelFor(move.parent);
+            if (level->up != up) {
+                persistent.detachLevel(level);
+                persistent.attachLevel(level, up);
+            }
+        }
+    }
+
+    for (QPersistentModelIndexLevel *level : std::as_const(lost))
+        persistent.deleteLevel(level);
 }
 
 using DefaultRoleNames = QHash<int, QByteArray>;
@@ -841,6 +977,7 @@ bool QAbstractItemModelPrivate::variantLessThan(const QVariant &v1, const QVaria
 
 void QAbstractItemModelPrivate::removePersistentIndexData(QPersistentModelIndexData *data)
 {
+    persistent.removeFromLevel(data);
     if (data->index.isValid()) {
         int removed = persistent.indexes.remove(data->index);
         Q_ASSERT_X(removed == 1, "QPersistentModelIndex::~QPersistentModelIndex",
@@ -864,6 +1001,11 @@ void QAbstractItemModelPrivate::removePersistentIndexData(QPersistentModelIndexD
 
 }
 
+static bool persistentRowLessThan(const QPersistentModelIndexData *data, int row)
+{
+    return data->index.row() < row;
+}
+
 void QAbstractItemModelPrivate::rowsAboutToBeInserted(const QModelIndex &parent,
                                                       int first, int last)
 {
@@ -871,11 +1013,12 @@ void QAbstractItemModelPrivate::rowsAboutToBeInserted(const QModelIndex &parent,
     Q_UNUSED(last);
     QList<QPersistentModelIndexData *> persistent_moved;
     if (first < q->rowCount(parent)) {
-        for (auto *data : std::as_const(persistent.indexes)) {
-            const QModelIndex &index = data->index;
-            if (index.row() >= first && index.isValid() && index.parent() == parent) {
-                persistent_moved.append(data);
-            }
+        ensurePersistentLevels();
+        if (QPersistentModelIndexLevel *level = persistent.levels.value(parent)) {
+            persistent.sortLevel(level);
+            const auto end = level->indexes.cend();
+            persistent_moved = QList<QPersistentModelIndexData *>(
+                    std::lower_bound(level->indexes.cbegin(), end, first, persistentRowLessThan), end);
         }
     }
     persistent.moved.push(persistent_moved);
@@ -884,6 +1027,7 @@ void QAbstractItemModelPrivate::rowsAboutToBeInserted(const QModelIndex &parent,
 void QAbstractItemModelPrivate::rowsInserted(const QModelIndex &parent,
                                              int first, int last)
 {
+    ++persistent.version;
     const QList<QPersistentModelIndexData *> persistent_moved = persistent.moved.pop();
     const int count = (last - first) + 1; // it is important to only use the delta, because the change could be nested
     for (auto *data : persistent_moved) {
@@ -894,61 +1038,124 @@ void QAbstractItemModelPrivate::rowsInserted(const QModelIndex &parent,
             persistent.insertMultiAtEnd(data->index, data);
         } else {
             qWarning() << "QAbstractItemModel::endInsertRows:  Invalid index (" << old.row() + count << ',' << old.column() << ") in model" << q_func();
+            persistent.removeFromLevel(data);
         }
     }
+    movePersistentLevels({ { persistentChildLevels(parent, first, INT_MAX, Qt::Vertical), count, parent } },
+                         Qt::Vertical);
 }
 
-void QAbstractItemModelPrivate::itemsAboutToBeMoved(const QModelIndex &srcParent, int srcFirst, int srcLast, const QModelIndex &destinationParent, int destinationChild, Qt::Orientation orientation)
-{
-    QList<QPersistentModelIndexData *> persistent_moved_explicitly;
-    QList<QPersistentModelIndexData *> persistent_moved_in_source;
-    QList<QPersistentModelIndexData *> persistent_moved_in_destination;
+namespace {
+enum class PersistentMove { None, Explicitly, InSource, InDestination };
+}
 
-    const bool sameParent = (srcParent == destinationParent);
+/*
+    Tells how the persistent index (or level of persistent indexes) at \a childPosition
+    under the source parent (if \a isSourceIndex) or the destination parent of a move
+    is affected by it.
+*/
+static PersistentMove classifyPersistentMove(int childPosition, bool isSourceIndex, bool sameParent,
+                                             int srcFirst, int srcLast, int destinationChild)
+{
     const bool movingUp = (srcFirst > destinationChild);
 
-    for (auto *data : std::as_const(persistent.indexes)) {
-        const QModelIndex &index = data->index;
-        const QModelIndex &parent = index.parent();
-        const bool isSourceIndex = (parent == srcParent);
-        const bool isDestinationIndex = (parent == destinationParent);
+    if (!sameParent && !isSourceIndex)
+        return childPosition >= destinationChild ? PersistentMove::InDestination : PersistentMove::None;
 
-        int childPosition;
-        if (orientation == Qt::Vertical)
-            childPosition = index.row();
-        else
-            childPosition = index.column();
+    if (sameParent && movingUp && childPosition < destinationChild)
+        return PersistentMove::None;
 
-        if (!index.isValid() || !(isSourceIndex || isDestinationIndex ) )
-            continue;
+    if (sameParent && !movingUp && childPosition < srcFirst )
+        return PersistentMove::None;
 
-        if (!sameParent && isDestinationIndex) {
-            if (childPosition >= destinationChild)
-                persistent_moved_in_destination.append(data);
-            continue;
-        }
+    if (!sameParent && childPosition < srcFirst)
+        return PersistentMove::None;
 
-        if (sameParent && movingUp && childPosition < destinationChild)
-            continue;
+    if (sameParent && (childPosition > srcLast) && (childPosition >= destinationChild ))
+        return PersistentMove::None;
 
-        if (sameParent && !movingUp && childPosition < srcFirst )
-            continue;
+    if ((childPosition <= srcLast) && (childPosition >= srcFirst))
+        return PersistentMove::Explicitly;
+    return PersistentMove::InSource;
+}
 
-        if (!sameParent && childPosition < srcFirst)
-            continue;
+void QAbstractItemModelPrivate::itemsAboutToBeMoved(const QModelIndex &srcParent, int srcFirst, int srcLast, const QModelIndex &destinationParent, int destinationChild, Qt::Orientation orientation)
+{
+    QList<QPersistentModelIndexData *> persistent_moved_explicitly;
+    QList<QPersistentModelIndexData *> persistent_moved_in_source;
+    QList<QPersistentModelIndexData *> persistent_moved_in_destination;
+    QList<QPersistentModelIndexLevel *> levels_moved_explicitly;
+    QList<QPersistentModelIndexLevel *> levels_moved_in_source;
+    QList<QPersistentModelIndexLevel *> levels_moved_in_destination;
 
-        if (sameParent && (childPosition > srcLast) && (childPosition >= destinationChild ))
-            continue;
+    const bool sameParent = (srcParent == destinationParent);
 
-        if ((childPosition <= srcLast) && (childPosition >= srcFirst)) {
-            persistent_moved_explicitly.append(data);
-        } else {
-            persistent_moved_in_source.append(data);
+    const auto position = [orientation](const QModelIndex &index) {
+        return orientation == Qt::Vertical ? index.row() : index.column();
+    };
+    const auto collect = [&](QPersistentModelIndexLevel *level, bool isSourceLevel) {
+        if (!level)
+            return;
+        auto it = level->indexes.cbegin();
+        const auto end = level->indexes.cend();
+        if (orientation == Qt::Vertical) {
+            // the affected rows are the ones from 'first' on, up to the first one that is not
+            persistent.sortLevel(level);
+            const int first = sameParent ? qMin(srcFirst, destinationChild)
+                                         : (isSourceLevel ? srcFirst : destinationChild);
+            it = std::lower_bound(it, end, first, persistentRowLessThan);
         }
-    }
+        for (; it != end; ++it) {
+            QPersistentModelIndexData *data = *it;
+            if (!data)
+                continue;
+            const PersistentMove move = classifyPersistentMove(position(data->index), isSourceLevel, sameParent,
+                                                               srcFirst, srcLast, destinationChild);
+            if (move == PersistentMove::None && orientation == Qt::Vertical)
+                break;
+            switch (move) {
+            case PersistentMove::None:
+                break;
+            case PersistentMove::Explicitly:
+                persistent_moved_explicitly.append(data);
+                break;
+            case PersistentMove::InSource:
+                persistent_moved_in_source.append(data);
+                break;
+            case PersistentMove::InDestination:
+                persistent_moved_in_destination.append(data);
+                break;
+            }
+        }
+        for (QPersistentModelIndexLevel *child : std::as_const(level->children)) {
+            switch (classifyPersistentMove(position(child->parent), isSourceLevel, sameParent,
+                                           srcFirst, srcLast, destinationChild)) {
+            case PersistentMove::None:
+                break;
+            case PersistentMove::Explicitly:
+                levels_moved_explicitly.append(child);
+                break;
+            case PersistentMove::InSource:
+                levels_moved_in_source.append(child);
+                break;
+            case PersistentMove::InDestination:
+                levels_moved_in_destination.append(child);
+                break;
+            }
+        }
+    };
+
+    ensurePersistentLevels();
+    collect(persistent.levels.value(srcParent), true);
+    if (!sameParent)
+        collect(persistent.levels.value(destinationParent), false);
+
     persistent.moved.push(persistent_moved_explicitly);
     persistent.moved.push(persistent_moved_in_source);
     persistent.moved.push(persistent_moved_in_destination);
+    persistent.movedLevels.push(levels_moved_explicitly);
+    persistent.movedLevels.push(levels_moved_in_source);
+    persistent.movedLevels.push(levels_moved_in_destination);
 }
 
 /*!
@@ -961,6 +1168,7 @@ void QAbstractItemModelPrivate::itemsAboutToBeMoved(const QModelIndex &srcParent
 void QAbstractItemModelPrivate::movePersistentIndexes(const QList<QPersistentModelIndexData *> &indexes, int change,
                                                       const QModelIndex &parent, Qt::Orientation orientation)
 {
+    QPersistentModelIndexLevel *level = nullptr;
     for (auto *data : indexes) {
         int row = data->index.row();
         int column = data->index.column();
@@ -974,17 +1182,28 @@ void QAbstractItemModelPrivate::movePersistentIndexes(const QList<QPersistentMod
         data->index = q_func()->index(row, column, parent);
         if (data->index.isValid()) {
             persistent.insertMultiAtEnd(data->index, data);
+            if (!level)
+                level = persistent.levelFor(parent);
+            if (data->level != level) {
+                persistent.removeFromLevel(data);
+                persistent.addToLevel(data, level);
+            }
         } else {
             qWarning() << "QAbstractItemModel::endMoveRows:  Invalid index (" << row << "," << column << ") in model" << q_func();
+            persistent.removeFromLevel(data);
         }
     }
 }
 
 void QAbstractItemModelPrivate::itemsMoved(const QModelIndex &sourceParent, int sourceFirst, int sourceLast, const QModelIndex &destinationParent, int destinationChild, Qt::Orientation orientation)
 {
+    ++persistent.version;
     const QList<QPersistentModelIndexData *> moved_in_destination = persistent.moved.pop();
     const QList<QPersistentModelIndexData *> moved_in_source = persistent.moved.pop();
     const QList<QPersistentModelIndexData *> moved_explicitly = persistent.moved.pop();
+    const QList<QPersistentModelIndexLevel *> levels_moved_in_destination = persistent.movedLevels.pop();
+    const QList<QPersistentModelIndexLevel *> levels_moved_in_source = persistent.movedLevels.pop();
+    const QList<QPersistentModelIndexLevel *> levels_moved_explicitly = persistent.movedLevels.pop();
 
     const bool sameParent = (sourceParent == destinationParent);
     const bool movingUp = (sourceFirst > destinationChild);
@@ -993,9 +1212,34 @@ void QAbstractItemModelPrivate::itemsMoved(const QModelIndex &sourceParent, int
     const int source_change = (!sameParent || !movingUp) ? -1*(sourceLast - sourceFirst + 1) : sourceLast - sourceFirst + 1 ;
     const int destination_change = sourceLast - sourceFirst + 1;
 
+    // the levels first, so that the indexes find the levels of their new parents
+    movePersistentLevels({ { levels_moved_explicitly, explicit_change, destinationParent },
+                           { levels_moved_in_source, source_change, sourceParent },
+                           { levels_moved_in_destination, destination_change, destinationParent } },
+                         orientation);
+
     movePersistentIndexes(moved_explicitly, explicit_change, destinationParent, orientation);
     movePersistentIndexes(moved_in_source, source_change, sourceParent, orientation);
     movePersistentIndexes(moved_in_destination, destination_change, destinationParent, orientation);
+
+    // Within a parent, only the rows between the source and the destination
+    // change their order.
+    if (sameParent && orientation == Qt::Vertical) {
+        QPersistentModelIndexLevel *level = nullptr;
+        qsizetype from = std::numeric_limits<qsizetype>::max();
+        qsizetype to = -1;
+        for (const auto *list : { &moved_explicitly, &moved_in_source }) {
+            for (const QPersistentModelIndexData *data : *list) {
+                if (!data->level)
+                    continue;
+                level = data->level;
+                from = qMin(from, qsizetype(data->levelPosition));
+                to = qMax(to, qsizetype(data->levelPosition) + 1);
+            }
+        }
+        if (level)
+            persistent.sortLevel(level, from, to);
+    }
 }
 
 void QAbstractItemModelPrivate::rowsAboutToBeRemoved(const QModelIndex &parent,
@@ -1005,20 +1249,20 @@ void QAbstractItemModelPrivate::rowsAboutToBeRemoved(const QModelIndex &parent,
     QList<QPersistentModelIndexData *> persistent_invalidated;
     // find the persistent indexes that are affected by the change, either by being in the removed subtree
     // or by being on the same level and below the removed rows
-    for (auto *data : std::as_const(persistent.indexes)) {
-        bool level_changed = false;
-        QModelIndex current = data->index;
-        while (current.isValid()) {
-            QModelIndex current_parent = current.parent();
-            if (current_parent == parent) { // on the same level as the change
-                if (!level_changed && current.row() > last) // below the removed rows
-                    persistent_moved.append(data);
-                else if (current.row() <= last && current.row() >= first) // in the removed subtree
-                    persistent_invalidated.append(data);
-                break;
-            }
-            current = current_parent;
-            level_changed = true;
+    ensurePersistentLevels();
+    if (QPersistentModelIndexLevel *level = persistent.levels.value(parent)) {
+        persistent.sortLevel(level);
+        const auto end = level->indexes.cend();
+        for (auto it = std::lower_bound(level->indexes.cbegin(), end, first, persistentRowLessThan); it != end; ++it) {
+            QPersistentModelIndexData *data = *it;
+            if (data->index.row() > last) // below the removed rows
+                persistent_moved.append(data);
+            else // in the removed subtree
+                persistent_invalidated.append(data);
+        }
+        for (const QPersistentModelIndexLevel *child : std::as_const(level->children)) {
+            if (child->parent.row() >= first && child->parent.row() <= last)
+                persistent.collectLevel(child, &persistent_invalidated);
         }
     }
 
@@ -1029,6 +1273,7 @@ void QAbstractItemModelPrivate::rowsAboutToBeRemoved(const QModelIndex &parent,
 void QAbstractItemModelPrivate::rowsRemoved(const QModelIndex &parent,
                                             int first, int last)
 {
+    ++persistent.version;
     const QList<QPersistentModelIndexData *> persistent_moved = persistent.moved.pop();
     const int count = (last - first) + 1; // it is important to only use the delta, because the change could be nested
     for (auto *data : persistent_moved) {
@@ -1039,6 +1284,7 @@ void QAbstractItemModelPrivate::rowsRemoved(const QModelIndex &parent,
             persistent.insertMultiAtEnd(data->index, data);
         } else {
             qWarning() << "QAbstractItemModel::endRemoveRows:  Invalid index (" << old.row() - count << ',' << old.column() << ") in model" << q_func();
+            persistent.removeFromLevel(data);
         }
     }
     const QList<QPersistentModelIndexData *> persistent_invalidated = persistent.invalidated.pop();
@@ -1047,7 +1293,12 @@ void QAbstractItemModelPrivate::rowsRemoved(const QModelIndex &parent,
         if (pit != persistent.indexes.cend())
             persistent.indexes.erase(pit);
         data->index = QModelIndex();
+        persistent.removeFromLevel(data);
     }
+    for (QPersistentModelIndexLevel *level : persistentChildLevels(parent, first, last, Qt::Vertical))
+        persistent.deleteLevel(level);
+    movePersistentLevels({ { persistentChildLevels(parent, last + 1, INT_MAX, Qt::Vertical), -count, parent } },
+                         Qt::Vertical);
 }
 
 void QAbstractItemModelPrivate::columnsAboutToBeInserted(const QModelIndex &parent,
@@ -1057,10 +1308,12 @@ void QAbstractItemModelPrivate::columnsAboutToBeInserted(const QModelIndex &pare
     Q_UNUSED(last);
     QList<QPersistentModelIndexData *> persistent_moved;
     if (first < q->columnCount(parent)) {
-        for (auto *data : std::as_const(persistent.indexes)) {
-            const QModelIndex &index = data->index;
-            if (index.column() >= first && index.isValid() && index.parent() == parent)
-                persistent_moved.append(data);
+        ensurePersistentLevels();
+        if (const QPersistentModelIndexLevel *level = persistent.levels.value(parent)) {
+            for (auto *data : level->indexes) {
+                if (data && data->index.column() >= first)
+                    persistent_moved.append(data);
+            }
         }
     }
     persistent.moved.push(persistent_moved);
@@ -1069,6 +1322,7 @@ void QAbstractItemModelPrivate::columnsAboutToBeInserted(const QModelIndex &pare
 void QAbstractItemModelPrivate::columnsInserted(const QModelIndex &parent,
                                                 int first, int last)
 {
+    ++persistent.version;
     const QList<QPersistentModelIndexData *> persistent_moved = persistent.moved.pop();
     const int count = (last - first) + 1; // it is important to only use the delta, because the change could be nested
     for (auto *data : persistent_moved) {
@@ -1079,8 +1333,11 @@ void QAbstractItemModelPrivate::columnsInserted(const QModelIndex &parent,
             persistent.insertMultiAtEnd(data->index, data);
         } else {
             qWarning() << "QAbstractItemModel::endInsertColumns:  Invalid index (" << old.row() << ',' << old.column() + count << ") in model" << q_func();
+            persistent.removeFromLevel(data);
         }
     }
+    movePersistentLevels({ { persistentChildLevels(parent, first, INT_MAX, Qt::Horizontal), count, parent } },
+                         Qt::Horizontal);
 }
 
 void QAbstractItemModelPrivate::columnsAboutToBeRemoved(const QModelIndex &parent,
@@ -1090,20 +1347,19 @@ void QAbstractItemModelPrivate::columnsAboutToBeRemoved(const QModelIndex &paren
     QList<QPersistentModelIndexData *> persistent_invalidated;
     // find the persistent indexes that are affected by the change, either by being in the removed subtree
     // or by being on the same level and to the right of the removed columns
-    for (auto *data : std::as_const(persistent.indexes)) {
-        bool level_changed = false;
-        QModelIndex current = data->index;
-        while (current.isValid()) {
-            QModelIndex current_parent = current.parent();
-            if (current_parent == parent) { // on the same level as the change
-                if (!level_changed && current.column() > last) // right of the removed columns
-                    persistent_moved.append(data);
-                else if (current.column() <= last && current.column() >= first) // in the removed subtree
-                    persistent_invalidated.append(data);
-                break;
-            }
-            current = current_parent;
-            level_changed = true;
+    ensurePersistentLevels();
+    if (const QPersistentModelIndexLevel *level = persistent.levels.value(parent)) {
+        for (auto *data : level->indexes) {
+            if (!data)
+                continue;
+            if (data->index.column() > last) // right of the removed columns
+                persistent_moved.append(data);
+            else if (data->index.column() >= first) // in the removed subtree
+                persistent_invalidated.append(data);
+        }
+        for (const QPersistentModelIndexLevel *child : level->children) {
+            if (child->parent.column() >= first && child->parent.column() <= last)
+                persistent.collectLevel(child, &persistent_invalidated);
         }
     }
 
@@ -1115,6 +1371,7 @@ void QAbstractItemModelPrivate::columnsAboutToBeRemoved(const QModelIndex &paren
 void QAbstractItemModelPrivate::columnsRemoved(const QModelIndex &parent,
                                                int first, int last)
 {
+    ++persistent.version;
     const QList<QPersistentModelIndexData *> persistent_moved = persistent.moved.pop();
     const int count = (last - first) + 1; // it is important to only use the delta, because the change could be nested
     for (auto *data : persistent_moved) {
@@ -1125,6 +1382,7 @@ void QAbstractItemModelPrivate::columnsRemoved(const QModelIndex &parent,
             persistent.insertMultiAtEnd(data->index, data);
         } else {
             qWarning() << "QAbstractItemModel::endRemoveColumns:  Invalid index (" << old.row() << ',' << old.column() - count << ") in model" << q_func();
+            persistent.removeFromLevel(data);
         }
     }
     const QList<QPersistentModelIndexData *> persistent_invalidated = persistent.invalidated.pop();
@@ -1133,7 +1391,12 @@ void QAbstractItemModelPrivate::columnsRemoved(const QModelIndex &parent,
         if (index != persistent.indexes.constEnd())
             persistent.indexes.erase(index);
         data->index = QModelIndex();
+        persistent.removeFromLevel(data);
     }
+    for (QPersistentModelIndexLevel *level : persistentChildLevels(parent, first, last, Qt::Horizontal))
+        persistent.deleteLevel(level);
+    movePersistentLevels({ { persistentChildLevels(parent, last + 1, INT_MAX, Qt::Horizontal), -count, parent } },
+                         Qt::Horizontal);
 }
 
 /*!
@@ -3450,16 +3713,21 @@ void QAbstractItemModel::endResetModel()
 void QAbstractItemModel::changePersistentIndex(const QModelIndex &from, const QModelIndex &to)
 {
     Q_D(QAbstractItemModel);
+    ++d->persistent.version;
     if (d->persistent.indexes.isEmpty())
         return;
+    d->persistent.levelsUnchecked = true;
     // find the data and reinsert it sorted
     const auto it = d->persistent.indexes.constFind(from);
     if (it != d->persistent.indexes.cend()) {
         QPersistentModelIndexData *data = *it;
         d->persistent.indexes.erase(it);
         data->index = to;
-        if (to.isValid())
+        d->persistent.removeFromLevel(data);
+        if (to.isValid()) {
             d->persistent.insertMultiAtEnd(to, data);
+            d->persistent.addToLevel(data, &d->persistent.unleveled);
+        }
     }
 }
 
@@ -3478,8 +3746,10 @@ void QAbstractItemModel::changePersistentIndexList(const QModelIndexList &from,
                                                    const QModelIndexList &to)
 {
     Q_D(QAbstractItemModel);
+    ++d->persistent.version;
     if (d->persistent.indexes.isEmpty())
         return;
+    d->persistent.levelsUnchecked = true;
     QList<QPersistentModelIndexData *> toBeReinserted;
     toBeReinserted.reserve(to.size());
     for (int i = 0; i < from.size(); ++i) {
@@ -3490,13 +3760,16 @@ void QAbstractItemModel::changePersistentIndexList(const QModelIndexList &from,
             QPersistentModelIndexData *data = *it;
             d->persistent.indexes.erase(it);
             data->index = to.at(i);
+            d->persistent.removeFromLevel(data);
             if (data->index.isValid())
                 toBeReinserted << data;
         }
     }
 
-    for (auto *data : std::as_const(toBeReinserted))
+    for (auto *data : std::as_const(toBeReinserted)) {
         d->persistent.insertMultiAtEnd(data->index, data);
+        d->persistent.addToLevel(data, &d->persistent.unleveled);
+    }
 }
 
 /*!
@@ -4189,6 +4462,249 @@ void QAbstractItemModelPrivate::Persistent::insertMultiAtEnd(const QModelIndex&
     }
 }
 
+QAbstractItemModelPrivate::Persistent::~Persistent()
+{
+    qDeleteAll(levels);
+}
+
+/*!
+    \internal
+
+    Returns the level of the persistent indexes whose parent is \a parent,
+    creating it and the levels above it as needed.
+*/
+QPersistentModelIndexLevel *QAbstractItemModelPrivate::Persistent::levelFor(const QModelIndex &parent)
+{
+    if (QPersistentModelIndexLevel *level = levels.value(parent))
+        return level;
+    auto *level = new QPersistentModelIndexLevel;
+    level->parent = parent;
+    if (parent.isValid())
+        attachLevel(level, levelFor(parent.parent()));
+    levels.insert(parent, level);
+    return level;
+}
+
+void QAbstractItemModelPrivate::Persistent::addToLevel(QPersistentModelIndexData *data,
+                                                        QPersistentModelIndexLevel *level)
+{
+    data->level = level;
+    data->levelPosition = int(level->indexes.size());
+    // indexes added in order keep the level sorted
+    if (level->sorted == data->levelPosition) {
+        const QPersistentModelIndexData *previous = level->indexes.isEmpty() ? nullptr : level->indexes.constLast();
+        if (level->indexes.isEmpty() || (previous && previous->index.row() <= data->index.row()))
+            ++level->sorted;
+    }
+    level->indexes.append(data);
+}
+
+void QAbstractItemModelPrivate::Persistent::removeFromLevel(QPersistentModelIndexData *data)
+{
+    QPersistentModelIndexLevel *level = data->level;
+    if (!level)
+        return;
+    level->indexes[data->levelPosition] = nullptr;
+    ++level->removed;
+    data->level = nullptr;
+    data->levelPosition = -1;
+
+    if (level->isEmpty() && level != &unleveled)
+        emptied.insert(level);
+    else if (level->removed > 32 && level->removed * 2 > level->indexes.size())
+        compactLevel(level);
+}
+
+/*!
+    \internal
+
+    Drops the entries of removed indexes from \a level.
+*/
+void QAbstractItemModelPrivate::Persistent::compactLevel(QPersistentModelIndexLevel *level)
+{
+    qsizetype sorted = 0;
+    qsizetype size = 0;
+    for (qsizetype i = 0; i < level->indexes.size(); ++i) {
+        QPersistentModelIndexData *data = level->indexes.at(i);
+        if (!data)
+            continue;
+        if (i < level->sorted)
+            ++sorted;
+        data->levelPosition = int(size);
+        level->indexes[size++] = data;
+    }
+    level->indexes.resize(size);
+    level->sorted = sorted;
+    level->removed = 0;
+}
+
+/*!
+    \internal
+
+    Orders the indexes of \a level by row.
+*/
+void QAbstractItemModelPrivate::Persistent::sortLevel(QPersistentModelIndexLevel *level)
+{
+    if (level->removed)
+        compactLevel(level);
+    if (level->sorted == level->indexes.size())
+        return;
+
+    const auto byRow = [](const QPersistentModelIndexData *left, const QPersistentModelIndexData *right) {
+        return left->index.row() < right->index.row();
+    };
+    const auto begin = level->indexes.begin();
+    const auto middle = begin + level->sorted;
+    const auto end = level->indexes.end();
+    std::sort(middle, end, byRow);
+    std::inplace_merge(begin, middle, end, byRow);
+    for (qsizetype i = 0; i < level->indexes.size(); ++i)
+        level->indexes.at(i)->levelPosition = int(i);
+    level->sorted = level->indexes.size();
+}
+
+/*!
+    \internal
+
+    Orders the indexes of \a level by row, given that only the ones from
+    position \a from up to \a to changed their rows, and only among themselves.
+*/
+void QAbstractItemModelPrivate::Persistent::sortLevel(QPersistentModelIndexLevel *level,
+                                                       qsizetype from, qsizetype to)
+{
+    if (level->removed || to > level->sorted) {
+        level->sorted = 0;
+        return;
+    }
+    const auto begin = level->indexes.begin();
+    std::sort(begin + from, begin + to,
+              [](const QPersistentModelIndexData *left, const QPersistentModelIndexData *right) {
+                  return left->index.row() < right->index.row();
+              });
+    for (qsizetype i = from; i < to; ++i)
+        level->indexes.at(i)->levelPosition = int(i);
+}
+
+/*!
+    \internal
+
+    Appends the indexes of \a level and of all levels below it to \a result.
+*/
+void QAbstractItemModelPrivate::Persistent::collectLevel(const QPersistentModelIndexLevel *level,
+                                                          QList<QPersistentModelIndexData *> *result) const
+{
+    for (QPersistentModelIndexData *data : level->indexes) {
+        if (data)
+            result->append(data);
+    }
+    for (const QPersistentModelIndexLevel *child : level->children)
+        collectLevel(child, result);
+}
+
+void QAbstractItemModelPrivate::Persistent::attachLevel(QPersistentModelIndexLevel *level,
+                                                         QPersistentModelIndexLevel *up)
+{
+    level->up = up;
+    level->childPosition = up->children.size();
+    up->children.append(level);
+}
+
+void QAbstractItemModelPrivate::Persistent::detachLevel(QPersistentModelIndexLevel *level)
+{
+    QPersistentModelIndexLevel *up = std::exchange(level->up, nullptr);
+    if (!up)
+        return;
+    QPersistentModelIndexLevel *last = up->children.takeLast();
+    if (last != level) {
+        up->children[level->childPosition] = last;
+        last->childPosition = level->childPosition;
+    }
+    level->childPosition = -1;
+    if (up->isEmpty())
+        emptied.insert(up);
+}
+
+/*!
+    \internal
+
+    Deletes \a level and the levels below it. Indexes still kept in them are
+    sorted in again on the next change of the model structure.
+*/
+void QAbstractItemModelPrivate::Persistent::deleteLevel(QPersistentModelIndexLevel *level)
+{
+    while (!level->children.isEmpty())
+        deleteLevel(level->children.constLast());
+    for (QPersistentModelIndexData *data : std::as_const(level->indexes)) {
+        if (data)
+            addToLevel(data, &unleveled);
+    }
+    const auto it = levels.constFind(level->parent);
+    if (it != levels.cend() && *it == level)
+        levels.erase(it);
+    detachLevel(level);
+    emptied.remove(level);
+    delete level;
+}
+
+/*!
+    \internal
+
+    Returns whether the parent of \a level and of all levels below it is still
+    the parent the model reports for the indexes kept in them. Asks the model
+    for the parent of one index per level only.
+*/
+bool QAbstractItemModelPrivate::Persistent::levelMatchesModel(const QPersistentModelIndexLevel *level) const
+{
+    for (const QPersistentModelIndexLevel *child : level->children) {
+        // Only call parent() on the parent of a child level once the indexes
+        // below it proved it to be current.
+        if (child->isEmpty())
+            continue;
+        if (!levelMatchesModel(child) || child->parent.parent() != level->parent)
+            return false;
+    }
+    for (const QPersistentModelIndexData *data : level->indexes) {
+        if (data)
+            return data->index.parent() == level->parent;
+    }
+    return true;
+}
+
+/*!
+    \internal
+
+    Deletes all levels, to sort the indexes in again on the next change of the
+    model structure.
+*/
+void QAbstractItemModelPrivate::Persistent::resetLevels()
+{
+    for (QPersistentModelIndexLevel *level : std::as_const(levels)) {
+        for (QPersistentModelIndexData *data : std::as_const(level->indexes)) {
+            if (data)
+                addToLevel(data, &unleveled);
+        }
+        delete level;
+    }
+    levels.clear();
+    emptied.clear();
+}
+
+/*!
+    \internal
+
+    Deletes all levels, once none of the indexes in them are valid anymore.
+*/
+void QAbstractItemModelPrivate::Persistent::clearLevels()
+{
+    qDeleteAll(levels);
+    levels.clear();
+    emptied.clear();
+    levelsUnchecked = false;
+    unleveled.indexes.clear();
+    unleveled.sorted = 0;
+    unleveled.removed = 0;
+}
+
 QT_END_NAMESPACE
 
 #include "moc_qabstractitemmodel.cpp"
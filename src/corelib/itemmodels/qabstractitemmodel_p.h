@@ -26,6 +26,8 @@ QT_BEGIN_NAMESPACE
 
 QT_REQUIRE_CONFIG(itemmodel);
 
+struct QPersistentModelIndexLevel;
+
 class QPersistentModelIndexData
 {
 public:
@@ -33,6 +35,10 @@ public:
     QPersistentModelIndexData(const QModelIndex &idx) : index(idx) {}
     QModelIndex index;
     QAtomicInt ref;
+    // where the index is kept in QAbstractItemModelPrivate::Persistent;
+    // the position fills the padding after ref
+    int levelPosition = -1;
+    QPersistentModelIndexLevel *level = nullptr;
     static QPersistentModelIndexData *create(const QModelIndex &index);
     static void destroy(QPersistentModelIndexData *data);
 };
@@ -57,6 +63,24 @@ struct QModelIndexWrapper // ### Qt 7: Remove again, use QModelIndex directly.
 };
 }
 
+// The persistent indexes sharing a parent. The levels form a tree that follows
+// the model, so that the indexes affected by a change of rows or columns can be
+// found without looking at all of them.
+struct QPersistentModelIndexLevel
+{
+    QModelIndex parent;
+    QPersistentModelIndexLevel *up = nullptr;
+    qsizetype childPosition = -1;
+    QList<QPersistentModelIndexLevel *> children;
+    // Removed indexes leave a nullptr behind until the level is compacted;
+    // the first 'sorted' entries are ordered by row.
+    QList<QPersistentModelIndexData *> indexes;
+    qsizetype sorted = 0;
+    qsizetype removed = 0;
+
+    bool isEmpty() const { return indexes.size() == removed && children.isEmpty(); }
+};
+
 class Q_CORE_EXPORT QAbstractItemModelPrivate : public QObjectPrivate
 {
     Q_DECLARE_PUBLIC(QAbstractItemModel)
@@ -103,6 +127,16 @@ public:
     void invalidatePersistentIndexes();
     void invalidatePersistentIndex(const QModelIndex &index);
 
+    void ensurePersistentLevels();
+    QList<QPersistentModelIndexLevel *> persistentChildLevels(const QModelIndex &parent, int first, int last,
+                                                              Qt::Orientation orientation) const;
+    struct PersistentLevelMove {
+        QList<QPersistentModelIndexLevel *> levels;
+        int change;
+        QModelIndex parent;
+    };
+    void movePersistentLevels(const QList<PersistentLevelMove> &moves, Qt::Orientation orientation);
+
     struct Change {
         constexpr Change() : parent(), first(-1), last(-1), needsAdjust(false) {}
         constexpr Change(const QModelIndex &p, int f, int l) : parent(p), first(f), last(l), needsAdjust(false) {}
@@ -131,10 +165,37 @@ public:
 
     struct Persistent {
         Persistent() {}
+        ~Persistent();
         QMultiHash<QtPrivate::QModelIndexWrapper, QPersistentModelIndexData *> indexes;
         QStack<QList<QPersistentModelIndexData *>> moved;
         QStack<QList<QPersistentModelIndexData *>> invalidated;
         void insertMultiAtEnd(const QModelIndex& key, QPersistentModelIndexData *data);
+        // changes whenever the persistent indexes might have changed
+        quint64 version = 0;
+
+        // The indexes grouped by parent. New indexes are kept in 'unleveled'
+        // and only sorted into their level when the model structure changes,
+        // so that creating a persistent index does not need to call parent().
+        QHash<QtPrivate::QModelIndexWrapper, QPersistentModelIndexLevel *> levels;
+        QPersistentModelIndexLevel unleveled;
+        QSet<QPersistentModelIndexLevel *> emptied;
+        QStack<QList<QPersistentModelIndexLevel *>> movedLevels;
+        // set by changePersistentIndex(), as the layout may have changed
+        bool levelsUnchecked = false;
+
+        QPersistentModelIndexLevel *levelFor(const QModelIndex &parent);
+        void addToLevel(QPersistentModelIndexData *data, QPersistentModelIndexLevel *level);
+        void removeFromLevel(QPersistentModelIndexData *data);
+        void compactLevel(QPersistentModelIndexLevel *level);
+        void sortLevel(QPersistentModelIndexLevel *level);
+        void sortLevel(QPersistentModelIndexLevel *level, qsizetype from, qsizetype to);
+        void collectLevel(const QPersistentModelIndexLevel *level, QList<QPersistentModelIndexData *> *result) const;
+        void attachLevel(QPersistentModelIndexLevel *level, QPersistentModelIndexLevel *up);
+        void detachLevel(QPersistentModelIndexLevel *level);
+        void deleteLevel(QPersistentModelIndexLevel *level);
+        bool levelMatchesModel(const QPersistentModelIndexLevel *level) const;
+        void resetLevels();
+        void clearLevels();
     } persistent;
 
     bool resetting = false;
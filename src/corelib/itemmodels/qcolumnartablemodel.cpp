@@ -0,0 +1,815 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qcolumnartablemodel.h"
+#include <private/qabstractitemmodel_p.h>
+
+#include <QtCore/qlist.h>
+#include <QtCore/qmap.h>
+#include <QtCore/qnumeric.h>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+class QColumnarTableModelPrivate : public QAbstractItemModelPrivate
+{
+    Q_DECLARE_PUBLIC(QColumnarTableModel)
+
+public:
+    using ColumnType = QColumnarTableModel::ColumnType;
+
+    // The values of one role of one column. Only the list matching the type
+    // is used; rows that were never given a value are tracked in isSet, so
+    // that they can be reported as invalid QVariants.
+    class Values
+    {
+    public:
+        explicit Values(ColumnType type = ColumnType::Variant, qsizetype rows = 0)
+            : type(type)
+        { insert(0, rows); }
+
+        QVariant value(qsizetype row) const;
+        bool setValue(qsizetype row, const QVariant &value);
+        bool assign(qsizetype row, qint64 value);
+        bool assign(qsizetype row, double value);
+        bool assign(qsizetype row, const QString &value);
+        bool assign(qsizetype row, const QVariant &value) { return setValue(row, value); }
+        void unset(qsizetype row);
+
+        void insert(qsizetype row, qsizetype count);
+        void remove(qsizetype row, qsizetype count);
+        void permute(const QList<int> &order);
+        int compare(qsizetype left, qsizetype right) const;
+
+        ColumnType type;
+        std::vector<bool> isSet;
+
+    private:
+        struct StringRef
+        {
+            qsizetype offset = 0;
+            qsizetype size = 0;
+        };
+        // Don't bother compacting the string arena for less than this many
+        // characters of replaced texts.
+        static constexpr qsizetype CompactionMinimum = 4096;
+
+        QStringView string(qsizetype row) const
+        {
+            const StringRef ref = strings.at(row);
+            return QStringView(arena).sliced(ref.offset, ref.size);
+        }
+        void setString(qsizetype row, QStringView text);
+        void compactStrings();
+
+        QList<qint64> integers;
+        QList<double> reals;
+        // All texts of the column are kept in a single arena; rows refer to
+        // them by offset. Texts that were replaced or removed stay in the
+        // arena until they make up half of it.
+        QList<StringRef> strings;
+        QString arena;
+        qsizetype garbage = 0;
+        QList<QVariant> variants;
+    };
+
+    struct Column
+    {
+        Values values;
+        QList<std::pair<int, Values>> roles;
+        QMap<int, QVariant> header;
+
+        Values *valuesForRole(int role);
+        const Values *valuesForRole(int role) const
+        { return const_cast<Column *>(this)->valuesForRole(role); }
+    };
+
+    static int valueRole(int role) { return role == Qt::EditRole ? Qt::DisplayRole : role; }
+    static QList<int> changedRoles(int role)
+    {
+        if (valueRole(role) == Qt::DisplayRole)
+            return {Qt::DisplayRole, Qt::EditRole};
+        return {role};
+    }
+
+    template <typename T>
+    bool setColumnValues(int column, int firstRow, QSpan<const T> values, int role);
+
+    QList<Column> columns;
+    int rows = 0;
+};
+
+QVariant QColumnarTableModelPrivate::Values::value(qsizetype row) const
+{
+    if (!isSet[row])
+        return QVariant();
+    switch (type) {
+    case ColumnType::Integer:
+        return QVariant(integers.at(row));
+    case ColumnType::Real:
+        return QVariant(reals.at(row));
+    case ColumnType::String:
+        return QVariant(string(row).toString());
+    case ColumnType::Variant:
+        break;
+    }
+    return variants.at(row);
+}
+
+bool QColumnarTableModelPrivate::Values::setValue(qsizetype row, const QVariant &value)
+{
+    if (!value.isValid()) {
+        unset(row);
+        return true;
+    }
+    bool ok = true;
+    switch (type) {
+    case ColumnType::Integer: {
+        const qint64 integer = value.toLongLong(&ok);
+        if (ok)
+            integers[row] = integer;
+        break;
+    }
+    case ColumnType::Real: {
+        const double real = value.toDouble(&ok);
+        if (ok)
+            reals[row] = real;
+        break;
+    }
+    case ColumnType::String:
+        ok = value.canConvert<QString>();
+        if (ok)
+            setString(row, value.toString());
+        break;
+    case ColumnType::Variant:
+        variants[row] = value;
+        break;
+    }
+    if (ok)
+        isSet[row] = true;
+    return ok;
+}
+
+bool QColumnarTableModelPrivate::Values::assign(qsizetype row, qint64 value)
+{
+    if (type != ColumnType::Integer)
+        return setValue(row, QVariant(value));
+    integers[row] = value;
+    isSet[row] = true;
+    return true;
+}
+
+bool QColumnarTableModelPrivate::Values::assign(qsizetype row, double value)
+{
+    if (type != ColumnType::Real)
+        return setValue(row, QVariant(value));
+    reals[row] = value;
+    isSet[row] = true;
+    return true;
+}
+
+bool QColumnarTableModelPrivate::Values::assign(qsizetype row, const QString &value)
+{
+    if (type != ColumnType::String)
+        return setValue(row, QVariant(value));
+    setString(row, value);
+    isSet[row] = true;
+    return true;
+}
+
+void QColumnarTableModelPrivate::Values::unset(qsizetype row)
+{
+    isSet[row] = false;
+    switch (type) {
+    case ColumnType::Integer:
+    case ColumnType::Real:
+        break;
+    case ColumnType::String:
+        garbage += strings.at(row).size;
+        strings[row] = StringRef();
+        break;
+    case ColumnType::Variant:
+        variants[row] = QVariant();
+        break;
+    }
+}
+
+void QColumnarTableModelPrivate::Values::setString(qsizetype row, QStringView text)
+{
+    StringRef &ref = strings[row];
+    if (text.size() <= ref.size) {
+        std::copy(text.begin(), text.end(), arena.data() + ref.offset);
+        garbage += ref.size - text.size();
+        ref.size = text.size();
+        return;
+    }
+    garbage += ref.size;
+    ref = StringRef();
+    if (garbage > CompactionMinimum && garbage > arena.size() / 2)
+        compactStrings();
+    strings[row] = StringRef{arena.size(), text.size()};
+    arena.append(text);
+}
+
+void QColumnarTableModelPrivate::Values::compactStrings()
+{
+    QString compacted;
+    compacted.reserve(arena.size() - garbage);
+    for (StringRef &ref : strings) {
+        const qsizetype offset = compacted.size();
+        compacted.append(QStringView(arena).sliced(ref.offset, ref.size));
+        ref.offset = offset;
+    }
+    arena = std::move(compacted);
+    garbage = 0;
+}
+
+void QColumnarTableModelPrivate::Values::insert(qsizetype row, qsizetype count)
+{
+    if (count <= 0)
+        return;
+    isSet.insert(isSet.begin() + row, count, false);
+    switch (type) {
+    case ColumnType::Integer:
+        integers.insert(row, count, 0);
+        break;
+    case ColumnType::Real:
+        reals.insert(row, count, 0.);
+        break;
+    case ColumnType::String:
+        strings.insert(row, count, StringRef());
+        break;
+    case ColumnType::Variant:
+        variants.insert(row, count, QVariant());
+        break;
+    }
+}
+
+void QColumnarTableModelPrivate::Values::remove(qsizetype row, qsizetype count)
+{
+    isSet.erase(isSet.begin() + row, isSet.begin() + row + count);
+    switch (type) {
+    case ColumnType::Integer:
+        integers.remove(row, count);
+        break;
+    case ColumnType::Real:
+        reals.remove(row, count);
+        break;
+    case ColumnType::String:
+        for (qsizetype i = row; i < row + count; ++i)
+            garbage += strings.at(i).size;
+        strings.remove(row, count);
+        if (strings.isEmpty()) {
+            arena.clear();
+            garbage = 0;
+        }
+        break;
+    case ColumnType::Variant:
+        variants.remove(row, count);
+        break;
+    }
+}
+
+// Reorders the rows so that row i holds what was in row order[i] before.
+void QColumnarTableModelPrivate::Values::permute(const QList<int> &order)
+{
+    const auto permuted = [&order](const auto &list) {
+        std::decay_t<decltype(list)> result;
+        result.reserve(list.size());
+        for (int from : order)
+            result.push_back(list[from]);
+        return result;
+    };
+    isSet = permuted(isSet);
+    switch (type) {
+    case ColumnType::Integer:
+        integers = permuted(integers);
+        break;
+    case ColumnType::Real:
+        reals = permuted(reals);
+        break;
+    case ColumnType::String:
+        strings = permuted(strings);
+        break;
+    case ColumnType::Variant:
+        variants = permuted(variants);
+        break;
+    }
+}
+
+// Compares two rows that both hold a value.
+int QColumnarTableModelPrivate::Values::compare(qsizetype left, qsizetype right) const
+{
+    switch (type) {
+    case ColumnType::Integer: {
+        const qint64 l = integers.at(left);
+        const qint64 r = integers.at(right);
+        return l < r ? -1 : (r < l ? 1 : 0);
+    }
+    case ColumnType::Real: {
+        // NaN is unordered against every number; sort it after all of them
+        const double l = reals.at(left);
+        const double r = reals.at(right);
+        if (qIsNaN(l) || qIsNaN(r))
+            return int(qIsNaN(l)) - int(qIsNaN(r));
+        return l < r ? -1 : (r < l ? 1 : 0);
+    }
+    case ColumnType::String:
+        return string(left).compare(string(right));
+    case ColumnType::Variant:
+        break;
+    }
+    const QPartialOrdering ordering = QVariant::compare(variants.at(left), variants.at(right));
+    if (ordering == QPartialOrdering::Less)
+        return -1;
+    if (ordering == QPartialOrdering::Greater)
+        return 1;
+    return 0;
+}
+
+QColumnarTableModelPrivate::Values *QColumnarTableModelPrivate::Column::valuesForRole(int role)
+{
+    role = valueRole(role);
+    if (role == Qt::DisplayRole)
+        return &values;
+    for (auto &[valueRole, roleValues] : roles) {
+        if (valueRole == role)
+            return &roleValues;
+    }
+    return nullptr;
+}
+
+template <typename T>
+bool QColumnarTableModelPrivate::setColumnValues(int column, int firstRow, QSpan<const T> values,
+                                                 int role)
+{
+    Q_Q(QColumnarTableModel);
+    if (column < 0 || column >= columns.size() || firstRow < 0
+        || values.size() > rows - firstRow) {
+        return false;
+    }
+    Values *target = columns[column].valuesForRole(role);
+    if (!target)
+        return false;
+
+    qsizetype written = 0;
+    while (written < values.size() && target->assign(firstRow + written, values[written]))
+        ++written;
+    if (written > 0) {
+        emit q->dataChanged(q->index(firstRow, column), q->index(int(firstRow + written - 1), column),
+                            changedRoles(role));
+    }
+    return written == values.size();
+}
+
+/*!
+    \class QColumnarTableModel
+    \inmodule QtCore
+    \since 6.9
+    \brief The QColumnarTableModel class provides a compact table model for
+    large amounts of data.
+
+    \ingroup model-view
+
+    QColumnarTableModel stores its data column by column. Each column has a
+    ColumnType that decides how its values are stored: integers and real
+    numbers are kept in plain arrays, and the texts of a String column share
+    a single buffer. A table with millions of cells therefore needs little
+    more memory than the data itself, in contrast to QStandardItemModel,
+    which allocates an item with its own list of role values for every cell.
+
+    Columns are added with appendColumn(), and rows with appendRows() or
+    insertRows(). The values of a range of rows are best written with
+    setColumnValues(), which emits a single dataChanged() signal for the
+    whole range; setData() can be used to change single cells. Cells that
+    were never given a value, or whose value was cleared, hold no data.
+
+    The Qt::DisplayRole and Qt::EditRole share the values of a column. Other
+    roles, such as Qt::ToolTipRole or Qt::ForegroundRole, are only stored for
+    columns that opted in with addRoleColumn(); data() returns an invalid
+    QVariant for all other roles. multiData() fetches any number of roles of
+    a cell in one call.
+
+    Reading from the model does not change it, so it can be used with the
+    QSortFilterProxyModel::ExtractSortKeys and
+    QSortFilterProxyModel::ConcurrentFiltering hints, provided that no other
+    thread modifies it while the proxy sorts or filters. sort() sorts the
+    rows of the model itself by comparing the stored values directly.
+
+    \sa QAbstractTableModel, QStandardItemModel, {Model Classes}
+*/
+
+/*!
+    \enum QColumnarTableModel::ColumnType
+
+    This enum describes how the values of a column are stored.
+
+    \value Integer  Values are stored as qint64.
+    \value Real     Values are stored as double.
+    \value String   Values are stored as text.
+    \value Variant  Values are stored as QVariant. This is the least compact
+                    type, but it can hold values of any type.
+
+    Values of other types that are written to a column are converted to its
+    type; setting a value that cannot be converted fails.
+*/
+
+/*!
+    Constructs an empty table model with the given \a parent.
+*/
+QColumnarTableModel::QColumnarTableModel(QObject *parent)
+    : QAbstractTableModel(*new QColumnarTableModelPrivate, parent)
+{
+}
+
+/*!
+    Destroys the model.
+*/
+QColumnarTableModel::~QColumnarTableModel() = default;
+
+/*!
+    Appends a column with values of the given \a type, and returns its index.
+    If \a title is not empty, it is used as the column's header.
+
+    The cells of the new column hold no data.
+*/
+int QColumnarTableModel::appendColumn(ColumnType type, const QString &title)
+{
+    Q_D(QColumnarTableModel);
+    const int column = int(d->columns.size());
+    beginInsertColumns(QModelIndex(), column, column);
+    QColumnarTableModelPrivate::Column newColumn{QColumnarTableModelPrivate::Values(type, d->rows),
+                                                 {}, {}};
+    if (!title.isEmpty())
+        newColumn.header.insert(Qt::DisplayRole, title);
+    d->columns.append(std::move(newColumn));
+    endInsertColumns();
+    return column;
+}
+
+/*!
+    Returns the type of the values of \a column.
+*/
+QColumnarTableModel::ColumnType QColumnarTableModel::columnType(int column) const
+{
+    Q_D(const QColumnarTableModel);
+    if (column < 0 || column >= d->columns.size())
+        return ColumnType::Variant;
+    return d->columns.at(column).values.type;
+}
+
+/*!
+    Makes \a column store values of the given \a type for \a role, in
+    addition to the values it holds for Qt::DisplayRole and Qt::EditRole.
+    Returns \c true on success, or \c false if the column does not exist or
+    already stores values for \a role.
+
+    \sa columnRoles()
+*/
+bool QColumnarTableModel::addRoleColumn(int column, int role, ColumnType type)
+{
+    Q_D(QColumnarTableModel);
+    if (column < 0 || column >= d->columns.size())
+        return false;
+    QColumnarTableModelPrivate::Column &target = d->columns[column];
+    if (target.valuesForRole(role))
+        return false;
+    target.roles.emplace_back(role, QColumnarTableModelPrivate::Values(type, d->rows));
+    return true;
+}
+
+/*!
+    Returns the roles that \a column stores values for in addition to
+    Qt::DisplayRole and Qt::EditRole.
+
+    \sa addRoleColumn()
+*/
+QList<int> QColumnarTableModel::columnRoles(int column) const
+{
+    Q_D(const QColumnarTableModel);
+    QList<int> roles;
+    if (column < 0 || column >= d->columns.size())
+        return roles;
+    for (const auto &roleValues : d->columns.at(column).roles)
+        roles.append(roleValues.first);
+    return roles;
+}
+
+/*!
+    Appends \a count rows to the model. The cells of the new rows hold no
+    data.
+
+    \sa setColumnValues(), insertRows()
+*/
+void QColumnarTableModel::appendRows(int count)
+{
+    Q_D(QColumnarTableModel);
+    insertRows(d->rows, count);
+}
+
+/*!
+    Sets the \a role values of \a column, starting at \a firstRow, to
+    \a values. Returns \c true if all values were set, or \c false if the
+    rows do not exist, the column does not store \a role values, or a value
+    cannot be converted to the type of the column. In the latter case the
+    values before the one that failed have been set.
+
+    A single dataChanged() signal is emitted for all rows that changed.
+
+    \sa appendRows(), setData()
+*/
+bool QColumnarTableModel::setColumnValues(int column, int firstRow, QSpan<const qint64> values,
+                                          int role)
+{
+    Q_D(QColumnarTableModel);
+    return d->setColumnValues(column, firstRow, values, role);
+}
+
+/*!
+    \overload
+*/
+bool QColumnarTableModel::setColumnValues(int column, int firstRow, QSpan<const double> values,
+                                          int role)
+{
+    Q_D(QColumnarTableModel);
+    return d->setColumnValues(column, firstRow, values, role);
+}
+
+/*!
+    \overload
+*/
+bool QColumnarTableModel::setColumnValues(int column, int firstRow, QSpan<const QString> values,
+                                          int role)
+{
+    Q_D(QColumnarTableModel);
+    return d->setColumnValues(column, firstRow, values, role);
+}
+
+/*!
+    \overload
+*/
+bool QColumnarTableModel::setColumnValues(int column, int firstRow, QSpan<const QVariant> values,
+                                          int role)
+{
+    Q_D(QColumnarTableModel);
+    return d->setColumnValues(column, firstRow, values, role);
+}
+
+/*!
+    Removes all rows from the model. The columns, their types and their
+    headers are kept.
+*/
+void QColumnarTableModel::clear()
+{
+    Q_D(QColumnarTableModel);
+    beginResetModel();
+    for (QColumnarTableModelPrivate::Column &column : d->columns) {
+        column.values = QColumnarTableModelPrivate::Values(column.values.type);
+        for (auto &roleValues : column.roles)
+            roleValues.second = QColumnarTableModelPrivate::Values(roleValues.second.type);
+    }
+    d->rows = 0;
+    endResetModel();
+}
+
+/*!
+    \reimp
+*/
+int QColumnarTableModel::rowCount(const QModelIndex &parent) const
+{
+    Q_D(const QColumnarTableModel);
+    return parent.isValid() ? 0 : d->rows;
+}
+
+/*!
+    \reimp
+*/
+int QColumnarTableModel::columnCount(const QModelIndex &parent) const
+{
+    Q_D(const QColumnarTableModel);
+    return parent.isValid() ? 0 : int(d->columns.size());
+}
+
+/*!
+    \reimp
+*/
+QVariant QColumnarTableModel::data(const QModelIndex &index, int role) const
+{
+    Q_D(const QColumnarTableModel);
+    if (!checkIndex(index, CheckIndexOption::IndexIsValid | CheckIndexOption::ParentIsInvalid))
+        return QVariant();
+    const auto *values = d->columns.at(index.column()).valuesForRole(role);
+    return values ? values->value(index.row()) : QVariant();
+}
+
+/*!
+    \reimp
+*/
+void QColumnarTableModel::multiData(const QModelIndex &index, QModelRoleDataSpan roleDataSpan) const
+{
+    Q_D(const QColumnarTableModel);
+    if (!checkIndex(index, CheckIndexOption::IndexIsValid | CheckIndexOption::ParentIsInvalid)) {
+        for (QModelRoleData &roleData : roleDataSpan)
+            roleData.clearData();
+        return;
+    }
+    const QColumnarTableModelPrivate::Column &column = d->columns.at(index.column());
+    for (QModelRoleData &roleData : roleDataSpan) {
+        const auto *values = column.valuesForRole(roleData.role());
+        if (values)
+            roleData.setData(values->value(index.row()));
+        else
+            roleData.clearData();
+    }
+}
+
+/*!
+    \reimp
+
+    Sets the \a role data of the cell at \a index to \a value. Returns
+    \c false if the column does not store values for \a role, or if \a value
+    cannot be converted to the type of the column. An invalid \a value
+    clears the cell.
+*/
+bool QColumnarTableModel::setData(const QModelIndex &index, const QVariant &value, int role)
+{
+    Q_D(QColumnarTableModel);
+    if (!checkIndex(index, CheckIndexOption::IndexIsValid | CheckIndexOption::ParentIsInvalid))
+        return false;
+    auto *values = d->columns[index.column()].valuesForRole(role);
+    if (!values || !values->setValue(index.row(), value))
+        return false;
+    emit dataChanged(index, index, QColumnarTableModelPrivate::changedRoles(role));
+    return true;
+}
+
+/*!
+    \reimp
+
+    Clears the values of all roles of the cell at \a index.
+*/
+bool QColumnarTableModel::clearItemData(const QModelIndex &index)
+{
+    Q_D(QColumnarTableModel);
+    if (!checkIndex(index, CheckIndexOption::IndexIsValid | CheckIndexOption::ParentIsInvalid))
+        return false;
+    QColumnarTableModelPrivate::Column &column = d->columns[index.column()];
+    column.values.unset(index.row());
+    for (auto &roleValues : column.roles)
+        roleValues.second.unset(index.row());
+    emit dataChanged(index, index);
+    return true;
+}
+
+/*!
+    \reimp
+*/
+QVariant QColumnarTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    Q_D(const QColumnarTableModel);
+    if (orientation == Qt::Horizontal && section >= 0 && section < d->columns.size()) {
+        const QMap<int, QVariant> &header = d->columns.at(section).header;
+        const auto it = header.constFind(QColumnarTableModelPrivate::valueRole(role));
+        if (it != header.cend())
+            return it.value();
+    }
+    return QAbstractTableModel::headerData(section, orientation, role);
+}
+
+/*!
+    \reimp
+
+    Only the headers of columns can be set.
+*/
+bool QColumnarTableModel::setHeaderData(int section, Qt::Orientation orientation,
+                                        const QVariant &value, int role)
+{
+    Q_D(QColumnarTableModel);
+    if (orientation != Qt::Horizontal || section < 0 || section >= d->columns.size())
+        return false;
+    QMap<int, QVariant> &header = d->columns[section].header;
+    role = QColumnarTableModelPrivate::valueRole(role);
+    if (value.isValid())
+        header.insert(role, value);
+    else
+        header.remove(role);
+    emit headerDataChanged(orientation, section, section);
+    return true;
+}
+
+/*!
+    \reimp
+*/
+Qt::ItemFlags QColumnarTableModel::flags(const QModelIndex &index) const
+{
+    if (!index.isValid())
+        return QAbstractTableModel::flags(index);
+    return QAbstractTableModel::flags(index) | Qt::ItemIsEditable;
+}
+
+/*!
+    \reimp
+
+    Inserts \a count rows before \a row. The cells of the new rows hold no
+    data.
+*/
+bool QColumnarTableModel::insertRows(int row, int count, const QModelIndex &parent)
+{
+    Q_D(QColumnarTableModel);
+    if (parent.isValid() || count < 1 || row < 0 || row > d->rows)
+        return false;
+    beginInsertRows(QModelIndex(), row, row + count - 1);
+    for (QColumnarTableModelPrivate::Column &column : d->columns) {
+        column.values.insert(row, count);
+        for (auto &roleValues : column.roles)
+            roleValues.second.insert(row, count);
+    }
+    d->rows += count;
+    endInsertRows();
+    return true;
+}
+
+/*!
+    \reimp
+*/
+bool QColumnarTableModel::removeRows(int row, int count, const QModelIndex &parent)
+{
+    Q_D(QColumnarTableModel);
+    if (parent.isValid() || count < 1 || row < 0 || count > d->rows - row)
+        return false;
+    beginRemoveRows(QModelIndex(), row, row + count - 1);
+    for (QColumnarTableModelPrivate::Column &column : d->columns) {
+        column.values.remove(row, count);
+        for (auto &roleValues : column.roles)
+            roleValues.second.remove(row, count);
+    }
+    d->rows -= count;
+    endRemoveRows();
+    return true;
+}
+
+/*!
+    \reimp
+*/
+bool QColumnarTableModel::removeColumns(int column, int count, const QModelIndex &parent)
+{
+    Q_D(QColumnarTableModel);
+    if (parent.isValid() || count < 1 || column < 0 || count > d->columns.size() - column)
+        return false;
+    beginRemoveColumns(QModelIndex(), column, column + count - 1);
+    d->columns.remove(column, count);
+    endRemoveColumns();
+    return true;
+}
+
+/*!
+    \reimp
+
+    Sorts the rows by the values of \a column in the given \a order. Rows
+    with equal values keep their relative order; rows whose cell holds no
+    data are placed last.
+*/
+void QColumnarTableModel::sort(int column, Qt::SortOrder order)
+{
+    Q_D(QColumnarTableModel);
+    if (column < 0 || column >= d->columns.size())
+        return;
+
+    emit layoutAboutToBeChanged(QList<QPersistentModelIndex>(), VerticalSortHint);
+
+    const QColumnarTableModelPrivate::Values &keys = d->columns.at(column).values;
+    QList<int> sorted(d->rows);
+    std::iota(sorted.begin(), sorted.end(), 0);
+    std::stable_sort(sorted.begin(), sorted.end(), [&keys, order](int left, int right) {
+        if (!keys.isSet[left] || !keys.isSet[right])
+            return keys.isSet[left] && !keys.isSet[right];
+        const int result = keys.compare(left, right);
+        return order == Qt::AscendingOrder ? result < 0 : result > 0;
+    });
+
+    for (QColumnarTableModelPrivate::Column &sortedColumn : d->columns) {
+        sortedColumn.values.permute(sorted);
+        for (auto &roleValues : sortedColumn.roles)
+            roleValues.second.permute(sorted);
+    }
+
+    QList<int> forwarding(d->rows);
+    for (int i = 0; i < d->rows; ++i)
+        forwarding[sorted.at(i)] = i;
+
+    const QModelIndexList oldList = persistentIndexList();
+    QModelIndexList newList;
+    newList.reserve(oldList.size());
+    for (const QModelIndex &oldIndex : oldList)
+        newList.append(index(forwarding.at(oldIndex.row()), oldIndex.column()));
+    changePersistentIndexList(oldList, newList);
+
+    emit layoutChanged(QList<QPersistentModelIndex>(), VerticalSortHint);
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qcolumnartablemodel.cpp"
@@ -0,0 +1,76 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QCOLUMNARTABLEMODEL_H
+#define QCOLUMNARTABLEMODEL_H
+
+#include <QtCore/qabstractitemmodel.h>
+#include <QtCore/qspan.h>
+
+QT_REQUIRE_CONFIG(columnartablemodel);
+
+QT_BEGIN_NAMESPACE
+
+class QColumnarTableModelPrivate;
+
+class Q_CORE_EXPORT QColumnarTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum class ColumnType {
+        Integer,
+        Real,
+        String,
+        Variant
+    };
+    Q_ENUM(ColumnType)
+
+    explicit QColumnarTableModel(QObject *parent = nullptr);
+    ~QColumnarTableModel() override;
+
+    int appendColumn(ColumnType type, const QString &title = QString());
+    ColumnType columnType(int column) const;
+    bool addRoleColumn(int column, int role, ColumnType type);
+    QList<int> columnRoles(int column) const;
+
+    void appendRows(int count);
+    bool setColumnValues(int column, int firstRow, QSpan<const qint64> values,
+                         int role = Qt::DisplayRole);
+    bool setColumnValues(int column, int firstRow, QSpan<const double> values,
+                         int role = Qt::DisplayRole);
+    bool setColumnValues(int column, int firstRow, QSpan<const QString> values,
+                         int role = Qt::DisplayRole);
+    bool setColumnValues(int column, int firstRow, QSpan<const QVariant> values,
+                         int role = Qt::DisplayRole);
+    void clear();
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    void multiData(const QModelIndex &index, QModelRoleDataSpan roleDataSpan) const override;
+    bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
+    bool clearItemData(const QModelIndex &index) override;
+
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+    bool setHeaderData(int section, Qt::Orientation orientation, const QVariant &value,
+                       int role = Qt::EditRole) override;
+
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+
+    bool insertRows(int row, int count, const QModelIndex &parent = QModelIndex()) override;
+    bool removeRows(int row, int count, const QModelIndex &parent = QModelIndex()) override;
+    bool removeColumns(int column, int count, const QModelIndex &parent = QModelIndex()) override;
+
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+private:
+    Q_DECLARE_PRIVATE(QColumnarTableModel)
+    Q_DISABLE_COPY(QColumnarTableModel)
+};
+
+QT_END_NAMESPACE
+
+#endif // QCOLUMNARTABLEMODEL_H
@@ -592,9 +592,369 @@ void QItemSelection::split(const QItemSelectionRange &range,
     }
 }
 
+/*!
+    \internal
+    \class QItemSelectionIntervals
+
+    Keeps a selection as disjoint row intervals, so that finding out whether
+    an item is selected takes logarithmic time in the number of ranges, and
+    merging two selections takes O(n log n) time instead of comparing every
+    range of one with every range of the other. Converting back to a
+    QItemSelection gives the smallest number of ranges for the bands.
+*/
+
+namespace {
+using IntervalRows = QItemSelectionIntervals::Rows;
+using IntervalBand = QItemSelectionIntervals::Band;
+
+// Adds the rows from first to last to rows, which must not hold rows after first.
+void appendRows(IntervalRows &rows, int first, int last)
+{
+    if (!rows.isEmpty() && qint64(rows.constLast().second) + 1 >= first)
+        rows.last().second = qMax(rows.constLast().second, last);
+    else
+        rows.emplaceBack(first, last);
+}
+
+IntervalRows normalizedRows(IntervalRows rows)
+{
+    std::sort(rows.begin(), rows.end());
+    IntervalRows result;
+    for (const auto &[first, last] : std::as_const(rows))
+        appendRows(result, first, last);
+    return result;
+}
+
+// Returns the rows where keep(isInA, isInB) holds.
+template <typename Keep>
+IntervalRows combinedRows(const IntervalRows &a, const IntervalRows &b, Keep keep)
+{
+    std::vector<qint64> cuts;
+    cuts.reserve(2 * (a.size() + b.size()));
+    for (const IntervalRows *rows : { &a, &b }) {
+        for (const auto &[first, last] : *rows) {
+            cuts.push_back(first);
+            cuts.push_back(qint64(last) + 1);
+        }
+    }
+    std::sort(cuts.begin(), cuts.end());
+    cuts.erase(std::unique(cuts.begin(), cuts.end()), cuts.end());
+
+    IntervalRows result;
+    qsizetype i = 0;
+    qsizetype j = 0;
+    for (size_t k = 0; k + 1 < cuts.size(); ++k) {
+        const qint64 from = cuts[k];
+        while (i < a.size() && a.at(i).second < from)
+            ++i;
+        while (j < b.size() && b.at(j).second < from)
+            ++j;
+        const bool isInA = i < a.size() && a.at(i).first <= from;
+        const bool isInB = j < b.size() && b.at(j).first <= from;
+        if (keep(isInA, isInB))
+            appendRows(result, int(from), int(cuts[k + 1] - 1));
+    }
+    return result;
+}
+
+// The columns from cuts[k] to cuts[k + 1] - 1 form the k-th segment.
+void addCuts(std::vector<int> &cuts, const QList<IntervalBand> &bands)
+{
+    for (const IntervalBand &band : bands) {
+        cuts.push_back(band.left);
+        cuts.push_back(band.right + 1);
+    }
+}
+
+void sortCuts(std::vector<int> &cuts)
+{
+    std::sort(cuts.begin(), cuts.end());
+    cuts.erase(std::unique(cuts.begin(), cuts.end()), cuts.end());
+}
+
+qsizetype firstSegment(const std::vector<int> &cuts, int left)
+{
+    return std::lower_bound(cuts.begin(), cuts.end(), left) - cuts.begin();
+}
+
+QList<IntervalRows> segmentRows(const QList<IntervalBand> &bands, const std::vector<int> &cuts)
+{
+    QList<IntervalRows> segments(qsizetype(cuts.size()) - 1);
+    for (const IntervalBand &band : bands) {
+        for (qsizetype k = firstSegment(cuts, band.left); cuts[k] <= band.right; ++k)
+            segments[k] = band.rows;
+    }
+    return segments;
+}
+
+// Joins neighboring segments with the same rows into bands.
+QList<IntervalBand> bandsFromSegments(const std::vector<int> &cuts, QList<IntervalRows> &segments)
+{
+    QList<IntervalBand> bands;
+    for (qsizetype k = 0; k < segments.size(); ++k) {
+        if (segments.at(k).isEmpty())
+            continue;
+        if (!bands.isEmpty() && bands.constLast().right + 1 == cuts[k]
+            && bands.constLast().rows == segments.at(k)) {
+            bands.last().right = cuts[k + 1] - 1;
+        } else {
+            bands.append({ cuts[k], cuts[k + 1] - 1, std::move(segments[k]) });
+        }
+    }
+    return bands;
+}
+} // unnamed namespace
+
+/*!
+    \internal
+
+    Constructs the intervals of the items in \a selection. Invalid ranges, and
+    ranges of another model than the first valid one, are left out.
+*/
+QItemSelectionIntervals::QItemSelectionIntervals(const QItemSelection &selection)
+{
+    QHash<QModelIndex, QList<qsizetype>> rangesByParent;
+    for (qsizetype i = 0; i < selection.size(); ++i) {
+        const QItemSelectionRange &range = selection.at(i);
+        if (!range.isValid())
+            continue;
+        if (!model)
+            model = range.model();
+        else if (range.model() != model)
+            continue;
+        rangesByParent[range.parent()].append(i);
+    }
+
+    for (auto it = rangesByParent.cbegin(), end = rangesByParent.cend(); it != end; ++it) {
+        std::vector<int> cuts;
+        for (qsizetype i : it.value()) {
+            cuts.push_back(selection.at(i).left());
+            cuts.push_back(selection.at(i).right() + 1);
+        }
+        sortCuts(cuts);
+
+        QList<IntervalRows> segments(qsizetype(cuts.size()) - 1);
+        for (qsizetype i : it.value()) {
+            const QItemSelectionRange &range = selection.at(i);
+            const int top = range.top();
+            const int bottom = range.bottom();
+            for (qsizetype k = firstSegment(cuts, range.left()); cuts[k] <= range.right(); ++k)
+                segments[k].emplaceBack(top, bottom);
+        }
+        for (IntervalRows &rows : segments)
+            rows = normalizedRows(std::move(rows));
+        blocks.insert(it.key(), bandsFromSegments(cuts, segments));
+    }
+}
+
+/*!
+    \internal
+
+    Returns \c true if the item at \a row and \a column below \a parent is
+    in the intervals. Whether the item is selectable is not checked.
+*/
+bool QItemSelectionIntervals::contains(int row, int column, const QModelIndex &parent) const
+{
+    const auto it = blocks.constFind(parent);
+    if (it == blocks.cend())
+        return false;
+
+    const QList<Band> &bands = it.value();
+    auto band = std::upper_bound(bands.cbegin(), bands.cend(), column,
+                                 [](int column, const Band &band) { return column < band.left; });
+    if (band == bands.cbegin() || (--band)->right < column)
+        return false;
+
+    const Rows &rows = band->rows;
+    auto interval = std::upper_bound(rows.cbegin(), rows.cend(), row,
+                                     [](int row, const std::pair<int, int> &interval) {
+                                         return row < interval.first;
+                                     });
+    return interval != rows.cbegin() && (--interval)->second >= row;
+}
+
+/*!
+    \internal
+
+    Merges the \a other intervals into these, like QItemSelection::merge()
+    does with \a command.
+*/
+void QItemSelectionIntervals::merge(const QItemSelectionIntervals &other,
+                                    QItemSelectionModel::SelectionFlags command)
+{
+    std::function<bool(bool, bool)> keep;
+    if (command & QItemSelectionModel::Deselect)
+        keep = [](bool isInThis, bool isInOther) { return isInThis && !isInOther; };
+    else if (command & QItemSelectionModel::Toggle)
+        keep = [](bool isInThis, bool isInOther) { return isInThis != isInOther; };
+    else if (command & QItemSelectionModel::Select)
+        keep = [](bool isInThis, bool isInOther) { return isInThis || isInOther; };
+    else
+        return;
+
+    if (!model)
+        model = other.model;
+    // the items below parents that only these intervals have stay as they are
+    for (auto it = other.blocks.cbegin(), end = other.blocks.cend(); it != end; ++it) {
+        const QList<Band> bands = blocks.value(it.key());
+        std::vector<int> cuts;
+        addCuts(cuts, bands);
+        addCuts(cuts, it.value());
+        sortCuts(cuts);
+
+        const QList<Rows> mine = segmentRows(bands, cuts);
+        const QList<Rows> theirs = segmentRows(it.value(), cuts);
+        QList<Rows> segments(mine.size());
+        for (qsizetype k = 0; k < segments.size(); ++k)
+            segments[k] = combinedRows(mine.at(k), theirs.at(k), keep);
+
+        QList<Band> merged = bandsFromSegments(cuts, segments);
+        if (merged.isEmpty())
+            blocks.remove(it.key());
+        else
+            blocks.insert(it.key(), std::move(merged));
+    }
+}
+
+/*!
+    \internal
+
+    Returns the intervals of the items in these intervals but not in \a other.
+*/
+QItemSelectionIntervals QItemSelectionIntervals::subtracted(const QItemSelectionIntervals &other) const
+{
+    QItemSelectionIntervals result = *this;
+    result.merge(other, QItemSelectionModel::Deselect);
+    return result;
+}
+
+/*!
+    \internal
+
+    Returns \c true if any of the items in the intervals is enabled and
+    selectable.
+*/
+bool QItemSelectionIntervals::hasSelectableItems() const
+{
+    for (auto it = blocks.cbegin(), end = blocks.cend(); it != end; ++it) {
+        for (const Band &band : it.value()) {
+            for (const auto &[first, last] : band.rows) {
+                const QItemSelectionRange range(model->index(first, band.left, it.key()),
+                                                model->index(last, band.right, it.key()));
+                if (!range.isEmpty())
+                    return true;
+            }
+        }
+    }
+    return false;
+}
+
+/*!
+    \internal
+
+    Returns one selection range for each interval of each band, ordered by
+    parent, column and row.
+*/
+QItemSelection QItemSelectionIntervals::toSelection() const
+{
+    QItemSelection result;
+    QList<QModelIndex> parents = blocks.keys();
+    std::sort(parents.begin(), parents.end());
+    for (const QModelIndex &parent : std::as_const(parents)) {
+        for (const Band &band : blocks.value(parent)) {
+            for (const auto &[first, last] : band.rows) {
+                result.append(QItemSelectionRange(model->index(first, band.left, parent),
+                                                  model->index(last, band.right, parent)));
+            }
+        }
+    }
+    return result;
+}
+
 QItemSelectionModelPrivate::~QItemSelectionModelPrivate()
     = default;
 
+/*!
+    \internal
+
+    Returns the intervals of ranges merged with currentSelection.
+*/
+QItemSelectionIntervals QItemSelectionModelPrivate::buildIntervals() const
+{
+    QItemSelectionIntervals result(ranges);
+    if (!currentSelection.isEmpty())
+        result.merge(QItemSelectionIntervals(currentSelection), currentCommand);
+    return result;
+}
+
+/*!
+    \internal
+
+    Returns the intervals of the selection, or \nullptr if the selection has
+    so few ranges that searching them is faster than building the intervals.
+    The intervals of ranges are kept until ranges or the persistent indexes
+    of the model change; currentSelection is merged into them again whenever
+    it changes.
+*/
+const QItemSelectionIntervals *QItemSelectionModelPrivate::selectedIntervals() const
+{
+    const QAbstractItemModel *m = model.value();
+    const quint64 version = m ? QAbstractItemModelPrivate::get(m)->persistent.version : 0;
+    if (rangeIntervals && intervalsVersion != version) {
+        rangeIntervals.reset();
+        intervals.reset();
+    }
+    if (!rangeIntervals) {
+        if (ranges.size() + currentSelection.size() < IntervalThreshold)
+            return nullptr;
+        rangeIntervals.emplace(ranges);
+        intervalsVersion = version;
+    }
+    if (currentSelection.isEmpty())
+        return &*rangeIntervals;
+    if (!intervals) {
+        intervals = *rangeIntervals;
+        intervals->merge(QItemSelectionIntervals(currentSelection), currentCommand);
+    }
+    return &*intervals;
+}
+
+/*!
+    \internal
+
+    Merges currentSelection into ranges. The intervals of the selection stay
+    as they are, they become the intervals of ranges.
+*/
+void QItemSelectionModelPrivate::finalize()
+{
+    if (currentSelection.isEmpty())
+        return;
+    const QAbstractItemModel *m = model.value();
+    if (intervals && intervalsVersion == (m ? QAbstractItemModelPrivate::get(m)->persistent.version : 0))
+        rangeIntervals = std::move(intervals);
+    else
+        rangeIntervals.reset();
+    intervals.reset();
+    ranges.merge(currentSelection, currentCommand);
+    currentSelection.clear();
+}
+
+/*!
+    \internal
+
+    Emits selectionChanged() with the items in \a newSelection but not in
+    \a oldSelection as selected, and the other way around as deselected.
+*/
+void QItemSelectionModelPrivate::emitSelectionChanged(const QItemSelectionIntervals &newSelection,
+                                                      const QItemSelectionIntervals &oldSelection)
+{
+    Q_Q(QItemSelectionModel);
+    const QItemSelection selected = newSelection.subtracted(oldSelection).toSelection();
+    const QItemSelection deselected = oldSelection.subtracted(newSelection).toSelection();
+    if (!selected.isEmpty() || !deselected.isEmpty())
+        emit q->selectionChanged(selected, deselected);
+}
+
 void QItemSelectionModelPrivate::initModel(QAbstractItemModel *m)
 {
     Q_Q(QItemSelectionModel);
@@ -609,6 +969,7 @@ void QItemSelectionModelPrivate::initModel(QAbstractItemModel *m)
 
     // Caller has to call notify(), unless calling during construction (the common case).
     model.setValueBypassingBindings(m);
+    invalidateIntervals();
 
     if (m) {
         connections = std::array<QMetaObject::Connection, 12> {
@@ -661,6 +1022,24 @@ QItemSelection QItemSelectionModelPrivate::expandSelection(const QItemSelection
                                  (command & QItemSelectionModel::Columns)))
         return selection;
 
+    // merging each expanded range into the others takes quadratic time
+    if (selection.size() >= IntervalThreshold) {
+        QItemSelection expanded;
+        expanded.reserve(selection.size());
+        for (const QItemSelectionRange &range : selection) {
+            const QModelIndex parent = range.parent();
+            if (command & QItemSelectionModel::Rows) {
+                expanded.append(QItemSelectionRange(model->index(range.top(), 0, parent),
+                                                    model->index(range.bottom(), model->columnCount(parent) - 1, parent)));
+            }
+            if (command & QItemSelectionModel::Columns) {
+                expanded.append(QItemSelectionRange(model->index(0, range.left(), parent),
+                                                    model->index(model->rowCount(parent) - 1, range.right(), parent)));
+            }
+        }
+        return QItemSelectionIntervals(expanded).toSelection();
+    }
+
     QItemSelection expanded;
     if (command & QItemSelectionModel::Rows) {
         for (int i = 0; i < selection.size(); ++i) {
@@ -763,6 +1142,7 @@ void QItemSelectionModelPrivate::rowsAboutToBeRemoved(const QModelIndex &parent,
         }
     }
     ranges.append(newParts);
+    invalidateIntervals();
 
     if (!deselected.isEmpty() || indexesOfSelectionChanged)
         emit q->selectionChanged(QItemSelection(), deselected);
@@ -831,6 +1211,7 @@ void QItemSelectionModelPrivate::columnsAboutToBeInserted(const QModelIndex &par
         }
     }
     ranges += split;
+    invalidateIntervals();
 }
 
 /*!
@@ -867,6 +1248,7 @@ void QItemSelectionModelPrivate::rowsAboutToBeInserted(const QModelIndex &parent
         }
     }
     ranges += split;
+    invalidateIntervals();
 
     if (indexesOfSelectionChanged)
         emit q->selectionChanged(QItemSelection(), QItemSelection());
@@ -1047,6 +1429,8 @@ static bool qt_PersistentModelIndexLessThan(const QPersistentModelIndex &i1, con
 */
 void QItemSelectionModelPrivate::layoutChanged(const QList<QPersistentModelIndex> &, QAbstractItemModel::LayoutChangeHint hint)
 {
+    invalidateIntervals();
+
     // special case for when all indexes are selected
     if (tableSelected && tableColCount == model->columnCount(tableParent)
         && tableRowCount == model->rowCount(tableParent)) {
@@ -1132,6 +1516,7 @@ void QItemSelectionModelPrivate::layoutChanged(const QList<QPersistentModelIndex
 void QItemSelectionModelPrivate::modelDestroyed()
 {
     model.setValueBypassingBindings(nullptr);
+    invalidateIntervals();
     disconnectModel();
     model.notify();
 }
@@ -1345,8 +1730,14 @@ void QItemSelectionModel::select(const QItemSelection &selection, QItemSelection
     // is invoked, so it would not be cleared yet. We clear it invalid ranges in it here.
     d->ranges.removeIf(QtFunctionObjects::IsNotValid());
 
-    QItemSelection old = d->ranges;
-    old.merge(d->currentSelection, d->currentCommand);
+    QItemSelection old;
+    std::optional<QItemSelectionIntervals> oldIntervals;
+    if (const QItemSelectionIntervals *intervals = d->selectedIntervals()) {
+        oldIntervals = *intervals;
+    } else {
+        old = d->ranges;
+        old.merge(d->currentSelection, d->currentCommand);
+    }
 
     // expand selection according to SelectionBehavior
     if (command & Rows || command & Columns)
@@ -1356,16 +1747,27 @@ void QItemSelectionModel::select(const QItemSelection &selection, QItemSelection
     if (command & Clear) {
         d->ranges.clear();
         d->currentSelection.clear();
+        d->invalidateIntervals();
     }
 
     // merge and clear currentSelection if Current was not set (ie. start new currentSelection)
     if (!(command & Current))
         d->finalize();
 
-    // update currentSelection
+    // update currentSelection; the intervals of ranges stay valid
     if (command & Toggle || command & Select || command & Deselect) {
         d->currentCommand = command;
         d->currentSelection = sel;
+        d->intervals.reset();
+    }
+
+    // big selections are compared as intervals, and the changes reported as
+    // the fewest ranges covering them
+    const QItemSelectionIntervals *newIntervals = d->selectedIntervals();
+    if (oldIntervals || newIntervals) {
+        d->emitSelectionChanged(newIntervals ? *newIntervals : d->buildIntervals(),
+                                oldIntervals ? *oldIntervals : QItemSelectionIntervals(old));
+        return;
     }
 
     // generate new selection, compare with old and emit selectionChanged()
@@ -1474,6 +1876,9 @@ bool QItemSelectionModel::isSelected(const QModelIndex &index) const
     if (d->model != index.model() || !index.isValid())
         return false;
 
+    if (const QItemSelectionIntervals *intervals = d->selectedIntervals())
+        return intervals->contains(index) && isSelectableAndEnabled(d->model->flags(index));
+
     //  search model ranges
     auto contains = [](const auto &index) {
         return [&index](const auto &range) { return range.contains(index); };
@@ -1515,6 +1920,18 @@ bool QItemSelectionModel::isRowSelected(int row, const QModelIndex &parent) cons
     if (parent.isValid() && d->model != parent.model())
         return false;
 
+    if (const QItemSelectionIntervals *intervals = d->selectedIntervals()) {
+        const int colCount = d->model->columnCount(parent);
+        int unselectable = 0;
+        for (int column = 0; column < colCount; ++column) {
+            if (!isSelectableAndEnabled(d->model->index(row, column, parent).flags()))
+                ++unselectable;
+            else if (!intervals->contains(row, column, parent))
+                return false;
+        }
+        return unselectable < colCount;
+    }
+
     // return false if row exist in currentSelection (Deselect)
     if (d->currentCommand & Deselect) {
         const auto matches = [](auto row, const auto &parent) {
@@ -1601,6 +2018,18 @@ bool QItemSelectionModel::isColumnSelected(int column, const QModelIndex &parent
     if (parent.isValid() && d->model != parent.model())
         return false;
 
+    if (const QItemSelectionIntervals *intervals = d->selectedIntervals()) {
+        const int rowCount = d->model->rowCount(parent);
+        int unselectable = 0;
+        for (int row = 0; row < rowCount; ++row) {
+            if (!isSelectableAndEnabled(d->model->index(row, column, parent).flags()))
+                ++unselectable;
+            else if (!intervals->contains(row, column, parent))
+                return false;
+        }
+        return unselectable < rowCount;
+    }
+
     // return false if column exist in currentSelection (Deselect)
     if (d->currentCommand & Deselect) {
         const auto matches = [](auto column, const auto &parent) {
@@ -1683,6 +2112,18 @@ bool QItemSelectionModel::rowIntersectsSelection(int row, const QModelIndex &par
     if (parent.isValid() && d->model != parent.model())
          return false;
 
+    if (const QItemSelectionIntervals *intervals = d->selectedIntervals()) {
+        for (const QItemSelectionIntervals::Band &band : intervals->bands(parent)) {
+            if (!intervals->contains(row, band.left, parent))
+                continue;
+            for (int column = band.left; column <= band.right; ++column) {
+                if (isSelectableAndEnabled(d->model->index(row, column, parent).flags()))
+                    return true;
+            }
+        }
+        return false;
+    }
+
     QItemSelection sel = d->ranges;
     sel.merge(d->currentSelection, d->currentCommand);
     if (sel.isEmpty() || sel.constFirst().parent() != parent)
@@ -1719,6 +2160,20 @@ bool QItemSelectionModel::columnIntersectsSelection(int column, const QModelInde
     if (parent.isValid() && d->model != parent.model())
         return false;
 
+    if (const QItemSelectionIntervals *intervals = d->selectedIntervals()) {
+        for (const QItemSelectionIntervals::Band &band : intervals->bands(parent)) {
+            if (column < band.left || column > band.right)
+                continue;
+            for (const auto &[first, last] : band.rows) {
+                for (int row = first; row <= last; ++row) {
+                    if (isSelectableAndEnabled(d->model->index(row, column, parent).flags()))
+                        return true;
+                }
+            }
+        }
+        return false;
+    }
+
     QItemSelection sel = d->ranges;
     sel.merge(d->currentSelection, d->currentCommand);
     if (sel.isEmpty() || sel.constFirst().parent() != parent)
@@ -1776,6 +2231,9 @@ bool QItemSelectionModel::hasSelection() const
         model_p->executePendingOperations();
     }
 
+    if (const QItemSelectionIntervals *intervals = d->selectedIntervals())
+        return intervals->hasSelectableItems();
+
     if (d->currentCommand & (Toggle | Deselect)) {
         QItemSelection sel = d->ranges;
         sel.merge(d->currentSelection, d->currentCommand);
@@ -1792,6 +2250,9 @@ bool QItemSelectionModel::hasSelection() const
 QModelIndexList QItemSelectionModel::selectedIndexes() const
 {
     Q_D(const QItemSelectionModel);
+    if (const QItemSelectionIntervals *intervals = d->selectedIntervals())
+        return intervals->toSelection().indexes();
+
     QItemSelection selected = d->ranges;
     selected.merge(d->currentSelection, d->currentCommand);
     return selected.indexes();
@@ -1880,6 +2341,9 @@ QModelIndexList QItemSelectionModel::selectedColumns(int row) const
 const QItemSelection QItemSelectionModel::selection() const
 {
     Q_D(const QItemSelectionModel);
+    if (const QItemSelectionIntervals *intervals = d->selectedIntervals())
+        return intervals->toSelection();
+
     QItemSelection selected = d->ranges;
     selected.merge(d->currentSelection, d->currentCommand);
     // make sure we have no invalid ranges
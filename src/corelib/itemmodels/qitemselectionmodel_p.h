@@ -18,12 +18,47 @@
 #include "qitemselectionmodel.h"
 #include "private/qobject_p.h"
 #include "private/qproperty_p.h"
+#include <QtCore/qhash.h>
 #include <array>
+#include <optional>
 
 QT_REQUIRE_CONFIG(itemmodel);
 
 QT_BEGIN_NAMESPACE
 
+// A selection normalized into disjoint row intervals: below each parent, the
+// selected columns are split into bands, and each band keeps the rows
+// selected in all of its columns as sorted, disjoint intervals. Membership
+// tests are binary searches, and merging two selections walks both in order.
+class Q_AUTOTEST_EXPORT QItemSelectionIntervals
+{
+public:
+    using Rows = QList<std::pair<int, int>>;
+    struct Band {
+        int left;
+        int right;
+        Rows rows;
+    };
+
+    QItemSelectionIntervals() = default;
+    explicit QItemSelectionIntervals(const QItemSelection &selection);
+
+    bool isEmpty() const { return blocks.isEmpty(); }
+    bool hasSelectableItems() const;
+    bool contains(int row, int column, const QModelIndex &parent) const;
+    bool contains(const QModelIndex &index) const
+    { return contains(index.row(), index.column(), index.parent()); }
+    QList<Band> bands(const QModelIndex &parent) const { return blocks.value(parent); }
+
+    void merge(const QItemSelectionIntervals &other, QItemSelectionModel::SelectionFlags command);
+    QItemSelectionIntervals subtracted(const QItemSelectionIntervals &other) const;
+    QItemSelection toSelection() const;
+
+private:
+    const QAbstractItemModel *model = nullptr;
+    QHash<QModelIndex, QList<Band>> blocks;
+};
+
 class QItemSelectionModelPrivate: public QObjectPrivate
 {
     Q_DECLARE_PUBLIC(QItemSelectionModel)
@@ -63,12 +98,19 @@ public:
             ranges.removeAll(*it);
     }
 
-    inline void finalize()
+    void finalize();
+
+    // Selections with fewer ranges are searched linearly.
+    static constexpr qsizetype IntervalThreshold = 64;
+    QItemSelectionIntervals buildIntervals() const;
+    const QItemSelectionIntervals *selectedIntervals() const;
+    void invalidateIntervals()
     {
-        ranges.merge(currentSelection, currentCommand);
-        if (!currentSelection.isEmpty())  // ### perhaps this should be in QList
-            currentSelection.clear();
+        rangeIntervals.reset();
+        intervals.reset();
     }
+    void emitSelectionChanged(const QItemSelectionIntervals &newSelection,
+                              const QItemSelectionIntervals &oldSelection);
 
     void setModel(QAbstractItemModel *mod) { q_func()->setModel(mod); }
     void disconnectModel();
@@ -89,6 +131,10 @@ public:
     bool tableSelected;
     QPersistentModelIndex tableParent;
     int tableColCount, tableRowCount;
+    // ranges, and ranges merged with currentSelection, for big selections
+    mutable std::optional<QItemSelectionIntervals> rangeIntervals;
+    mutable std::optional<QItemSelectionIntervals> intervals;
+    mutable quint64 intervalsVersion = 0;
     std::array<QMetaObject::Connection, 12> connections;
 };
 
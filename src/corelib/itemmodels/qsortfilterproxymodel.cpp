@@ -5,13 +5,22 @@
 #include "qitemselectionmodel.h"
 #include <qsize.h>
 #include <qdebug.h>
+#include <qnumeric.h>
+#include <qscopedvaluerollback.h>
 #include <qdatetime.h>
 #include <qstringlist.h>
 #include <private/qabstractitemmodel_p.h>
 #include <private/qabstractproxymodel_p.h>
 #include <private/qproperty_p.h>
+#if QT_CONFIG(thread)
+#include <qsemaphore.h>
+#include <qthread.h>
+#include <qthreadpool.h>
+#endif
 
 #include <algorithm>
+#include <numeric>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
@@ -77,6 +86,80 @@ private:
 };
 
 
+// Below this many rows, handing work to other threads costs more than it saves.
+static constexpr qsizetype ConcurrentRowsPerTask = 4096;
+// When more rows than this change their place at once, one layout change is
+// cheaper than a move for each of them.
+static constexpr qsizetype MaxIncrementalMoves = 16;
+
+static qsizetype concurrentTaskCount(qsizetype rows)
+{
+#if QT_CONFIG(thread)
+    return qBound(qsizetype(1), rows / ConcurrentRowsPerTask,
+                  qsizetype(QThread::idealThreadCount()));
+#else
+    Q_UNUSED(rows);
+    return 1;
+#endif
+}
+
+// Calls \a task for each index in [0, count). Tasks are handed to idle threads
+// of the global thread pool; the ones no thread is available for run on the
+// calling thread, so this never waits for the pool to free up.
+template <typename Task>
+static void runConcurrently(qsizetype count, const Task &task)
+{
+#if QT_CONFIG(thread)
+    if (count > 1) {
+        QThreadPool *pool = QThreadPool::globalInstance();
+        QSemaphore finished;
+        int started = 0;
+        for (qsizetype i = 1; i < count; ++i) {
+            if (pool->tryStart([&task, &finished, i] { task(i); finished.release(); }))
+                ++started;
+            else
+                task(i);
+        }
+        task(0);
+        finished.acquire(started);
+        return;
+    }
+#endif
+    for (qsizetype i = 0; i < count; ++i)
+        task(i);
+}
+
+// Stable sort of \a order, in chunks on several threads followed by pairwise
+// merges when \a order is large. \a lessThan must be safe to call concurrently.
+template <typename LessThan>
+static void concurrentStableSort(std::vector<int> &order, const LessThan &lessThan)
+{
+    const qsizetype chunks = concurrentTaskCount(qsizetype(order.size()));
+    if (chunks <= 1) {
+        std::stable_sort(order.begin(), order.end(), lessThan);
+        return;
+    }
+
+    std::vector<qsizetype> bounds(chunks + 1);
+    for (qsizetype i = 0; i <= chunks; ++i)
+        bounds[i] = qsizetype(order.size()) * i / chunks;
+    const auto at = [&order, &bounds](qsizetype chunk) { return order.begin() + bounds[chunk]; };
+
+    runConcurrently(chunks, [&](qsizetype i) {
+        std::stable_sort(at(i), at(i + 1), lessThan);
+    });
+    for (qsizetype width = 1; width < chunks; width *= 2) {
+        runConcurrently((chunks + 2 * width - 1) / (2 * width), [&](qsizetype i) {
+            const qsizetype first = i * 2 * width;
+            const qsizetype middle = qMin(first + width, chunks);
+            const qsizetype last = qMin(first + 2 * width, chunks);
+            if (middle < last)
+                std::inplace_merge(at(first), at(middle), at(last), lessThan);
+        });
+    }
+}
+
+
 //this struct is used to store what are the rows that are removed
 //between a call to rowsAboutToBeRemoved and rowsRemoved
 //it avoids readding rows to the mapping that are currently being removed
@@ -124,6 +207,9 @@ public:
         QList<int> proxy_columns;
         QList<QModelIndex> mapped_children;
         QModelIndex source_parent;
+        // Rows inserted into the source model that were not filtered and
+        // sorted into this mapping yet (see SortFilterHint::IncrementalUpdates)
+        QList<int> pending_source_rows;
     };
 
     mutable QHash<QtPrivate::QModelIndexWrapper, Mapping*> source_index_mapping;
@@ -183,6 +269,8 @@ public:
     int proxy_sort_column = -1;
     Qt::SortOrder sort_order = Qt::AscendingOrder;
     bool complete_insert = false;
+    QSortFilterProxyModel::SortFilterHints sort_filter_hints;
+    bool source_rows_pending = false;
 
     Q_OBJECT_COMPAT_PROPERTY_WITH_ARGS(
             QSortFilterProxyModelPrivate, Qt::CaseSensitivity, sort_casesensitivity,
@@ -332,6 +420,11 @@ public:
     int find_source_sort_column() const;
     void sort_source_rows(QList<int> &source_rows,
                           const QModelIndex &source_parent) const;
+    void sort_source_rows_by_keys(QList<int> &source_rows,
+                                  const QModelIndex &source_parent) const;
+    void move_source_rows_into_place(Mapping *m, QList<int> source_rows,
+                                     const QModelIndex &source_parent);
+    void insert_pending_source_rows();
     QList<std::pair<int, QList<int>>> proxy_intervals_for_source_items_to_add(
         const QList<int> &proxy_to_source, const QList<int> &source_items,
         const QModelIndex &source_parent, Qt::Orientation orient) const;
@@ -377,7 +470,25 @@ public:
 
     bool needsReorder(const QList<int> &source_rows, const QModelIndex &source_parent) const;
 
+    // The filter properties, read on the calling thread while
+    // filterAcceptsRowsInternal() runs filterAcceptsRow() on other threads:
+    // reading a property may evaluate its binding, which is not thread-safe.
+    struct FilterSnapshot
+    {
+        QRegularExpression regularExpression;
+        int column;
+        int role;
+        bool recursive;
+        bool acceptChildren;
+    };
+    mutable const FilterSnapshot *filter_snapshot = nullptr;
+
+    bool filterAcceptsRow(int source_row, const QModelIndex &source_parent,
+                          const QRegularExpression &regularExpression, int column,
+                          int role) const;
     bool filterAcceptsRowInternal(int source_row, const QModelIndex &source_parent) const;
+    QList<bool> filterAcceptsRowsInternal(const QList<int> &source_rows,
+                                          const QModelIndex &source_parent) const;
     bool recursiveChildAcceptsRow(int source_row, const QModelIndex &source_parent) const;
     bool recursiveParentAcceptsRow(const QModelIndex &source_parent) const;
 };
@@ -403,17 +514,49 @@ bool QSortFilterProxyModelPrivate::filterAcceptsRowInternal(int source_row, cons
     if (q->filterAcceptsRow(source_row, source_parent))
         return true;
 
+    const bool acceptChildren = filter_snapshot ? filter_snapshot->acceptChildren
+                                                : accept_children.value();
+    const bool recursive = filter_snapshot ? filter_snapshot->recursive
+                                           : filter_recursive.value();
+
     // Go up the tree and accept this row if a parent is accepted
-    if (accept_children && recursiveParentAcceptsRow(source_parent))
+    if (acceptChildren && recursiveParentAcceptsRow(source_parent))
         return true;
 
     // Go down the tree and accept this row if a child is accepted
-    if (filter_recursive && recursiveChildAcceptsRow(source_row, source_parent))
+    if (recursive && recursiveChildAcceptsRow(source_row, source_parent))
         return true;
 
     return false;
 }
 
+/*!
+  \internal
+
+  Returns, for each of the \a source_rows, whether filterAcceptsRowInternal()
+  accepts it. With QSortFilterProxyModel::ConcurrentFiltering set, large
+  batches of rows are split across the global thread pool.
+*/
+QList<bool> QSortFilterProxyModelPrivate::filterAcceptsRowsInternal(
+    const QList<int> &source_rows, const QModelIndex &source_parent) const
+{
+    const qsizetype count = source_rows.size();
+    QList<bool> accepted(count);
+    bool *result = accepted.data();
+    const qsizetype tasks = (sort_filter_hints & QSortFilterProxyModel::ConcurrentFiltering)
+            ? concurrentTaskCount(count) : 1;
+    const FilterSnapshot snapshot = { filter_regularexpression.value(), filter_column,
+                                      filter_role, filter_recursive, accept_children };
+    const QScopedValueRollback<const FilterSnapshot *> rollback(
+            filter_snapshot, tasks > 1 ? &snapshot : filter_snapshot);
+    runConcurrently(tasks, [&](qsizetype task) {
+        const qsizetype last = count * (task + 1) / tasks;
+        for (qsizetype i = count * task / tasks; i < last; ++i)
+            result[i] = filterAcceptsRowInternal(source_rows.at(i), source_parent);
+    });
+    return accepted;
+}
+
 bool QSortFilterProxyModelPrivate::recursiveParentAcceptsRow(const QModelIndex &source_parent) const
 {
     Q_Q(const QSortFilterProxyModel);
@@ -483,11 +626,10 @@ IndexMap::const_iterator QSortFilterProxyModelPrivate::create_mapping(
     Mapping *m = new Mapping;
 
     int source_rows = model->rowCount(source_parent);
-    m->source_rows.reserve(source_rows);
-    for (int i = 0; i < source_rows; ++i) {
-        if (filterAcceptsRowInternal(i, source_parent))
-            m->source_rows.append(i);
-    }
+    m->source_rows.resize(source_rows);
+    std::iota(m->source_rows.begin(), m->source_rows.end(), 0);
+    const QList<bool> accepted = filterAcceptsRowsInternal(m->source_rows, source_parent);
+    m->source_rows.removeIf([&accepted](int source_row) { return !accepted.at(source_row); });
     int source_cols = model->columnCount(source_parent);
     m->source_columns.reserve(source_cols);
     for (int i = 0; i < source_cols; ++i) {
@@ -606,6 +748,7 @@ bool QSortFilterProxyModelPrivate::can_create_mapping(const QModelIndex &source_
 void QSortFilterProxyModelPrivate::sort()
 {
     Q_Q(QSortFilterProxyModel);
+    insert_pending_source_rows();
     emit q->layoutAboutToBeChanged(QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
     QModelIndexPairList source_indexes = store_persistent_indexes();
     const auto end = source_index_mapping.constEnd();
@@ -680,7 +823,10 @@ void QSortFilterProxyModelPrivate::sort_source_rows(
     QList<int> &source_rows, const QModelIndex &source_parent) const
 {
     Q_Q(const QSortFilterProxyModel);
-    if (source_sort_column >= 0) {
+    if (source_sort_column >= 0
+        && (sort_filter_hints & QSortFilterProxyModel::ExtractSortKeys)) {
+        sort_source_rows_by_keys(source_rows, source_parent);
+    } else if (source_sort_column >= 0) {
         if (sort_order == Qt::AscendingOrder) {
             QSortFilterProxyModelLessThan lt(source_sort_column, source_parent, model, q);
             std::stable_sort(source_rows.begin(), source_rows.end(), lt);
@@ -695,6 +841,217 @@ void QSortFilterProxyModelPrivate::sort_source_rows(
     }
 }
 
+// NaN is neither less nor greater than any number, which std::stable_sort()
+// cannot cope with; order it after all other values instead.
+static bool isDoubleLessThan(double left, double right)
+{
+    return left < right || (qIsNaN(right) && !qIsNaN(left));
+}
+
+static bool isNaN(const QVariant &value)
+{
+    switch (value.userType()) {
+    case QMetaType::Float:
+        return qIsNaN(value.toFloat());
+    case QMetaType::Double:
+        return qIsNaN(value.toDouble());
+    default:
+        return false;
+    }
+}
+
+/*!
+  \internal
+
+  Sorts \a source_rows like sort_source_rows() does, but without calling
+  lessThan(): the sort role data of every row is fetched once, and the values
+  are then compared the way the default lessThan() compares them. When all
+  rows hold the same numeric or string type, the values are first copied into
+  a plain array of that type, which is much cheaper to compare than QVariant.
+  Floating-point NaN values, which the default lessThan() cannot order, go
+  after all other values.
+*/
+void QSortFilterProxyModelPrivate::sort_source_rows_by_keys(
+    QList<int> &source_rows, const QModelIndex &source_parent) const
+{
+    const qsizetype count = source_rows.size();
+    if (count < 2)
+        return;
+
+    std::vector<QVariant> values(count);
+    const int role = sort_role;
+    const qsizetype tasks = (sort_filter_hints & QSortFilterProxyModel::ConcurrentFiltering)
+            ? concurrentTaskCount(count) : 1;
+    runConcurrently(tasks, [&](qsizetype task) {
+        const qsizetype last = count * (task + 1) / tasks;
+        for (qsizetype i = count * task / tasks; i < last; ++i) {
+            const QModelIndex index = model->index(source_rows.at(i), source_sort_column,
+                                                   source_parent);
+            values[i] = model->data(index, role);
+        }
+    });
+
+    // Rows without data compare greater than all others in isVariantLessThan(),
+    // so they go last (first when sorting in descending order), in the order
+    // they came in. The remaining ones are sorted by their position in values.
+    QList<int> no_data_rows;
+    std::vector<int> order;
+    order.reserve(count);
+    int type = QMetaType::UnknownType;
+    bool single_type = true;
+    for (qsizetype i = 0; i < count; ++i) {
+        const int value_type = values[i].userType();
+        if (value_type == QMetaType::UnknownType) {
+            no_data_rows.append(source_rows.at(i));
+            continue;
+        }
+        if (order.empty())
+            type = value_type;
+        else if (value_type != type)
+            single_type = false;
+        order.push_back(int(i));
+    }
+
+    const bool ascending = sort_order == Qt::AscendingOrder;
+    const auto sortBy = [&](const auto &lessThan) {
+        if (ascending)
+            concurrentStableSort(order, [&lessThan](int l, int r) { return lessThan(l, r); });
+        else
+            concurrentStableSort(order, [&lessThan](int l, int r) { return lessThan(r, l); });
+    };
+    const auto sortByKeys = [&](auto toKey, const auto &lessThan) {
+        std::vector<decltype(toKey(values.front()))> keys(count);
+        for (int i : order)
+            keys[i] = toKey(values[i]);
+        sortBy([&keys, &lessThan](int l, int r) { return lessThan(keys[l], keys[r]); });
+    };
+
+    if (!single_type)
+        type = QMetaType::UnknownType;
+    switch (type) {
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+        sortByKeys([](const QVariant &v) { return v.toLongLong(); }, std::less<qlonglong>());
+        break;
+    case QMetaType::Float:
+    case QMetaType::Double:
+        sortByKeys([](const QVariant &v) { return v.toDouble(); }, isDoubleLessThan);
+        break;
+    case QMetaType::QString:
+        if (sort_localeaware) {
+            sortByKeys([](const QVariant &v) { return v.toString(); },
+                       [](const QString &l, const QString &r) {
+                           return l.localeAwareCompare(r) < 0;
+                       });
+        } else {
+            const Qt::CaseSensitivity cs = sort_casesensitivity;
+            sortByKeys([](const QVariant &v) { return v.toString(); },
+                       [cs](const QString &l, const QString &r) {
+                           return l.compare(r, cs) < 0;
+                       });
+        }
+        break;
+    default: {
+        const Qt::CaseSensitivity cs = sort_casesensitivity;
+        const bool locale_aware = sort_localeaware;
+        sortBy([&values, cs, locale_aware](int l, int r) {
+            const bool left_nan = isNaN(values[l]);
+            const bool right_nan = isNaN(values[r]);
+            if (left_nan || right_nan)
+                return !left_nan;
+            return QAbstractItemModelPrivate::isVariantLessThan(values[l], values[r],
+                                                                cs, locale_aware);
+        });
+        break;
+    }
+    }
+
+    QList<int> sorted_rows;
+    sorted_rows.reserve(count);
+    if (!ascending)
+        sorted_rows.append(no_data_rows);
+    for (int i : order)
+        sorted_rows.append(source_rows.at(i));
+    if (ascending)
+        sorted_rows.append(no_data_rows);
+    source_rows = std::move(sorted_rows);
+}
+
+/*!
+  \internal
+
+  Moves each of the \a source_rows, whose sort data changed, to where it
+  belongs in the sorted mapping \a m. Each row is moved with its own
+  rowsMoved() signal, which is much cheaper for views and persistent indexes
+  than a layout change of the whole parent when only a few rows moved.
+
+  The rows end up in the same places as if they had been removed, sorted, and
+  inserted again.
+*/
+void QSortFilterProxyModelPrivate::move_source_rows_into_place(
+    Mapping *m, QList<int> source_rows, const QModelIndex &source_parent)
+{
+    Q_Q(QSortFilterProxyModel);
+    const QModelIndex proxy_parent = q->mapFromSource(source_parent);
+    if (!proxy_parent.isValid() && source_parent.isValid())
+        return;
+
+    const auto lessThan = [&](int source_row_left, int source_row_right) {
+        const QModelIndex left = model->index(source_row_left, source_sort_column, source_parent);
+        const QModelIndex right = model->index(source_row_right, source_sort_column, source_parent);
+        return sort_order == Qt::AscendingOrder ? q->lessThan(left, right)
+                                                : q->lessThan(right, left);
+    };
+
+    sort_source_rows(source_rows, source_parent);
+    // Rows that were not moved yet may be anywhere, so they are skipped when
+    // looking for the place of a row.
+    QList<int> source_rows_unplaced = source_rows;
+    for (int source_row : std::as_const(source_rows)) {
+        source_rows_unplaced.removeOne(source_row);
+        const int from = m->proxy_rows.at(source_row);
+        const auto skip = [&](int proxy_row) {
+            return proxy_row == from
+                    || source_rows_unplaced.contains(m->source_rows.at(proxy_row));
+        };
+
+        // Find the first proxy row that sorts after source_row
+        int proxy_low = 0;
+        int proxy_high = m->source_rows.size();
+        while (proxy_low < proxy_high) {
+            const int proxy_mid = (proxy_low + proxy_high) / 2;
+            int proxy_row = proxy_mid;
+            while (proxy_row >= proxy_low && skip(proxy_row))
+                --proxy_row;
+            if (proxy_row < proxy_low) {
+                proxy_row = proxy_mid + 1;
+                while (proxy_row < proxy_high && skip(proxy_row))
+                    ++proxy_row;
+                if (proxy_row == proxy_high)
+                    break;
+            }
+            if (lessThan(source_row, m->source_rows.at(proxy_row)))
+                proxy_high = proxy_row;
+            else
+                proxy_low = proxy_row + 1;
+        }
+
+        if (proxy_low == from || proxy_low == from + 1)
+            continue;
+        q->beginMoveRows(proxy_parent, from, from, proxy_parent, proxy_low);
+        const auto begin = m->source_rows.begin();
+        const int to = proxy_low > from ? proxy_low - 1 : proxy_low;
+        if (to > from)
+            std::rotate(begin + from, begin + from + 1, begin + to + 1);
+        else
+            std::rotate(begin + to, begin + from, begin + from + 1);
+        for (int proxy_row = qMin(from, to); proxy_row <= qMax(from, to); ++proxy_row)
+            m->proxy_rows[m->source_rows.at(proxy_row)] = proxy_row;
+        q->endMoveRows();
+    }
+}
+
 /*!
   \internal
 
@@ -1000,6 +1357,25 @@ void QSortFilterProxyModelPrivate::source_items_inserted(
         build_source_to_proxy_mapping(proxy_to_source, source_to_proxy);
     }
 
+    if (orient == Qt::Vertical) {
+        // Rows that are still waiting to be added move with the other source rows
+        for (int &pending_row : m->pending_source_rows) {
+            if (pending_row >= start)
+                pending_row += delta_item_count;
+        }
+        if ((sort_filter_hints & QSortFilterProxyModel::IncrementalUpdates)
+            && !filter_recursive && old_item_count > 0) {
+            for (int i = start; i <= end; ++i)
+                m->pending_source_rows.append(i);
+            if (!source_rows_pending) {
+                source_rows_pending = true;
+                QMetaObject::invokeMethod(q, [this] { insert_pending_source_rows(); },
+                                          Qt::QueuedConnection);
+            }
+            return;
+        }
+    }
+
     // Figure out which items to add to mapping based on filter
     QList<int> source_items;
     for (int i = start; i <= end; ++i) {
@@ -1043,6 +1419,48 @@ void QSortFilterProxyModelPrivate::source_items_inserted(
     insert_source_items(source_to_proxy, proxy_to_source, source_items, source_parent, orient);
 }
 
+/*!
+  \internal
+
+  Filters, sorts and inserts the source rows that source_items_inserted()
+  queued since the last call, so that all rows inserted into the same parent
+  during one pass of the event loop are added in as few intervals as possible.
+
+  Anything that looks at the unmapped rows of a mapping (filter changes,
+  dataChanged(), removals, layout changes) must call this first.
+*/
+void QSortFilterProxyModelPrivate::insert_pending_source_rows()
+{
+    if (!source_rows_pending)
+        return;
+    source_rows_pending = false;
+
+    QList<QModelIndex> source_parents;
+    for (auto it = source_index_mapping.cbegin(), end = source_index_mapping.cend(); it != end; ++it) {
+        if (!it.value()->pending_source_rows.isEmpty())
+            source_parents.append(it.key());
+    }
+
+    for (const QModelIndex &source_parent : std::as_const(source_parents)) {
+        const IndexMap::const_iterator it = source_index_mapping.constFind(source_parent);
+        if (it == source_index_mapping.constEnd())
+            continue;
+        Mapping *m = it.value();
+        QList<int> pending_rows = std::exchange(m->pending_source_rows, {});
+        std::sort(pending_rows.begin(), pending_rows.end());
+
+        const QList<bool> accepted = filterAcceptsRowsInternal(pending_rows, source_parent);
+        QList<int> source_items;
+        for (qsizetype i = 0; i < pending_rows.size(); ++i) {
+            if (accepted.at(i))
+                source_items.append(pending_rows.at(i));
+        }
+        sort_source_rows(source_items, source_parent);
+        insert_source_items(m->proxy_rows, m->source_rows, source_items, source_parent,
+                            Qt::Vertical);
+    }
+}
+
 /*!
   \internal
 
@@ -1267,6 +1685,7 @@ void QSortFilterProxyModelPrivate::update_persistent_indexes(
 */
 void QSortFilterProxyModelPrivate::filter_about_to_be_changed(const QModelIndex &source_parent)
 {
+    insert_pending_source_rows();
     if (!filter_regularexpression.valueBypassingBindings().pattern().isEmpty()
         && source_index_mapping.constFind(source_parent) == source_index_mapping.constEnd()) {
         create_mapping(source_parent);
@@ -1282,6 +1701,7 @@ void QSortFilterProxyModelPrivate::filter_about_to_be_changed(const QModelIndex
 */
 void QSortFilterProxyModelPrivate::filter_changed(Direction dir, const QModelIndex &source_parent)
 {
+    insert_pending_source_rows();
     IndexMap::const_iterator it = source_index_mapping.constFind(source_parent);
     if (it == source_index_mapping.constEnd())
         return;
@@ -1329,23 +1749,40 @@ QSet<int> QSortFilterProxyModelPrivate::handle_filter_changed(
     Q_Q(QSortFilterProxyModel);
     // Figure out which mapped items to remove
     QList<int> source_items_remove;
-    for (int i = 0; i < proxy_to_source.size(); ++i) {
-        const int source_item = proxy_to_source.at(i);
-        if ((orient == Qt::Vertical)
-            ? !filterAcceptsRowInternal(source_item, source_parent)
-            : !q->filterAcceptsColumn(source_item, source_parent)) {
-            // This source item does not satisfy the filter, so it must be removed
-            source_items_remove.append(source_item);
+    if (orient == Qt::Vertical) {
+        const QList<bool> accepted = filterAcceptsRowsInternal(proxy_to_source, source_parent);
+        for (int i = 0; i < proxy_to_source.size(); ++i) {
+            if (!accepted.at(i))
+                source_items_remove.append(proxy_to_source.at(i));
+        }
+    } else {
+        for (int i = 0; i < proxy_to_source.size(); ++i) {
+            const int source_item = proxy_to_source.at(i);
+            if (!q->filterAcceptsColumn(source_item, source_parent)) {
+                // This source item does not satisfy the filter, so it must be removed
+                source_items_remove.append(source_item);
+            }
         }
     }
     // Figure out which non-mapped items to insert
     QList<int> source_items_insert;
     int source_count = source_to_proxy.size();
-    for (int source_item = 0; source_item < source_count; ++source_item) {
-        if (source_to_proxy.at(source_item) == -1) {
-            if ((orient == Qt::Vertical)
-                ? filterAcceptsRowInternal(source_item, source_parent)
-                : q->filterAcceptsColumn(source_item, source_parent)) {
+    if (orient == Qt::Vertical) {
+        QList<int> source_items_unmapped;
+        for (int source_item = 0; source_item < source_count; ++source_item) {
+            if (source_to_proxy.at(source_item) == -1)
+                source_items_unmapped.append(source_item);
+        }
+        const QList<bool> accepted =
+                filterAcceptsRowsInternal(source_items_unmapped, source_parent);
+        for (int i = 0; i < source_items_unmapped.size(); ++i) {
+            if (accepted.at(i))
+                source_items_insert.append(source_items_unmapped.at(i));
+        }
+    } else {
+        for (int source_item = 0; source_item < source_count; ++source_item) {
+            if (source_to_proxy.at(source_item) == -1
+                && q->filterAcceptsColumn(source_item, source_parent)) {
                 // This source item satisfies the filter, so it must be added
                 source_items_insert.append(source_item);
             }
@@ -1397,6 +1834,7 @@ void QSortFilterProxyModelPrivate::_q_sourceDataChanged(const QModelIndex &sourc
     Q_Q(QSortFilterProxyModel);
     if (!source_top_left.isValid() || !source_bottom_right.isValid())
         return;
+    insert_pending_source_rows();
 
     std::vector<QSortFilterProxyModelDataChanged> data_changed_list;
     data_changed_list.emplace_back(source_top_left, source_bottom_right);
@@ -1480,18 +1918,23 @@ void QSortFilterProxyModelPrivate::_q_sourceDataChanged(const QModelIndex &sourc
 
         if (!source_rows_resort.isEmpty()) {
             if (needsReorder(source_rows_resort, source_parent)) {
-                // Re-sort the rows of this level
-                QList<QPersistentModelIndex> parents;
-                parents << q->mapFromSource(source_parent);
-                emit q->layoutAboutToBeChanged(parents, QAbstractItemModel::VerticalSortHint);
-                QModelIndexPairList source_indexes = store_persistent_indexes();
-                remove_source_items(m->proxy_rows, m->source_rows, source_rows_resort,
-                        source_parent, Qt::Vertical, false);
-                sort_source_rows(source_rows_resort, source_parent);
-                insert_source_items(m->proxy_rows, m->source_rows, source_rows_resort,
-                        source_parent, Qt::Vertical, false);
-                update_persistent_indexes(source_indexes);
-                emit q->layoutChanged(parents, QAbstractItemModel::VerticalSortHint);
+                if ((sort_filter_hints & QSortFilterProxyModel::IncrementalUpdates)
+                    && source_rows_resort.size() <= MaxIncrementalMoves) {
+                    move_source_rows_into_place(m, source_rows_resort, source_parent);
+                } else {
+                    // Re-sort the rows of this level
+                    QList<QPersistentModelIndex> parents;
+                    parents << q->mapFromSource(source_parent);
+                    emit q->layoutAboutToBeChanged(parents, QAbstractItemModel::VerticalSortHint);
+                    QModelIndexPairList source_indexes = store_persistent_indexes();
+                    remove_source_items(m->proxy_rows, m->source_rows, source_rows_resort,
+                            source_parent, Qt::Vertical, false);
+                    sort_source_rows(source_rows_resort, source_parent);
+                    insert_source_items(m->proxy_rows, m->source_rows, source_rows_resort,
+                            source_parent, Qt::Vertical, false);
+                    update_persistent_indexes(source_indexes);
+                    emit q->layoutChanged(parents, QAbstractItemModel::VerticalSortHint);
+                }
             }
             // Make sure we also emit dataChanged for the rows
             source_rows_change += source_rows_resort;
@@ -1597,6 +2040,7 @@ void QSortFilterProxyModelPrivate::_q_sourceLayoutAboutToBeChanged(const QList<Q
 {
     Q_Q(QSortFilterProxyModel);
     Q_UNUSED(hint); // We can't forward Hint because we might filter additional rows or columns
+    insert_pending_source_rows();
     saved_persistent_indexes.clear();
 
     saved_layoutChange_parents.clear();
@@ -1709,6 +2153,7 @@ void QSortFilterProxyModelPrivate::_q_sourceRowsInserted(
 void QSortFilterProxyModelPrivate::_q_sourceRowsAboutToBeRemoved(
     const QModelIndex &source_parent, int start, int end)
 {
+    insert_pending_source_rows();
     itemsBeingRemoved = QRowsRemoval(source_parent, start, end);
     source_items_about_to_be_removed(source_parent, start, end,
                                      Qt::Vertical);
@@ -1773,6 +2218,7 @@ void QSortFilterProxyModelPrivate::_q_sourceColumnsAboutToBeInserted(
 {
     Q_UNUSED(start);
     Q_UNUSED(end);
+    insert_pending_source_rows();
     //Force the creation of a mapping now, even if it's empty.
     //We need it because the proxy can be accessed at the moment it emits columnsAboutToBeInserted in insert_source_items
     if (can_create_mapping(source_parent))
@@ -1802,6 +2248,7 @@ void QSortFilterProxyModelPrivate::_q_sourceColumnsInserted(
 void QSortFilterProxyModelPrivate::_q_sourceColumnsAboutToBeRemoved(
     const QModelIndex &source_parent, int start, int end)
 {
+    insert_pending_source_rows();
     source_items_about_to_be_removed(source_parent, start, end,
                                      Qt::Horizontal);
 }
@@ -3064,6 +3511,70 @@ QBindable<bool> QSortFilterProxyModel::bindableAutoAcceptChildRows()
     return QBindable<bool>(&d->accept_children);
 }
 
+/*!
+    \since 6.9
+    \enum QSortFilterProxyModel::SortFilterHint
+
+    This enum describes hints that let the proxy model sort and filter large
+    source models faster.
+
+    \value NoSortFilterHints The proxy compares rows by calling lessThan() and
+           filters them by calling filterAcceptsRow() one after the other, on
+           the thread the proxy model lives in. This is the default.
+    \value ExtractSortKeys The proxy reads the sortRole data of every row
+           once, and sorts the values as the default implementation of
+           lessThan() would compare them, without calling lessThan(). When all
+           rows hold the same numeric or string type, the values are sorted as
+           plain numbers or strings; large sorts are spread over the threads
+           of the global QThreadPool. Floating-point NaN values are sorted
+           after all other values. A reimplemented lessThan() is not called
+           while this hint is set, so do not set it if lessThan() is
+           reimplemented.
+    \value ConcurrentFiltering filterAcceptsRow() and the source model's
+           data() are called from threads of the global QThreadPool when many
+           rows have to be filtered, or when sort keys are read. Only set this
+           hint if both are safe to call concurrently while the source model is
+           not modified; QSortFilterProxyModel's own implementation of
+           filterAcceptsRow() is.
+    \value IncrementalUpdates Rows inserted into the source model are added
+           to the proxy model when control returns to the event loop, all rows
+           inserted into the same parent in one go; until then they are
+           treated as if they were filtered out. When the sort data of a few
+           rows changes, the proxy model moves those rows with rowsMoved()
+           instead of emitting layoutChanged(). This hint has no effect on
+           insertions while \l recursiveFilteringEnabled is \c true.
+
+    \sa sortFilterHints
+*/
+
+/*!
+    \since 6.9
+    \property QSortFilterProxyModel::sortFilterHints
+    \brief hints that allow the proxy model to sort and filter more efficiently.
+
+    The default value is NoSortFilterHints.
+
+    \sa lessThan(), filterAcceptsRow()
+*/
+QSortFilterProxyModel::SortFilterHints QSortFilterProxyModel::sortFilterHints() const
+{
+    Q_D(const QSortFilterProxyModel);
+    return d->sort_filter_hints;
+}
+
+void QSortFilterProxyModel::setSortFilterHints(SortFilterHints hints)
+{
+    Q_D(QSortFilterProxyModel);
+    if (d->sort_filter_hints == hints)
+        return;
+    const bool sortKeysChanged = (d->sort_filter_hints ^ hints).testFlag(ExtractSortKeys);
+    d->insert_pending_source_rows();
+    d->sort_filter_hints = hints;
+    // A reimplemented lessThan() can order rows differently than the keys do.
+    if (sortKeysChanged)
+        d->sort();
+}
+
 /*!
    \since 4.3
 
@@ -3226,25 +3737,38 @@ bool QSortFilterProxyModel::filterAcceptsRow(int source_row, const QModelIndex &
 {
     Q_D(const QSortFilterProxyModel);
 
-    if (d->filter_regularexpression.value().pattern().isEmpty())
+    if (const auto *snapshot = d->filter_snapshot) {
+        return d->filterAcceptsRow(source_row, source_parent, snapshot->regularExpression,
+                                   snapshot->column, snapshot->role);
+    }
+    return d->filterAcceptsRow(source_row, source_parent, d->filter_regularexpression.value(),
+                               d->filter_column, d->filter_role);
+}
+
+bool QSortFilterProxyModelPrivate::filterAcceptsRow(int source_row,
+                                                    const QModelIndex &source_parent,
+                                                    const QRegularExpression &regularExpression,
+                                                    int column, int role) const
+{
+    if (regularExpression.pattern().isEmpty())
         return true;
 
-    int column_count = d->model->columnCount(source_parent);
-    if (d->filter_column == -1) {
-        for (int column = 0; column < column_count; ++column) {
-            QModelIndex source_index = d->model->index(source_row, column, source_parent);
-            QString key = d->model->data(source_index, d->filter_role).toString();
-            if (key.contains(d->filter_regularexpression.value()))
+    int column_count = model->columnCount(source_parent);
+    if (column == -1) {
+        for (int c = 0; c < column_count; ++c) {
+            QModelIndex source_index = model->index(source_row, c, source_parent);
+            QString key = model->data(source_index, role).toString();
+            if (key.contains(regularExpression))
                 return true;
         }
         return false;
     }
 
-    if (d->filter_column >= column_count) // the column may not exist
+    if (column >= column_count) // the column may not exist
         return true;
-    QModelIndex source_index = d->model->index(source_row, d->filter_column, source_parent);
-    QString key = d->model->data(source_index, d->filter_role).toString();
-    return key.contains(d->filter_regularexpression.value());
+    QModelIndex source_index = model->index(source_row, column, source_parent);
+    QString key = model->data(source_index, role).toString();
+    return key.contains(regularExpression);
 }
 
 /*!
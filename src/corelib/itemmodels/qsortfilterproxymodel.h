@@ -46,8 +46,18 @@ class Q_CORE_EXPORT QSortFilterProxyModel : public QAbstractProxyModel
                BINDABLE bindableRecursiveFilteringEnabled)
     Q_PROPERTY(bool autoAcceptChildRows READ autoAcceptChildRows WRITE setAutoAcceptChildRows
                NOTIFY autoAcceptChildRowsChanged BINDABLE bindableAutoAcceptChildRows)
+    Q_PROPERTY(SortFilterHints sortFilterHints READ sortFilterHints WRITE setSortFilterHints)
 
 public:
+    enum SortFilterHint {
+        NoSortFilterHints = 0x0,
+        ExtractSortKeys = 0x1,
+        ConcurrentFiltering = 0x2,
+        IncrementalUpdates = 0x4,
+    };
+    Q_DECLARE_FLAGS(SortFilterHints, SortFilterHint)
+    Q_FLAG(SortFilterHints)
+
     explicit QSortFilterProxyModel(QObject *parent = nullptr);
     ~QSortFilterProxyModel();
 
@@ -101,6 +111,9 @@ public:
     void setAutoAcceptChildRows(bool accept);
     QBindable<bool> bindableAutoAcceptChildRows();
 
+    SortFilterHints sortFilterHints() const;
+    void setSortFilterHints(SortFilterHints hints);
+
 public Q_SLOTS:
     void setFilterRegularExpression(const QString &pattern);
     void setFilterRegularExpression(const QRegularExpression &regularExpression);
@@ -175,6 +188,8 @@ private:
     Q_DISABLE_COPY(QSortFilterProxyModel)
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(QSortFilterProxyModel::SortFilterHints)
+
 QT_END_NAMESPACE
 
 #endif // QSORTFILTERPROXYMODEL_H
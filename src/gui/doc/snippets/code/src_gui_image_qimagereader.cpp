@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR BSD-3-Clause
 #include <QImage>
 #include <QImageReader>
+#include <QImageWriter>
 
 namespace src_gui_image_qimagereader {
 void wrapper0() {
@@ -42,4 +43,23 @@ if (reader.supportsOption(QImageIOHandler::Size))
 //! [3]
 
 } // wrapper2
+
+
+void wrapper3() {
+
+//! [scanlines]
+QImageReader reader("scan.png");
+QImageWriter writer("scan.jpg");
+if (reader.beginScanlineRead()
+        && writer.beginScanlineWrite(reader.size(), reader.scanlineFormat())) {
+    QImage rows(reader.size().width(), 256, reader.scanlineFormat());
+    while (int count = reader.readScanlines(&rows)) {
+        if (count < 0 || !writer.writeScanlines(rows.copy(0, 0, rows.width(), count)))
+            break;
+    }
+    writer.endScanlineWrite();
+}
+//! [scanlines]
+
+} // wrapper3
 } // src_gui_image_qimagereader
@@ -671,6 +671,7 @@ bool qt_write_dib(QDataStream &s, const QImage &image, int bpl, int bpl_bmp, int
 QBmpHandler::QBmpHandler(InternalFormat fmt) :
     m_format(fmt), state(Ready)
 {
+    QImageIOHandlerPrivate::setScanlineHandler(this, this);
 }
 
 QByteArray QBmpHandler::formatName() const
@@ -750,6 +751,20 @@ bool QBmpHandler::read(QImage *image)
     s.setByteOrder(QDataStream::LittleEndian);
 
     // read image
+    const qint64 datapos = dataPosition();
+    const bool readSuccess = m_format == BmpFormat ?
+        read_dib_body(s, infoHeader, datapos, startpos + BMP_FILEHDR_SIZE, *image) :
+        read_dib_body(s, infoHeader, datapos, startpos, *image);
+    if (!readSuccess)
+        return false;
+
+    state = Ready;
+    return true;
+}
+
+qint64 QBmpHandler::dataPosition() const
+{
+    QIODevice *d = device();
     qint64 datapos = startpos;
     if (m_format == BmpFormat) {
         datapos += fileHeader.bfOffBits;
@@ -773,16 +788,178 @@ bool QBmpHandler::read(QImage *image)
             }
         }
     }
-    const bool readSuccess = m_format == BmpFormat ?
-        read_dib_body(s, infoHeader, datapos, startpos + BMP_FILEHDR_SIZE, *image) :
-        read_dib_body(s, infoHeader, datapos, startpos, *image);
-    if (!readSuccess)
+    return datapos;
+}
+
+bool QBmpHandler::beginScanlineRead(QSize *size, QImage::Format *format, QList<QRgb> *colorTable)
+{
+    if (state == Error || (state == Ready && !readHeader())) {
+        state = Error;
         return false;
+    }
 
-    state = Ready;
+    // Rows are stored bottom-up unless the height is negative, so they are
+    // read with a seek each. Compressed and bit-field images are not supported.
+    QIODevice *d = device();
+    const int nbits = infoHeader.biBitCount;
+    if (d->isSequential() || infoHeader.biCompression != BMP_RGB || nbits == 16)
+        return false;
+
+    const int w = infoHeader.biWidth;
+    const int h = qAbs(infoHeader.biHeight);
+    scanlineAlpha = nbits == 32 && infoHeader.biSize >= BMP_WIN4
+            && infoHeader.biAlphaMask == 0xff000000;
+    switch (nbits) {
+    case 1:
+        *format = QImage::Format_Mono;
+        break;
+    case 4:
+    case 8:
+        *format = QImage::Format_Indexed8;
+        break;
+    default:
+        *format = scanlineAlpha ? QImage::Format_ARGB32 : QImage::Format_RGB32;
+        break;
+    }
+
+    qint64 headerEnd = startpos + (m_format == BmpFormat ? BMP_FILEHDR_SIZE : 0)
+            + infoHeader.biSize;
+    if (nbits <= 8) {
+        const int ncols = infoHeader.biClrUsed ? infoHeader.biClrUsed : 1 << nbits;
+        if (ncols < 1 || ncols > 256)
+            return false;
+        if (!d->seek(headerEnd))
+            return false;
+        const int rgb_len = infoHeader.biSize == BMP_OLD ? 3 : 4;
+        colorTable->resize(ncols);
+        uchar rgb[4];
+        for (int i = 0; i < ncols; ++i) {
+            if (d->read((char *)rgb, rgb_len) != rgb_len)
+                return false;
+            (*colorTable)[i] = qRgb(rgb[2], rgb[1], rgb[0]);
+        }
+        headerEnd += ncols * rgb_len;
+    }
+
+    *size = QSize(w, h);
+    // Like read(), never start the pixel data before the end of the color
+    // table, even if the file header says so.
+    scanlinePos = qMax(dataPosition(), headerEnd);
+    scanlineBuffer.resize(((qsizetype(w) * nbits + 31) / 32) * 4);
+    scanline = 0;
     return true;
 }
 
+int QBmpHandler::readScanlines(uchar *buffer, qsizetype bytesPerLine, int count)
+{
+    if (state != ReadHeader || scanlineBuffer.isEmpty())
+        return -1;
+
+    QIODevice *d = device();
+    const int w = infoHeader.biWidth;
+    const int h = qAbs(infoHeader.biHeight);
+    const int nbits = infoHeader.biBitCount;
+    const qsizetype bpl_bmp = scanlineBuffer.size();
+    uchar *buf = reinterpret_cast<uchar *>(scanlineBuffer.data());
+
+    count = qMin(count, h - scanline);
+    for (int i = 0; i < count; ++i, ++scanline) {
+        const int row = infoHeader.biHeight > 0 ? h - scanline - 1 : scanline;
+        uchar *p = buffer + i * bytesPerLine;
+        if (!d->seek(scanlinePos + row * bpl_bmp) || d->read((char *)buf, bpl_bmp) != bpl_bmp) {
+            // Like read(), leave rows that are missing from the file empty
+            memset(p, 0, bytesPerLine);
+            continue;
+        }
+        if (nbits == 1) {
+            memcpy(p, buf, (w + 7) / 8);
+        } else if (nbits == 4) {
+            for (int x = 0; x < w; ++x)                // convert nibbles to bytes
+                p[x] = x & 1 ? buf[x >> 1] & 0x0f : buf[x >> 1] >> 4;
+        } else if (nbits == 8) {
+            memcpy(p, buf, w);
+        } else {
+            QRgb *q = reinterpret_cast<QRgb *>(p);
+            const uchar *b = buf;
+            for (int x = 0; x < w; ++x, b += nbits / 8)
+                q[x] = qRgba(b[2], b[1], b[0], scanlineAlpha ? b[3] : 0xff);
+        }
+    }
+    if (scanline == h) {
+        scanlineBuffer.clear();
+        state = Ready;
+    }
+    return count;
+}
+
+bool QBmpHandler::beginScanlineWrite(QSize size, QImage::Format *format)
+{
+    // Rows are written as 24-bit pixels, top-down, so that the device does
+    // not need to be seekable.
+    *format = QImage::Format_RGB888;
+    const qsizetype bpl_bmp = ((qsizetype(size.width()) * 24 + 31) / 32) * 4;
+    const qint64 imageSize = bpl_bmp * size.height();
+    if (size.isEmpty() || imageSize + BMP_FILEHDR_SIZE + BMP_WIN > INT_MAX)
+        return false;
+
+    QDataStream s(device());
+    s.setByteOrder(QDataStream::LittleEndian); // Intel byte order
+    if (m_format == BmpFormat) {
+        BMP_FILEHDR bf;
+        memcpy(bf.bfType, "BM", 2);
+        bf.bfReserved1 = 0;
+        bf.bfReserved2 = 0;
+        bf.bfOffBits = BMP_FILEHDR_SIZE + BMP_WIN;
+        bf.bfSize = bf.bfOffBits + imageSize;
+        s << bf;
+    }
+
+    BMP_INFOHDR bi;
+    bi.biSize          = BMP_WIN;
+    bi.biWidth         = size.width();
+    bi.biHeight        = -size.height();
+    bi.biPlanes        = 1;
+    bi.biBitCount      = 24;
+    bi.biCompression   = BMP_RGB;
+    bi.biSizeImage     = imageSize;
+    bi.biXPelsPerMeter = 2834; // 72 dpi default
+    bi.biYPelsPerMeter = 2834;
+    bi.biClrUsed       = 0;
+    bi.biClrImportant  = 0;
+    s << bi;
+    if (s.status() != QDataStream::Ok)
+        return false;
+
+    infoHeader = bi;
+    scanlineBuffer = QByteArray(bpl_bmp, '\0');
+    scanline = 0;
+    return true;
+}
+
+bool QBmpHandler::writeScanlines(const uchar *buffer, qsizetype bytesPerLine, int count)
+{
+    const int w = infoHeader.biWidth;
+    uchar *buf = reinterpret_cast<uchar *>(scanlineBuffer.data());
+    for (int y = 0; y < count; ++y) {
+        const uchar *p = buffer + y * bytesPerLine;
+        for (int x = 0; x < w; ++x, p += 3) {
+            buf[3 * x] = p[2];
+            buf[3 * x + 1] = p[1];
+            buf[3 * x + 2] = p[0];
+        }
+        if (device()->write(scanlineBuffer) != scanlineBuffer.size())
+            return false;
+    }
+    scanline += count;
+    return true;
+}
+
+bool QBmpHandler::endScanlineWrite()
+{
+    scanlineBuffer.clear();
+    return scanline == -infoHeader.biHeight;
+}
+
 bool QBmpHandler::write(const QImage &img)
 {
     QImage image;
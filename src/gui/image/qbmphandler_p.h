@@ -17,6 +17,7 @@
 
 #include <QtGui/private/qtguiglobal_p.h>
 #include "QtGui/qimageiohandler.h"
+#include "private/qimageiohandler_p.h"
 
 #ifndef QT_NO_IMAGEFORMAT_BMP
 
@@ -64,7 +65,7 @@ struct BMP_INFOHDR {                     // BMP information header
 // system for OLE/clipboard operations. DIB is a subset of BMP (without file
 // header). The Windows platform plugin accesses the DIB-functionality.
 
-class QBmpHandler : public QImageIOHandler
+class QBmpHandler : public QImageIOHandler, public QImageScanlineHandler
 {
 public:
     enum InternalFormat {
@@ -83,8 +84,15 @@ public:
     void setOption(ImageOption option, const QVariant &value) override;
     bool supportsOption(ImageOption option) const override;
 
+    bool beginScanlineRead(QSize *size, QImage::Format *format, QList<QRgb> *colorTable) override;
+    int readScanlines(uchar *buffer, qsizetype bytesPerLine, int count) override;
+    bool beginScanlineWrite(QSize size, QImage::Format *format) override;
+    bool writeScanlines(const uchar *buffer, qsizetype bytesPerLine, int count) override;
+    bool endScanlineWrite() override;
+
 private:
     bool readHeader();
+    qint64 dataPosition() const;
     inline QByteArray formatName() const;
 
     enum State {
@@ -99,6 +107,11 @@ private:
     BMP_FILEHDR fileHeader;
     BMP_INFOHDR infoHeader;
     qint64 startpos;
+
+    qint64 scanlinePos = 0;
+    QByteArray scanlineBuffer;
+    int scanline = 0;
+    bool scanlineAlpha = false;
 };
 
 QT_END_NAMESPACE
@@ -0,0 +1,218 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include <qimage.h>
+#include <private/qimage_p.h>
+#include <private/qrgba64_p.h>
+#include <private/qsimd_p.h>
+
+#if defined(QT_COMPILER_SUPPORTS_AVX2)
+
+QT_BEGIN_NAMESPACE
+
+// Rounds the 16-bit channels of RGBA64 to 8 bits, the same way as
+// qt_convertRGBA64ToARGB32(), eight pixels at a time.
+template<bool RGBA>
+static void convertRGBA64ToARGB32_avx2(uint *dst, const QRgba64 *src, int count)
+{
+    int i = 0;
+    const __m256i vhalf = _mm256_set1_epi32(0x80);
+    const __m256i vzero = _mm256_setzero_si256();
+    const __m256i permuteMask = _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7);
+    for (; i < count - 7; i += 8) {
+        __m256i vs1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        __m256i vs2 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i + 4));
+        if (!RGBA) {
+            vs1 = _mm256_shufflelo_epi16(vs1, _MM_SHUFFLE(3, 0, 1, 2));
+            vs1 = _mm256_shufflehi_epi16(vs1, _MM_SHUFFLE(3, 0, 1, 2));
+            vs2 = _mm256_shufflelo_epi16(vs2, _MM_SHUFFLE(3, 0, 1, 2));
+            vs2 = _mm256_shufflehi_epi16(vs2, _MM_SHUFFLE(3, 0, 1, 2));
+        }
+        __m256i v1 = _mm256_unpacklo_epi16(vs1, vzero);
+        __m256i v2 = _mm256_unpackhi_epi16(vs1, vzero);
+        __m256i v3 = _mm256_unpacklo_epi16(vs2, vzero);
+        __m256i v4 = _mm256_unpackhi_epi16(vs2, vzero);
+        v1 = _mm256_add_epi32(v1, vhalf);
+        v2 = _mm256_add_epi32(v2, vhalf);
+        v3 = _mm256_add_epi32(v3, vhalf);
+        v4 = _mm256_add_epi32(v4, vhalf);
+        v1 = _mm256_srli_epi32(_mm256_sub_epi32(v1, _mm256_srli_epi32(v1, 8)), 8);
+        v2 = _mm256_srli_epi32(_mm256_sub_epi32(v2, _mm256_srli_epi32(v2, 8)), 8);
+        v3 = _mm256_srli_epi32(_mm256_sub_epi32(v3, _mm256_srli_epi32(v3, 8)), 8);
+        v4 = _mm256_srli_epi32(_mm256_sub_epi32(v4, _mm256_srli_epi32(v4, 8)), 8);
+        // The packs work within each 128-bit lane, which leaves the pixels
+        // in the order 0, 1, 4, 5, 2, 3, 6, 7.
+        __m256i vd = _mm256_packus_epi16(_mm256_packs_epi32(v1, v2), _mm256_packs_epi32(v3, v4));
+        vd = _mm256_permutevar8x32_epi32(vd, permuteMask);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), vd);
+    }
+    for (; i < count; ++i) {
+        uint s = src[i].toArgb32();
+        if (RGBA)
+            s = ARGB2RGBA(s);
+        dst[i] = s;
+    }
+}
+
+template<bool RGBA>
+static void convertRGBA64ToARGB32Image_avx2(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags)
+{
+    Q_ASSERT(src->format == QImage::Format_RGBA64);
+    Q_ASSERT(RGBA || dest->format == QImage::Format_ARGB32);
+    Q_ASSERT(!RGBA || dest->format == QImage::Format_RGBA8888);
+    Q_ASSERT(src->width == dest->width);
+    Q_ASSERT(src->height == dest->height);
+
+    const uchar *srcData = src->data;
+    uchar *destData = dest->data;
+    for (int i = 0; i < src->height; ++i) {
+        convertRGBA64ToARGB32_avx2<RGBA>(reinterpret_cast<uint *>(destData),
+                                         reinterpret_cast<const QRgba64 *>(srcData), src->width);
+        srcData += src->bytes_per_line;
+        destData += dest->bytes_per_line;
+    }
+}
+
+void convert_RGBA64_to_ARGB32_avx2(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags flags)
+{
+    convertRGBA64ToARGB32Image_avx2<false>(dest, src, flags);
+}
+
+void convert_RGBA64_to_RGBA8888_avx2(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags flags)
+{
+    convertRGBA64ToARGB32Image_avx2<true>(dest, src, flags);
+}
+
+// Widens each 8-bit channel to 16 bits by repeating it, like QRgba64::fromArgb32().
+template<bool RGBA>
+static void convertARGB32ToRGBA64Image_avx2(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags)
+{
+    Q_ASSERT(RGBA || src->format == QImage::Format_ARGB32);
+    Q_ASSERT(!RGBA || src->format == QImage::Format_RGBA8888);
+    Q_ASSERT(dest->format == QImage::Format_RGBA64);
+    Q_ASSERT(src->width == dest->width);
+    Q_ASSERT(src->height == dest->height);
+
+    // ARGB32 is stored as BGRA, RGBA64 wants RGBA.
+    const __m256i rgbaMask = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+                                              2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const uchar *srcData = src->data;
+    uchar *destData = dest->data;
+    for (int y = 0; y < src->height; ++y) {
+        const uint *s = reinterpret_cast<const uint *>(srcData);
+        QRgba64 *d = reinterpret_cast<QRgba64 *>(destData);
+        int i = 0;
+        for (; i < src->width - 7; i += 8) {
+            __m256i vs = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+            if (!RGBA)
+                vs = _mm256_shuffle_epi8(vs, rgbaMask);
+            const __m256i lo = _mm256_unpacklo_epi8(vs, vs);
+            const __m256i hi = _mm256_unpackhi_epi8(vs, vs);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(d + i), _mm256_permute2x128_si256(lo, hi, 0x20));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(d + i + 4), _mm256_permute2x128_si256(lo, hi, 0x31));
+        }
+        for (; i < src->width; ++i)
+            d[i] = QRgba64::fromArgb32(RGBA ? RGBA2ARGB(s[i]) : s[i]);
+        srcData += src->bytes_per_line;
+        destData += dest->bytes_per_line;
+    }
+}
+
+void convert_ARGB32_to_RGBA64_avx2(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags flags)
+{
+    convertARGB32ToRGBA64Image_avx2<false>(dest, src, flags);
+}
+
+void convert_RGBA8888_to_RGBA64_avx2(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags flags)
+{
+    convertARGB32ToRGBA64Image_avx2<true>(dest, src, flags);
+}
+
+void convert_gray16_to_RGBA64_avx2(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags)
+{
+    Q_ASSERT(src->format == QImage::Format_Grayscale16);
+    Q_ASSERT(dest->format == QImage::Format_RGBA64 || dest->format == QImage::Format_RGBX64 ||
+             dest->format == QImage::Format_RGBA64_Premultiplied);
+    Q_ASSERT(src->width == dest->width);
+    Q_ASSERT(src->height == dest->height);
+
+    const __m256i valpha = _mm256_set1_epi16(-1);
+    const uchar *srcData = src->data;
+    uchar *destData = dest->data;
+    for (int y = 0; y < src->height; ++y) {
+        const quint16 *s = reinterpret_cast<const quint16 *>(srcData);
+        QRgba64 *d = reinterpret_cast<QRgba64 *>(destData);
+        int i = 0;
+        for (; i < src->width - 15; i += 16) {
+            const __m256i vs = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+            // Interleaving (g, g) with (g, a) gives whole pixels; p0 to p3
+            // hold pixels 0-1, 2-3, 4-5 and 6-7 in their low lanes and
+            // pixels 8-15 in their high lanes.
+            const __m256i ggLo = _mm256_unpacklo_epi16(vs, vs);
+            const __m256i gaLo = _mm256_unpacklo_epi16(vs, valpha);
+            const __m256i ggHi = _mm256_unpackhi_epi16(vs, vs);
+            const __m256i gaHi = _mm256_unpackhi_epi16(vs, valpha);
+            const __m256i p0 = _mm256_unpacklo_epi32(ggLo, gaLo);
+            const __m256i p1 = _mm256_unpackhi_epi32(ggLo, gaLo);
+            const __m256i p2 = _mm256_unpacklo_epi32(ggHi, gaHi);
+            const __m256i p3 = _mm256_unpackhi_epi32(ggHi, gaHi);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(d + i), _mm256_permute2x128_si256(p0, p1, 0x20));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(d + i + 4), _mm256_permute2x128_si256(p2, p3, 0x20));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(d + i + 8), _mm256_permute2x128_si256(p0, p1, 0x31));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(d + i + 12), _mm256_permute2x128_si256(p2, p3, 0x31));
+        }
+        for (; i < src->width; ++i)
+            d[i] = qRgba64(s[i], s[i], s[i], 0xffff);
+        srcData += src->bytes_per_line;
+        destData += dest->bytes_per_line;
+    }
+}
+
+static inline void setOpaqueRGBA64_avx2(QRgba64 *dst, const QRgba64 *src, int count)
+{
+    const __m256i valpha = _mm256_set1_epi64x(qint64(Q_UINT64_C(0xffff000000000000)));
+    int i = 0;
+    for (; i < count - 3; i += 4) {
+        const __m256i vs = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_or_si256(vs, valpha));
+    }
+    for (; i < count; ++i) {
+        dst[i] = src[i];
+        dst[i].setAlpha(65535);
+    }
+}
+
+void convert_RGBA64_to_RGBx64_avx2(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags)
+{
+    Q_ASSERT(src->format == QImage::Format_RGBA64);
+    Q_ASSERT(dest->format == QImage::Format_RGBX64);
+    Q_ASSERT(src->width == dest->width);
+    Q_ASSERT(src->height == dest->height);
+
+    const uchar *srcData = src->data;
+    uchar *destData = dest->data;
+    for (int i = 0; i < src->height; ++i) {
+        setOpaqueRGBA64_avx2(reinterpret_cast<QRgba64 *>(destData),
+                             reinterpret_cast<const QRgba64 *>(srcData), src->width);
+        srcData += src->bytes_per_line;
+        destData += dest->bytes_per_line;
+    }
+}
+
+bool convert_RGBA64_to_RGBx64_inplace_avx2(QImageData *data, Qt::ImageConversionFlags)
+{
+    Q_ASSERT(data->format == QImage::Format_RGBA64);
+
+    uchar *lineData = data->data;
+    for (int i = 0; i < data->height; ++i) {
+        QRgba64 *line = reinterpret_cast<QRgba64 *>(lineData);
+        setOpaqueRGBA64_avx2(line, line, data->width);
+        lineData += data->bytes_per_line;
+    }
+    data->format = QImage::Format_RGBX64;
+    return true;
+}
+
+QT_END_NAMESPACE
+
+#endif // QT_COMPILER_SUPPORTS_AVX2
@@ -2768,6 +2768,27 @@ static void qInitImageConversions()
     }
 #endif
 
+#if defined(QT_COMPILER_SUPPORTS_AVX2)
+    if (qCpuHasFeature(ArchHaswell)) {
+        extern void convert_ARGB32_to_RGBA64_avx2(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags);
+        extern void convert_RGBA8888_to_RGBA64_avx2(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags);
+        extern void convert_RGBA64_to_ARGB32_avx2(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags);
+        extern void convert_RGBA64_to_RGBA8888_avx2(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags);
+        extern void convert_RGBA64_to_RGBx64_avx2(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags);
+        extern bool convert_RGBA64_to_RGBx64_inplace_avx2(QImageData *data, Qt::ImageConversionFlags);
+        extern void convert_gray16_to_RGBA64_avx2(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags);
+        qimage_converter_map[QImage::Format_ARGB32][QImage::Format_RGBA64] = convert_ARGB32_to_RGBA64_avx2;
+        qimage_converter_map[QImage::Format_RGBA8888][QImage::Format_RGBA64] = convert_RGBA8888_to_RGBA64_avx2;
+        qimage_converter_map[QImage::Format_RGBA64][QImage::Format_ARGB32] = convert_RGBA64_to_ARGB32_avx2;
+        qimage_converter_map[QImage::Format_RGBA64][QImage::Format_RGBA8888] = convert_RGBA64_to_RGBA8888_avx2;
+        qimage_converter_map[QImage::Format_RGBA64][QImage::Format_RGBX64] = convert_RGBA64_to_RGBx64_avx2;
+        qimage_converter_map[QImage::Format_Grayscale16][QImage::Format_RGBX64] = convert_gray16_to_RGBA64_avx2;
+        qimage_converter_map[QImage::Format_Grayscale16][QImage::Format_RGBA64] = convert_gray16_to_RGBA64_avx2;
+        qimage_converter_map[QImage::Format_Grayscale16][QImage::Format_RGBA64_Premultiplied] = convert_gray16_to_RGBA64_avx2;
+        qimage_inplace_converter_map[QImage::Format_RGBA64][QImage::Format_RGBX64] = convert_RGBA64_to_RGBx64_inplace_avx2;
+    }
+#endif
+
 #if defined(QT_COMPILER_SUPPORTS_LSX)
     if (qCpuHasFeature(LSX)) {
         extern void convert_RGB888_to_RGB32_lsx(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags);
@@ -0,0 +1,519 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qimagecache.h"
+
+#include <QtCore/qalgorithms.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qwaitcondition.h>
+
+#if QT_CONFIG(future)
+#include <QtCore/qpromise.h>
+#include <QtCore/qthreadpool.h>
+#endif
+
+#include <list>
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QImageCache
+    \inmodule QtGui
+    \since 6.9
+    \threadsafe
+
+    \brief The QImageCache class provides a thread-safe cache for images.
+
+    QImageCache associates images with string keys, like QPixmapCache
+    does for pixmaps. Unlike QPixmapCache, it can be used from any thread,
+    which makes it suitable for images that are decoded or scaled by
+    worker threads, such as thumbnails.
+
+    The cache is limited to byteLimit() bytes of image data, counted with
+    QImage::sizeInBytes(). Internally, the cache is split into
+    shardCount() independently locked shards, so that threads working on
+    different keys rarely contend for the same lock. Each shard holds an
+    equal part of the byte limit; an image that is larger than that part
+    is not cached.
+
+    When a shard is full, images are evicted in least recently used
+    order. Images that have been found at least once since they were
+    inserted are kept in a protected segment, which takes up to four
+    fifths of the shard, so that a scan over many images that are used
+    only once does not evict the images that are used repeatedly.
+
+    findOrCreate() and findOrCreateAsync() create missing images with a
+    function supplied by the caller. If several threads ask for the same
+    missing key at the same time, only one of them runs the function, and
+    the others wait for and share its result.
+
+    statistics() reports how effective the cache is.
+
+    \sa QPixmapCache, QCache
+*/
+
+/*!
+    \class QImageCache::Statistics
+    \inmodule QtGui
+    \since 6.9
+
+    \brief The Statistics struct holds the usage counters of a QImageCache.
+*/
+
+/*!
+    \variable QImageCache::Statistics::hits
+    \brief the number of lookups that found an image in the cache
+*/
+
+/*!
+    \variable QImageCache::Statistics::misses
+    \brief the number of lookups that did not find an image in the cache
+*/
+
+/*!
+    \variable QImageCache::Statistics::insertions
+    \brief the number of images that were put into the cache
+*/
+
+/*!
+    \variable QImageCache::Statistics::evictions
+    \brief the number of images that were removed to stay within the
+    byte limit
+*/
+
+/*!
+    \variable QImageCache::Statistics::sharedLoads
+    \brief the number of misses that waited for an image another thread
+    was creating, instead of creating it again
+*/
+
+/*!
+    \variable QImageCache::Statistics::totalCost
+    \brief the number of bytes of image data in the cache
+*/
+
+/*!
+    \variable QImageCache::Statistics::count
+    \brief the number of images in the cache
+*/
+
+namespace {
+
+struct CacheEntry
+{
+    QString key;
+    QImage image;
+    qint64 cost;
+    bool isProtected;
+};
+
+struct PendingLoad
+{
+    QImage image;
+    bool done = false;
+    QWaitCondition finished;
+};
+
+class ImageCacheShard
+{
+public:
+    using List = std::list<CacheEntry>;
+
+    QImage *lookup(const QString &key);
+    bool contains(const QString &key) const { return index.contains(key); }
+    qint64 totalCost() const { return probationCost + protectedCost; }
+    qsizetype count() const { return index.size(); }
+    bool insert(const QString &key, const QImage &image);
+    bool remove(const QString &key);
+    void clear();
+    void setLimit(qint64 bytes);
+
+    mutable QMutex mutex;
+    QHash<QString, std::shared_ptr<PendingLoad>> loads;
+    QImageCache::Statistics statistics;
+
+private:
+    qint64 protectedLimit() const { return limit / 5 * 4; }
+    void unlink(List::iterator it);
+    void trim();
+
+    QHash<QString, List::iterator> index;
+    List probation; // most recently used first
+    List protectedEntries;
+    qint64 probationCost = 0;
+    qint64 protectedCost = 0;
+    qint64 limit = 0;
+};
+
+QImage *ImageCacheShard::lookup(const QString &key)
+{
+    const auto found = index.constFind(key);
+    if (found == index.cend())
+        return nullptr;
+    const List::iterator it = *found;
+    if (it->isProtected) {
+        protectedEntries.splice(protectedEntries.begin(), protectedEntries, it);
+    } else {
+        // A second use promotes the entry. If that overflows the protected
+        // segment, its least recently used entries go back to probation,
+        // where they are the next to be evicted after the new ones.
+        it->isProtected = true;
+        probationCost -= it->cost;
+        protectedCost += it->cost;
+        protectedEntries.splice(protectedEntries.begin(), probation, it);
+        while (protectedCost > protectedLimit() && protectedEntries.size() > 1) {
+            const List::iterator demoted = std::prev(protectedEntries.end());
+            demoted->isProtected = false;
+            protectedCost -= demoted->cost;
+            probationCost += demoted->cost;
+            probation.splice(probation.begin(), protectedEntries, demoted);
+        }
+    }
+    return &it->image;
+}
+
+bool ImageCacheShard::insert(const QString &key, const QImage &image)
+{
+    const qint64 cost = image.sizeInBytes();
+    remove(key);
+    if (cost > limit)
+        return false;
+    probation.push_front(CacheEntry{key, image, cost, false});
+    index.insert(key, probation.begin());
+    probationCost += cost;
+    ++statistics.insertions;
+    trim();
+    return true;
+}
+
+void ImageCacheShard::unlink(List::iterator it)
+{
+    index.remove(it->key);
+    if (it->isProtected) {
+        protectedCost -= it->cost;
+        protectedEntries.erase(it);
+    } else {
+        probationCost -= it->cost;
+        probation.erase(it);
+    }
+}
+
+bool ImageCacheShard::remove(const QString &key)
+{
+    const auto found = index.constFind(key);
+    if (found == index.cend())
+        return false;
+    unlink(*found);
+    return true;
+}
+
+void ImageCacheShard::clear()
+{
+    index.clear();
+    probation.clear();
+    protectedEntries.clear();
+    probationCost = 0;
+    protectedCost = 0;
+}
+
+void ImageCacheShard::trim()
+{
+    while (probationCost + protectedCost > limit) {
+        List &victims = probation.empty() ? protectedEntries : probation;
+        unlink(std::prev(victims.end()));
+        ++statistics.evictions;
+    }
+}
+
+void ImageCacheShard::setLimit(qint64 bytes)
+{
+    limit = bytes;
+    trim();
+}
+
+} // unnamed namespace
+
+class QImageCachePrivate
+{
+public:
+    QImageCachePrivate(qint64 byteLimit, int shardCount);
+
+    ImageCacheShard &shardFor(const QString &key) const
+    {
+        // Use the high bits of a remixed hash, the low bits of qHash() pick
+        // the bucket within the shard's own hash.
+        const quint64 hash = quint64(qHash(key)) * Q_UINT64_C(0x9e3779b97f4a7c15);
+        return shards[shardBits ? hash >> (64 - shardBits) : 0];
+    }
+
+    std::unique_ptr<ImageCacheShard[]> shards;
+    qint64 byteLimit;
+    int shardCount;
+    int shardBits;
+};
+
+QImageCachePrivate::QImageCachePrivate(qint64 byteLimit, int shardCount)
+    : byteLimit(qMax<qint64>(byteLimit, 0))
+{
+    if (shardCount <= 0)
+        shardCount = 2 * QThread::idealThreadCount();
+    shardCount = qBound(1, shardCount, 256);
+    shardBits = 0;
+    while ((1 << shardBits) < shardCount)
+        ++shardBits;
+    this->shardCount = 1 << shardBits;
+    shards.reset(new ImageCacheShard[this->shardCount]);
+    for (int i = 0; i < this->shardCount; ++i)
+        shards[i].setLimit(this->byteLimit / this->shardCount);
+}
+
+/*!
+    Constructs an empty cache that holds up to \a byteLimit bytes of image
+    data, split into \a shardCount shards.
+
+    The shard count is rounded up to a power of two. If \a shardCount is
+    0 or less, a count suitable for QThread::idealThreadCount() is used.
+*/
+QImageCache::QImageCache(qint64 byteLimit, int shardCount)
+    : d(new QImageCachePrivate(byteLimit, shardCount))
+{
+}
+
+/*!
+    Destroys the cache and all images in it.
+
+    No call to findOrCreateAsync() may be pending when the cache is
+    destroyed.
+*/
+QImageCache::~QImageCache()
+{
+    delete d;
+}
+
+/*!
+    Returns the maximum number of bytes of image data the cache holds.
+
+    \sa setByteLimit()
+*/
+qint64 QImageCache::byteLimit() const
+{
+    return d->byteLimit;
+}
+
+/*!
+    Sets the maximum number of bytes of image data the cache holds to
+    \a bytes, evicting images if the cache holds more than that.
+
+    This function must not be called concurrently with itself.
+
+    \sa byteLimit()
+*/
+void QImageCache::setByteLimit(qint64 bytes)
+{
+    d->byteLimit = qMax<qint64>(bytes, 0);
+    for (int i = 0; i < d->shardCount; ++i) {
+        ImageCacheShard &shard = d->shards[i];
+        QMutexLocker locker(&shard.mutex);
+        shard.setLimit(d->byteLimit / d->shardCount);
+    }
+}
+
+/*!
+    Returns the number of independently locked parts the cache is split
+    into.
+*/
+int QImageCache::shardCount() const
+{
+    return d->shardCount;
+}
+
+/*!
+    Looks for an image with the given \a key in the cache. If one is
+    found, sets \a image to it, marks it as recently used and returns
+    \c true; otherwise returns \c false.
+*/
+bool QImageCache::find(const QString &key, QImage *image) const
+{
+    ImageCacheShard &shard = d->shardFor(key);
+    QMutexLocker locker(&shard.mutex);
+    if (const QImage *cached = shard.lookup(key)) {
+        ++shard.statistics.hits;
+        if (image)
+            *image = *cached;
+        return true;
+    }
+    ++shard.statistics.misses;
+    return false;
+}
+
+/*!
+    Returns \c true if the cache holds an image with the given \a key.
+
+    Unlike find(), this function neither marks the image as used nor
+    changes the statistics.
+*/
+bool QImageCache::contains(const QString &key) const
+{
+    ImageCacheShard &shard = d->shardFor(key);
+    QMutexLocker locker(&shard.mutex);
+    return shard.contains(key);
+}
+
+/*!
+    Inserts a copy of \a image into the cache with the given \a key,
+    replacing any image already stored with that key. Returns \c true if
+    the image was inserted.
+
+    The image is not inserted if it is null, or if it is larger than the
+    part of the byte limit available to a single shard.
+*/
+bool QImageCache::insert(const QString &key, const QImage &image)
+{
+    if (image.isNull())
+        return false;
+    ImageCacheShard &shard = d->shardFor(key);
+    QMutexLocker locker(&shard.mutex);
+    return shard.insert(key, image);
+}
+
+/*!
+    Removes the image with the given \a key from the cache. Returns
+    \c true if there was such an image.
+*/
+bool QImageCache::remove(const QString &key)
+{
+    ImageCacheShard &shard = d->shardFor(key);
+    QMutexLocker locker(&shard.mutex);
+    return shard.remove(key);
+}
+
+/*!
+    Removes all images from the cache. Loads that are in progress are not
+    affected.
+*/
+void QImageCache::clear()
+{
+    for (int i = 0; i < d->shardCount; ++i) {
+        ImageCacheShard &shard = d->shards[i];
+        QMutexLocker locker(&shard.mutex);
+        shard.clear();
+    }
+}
+
+/*!
+    Returns the image with the given \a key. If the cache does not hold
+    one, calls \a create to make it and inserts the result, unless it is
+    a null image.
+
+    If another thread is already creating the image for \a key, this
+    function waits for it and returns its result instead of calling
+    \a create. \a create is called without any lock held, so it may use
+    the cache itself, but it must not ask for \a key. \a create must not
+    throw; threads waiting for \a key would never be woken up.
+*/
+QImage QImageCache::findOrCreate(const QString &key, qxp::function_ref<QImage()> create)
+{
+    ImageCacheShard &shard = d->shardFor(key);
+    QMutexLocker locker(&shard.mutex);
+    if (const QImage *cached = shard.lookup(key)) {
+        ++shard.statistics.hits;
+        return *cached;
+    }
+    ++shard.statistics.misses;
+
+    if (const std::shared_ptr<PendingLoad> load = shard.loads.value(key)) {
+        ++shard.statistics.sharedLoads;
+        while (!load->done)
+            load->finished.wait(&shard.mutex);
+        return load->image;
+    }
+
+    const auto load = std::make_shared<PendingLoad>();
+    shard.loads.insert(key, load);
+    locker.unlock();
+    QImage image = create();
+    locker.relock();
+    if (!image.isNull())
+        shard.insert(key, image);
+    shard.loads.remove(key);
+    load->image = image;
+    load->done = true;
+    load->finished.wakeAll();
+    return image;
+}
+
+#if QT_CONFIG(future)
+/*!
+    Returns a future for the image with the given \a key.
+
+    If the cache holds the image, the returned future is already
+    finished. Otherwise, findOrCreate() is called with \a create on a
+    thread of \a pool, or of QThreadPool::globalInstance() if \a pool is
+    \nullptr, and the future finishes when it returns.
+*/
+QFuture<QImage> QImageCache::findOrCreateAsync(const QString &key,
+                                               std::function<QImage()> create,
+                                               QThreadPool *pool)
+{
+    {
+        ImageCacheShard &shard = d->shardFor(key);
+        QMutexLocker locker(&shard.mutex);
+        if (const QImage *cached = shard.lookup(key)) {
+            ++shard.statistics.hits;
+            return QtFuture::makeReadyValueFuture(QImage(*cached));
+        }
+    }
+
+    QPromise<QImage> promise;
+    QFuture<QImage> future = promise.future();
+    promise.start();
+    if (!pool)
+        pool = QThreadPool::globalInstance();
+    pool->start([this, key, create = std::move(create), promise = std::move(promise)]() mutable {
+        promise.addResult(findOrCreate(key, create));
+        promise.finish();
+    });
+    return future;
+}
+#endif // QT_CONFIG(future)
+
+/*!
+    Returns the usage counters of the cache, summed over all shards.
+
+    \sa resetStatistics()
+*/
+QImageCache::Statistics QImageCache::statistics() const
+{
+    Statistics result;
+    for (int i = 0; i < d->shardCount; ++i) {
+        ImageCacheShard &shard = d->shards[i];
+        QMutexLocker locker(&shard.mutex);
+        result.hits += shard.statistics.hits;
+        result.misses += shard.statistics.misses;
+        result.insertions += shard.statistics.insertions;
+        result.evictions += shard.statistics.evictions;
+        result.sharedLoads += shard.statistics.sharedLoads;
+        result.totalCost += shard.totalCost();
+        result.count += shard.count();
+    }
+    return result;
+}
+
+/*!
+    Sets the hit, miss, insertion, eviction and shared load counters to 0.
+
+    \sa statistics()
+*/
+void QImageCache::resetStatistics()
+{
+    for (int i = 0; i < d->shardCount; ++i) {
+        ImageCacheShard &shard = d->shards[i];
+        QMutexLocker locker(&shard.mutex);
+        shard.statistics = Statistics();
+    }
+}
+
+QT_END_NAMESPACE
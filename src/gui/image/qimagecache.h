@@ -0,0 +1,64 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QIMAGECACHE_H
+#define QIMAGECACHE_H
+
+#include <QtGui/qtguiglobal.h>
+#include <QtGui/qimage.h>
+#include <QtCore/qxpfunctional.h>
+
+#if QT_CONFIG(future)
+#include <QtCore/qfuture.h>
+#include <functional>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+class QImageCachePrivate;
+class QThreadPool;
+
+class Q_GUI_EXPORT QImageCache
+{
+public:
+    struct Statistics
+    {
+        qint64 hits = 0;
+        qint64 misses = 0;
+        qint64 insertions = 0;
+        qint64 evictions = 0;
+        qint64 sharedLoads = 0;
+        qint64 totalCost = 0;
+        qsizetype count = 0;
+    };
+
+    explicit QImageCache(qint64 byteLimit = 64 * 1024 * 1024, int shardCount = 0);
+    ~QImageCache();
+
+    qint64 byteLimit() const;
+    void setByteLimit(qint64 bytes);
+    int shardCount() const;
+
+    bool find(const QString &key, QImage *image) const;
+    bool contains(const QString &key) const;
+    bool insert(const QString &key, const QImage &image);
+    bool remove(const QString &key);
+    void clear();
+
+    QImage findOrCreate(const QString &key, qxp::function_ref<QImage()> create);
+#if QT_CONFIG(future)
+    QFuture<QImage> findOrCreateAsync(const QString &key, std::function<QImage()> create,
+                                      QThreadPool *pool = nullptr);
+#endif
+
+    Statistics statistics() const;
+    void resetStatistics();
+
+private:
+    Q_DISABLE_COPY_MOVE(QImageCache)
+    QImageCachePrivate *d;
+};
+
+QT_END_NAMESPACE
+
+#endif // QIMAGECACHE_H
@@ -225,6 +225,7 @@
 */
 
 #include "qimageiohandler.h"
+#include "qimageiohandler_p.h"
 #include "qimage_p.h"
 
 #include <qbytearray.h>
@@ -236,29 +237,93 @@ QT_BEGIN_NAMESPACE
 
 Q_LOGGING_CATEGORY(lcImageIo, "qt.gui.imageio")
 
-class QIODevice;
+QImageIOHandlerPrivate::QImageIOHandlerPrivate(QImageIOHandler *q)
+{
+    device = nullptr;
+    q_ptr = q;
+}
 
-class QImageIOHandlerPrivate
+QImageIOHandlerPrivate::~QImageIOHandlerPrivate()
 {
-    Q_DECLARE_PUBLIC(QImageIOHandler)
-public:
-    QImageIOHandlerPrivate(QImageIOHandler *q);
-    virtual ~QImageIOHandlerPrivate();
+}
 
-    QIODevice *device;
-    mutable QByteArray format;
+/*!
+    \class QImageScanlineHandler
+    \inmodule QtGui
+    \internal
 
-    QImageIOHandler *q_ptr;
-};
+    \brief The QImageScanlineHandler class is the interface of image
+    handlers that read or write images a few rows at a time.
 
-QImageIOHandlerPrivate::QImageIOHandlerPrivate(QImageIOHandler *q)
+    QImageReader::readScanlines() and QImageWriter::writeScanlines() use
+    it to process images that are too large to be held in a QImage. A
+    handler implements it in addition to QImageIOHandler and registers
+    itself with QImageIOHandlerPrivate::setScanlineHandler().
+
+    Rows are always processed from top to bottom. The default
+    implementations fail.
+*/
+
+QImageScanlineHandler::~QImageScanlineHandler() = default;
+
+/*!
+    Reads the header of the image and sets \a size, the \a format that
+    rows are read in and, for indexed formats, their \a colorTable.
+    Returns \c false if the image cannot be read row by row.
+*/
+bool QImageScanlineHandler::beginScanlineRead(QSize *size, QImage::Format *format,
+                                              QList<QRgb> *colorTable)
 {
-    device = nullptr;
-    q_ptr = q;
+    Q_UNUSED(size);
+    Q_UNUSED(format);
+    Q_UNUSED(colorTable);
+    return false;
 }
 
-QImageIOHandlerPrivate::~QImageIOHandlerPrivate()
+/*!
+    Reads up to \a count rows into \a buffer, which has \a bytesPerLine
+    bytes per row. Returns the number of rows read, 0 after the last row,
+    or -1 on error.
+*/
+int QImageScanlineHandler::readScanlines(uchar *buffer, qsizetype bytesPerLine, int count)
+{
+    Q_UNUSED(buffer);
+    Q_UNUSED(bytesPerLine);
+    Q_UNUSED(count);
+    return -1;
+}
+
+/*!
+    Writes the header of an image of the given \a size. \a format is the
+    format of the image; the handler can change it to the format it wants
+    the rows to be passed in. Returns \c false if the image cannot be
+    written row by row.
+*/
+bool QImageScanlineHandler::beginScanlineWrite(QSize size, QImage::Format *format)
+{
+    Q_UNUSED(size);
+    Q_UNUSED(format);
+    return false;
+}
+
+/*!
+    Writes \a count rows from \a buffer, which has \a bytesPerLine bytes
+    per row.
+*/
+bool QImageScanlineHandler::writeScanlines(const uchar *buffer, qsizetype bytesPerLine, int count)
+{
+    Q_UNUSED(buffer);
+    Q_UNUSED(bytesPerLine);
+    Q_UNUSED(count);
+    return false;
+}
+
+/*!
+    Finishes writing the image after all rows have been written.
+*/
+bool QImageScanlineHandler::endScanlineWrite()
 {
+    return false;
 }
 
 /*!
@@ -0,0 +1,67 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QIMAGEIOHANDLER_P_H
+#define QIMAGEIOHANDLER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtGui/private/qtguiglobal_p.h>
+#include <QtGui/qimageiohandler.h>
+#include <QtCore/qlist.h>
+
+QT_BEGIN_NAMESPACE
+
+// Implemented by image handlers that can read or write an image a few rows
+// at a time, top to bottom, without holding all of it in memory. Handlers
+// register themselves with QImageIOHandlerPrivate::setScanlineHandler().
+class Q_GUI_EXPORT QImageScanlineHandler
+{
+public:
+    virtual ~QImageScanlineHandler();
+
+    // Reads the header and returns the size of the image, the format of
+    // the rows and, for indexed formats, their color table.
+    virtual bool beginScanlineRead(QSize *size, QImage::Format *format, QList<QRgb> *colorTable);
+    // Reads up to count rows into buffer and returns the number of rows
+    // read, 0 after the last row, or -1 on error.
+    virtual int readScanlines(uchar *buffer, qsizetype bytesPerLine, int count);
+
+    // Writes the header. The handler can change format to the format it
+    // wants the rows in.
+    virtual bool beginScanlineWrite(QSize size, QImage::Format *format);
+    virtual bool writeScanlines(const uchar *buffer, qsizetype bytesPerLine, int count);
+    virtual bool endScanlineWrite();
+};
+
+class Q_GUI_EXPORT QImageIOHandlerPrivate
+{
+    Q_DECLARE_PUBLIC(QImageIOHandler)
+public:
+    QImageIOHandlerPrivate(QImageIOHandler *q);
+    virtual ~QImageIOHandlerPrivate();
+
+    static QImageScanlineHandler *scanlineHandler(QImageIOHandler *handler)
+    { return handler->d_func()->scanlines; }
+    static void setScanlineHandler(QImageIOHandler *handler, QImageScanlineHandler *scanlines)
+    { handler->d_func()->scanlines = scanlines; }
+
+    QIODevice *device;
+    mutable QByteArray format;
+    QImageScanlineHandler *scanlines = nullptr;
+
+    QImageIOHandler *q_ptr;
+};
+
+QT_END_NAMESPACE
+
+#endif // QIMAGEIOHANDLER_P_H
@@ -30,6 +30,10 @@
     supported and the device is open for reading). Call read() to read
     the image.
 
+    To read many images at once, for instance to make thumbnails, call
+    readAsync(). It reads the files on a thread pool and reports the
+    images through a QFuture.
+
     If any error occurs when reading the image, read() will return a
     null QImage. You can then call error() to find the type of error
     that occurred, or errorString() to get a human readable
@@ -112,11 +116,16 @@
 
 // factory loader
 #include <qcoreapplication.h>
+#if QT_CONFIG(future)
+#include <qpromise.h>
+#include <qthreadpool.h>
+#endif
 #include <private/qfactoryloader_p.h>
 #include <QtCore/private/qlocking_p.h>
 
 // for qt_getImageText
 #include <private/qimage_p.h>
+#include <private/qimageiohandler_p.h>
 
 // image handlers
 #include <private/qbmphandler_p.h>
@@ -131,6 +140,7 @@
 #include <qtgui_tracepoints_p.h>
 
 #include <algorithm>
+#include <memory>
 
 QT_BEGIN_NAMESPACE
 
@@ -416,6 +426,13 @@ public:
     QImageIOHandler *handler;
     bool initHandler();
 
+    // row by row reading
+    QImageScanlineHandler *scanlines = nullptr;
+    QSize scanlineSize;
+    QImage::Format scanlineFormat = QImage::Format_Invalid;
+    QList<QRgb> scanlineColorTable;
+    int nextScanline = 0;
+
     // image options
     QRect clipRect;
     QSize scaledSize;
@@ -726,6 +743,8 @@ void QImageReader::setDevice(QIODevice *device)
 {
     delete d->handler;
     d->handler = nullptr;
+    d->scanlines = nullptr;
+    d->scanlineFormat = QImage::Format_Invalid;
     if (d->device && d->deleteDevice)
         delete d->device;
     d->device = device;
@@ -1110,6 +1129,100 @@ QImage QImageReader::read()
     return read(&image) ? image : QImage();
 }
 
+/*!
+    \since 6.9
+
+    Prepares reading the image a few rows at a time with readScanlines(),
+    for images that are too large to be held in memory at once. Returns
+    \c true if the image format supports this; otherwise returns \c false
+    and sets error().
+
+    Reading row by row is supported by the PNG, JPEG, BMP and PPM formats,
+    except for interlaced PNG images, and compressed BMP images or BMP
+    images on sequential devices.
+    The clip rect, scaled size and automatic transformation options do
+    not apply to it.
+
+    \sa readScanlines(), scanlineFormat(), QImageWriter::beginScanlineWrite()
+*/
+bool QImageReader::beginScanlineRead()
+{
+    if (!d->initHandler())
+        return false;
+
+    d->scanlines = QImageIOHandlerPrivate::scanlineHandler(d->handler);
+    if (!d->scanlines || !d->scanlines->beginScanlineRead(&d->scanlineSize, &d->scanlineFormat,
+                                                          &d->scanlineColorTable)) {
+        d->scanlines = nullptr;
+        d->scanlineFormat = QImage::Format_Invalid;
+        d->imageReaderError = QImageReader::UnsupportedFormatError;
+        d->errorString = QImageReader::tr("Image cannot be read row by row");
+        return false;
+    }
+    d->nextScanline = 0;
+    return true;
+}
+
+/*!
+    \since 6.9
+
+    Returns the format of the rows returned by readScanlines(), or
+    QImage::Format_Invalid if beginScanlineRead() has not succeeded.
+*/
+QImage::Format QImageReader::scanlineFormat() const
+{
+    return d->scanlineFormat;
+}
+
+/*!
+    \since 6.9
+
+    Reads the next rows of the image into \a rows, and returns the number
+    of rows read. Returns 0 after the last row has been read, and -1 on
+    error.
+
+    Each call reads up to rows->height() rows into the top of \a rows. If
+    \a rows does not have the width of the image and the format given by
+    scanlineFormat(), it is reallocated with them, keeping its height, or
+    with a height of one row if it is null. Reusing the same image for all
+    rows keeps the memory needed constant, independent of the height of
+    the image:
+
+    \snippet code/src_gui_image_qimagereader.cpp scanlines
+
+    Only the pixels are read. Metadata such as the color space and text
+    keys is not set on \a rows.
+
+    \sa beginScanlineRead()
+*/
+int QImageReader::readScanlines(QImage *rows)
+{
+    if (!d->scanlines || !rows)
+        return -1;
+    if (d->nextScanline >= d->scanlineSize.height())
+        return 0;
+
+    if (rows->width() != d->scanlineSize.width() || rows->format() != d->scanlineFormat) {
+        if (!QImageIOHandler::allocateImage(QSize(d->scanlineSize.width(), qMax(rows->height(), 1)),
+                                            d->scanlineFormat, rows)) {
+            return -1;
+        }
+        if (!d->scanlineColorTable.isEmpty())
+            rows->setColorTable(d->scanlineColorTable);
+    }
+
+    const int count = qMin(rows->height(), d->scanlineSize.height() - d->nextScanline);
+    const int read = d->scanlines->readScanlines(rows->bits(), rows->bytesPerLine(), count);
+    if (read < 0) {
+        d->scanlines = nullptr;
+        d->imageReaderError = InvalidDataError;
+        d->errorString = QImageReader::tr("Unable to read image data");
+        return -1;
+    }
+    d->nextScanline += read;
+    return read;
+}
+
 extern void qt_imageTransform(QImage &src, QImageIOHandler::Transformations orient);
 
 /*!
@@ -1549,4 +1662,59 @@ void QImageReader::setAllocationLimit(int mbLimit)
         QImageReaderPrivate::maxAlloc = mbLimit;
 }
 
+#if QT_CONFIG(future)
+/*!
+    \since 6.9
+
+    Reads the images in the files \a fileNames on the threads of \a pool,
+    or of QThreadPool::globalInstance() if \a pool is \nullptr, and
+    returns a future that reports them.
+
+    The image read from a file is the result of the future with the same
+    index as the file name; use QFuture::resultAt() or
+    QFuture::takeResults() to get it. Files that cannot be read have a
+    null image as result. The files are read in parallel, so results can
+    become available in any order.
+
+    If \a configure is set, it is called with the reader of each file
+    before the image is read, on the thread that reads it. Use it to set
+    the scaled size, clip rect or other options of the reader, for
+    instance depending on the size() of the image.
+
+    Files that have not been started when the future is canceled are not
+    read.
+
+    \sa read(), QFuture
+*/
+QFuture<QImage> QImageReader::readAsync(const QStringList &fileNames,
+                                        std::function<void(QImageReader &)> configure,
+                                        QThreadPool *pool)
+{
+    const auto promise = std::make_shared<QPromise<QImage>>();
+    QFuture<QImage> future = promise->future();
+    promise->start();
+    if (fileNames.isEmpty()) {
+        promise->finish();
+        return future;
+    }
+
+    if (!pool)
+        pool = QThreadPool::globalInstance();
+    const auto remaining = std::make_shared<QAtomicInt>(int(fileNames.size()));
+    for (qsizetype i = 0; i < fileNames.size(); ++i) {
+        pool->start([promise, remaining, configure, fileName = fileNames.at(i), index = int(i)] {
+            if (!promise->isCanceled()) {
+                QImageReader reader(fileName);
+                if (configure)
+                    configure(reader);
+                promise->addResult(reader.read(), index);
+            }
+            if (!remaining->deref())
+                promise->finish();
+        });
+    }
+    return future;
+}
+#endif // QT_CONFIG(future)
+
 QT_END_NAMESPACE
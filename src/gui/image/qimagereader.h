@@ -10,6 +10,11 @@
 #include <QtGui/qimage.h>
 #include <QtGui/qimageiohandler.h>
 
+#if QT_CONFIG(future)
+#include <QtCore/qfuture.h>
+#include <functional>
+#endif
+
 QT_BEGIN_NAMESPACE
 
 
@@ -17,6 +22,7 @@ class QColor;
 class QIODevice;
 class QRect;
 class QSize;
+class QThreadPool;
 
 class QImageReaderPrivate;
 class Q_GUI_EXPORT QImageReader
@@ -87,6 +93,10 @@ public:
     QImage read();
     bool read(QImage *image);
 
+    bool beginScanlineRead();
+    QImage::Format scanlineFormat() const;
+    int readScanlines(QImage *rows);
+
     bool jumpToNextImage();
     bool jumpToImage(int imageNumber);
     int loopCount() const;
@@ -107,6 +117,11 @@ public:
     static QList<QByteArray> imageFormatsForMimeType(const QByteArray &mimeType);
     static int allocationLimit();
     static void setAllocationLimit(int mbLimit);
+#if QT_CONFIG(future)
+    static QFuture<QImage> readAsync(const QStringList &fileNames,
+                                     std::function<void(QImageReader &)> configure = {},
+                                     QThreadPool *pool = nullptr);
+#endif
 
 private:
     Q_DISABLE_COPY(QImageReader)
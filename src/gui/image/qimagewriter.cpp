@@ -90,6 +90,7 @@
 #include <private/qpnghandler_p.h>
 #endif
 
+#include <private/qimageiohandler_p.h>
 #include <private/qimagereaderwriterhelpers_p.h>
 
 #include <algorithm>
@@ -204,6 +205,7 @@ public:
     QImageWriterPrivate(QImageWriter *qq);
 
     bool canWriteHelper();
+    void setHandlerOptions();
 
     // device
     QByteArray format;
@@ -211,6 +213,12 @@ public:
     bool deleteDevice;
     QImageIOHandler *handler;
 
+    // row by row writing
+    QImageScanlineHandler *scanlines = nullptr;
+    QSize scanlineSize;
+    QImage::Format scanlineFormat = QImage::Format_Invalid;
+    int nextScanline = 0;
+
     // image options
     int quality;
     int compression;
@@ -363,6 +371,7 @@ void QImageWriter::setDevice(QIODevice *device)
 {
     delete d->handler;
     d->handler = nullptr;
+    d->scanlines = nullptr;
     if (d->device && d->deleteDevice)
         delete d->device;
 
@@ -661,20 +670,7 @@ bool QImageWriter::write(const QImage &image)
         return false;
 
     QImage img = image;
-    if (d->handler->supportsOption(QImageIOHandler::Quality))
-        d->handler->setOption(QImageIOHandler::Quality, d->quality);
-    if (d->handler->supportsOption(QImageIOHandler::CompressionRatio))
-        d->handler->setOption(QImageIOHandler::CompressionRatio, d->compression);
-    if (d->handler->supportsOption(QImageIOHandler::Gamma))
-        d->handler->setOption(QImageIOHandler::Gamma, d->gamma);
-    if (!d->description.isEmpty() && d->handler->supportsOption(QImageIOHandler::Description))
-        d->handler->setOption(QImageIOHandler::Description, d->description);
-    if (!d->subType.isEmpty() && d->handler->supportsOption(QImageIOHandler::SubType))
-        d->handler->setOption(QImageIOHandler::SubType, d->subType);
-    if (d->handler->supportsOption(QImageIOHandler::OptimizedWrite))
-        d->handler->setOption(QImageIOHandler::OptimizedWrite, d->optimizedWrite);
-    if (d->handler->supportsOption(QImageIOHandler::ProgressiveScanWrite))
-        d->handler->setOption(QImageIOHandler::ProgressiveScanWrite, d->progressiveScanWrite);
+    d->setHandlerOptions();
     if (d->handler->supportsOption(QImageIOHandler::ImageTransformation))
         d->handler->setOption(QImageIOHandler::ImageTransformation, int(d->transformation));
     else
@@ -687,6 +683,131 @@ bool QImageWriter::write(const QImage &image)
     return true;
 }
 
+/*!
+    \internal
+*/
+void QImageWriterPrivate::setHandlerOptions()
+{
+    if (handler->supportsOption(QImageIOHandler::Quality))
+        handler->setOption(QImageIOHandler::Quality, quality);
+    if (handler->supportsOption(QImageIOHandler::CompressionRatio))
+        handler->setOption(QImageIOHandler::CompressionRatio, compression);
+    if (handler->supportsOption(QImageIOHandler::Gamma))
+        handler->setOption(QImageIOHandler::Gamma, gamma);
+    if (!description.isEmpty() && handler->supportsOption(QImageIOHandler::Description))
+        handler->setOption(QImageIOHandler::Description, description);
+    if (!subType.isEmpty() && handler->supportsOption(QImageIOHandler::SubType))
+        handler->setOption(QImageIOHandler::SubType, subType);
+    if (handler->supportsOption(QImageIOHandler::OptimizedWrite))
+        handler->setOption(QImageIOHandler::OptimizedWrite, optimizedWrite);
+    if (handler->supportsOption(QImageIOHandler::ProgressiveScanWrite))
+        handler->setOption(QImageIOHandler::ProgressiveScanWrite, progressiveScanWrite);
+}
+
+/*!
+    \since 6.9
+
+    Prepares writing an image of the given \a size a few rows at a time
+    with writeScanlines(), for images that are too large to be held in
+    memory at once. \a format is the format of the rows that will be
+    passed. Returns \c true if the image format supports this; otherwise
+    returns \c false and sets error().
+
+    Writing row by row is supported by the PNG, JPEG, BMP and PPM formats.
+    The transformation option does not apply to it.
+
+    \sa writeScanlines(), endScanlineWrite(), QImageReader::beginScanlineRead()
+*/
+bool QImageWriter::beginScanlineWrite(const QSize &size, QImage::Format format)
+{
+    if (Q_UNLIKELY(size.isEmpty() || format == QImage::Format_Invalid)) {
+        d->imageWriterError = QImageWriter::InvalidImageError;
+        d->errorString = QImageWriter::tr("Image is empty");
+        return false;
+    }
+
+    if (!canWrite())
+        return false;
+
+    d->setHandlerOptions();
+    d->scanlines = QImageIOHandlerPrivate::scanlineHandler(d->handler);
+    d->scanlineFormat = format;
+    if (!d->scanlines || !d->scanlines->beginScanlineWrite(size, &d->scanlineFormat)) {
+        d->scanlines = nullptr;
+        d->imageWriterError = QImageWriter::UnsupportedFormatError;
+        d->errorString = QImageWriter::tr("Image cannot be written row by row");
+        return false;
+    }
+    d->scanlineSize = size;
+    d->nextScanline = 0;
+    return true;
+}
+
+/*!
+    \since 6.9
+
+    Writes all rows of \a rows as the next rows of the image. \a rows must
+    have the width passed to beginScanlineWrite(); it is converted to the
+    format the image format needs, if necessary. Returns \c true on
+    success; otherwise returns \c false.
+
+    Only the pixels are written. Metadata such as the color space and text
+    keys of \a rows is ignored.
+
+    \sa beginScanlineWrite(), endScanlineWrite()
+*/
+bool QImageWriter::writeScanlines(const QImage &rows)
+{
+    if (!d->scanlines)
+        return false;
+    if (rows.width() != d->scanlineSize.width()
+            || rows.height() > d->scanlineSize.height() - d->nextScanline) {
+        d->imageWriterError = QImageWriter::InvalidImageError;
+        d->errorString = QImageWriter::tr("Rows do not fit into the image");
+        return false;
+    }
+
+    const QImage converted = rows.convertToFormat(d->scanlineFormat);
+    if (!d->scanlines->writeScanlines(converted.constBits(), converted.bytesPerLine(),
+                                      converted.height())) {
+        d->scanlines = nullptr;
+        d->imageWriterError = QImageWriter::DeviceError;
+        d->errorString = QImageWriter::tr("Unable to write image data");
+        return false;
+    }
+    d->nextScanline += rows.height();
+    return true;
+}
+
+/*!
+    \since 6.9
+
+    Finishes writing the image after all of its rows have been passed to
+    writeScanlines(). Returns \c true on success; otherwise returns
+    \c false.
+
+    \sa beginScanlineWrite()
+*/
+bool QImageWriter::endScanlineWrite()
+{
+    QImageScanlineHandler *scanlines = std::exchange(d->scanlines, nullptr);
+    if (!scanlines)
+        return false;
+    if (d->nextScanline != d->scanlineSize.height()) {
+        d->imageWriterError = QImageWriter::InvalidImageError;
+        d->errorString = QImageWriter::tr("Not all rows of the image were written");
+        return false;
+    }
+    if (!scanlines->endScanlineWrite()) {
+        d->imageWriterError = QImageWriter::DeviceError;
+        d->errorString = QImageWriter::tr("Unable to write image data");
+        return false;
+    }
+    if (QFileDevice *file = qobject_cast<QFileDevice *>(d->device))
+        file->flush();
+    return true;
+}
+
 /*!
     Returns the type of error that last occurred.
 
@@ -66,6 +66,10 @@ public:
     bool canWrite() const;
     bool write(const QImage &image);
 
+    bool beginScanlineWrite(const QSize &size, QImage::Format format);
+    bool writeScanlines(const QImage &rows);
+    bool endScanlineWrite();
+
     ImageWriterError error() const;
     QString errorString() const;
 
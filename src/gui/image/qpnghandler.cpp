@@ -56,12 +56,15 @@ using namespace Qt::StringLiterals;
   All QImage formats output to reasonably efficient PNG equivalents.
 */
 
+class QPNGImageWriter;
+
 class QPngHandlerPrivate
 {
 public:
     enum State {
         Ready,
         ReadHeader,
+        ReadingScanlines,
         ReadingEnd,
         Error
     };
@@ -80,6 +83,7 @@ public:
 
     float gamma;
     float fileGamma;
+    QRect clipRect;
     int quality; // quality is used for backward compatibility, maps to compression
     int compression;
     QString description;
@@ -91,11 +95,21 @@ public:
     png_info *info_ptr;
     png_info *end_info;
     png_byte **row_pointers;
+    QByteArray rowBuffer;
+
+    QPNGImageWriter *scanlineWriter = nullptr;
+    int scanline = 0;
 
     bool readPngHeader();
     bool readPngImage(QImage *image);
     void readPngTexts(png_info *info);
 
+    bool beginScanlineRead(QSize *size, QImage::Format *format, QList<QRgb> *colorTable);
+    int readScanlines(uchar *buffer, qsizetype bytesPerLine, int count);
+    bool beginScanlineWrite(QSize size, QImage::Format *format);
+    bool writeScanlines(const uchar *buffer, qsizetype bytesPerLine, int count);
+    bool endScanlineWrite();
+
     QImage::Format readImageFormat();
 
     State state;
@@ -122,6 +136,11 @@ public:
     bool writeImage(const QImage& img, int compression, const QString &description)
         { return writeImage(img, compression, description, 0, 0); }
 
+    bool beginScanlineWrite(QSize size, QImage::Format *format, int compression,
+                            const QString &description);
+    bool writeScanlines(const uchar *buffer, qsizetype bytesPerLine, int count);
+    bool endScanlineWrite();
+
     QIODevice* device() { return dev; }
 
 private:
@@ -131,6 +150,10 @@ private:
     int looping;
     int ms_delay;
     float gamma;
+
+    png_structp scanline_ptr = nullptr;
+    png_infop scanline_info = nullptr;
+    int scanlines_written = 0;
 };
 
 extern "C" {
@@ -181,7 +204,7 @@ void qpiw_flush_fn(png_structp /* png_ptr */)
 }
 
 static
-bool setup_qt(QImage& image, png_structp png_ptr, png_infop info_ptr)
+bool setup_qt(QImage& image, png_structp png_ptr, png_infop info_ptr, const QSize &clipSize)
 {
     png_uint_32 width = 0;
     png_uint_32 height = 0;
@@ -193,7 +216,7 @@ bool setup_qt(QImage& image, png_structp png_ptr, png_infop info_ptr)
     png_colorp palette = nullptr;
     int num_palette;
     png_get_IHDR(png_ptr, info_ptr, &width, &height, &bit_depth, &color_type, nullptr, nullptr, nullptr);
-    QSize size(width, height);
+    QSize size = clipSize.isValid() ? clipSize : QSize(width, height);
     png_set_interlace_handling(png_ptr);
 
     if (color_type == PNG_COLOR_TYPE_GRAY) {
@@ -269,7 +292,8 @@ bool setup_qt(QImage& image, png_structp png_ptr, png_infop info_ptr)
             png_set_packing(png_ptr);
         png_read_update_info(png_ptr, info_ptr);
         png_get_IHDR(png_ptr, info_ptr, &width, &height, &bit_depth, &color_type, nullptr, nullptr, nullptr);
-        size = QSize(width, height);
+        if (!clipSize.isValid())
+            size = QSize(width, height);
         QImage::Format format = bit_depth == 1 ? QImage::Format_Mono : QImage::Format_Indexed8;
         if (!QImageIOHandler::allocateImage(size, format, &image))
             return false;
@@ -358,6 +382,19 @@ static void qt_png_warning(png_structp /*png_ptr*/, png_const_charp message)
 
 }
 
+static int qt_png_compression_level(int compression, int quality)
+{
+    // quality is used for backward compatibility, maps to compression
+    if (compression >= 0)
+        compression = qMin(compression, 100);
+    else if (quality >= 0)
+        compression = 100 - qMin(quality, 100);
+
+    if (compression >= 0)
+        compression = (compression * 9) / 91; // map [0,100] -> [0,9]
+    return compression;
+}
+
 
 void QPngHandlerPrivate::readPngTexts(png_info *info)
 {
@@ -508,6 +545,7 @@ bool QPngHandlerPrivate::readPngImage(QImage *outImage)
         png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
         png_ptr = nullptr;
         delete[] row_pointers;
+        rowBuffer.clear();
         state = Error;
         return false;
     }
@@ -520,7 +558,17 @@ bool QPngHandlerPrivate::readPngImage(QImage *outImage)
         colorSpaceState = GammaChrm;
     }
 
-    if (!setup_qt(*outImage, png_ptr, info_ptr)) {
+    // Without interlacing, rows arrive top to bottom and decoding can stop
+    // after the last row of the clip rect. Only the clipped part of each
+    // row is kept, which needs pixels that are whole bytes.
+    const QRect imageRect(0, 0, png_get_image_width(png_ptr, info_ptr),
+                          png_get_image_height(png_ptr, info_ptr));
+    const bool clipRows = clipRect.isValid() && clipRect != imageRect
+            && imageRect.contains(clipRect)
+            && png_get_interlace_type(png_ptr, info_ptr) == PNG_INTERLACE_NONE
+            && readImageFormat() != QImage::Format_Mono;
+
+    if (!setup_qt(*outImage, png_ptr, info_ptr, clipRows ? clipRect.size() : QSize())) {
         png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
         png_ptr = nullptr;
         delete[] row_pointers;
@@ -540,12 +588,31 @@ bool QPngHandlerPrivate::readPngImage(QImage *outImage)
     png_get_oFFs(png_ptr, info_ptr, &offset_x, &offset_y, &unit_type);
     uchar *data = outImage->bits();
     qsizetype bpl = outImage->bytesPerLine();
-    row_pointers = new png_bytep[height];
+    if (clipRows) {
+        const qsizetype rowBytes = png_get_rowbytes(png_ptr, info_ptr);
+        const int bytesPerPixel = outImage->depth() / 8;
+        const qsizetype clipOffset = qsizetype(clipRect.x()) * bytesPerPixel;
+        const qsizetype clipBytes = qsizetype(clipRect.width()) * bytesPerPixel;
+        rowBuffer.resize(rowBytes);
+        png_bytep row = reinterpret_cast<png_bytep>(rowBuffer.data());
+        // The rows below the clip rect are still inflated, since text
+        // chunks may follow the image data.
+        for (int y = 0; y < int(height); ++y) {
+            png_read_row(png_ptr, row, nullptr);
+            if (y >= clipRect.top() && y <= clipRect.bottom())
+                memcpy(data + (y - clipRect.top()) * bpl, row + clipOffset, clipBytes);
+        }
+        rowBuffer.clear();
+        width = clipRect.width();
+        height = clipRect.height();
+    } else {
+        row_pointers = new png_bytep[height];
 
-    for (uint y = 0; y < height; y++)
-        row_pointers[y] = data + y * bpl;
+        for (uint y = 0; y < height; y++)
+            row_pointers[y] = data + y * bpl;
 
-    png_read_image(png_ptr, row_pointers);
+        png_read_image(png_ptr, row_pointers);
+    }
 
     outImage->setDotsPerMeterX(png_get_x_pixels_per_meter(png_ptr,info_ptr));
     outImage->setDotsPerMeterY(png_get_y_pixels_per_meter(png_ptr,info_ptr));
@@ -567,9 +634,11 @@ bool QPngHandlerPrivate::readPngImage(QImage *outImage)
         }
     }
 
+    if (clipRect.isValid() && !clipRows)
+        *outImage = outImage->copy(clipRect);
+
     state = ReadingEnd;
     png_read_end(png_ptr, end_info);
-
     readPngTexts(end_info);
     for (int i = 0; i < readTexts.size()-1; i+=2)
         outImage->setText(readTexts.at(i), readTexts.at(i+1));
@@ -586,6 +655,124 @@ bool QPngHandlerPrivate::readPngImage(QImage *outImage)
     return true;
 }
 
+bool QPngHandlerPrivate::beginScanlineRead(QSize *size, QImage::Format *format, QList<QRgb> *colorTable)
+{
+    if (state == Error)
+        return false;
+
+    if (state == Ready && !readPngHeader()) {
+        state = Error;
+        return false;
+    }
+
+    // Interlaced images only have their final rows after the last pass.
+    if (state != ReadHeader || png_get_interlace_type(png_ptr, info_ptr) != PNG_INTERLACE_NONE)
+        return false;
+
+    if (setjmp(png_jmpbuf(png_ptr))) {
+        png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
+        png_ptr = nullptr;
+        state = Error;
+        return false;
+    }
+
+    if (gamma != 0.0 && fileGamma != 0.0)
+        png_set_gamma(png_ptr, 1.0f / gamma, fileGamma);
+
+    // A single row image tells the format and color table the rows are
+    // transformed to.
+    const int width = png_get_image_width(png_ptr, info_ptr);
+    QImage row;
+    if (!setup_qt(row, png_ptr, info_ptr, QSize(width, 1))) {
+        png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
+        png_ptr = nullptr;
+        state = Error;
+        return false;
+    }
+
+    *size = QSize(width, png_get_image_height(png_ptr, info_ptr));
+    *format = row.format();
+    *colorTable = row.colorTable();
+    scanline = 0;
+    state = ReadingScanlines;
+    return true;
+}
+
+int QPngHandlerPrivate::readScanlines(uchar *buffer, qsizetype bytesPerLine, int count)
+{
+    if (state != ReadingScanlines)
+        return -1;
+
+    if (setjmp(png_jmpbuf(png_ptr))) {
+        png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
+        png_ptr = nullptr;
+        state = Error;
+        return -1;
+    }
+
+    const int height = png_get_image_height(png_ptr, info_ptr);
+    const bool checkPalette = png_get_color_type(png_ptr, info_ptr) == PNG_COLOR_TYPE_PALETTE
+            && png_get_bit_depth(png_ptr, info_ptr) != 1;
+    const int width = png_get_image_width(png_ptr, info_ptr);
+    int num_palette = 0;
+    png_colorp palette;
+    if (checkPalette)
+        png_get_PLTE(png_ptr, info_ptr, &palette, &num_palette);
+
+    const int rows = qMin(count, height - scanline);
+    for (int y = 0; y < rows; ++y) {
+        uchar *row = buffer + y * bytesPerLine;
+        png_read_row(png_ptr, row, nullptr);
+        if (checkPalette) {
+            // sanity check palette entries
+            for (int x = 0; x < width; ++x) {
+                if (row[x] >= num_palette)
+                    row[x] = 0;
+            }
+        }
+    }
+    scanline += rows;
+
+    if (scanline == height) {
+        state = ReadingEnd;
+        png_read_end(png_ptr, end_info);
+        png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
+        png_ptr = nullptr;
+        state = Ready;
+    }
+    return rows;
+}
+
+bool QPngHandlerPrivate::beginScanlineWrite(QSize size, QImage::Format *format)
+{
+    delete scanlineWriter;
+    scanlineWriter = new QPNGImageWriter(q->device());
+    scanlineWriter->setGamma(gamma);
+    if (!scanlineWriter->beginScanlineWrite(size, format,
+                                            qt_png_compression_level(compression, quality),
+                                            description)) {
+        delete scanlineWriter;
+        scanlineWriter = nullptr;
+        return false;
+    }
+    return true;
+}
+
+bool QPngHandlerPrivate::writeScanlines(const uchar *buffer, qsizetype bytesPerLine, int count)
+{
+    return scanlineWriter && scanlineWriter->writeScanlines(buffer, bytesPerLine, count);
+}
+
+bool QPngHandlerPrivate::endScanlineWrite()
+{
+    if (!scanlineWriter)
+        return false;
+    const bool result = scanlineWriter->endScanlineWrite();
+    delete scanlineWriter;
+    scanlineWriter = nullptr;
+    return result;
+}
+
 QImage::Format QPngHandlerPrivate::readImageFormat()
 {
         QImage::Format format = QImage::Format_Invalid;
@@ -641,6 +828,8 @@ QPNGImageWriter::QPNGImageWriter(QIODevice* iod) :
 
 QPNGImageWriter::~QPNGImageWriter()
 {
+    if (scanline_ptr)
+        png_destroy_write_struct(&scanline_ptr, &scanline_info);
 }
 
 void QPNGImageWriter::setDisposalMethod(DisposalMethod dm)
@@ -663,6 +852,45 @@ void QPNGImageWriter::setGamma(float g)
     gamma = g;
 }
 
+static void set_compression_level(png_structp png_ptr, int compression)
+{
+    if (compression >= 0) {
+        if (compression > 9) {
+            qCWarning(lcImageIo, "PNG: Compression %d out of range", compression);
+            compression = 9;
+        }
+        png_set_compression_level(png_ptr, compression);
+    }
+}
+
+static void set_color_space(png_structp png_ptr, png_infop info_ptr, QColorSpace cs, float gamma)
+{
+#ifdef PNG_iCCP_SUPPORTED
+    // Support the old gamma making it override transferfunction (if possible)
+    if (cs.isValid() && gamma != 0.0 && !qFuzzyCompare(cs.gamma(), 1.0f / gamma))
+        cs = cs.withTransferFunction(QColorSpace::TransferFunction::Gamma, 1.0f / gamma);
+    QByteArray iccProfile = cs.iccProfile();
+    if (!iccProfile.isEmpty()) {
+        QByteArray iccProfileName = cs.description().toLatin1();
+        if (iccProfileName.isEmpty())
+            iccProfileName = QByteArrayLiteral("Custom");
+        png_set_iCCP(png_ptr, info_ptr,
+             #if PNG_LIBPNG_VER < 10500
+                     iccProfileName.data(), PNG_COMPRESSION_TYPE_BASE, iccProfile.data(),
+             #else
+                     iccProfileName.constData(), PNG_COMPRESSION_TYPE_BASE,
+                     (png_const_bytep)iccProfile.constData(),
+             #endif
+                     iccProfile.size());
+    } else
+#else
+    Q_UNUSED(cs);
+#endif
+    if (gamma != 0.0) {
+        png_set_gAMA(png_ptr, info_ptr, 1.0/gamma);
+    }
+}
+
 static void set_text(const QImage &image, png_structp png_ptr, png_infop info_ptr,
                      const QString &description)
 {
@@ -757,14 +985,7 @@ bool QPNGImageWriter::writeImage(const QImage& image, int compression_in, const
         return false;
     }
 
-    int compression = compression_in;
-    if (compression >= 0) {
-        if (compression > 9) {
-            qCWarning(lcImageIo, "PNG: Compression %d out of range", compression);
-            compression = 9;
-        }
-        png_set_compression_level(png_ptr, compression);
-    }
+    set_compression_level(png_ptr, compression_in);
 
     png_set_write_fn(png_ptr, (void*)this, qpiw_write_fn, qpiw_flush_fn);
 
@@ -805,29 +1026,7 @@ bool QPNGImageWriter::writeImage(const QImage& image, int compression_in, const
                  bpc, // per channel
                  color_type, 0, 0, 0);       // sets #channels
 
-#ifdef PNG_iCCP_SUPPORTED
-    QColorSpace cs = image.colorSpace();
-    // Support the old gamma making it override transferfunction (if possible)
-    if (cs.isValid() && gamma != 0.0 && !qFuzzyCompare(cs.gamma(), 1.0f / gamma))
-        cs = cs.withTransferFunction(QColorSpace::TransferFunction::Gamma, 1.0f / gamma);
-    QByteArray iccProfile = cs.iccProfile();
-    if (!iccProfile.isEmpty()) {
-        QByteArray iccProfileName = cs.description().toLatin1();
-        if (iccProfileName.isEmpty())
-            iccProfileName = QByteArrayLiteral("Custom");
-        png_set_iCCP(png_ptr, info_ptr,
-             #if PNG_LIBPNG_VER < 10500
-                     iccProfileName.data(), PNG_COMPRESSION_TYPE_BASE, iccProfile.data(),
-             #else
-                     iccProfileName.constData(), PNG_COMPRESSION_TYPE_BASE,
-                     (png_const_bytep)iccProfile.constData(),
-             #endif
-                     iccProfile.size());
-    } else
-#endif
-    if (gamma != 0.0) {
-        png_set_gAMA(png_ptr, info_ptr, 1.0/gamma);
-    }
+    set_color_space(png_ptr, info_ptr, image.colorSpace(), gamma);
 
     if (image.format() == QImage::Format_MonoLSB)
        png_set_packswap(png_ptr);
@@ -1007,33 +1206,104 @@ bool QPNGImageWriter::writeImage(const QImage& image, int compression_in, const
     return true;
 }
 
-static bool write_png_image(const QImage &image, QIODevice *device,
-                            int compression, int quality, float gamma, const QString &description)
+bool QPNGImageWriter::beginScanlineWrite(QSize size, QImage::Format *format, int compression,
+                                         const QString &description)
 {
-    // quality is used for backward compatibility, maps to compression
+    scanline_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+    if (!scanline_ptr)
+        return false;
+    png_set_error_fn(scanline_ptr, nullptr, nullptr, qt_png_warning);
+#ifdef PNG_BENIGN_ERRORS_SUPPORTED
+    png_set_benign_errors(scanline_ptr, 1);
+#endif
+    scanline_info = png_create_info_struct(scanline_ptr);
+    if (!scanline_info) {
+        png_destroy_write_struct(&scanline_ptr, nullptr);
+        return false;
+    }
 
-    QPNGImageWriter writer(device);
-    if (compression >= 0)
-        compression = qMin(compression, 100);
-    else if (quality >= 0)
-        compression = 100 - qMin(quality, 100);
+    if (setjmp(png_jmpbuf(scanline_ptr))) {
+        png_destroy_write_struct(&scanline_ptr, &scanline_info);
+        return false;
+    }
 
-    if (compression >= 0)
-        compression = (compression * 9) / 91; // map [0,100] -> [0,9]
+    set_compression_level(scanline_ptr, compression);
+    png_set_write_fn(scanline_ptr, (void*)this, qpiw_write_fn, qpiw_flush_fn);
+
+    // Rows are written as 8-bit gray, RGB or RGBA.
+    int color_type = PNG_COLOR_TYPE_RGB;
+    if (*format == QImage::Format_Grayscale8) {
+        color_type = PNG_COLOR_TYPE_GRAY;
+    } else if (QImage::toPixelFormat(*format).alphaUsage() == QPixelFormat::UsesAlpha) {
+        color_type = PNG_COLOR_TYPE_RGB_ALPHA;
+        *format = QImage::Format_RGBA8888;
+    } else {
+        *format = QImage::Format_RGB888;
+    }
+    png_set_IHDR(scanline_ptr, scanline_info, size.width(), size.height(), 8, color_type,
+                 PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
+    // The rows carry no color space, so only the gamma option applies.
+    set_color_space(scanline_ptr, scanline_info, QColorSpace(), gamma);
+    set_text(QImage(), scanline_ptr, scanline_info, description);
+    png_write_info(scanline_ptr, scanline_info);
+    scanlines_written = 0;
+    return true;
+}
+
+bool QPNGImageWriter::writeScanlines(const uchar *buffer, qsizetype bytesPerLine, int count)
+{
+    if (!scanline_ptr)
+        return false;
+
+    if (setjmp(png_jmpbuf(scanline_ptr))) {
+        png_destroy_write_struct(&scanline_ptr, &scanline_info);
+        return false;
+    }
+
+    for (int y = 0; y < count; ++y)
+        png_write_row(scanline_ptr, const_cast<png_bytep>(buffer + y * bytesPerLine));
+    scanlines_written += count;
+    return true;
+}
+
+bool QPNGImageWriter::endScanlineWrite()
+{
+    if (!scanline_ptr)
+        return false;
+
+    if (setjmp(png_jmpbuf(scanline_ptr))) {
+        png_destroy_write_struct(&scanline_ptr, &scanline_info);
+        return false;
+    }
 
+    const bool complete = scanlines_written == int(png_get_image_height(scanline_ptr, scanline_info));
+    if (complete) {
+        png_write_end(scanline_ptr, scanline_info);
+        frames_written++;
+    }
+    png_destroy_write_struct(&scanline_ptr, &scanline_info);
+    return complete;
+}
+
+static bool write_png_image(const QImage &image, QIODevice *device,
+                            int compression, int quality, float gamma, const QString &description)
+{
+    QPNGImageWriter writer(device);
     writer.setGamma(gamma);
-    return writer.writeImage(image, compression, description);
+    return writer.writeImage(image, qt_png_compression_level(compression, quality), description);
 }
 
 QPngHandler::QPngHandler()
     : d(new QPngHandlerPrivate(this))
 {
+    QImageIOHandlerPrivate::setScanlineHandler(this, this);
 }
 
 QPngHandler::~QPngHandler()
 {
     if (d->png_ptr)
         png_destroy_read_struct(&d->png_ptr, &d->info_ptr, &d->end_info);
+    delete d->scanlineWriter;
     delete d;
 }
 
@@ -1072,6 +1342,33 @@ bool QPngHandler::write(const QImage &image)
     return write_png_image(image, device(), d->compression, d->quality, d->gamma, d->description);
 }
 
+bool QPngHandler::beginScanlineRead(QSize *size, QImage::Format *format, QList<QRgb> *colorTable)
+{
+    if (!canRead())
+        return false;
+    return d->beginScanlineRead(size, format, colorTable);
+}
+
+int QPngHandler::readScanlines(uchar *buffer, qsizetype bytesPerLine, int count)
+{
+    return d->readScanlines(buffer, bytesPerLine, count);
+}
+
+bool QPngHandler::beginScanlineWrite(QSize size, QImage::Format *format)
+{
+    return d->beginScanlineWrite(size, format);
+}
+
+bool QPngHandler::writeScanlines(const uchar *buffer, qsizetype bytesPerLine, int count)
+{
+    return d->writeScanlines(buffer, bytesPerLine, count);
+}
+
+bool QPngHandler::endScanlineWrite()
+{
+    return d->endScanlineWrite();
+}
+
 bool QPngHandler::supportsOption(ImageOption option) const
 {
     return option == Gamma
@@ -1079,7 +1376,8 @@ bool QPngHandler::supportsOption(ImageOption option) const
         || option == ImageFormat
         || option == Quality
         || option == CompressionRatio
-        || option == Size;
+        || option == Size
+        || (option == ClipRect && device() && device()->isReadable());
 }
 
 QVariant QPngHandler::option(ImageOption option) const
@@ -1102,6 +1400,8 @@ QVariant QPngHandler::option(ImageOption option) const
                      png_get_image_height(d->png_ptr, d->info_ptr));
     else if (option == ImageFormat)
         return d->readImageFormat();
+    else if (option == ClipRect)
+        return d->clipRect;
     return QVariant();
 }
 
@@ -1115,6 +1415,8 @@ void QPngHandler::setOption(ImageOption option, const QVariant &value)
         d->compression = value.toInt();
     else if (option == Description)
         d->description = value.toString();
+    else if (option == ClipRect)
+        d->clipRect = value.toRect();
 }
 
 QT_END_NAMESPACE
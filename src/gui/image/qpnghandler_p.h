@@ -17,13 +17,14 @@
 
 #include <QtGui/private/qtguiglobal_p.h>
 #include "QtGui/qimageiohandler.h"
+#include "private/qimageiohandler_p.h"
 
 #ifndef QT_NO_IMAGEFORMAT_PNG
 
 QT_BEGIN_NAMESPACE
 
 class QPngHandlerPrivate;
-class QPngHandler : public QImageIOHandler
+class QPngHandler : public QImageIOHandler, public QImageScanlineHandler
 {
 public:
     QPngHandler();
@@ -39,6 +40,12 @@ public:
 
     static bool canRead(QIODevice *device);
 
+    bool beginScanlineRead(QSize *size, QImage::Format *format, QList<QRgb> *colorTable) override;
+    int readScanlines(uchar *buffer, qsizetype bytesPerLine, int count) override;
+    bool beginScanlineWrite(QSize size, QImage::Format *format) override;
+    bool writeScanlines(const uchar *buffer, qsizetype bytesPerLine, int count) override;
+    bool endScanlineWrite() override;
+
 private:
     QPngHandlerPrivate *d;
 };
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include "private/qppmhandler_p.h"
+#include "private/qimageiohandler_p.h"
 
 #ifndef QT_NO_IMAGEFORMAT_PPM
 
@@ -107,36 +108,38 @@ static inline QRgb scale_pbm_color(quint16 mx, quint16 rv, quint16 gv, quint16 b
     return QRgba64::fromRgba64((rv * 0xffffu) / mx, (gv * 0xffffu) / mx, (bv * 0xffffu) / mx, 0xffff).toArgb32();
 }
 
-static bool read_pbm_body(QIODevice *device, char type, int w, int h, int mcc, QImage *outImage)
+static QImage::Format pbm_format(char type)
 {
-    int nbits, y;
-    qsizetype pbm_bpl;
-    bool raw;
-
-    QImage::Format format;
     switch (type) {
         case '1':                                // ascii PBM
         case '4':                                // raw PBM
-            nbits = 1;
-            format = QImage::Format_Mono;
-            break;
+            return QImage::Format_Mono;
         case '2':                                // ascii PGM
         case '5':                                // raw PGM
-            nbits = 8;
-            format = QImage::Format_Grayscale8;
-            break;
+            return QImage::Format_Grayscale8;
         case '3':                                // ascii PPM
         case '6':                                // raw PPM
-            nbits = 32;
-            format = QImage::Format_RGB32;
-            break;
+            return QImage::Format_RGB32;
         default:
-            return false;
+            return QImage::Format_Invalid;
     }
-    raw = type >= '4';
+}
 
-    if (!QImageIOHandler::allocateImage(QSize(w, h), format, outImage))
+static const QList<QRgb> pbm_color_table = { qRgb(255, 255, 255), qRgb(0, 0, 0) };
+
+// Reads the next h rows of the image into bits, which has bpl bytes per row.
+static bool read_pbm_rows(QIODevice *device, char type, int w, int h, int mcc,
+                          uchar *bits, qsizetype bpl)
+{
+    int y;
+    qsizetype pbm_bpl;
+    bool raw;
+
+    const QImage::Format format = pbm_format(type);
+    if (format == QImage::Format_Invalid)
         return false;
+    const int nbits = QImage::toPixelFormat(format).bitsPerPixel();
+    raw = type >= '4';
 
     pbm_bpl = (qsizetype(w) * nbits + 7) / 8;   // bytes per scanline in PBM
 
@@ -151,7 +154,7 @@ static bool read_pbm_body(QIODevice *device, char type, int w, int h, int mcc, Q
                     delete[] buf24;
                     return false;
                 }
-                p = (QRgb *)outImage->scanLine(y);
+                p = (QRgb *)(bits + y * bpl);
                 end = p + w;
                 b = buf24;
                 while (p < end) {
@@ -182,7 +185,7 @@ static bool read_pbm_body(QIODevice *device, char type, int w, int h, int mcc, Q
                     delete[] buf16;
                     return false;
                 }
-                uchar *p = outImage->scanLine(y);
+                uchar *p = bits + y * bpl;
                 uchar *end = p + w;
                 uchar *b = buf16;
                 while (p < end) {
@@ -193,7 +196,7 @@ static bool read_pbm_body(QIODevice *device, char type, int w, int h, int mcc, Q
             delete[] buf16;
         } else {                                // type 4,5
             for (y=0; y<h; y++) {
-                uchar *p = outImage->scanLine(y);
+                uchar *p = bits + y * bpl;
                 if (device->read((char *)p, pbm_bpl) != pbm_bpl)
                     return false;
                 if (nbits == 8 && mcc < 255) {
@@ -207,7 +210,7 @@ static bool read_pbm_body(QIODevice *device, char type, int w, int h, int mcc, Q
         qsizetype n;
         bool ok = true;
         for (y = 0; y < h && ok; y++) {
-            p = outImage->scanLine(y);
+            p = bits + y * bpl;
             n = pbm_bpl;
             if (nbits == 1) {
                 int b;
@@ -259,11 +262,23 @@ static bool read_pbm_body(QIODevice *device, char type, int w, int h, int mcc, Q
             return false;
     }
 
-    if (format == QImage::Format_Mono) {
-        outImage->setColorCount(2);
-        outImage->setColor(0, qRgb(255,255,255));   // white
-        outImage->setColor(1, qRgb(0,0,0));         // black
-    }
+    return true;
+}
+
+static bool read_pbm_body(QIODevice *device, char type, int w, int h, int mcc, QImage *outImage)
+{
+    const QImage::Format format = pbm_format(type);
+    if (format == QImage::Format_Invalid)
+        return false;
+
+    if (!QImageIOHandler::allocateImage(QSize(w, h), format, outImage))
+        return false;
+
+    if (!read_pbm_rows(device, type, w, h, mcc, outImage->bits(), outImage->bytesPerLine()))
+        return false;
+
+    if (format == QImage::Format_Mono)
+        outImage->setColorTable(pbm_color_table);   // white, black
 
     return true;
 }
@@ -422,6 +437,7 @@ static bool write_pbm_image(QIODevice *out, const QImage &sourceImage, QByteArra
 QPpmHandler::QPpmHandler()
     : state(Ready)
 {
+    QImageIOHandlerPrivate::setScanlineHandler(this, this);
 }
 
 bool QPpmHandler::readHeader()
@@ -499,6 +515,84 @@ bool QPpmHandler::write(const QImage &image)
     return write_pbm_image(device(), image, subType);
 }
 
+bool QPpmHandler::beginScanlineRead(QSize *size, QImage::Format *format, QList<QRgb> *colorTable)
+{
+    if (state == Error || (state == Ready && !readHeader())) {
+        state = Error;
+        return false;
+    }
+    *size = QSize(width, height);
+    *format = pbm_format(type);
+    if (*format == QImage::Format_Mono)
+        *colorTable = pbm_color_table;
+    scanline = 0;
+    return *format != QImage::Format_Invalid;
+}
+
+int QPpmHandler::readScanlines(uchar *buffer, qsizetype bytesPerLine, int count)
+{
+    if (state != ReadHeader)
+        return -1;
+    count = qMin(count, height - scanline);
+    if (!read_pbm_rows(device(), type, width, count, mcc, buffer, bytesPerLine)) {
+        state = Error;
+        return -1;
+    }
+    scanline += count;
+    if (scanline == height)
+        state = Ready;
+    return count;
+}
+
+bool QPpmHandler::beginScanlineWrite(QSize size, QImage::Format *format)
+{
+    // Rows are written raw: bitmaps are thresholded from gray rows, and
+    // pixmaps are written from RGB888 rows as they are.
+    const QByteArrayView kind = QByteArrayView(subType).left(3);
+    QByteArray header = kind == "pbm" ? "P4\n" : kind == "pgm" ? "P5\n" : "P6\n";
+    header += QByteArray::number(size.width()) + ' ' + QByteArray::number(size.height()) + '\n';
+    if (kind != "pbm")
+        header += "255\n";
+    type = header.at(1);
+    *format = type == '6' ? QImage::Format_RGB888 : QImage::Format_Grayscale8;
+    width = size.width();
+    height = size.height();
+    scanline = 0;
+    return device()->write(header) == header.size();
+}
+
+bool QPpmHandler::writeScanlines(const uchar *buffer, qsizetype bytesPerLine, int count)
+{
+    if (type == '4') {
+        QByteArray row((width + 7) / 8, Qt::Uninitialized);
+        for (int y = 0; y < count; ++y) {
+            const uchar *gray = buffer + y * bytesPerLine;
+            row.fill(0);
+            for (int x = 0; x < width; ++x) {
+                if (gray[x] < 128)
+                    row[x >> 3] = char(row.at(x >> 3) | (0x80 >> (x & 7)));
+            }
+            if (device()->write(row) != row.size())
+                return false;
+        }
+    } else {
+        const qsizetype rowBytes = qsizetype(width) * (type == '5' ? 1 : 3);
+        for (int y = 0; y < count; ++y) {
+            if (device()->write(reinterpret_cast<const char *>(buffer + y * bytesPerLine), rowBytes)
+                    != rowBytes) {
+                return false;
+            }
+        }
+    }
+    scanline += count;
+    return true;
+}
+
+bool QPpmHandler::endScanlineWrite()
+{
+    return scanline == height;
+}
+
 bool QPpmHandler::supportsOption(ImageOption option) const
 {
     return option == SubType
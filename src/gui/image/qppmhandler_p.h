@@ -17,13 +17,14 @@
 
 #include <QtGui/private/qtguiglobal_p.h>
 #include "QtGui/qimageiohandler.h"
+#include "private/qimageiohandler_p.h"
 
 #ifndef QT_NO_IMAGEFORMAT_PPM
 
 QT_BEGIN_NAMESPACE
 
 class QByteArray;
-class QPpmHandler : public QImageIOHandler
+class QPpmHandler : public QImageIOHandler, public QImageScanlineHandler
 {
 public:
     QPpmHandler();
@@ -37,6 +38,12 @@ public:
     void setOption(ImageOption option, const QVariant &value) override;
     bool supportsOption(ImageOption option) const override;
 
+    bool beginScanlineRead(QSize *size, QImage::Format *format, QList<QRgb> *colorTable) override;
+    int readScanlines(uchar *buffer, qsizetype bytesPerLine, int count) override;
+    bool beginScanlineWrite(QSize size, QImage::Format *format) override;
+    bool writeScanlines(const uchar *buffer, qsizetype bytesPerLine, int count) override;
+    bool endScanlineWrite() override;
+
 private:
     bool readHeader();
     enum State {
@@ -49,6 +56,7 @@ private:
     int width;
     int height;
     int mcc;
+    int scanline = 0;
     mutable QByteArray subType;
 };
 
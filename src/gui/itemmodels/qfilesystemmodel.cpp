@@ -595,7 +595,7 @@ QModelIndex QFileSystemModel::parent(const QModelIndex &index) const
     // get the parent's row
     QFileSystemModelPrivate::QFileSystemNode *grandParentNode = parentNode->parent;
     Q_ASSERT(grandParentNode->children.contains(parentNode->fileName));
-    int visualRow = d->translateVisibleLocation(grandParentNode, grandParentNode->visibleLocation(grandParentNode->children.value(parentNode->fileName)->fileName));
+    int visualRow = d->translateVisibleLocation(grandParentNode, grandParentNode->visibleLocation(parentNode));
     if (visualRow == -1)
         return QModelIndex();
     return createIndex(visualRow, 0, parentNode);
@@ -618,7 +618,7 @@ QModelIndex QFileSystemModelPrivate::index(const QFileSystemModelPrivate::QFileS
     if (!node->isVisible)
         return QModelIndex();
 
-    int visualRow = translateVisibleLocation(parentNode, parentNode->visibleLocation(node->fileName));
+    int visualRow = translateVisibleLocation(parentNode, parentNode->visibleLocation(node));
     return q->createIndex(visualRow, column, const_cast<QFileSystemNode*>(node));
 }
 
@@ -917,7 +917,7 @@ bool QFileSystemModel::setData(const QModelIndex &idx, const QVariant &value, in
 
         QFileSystemModelPrivate::QFileSystemNode *indexNode = d->node(idx);
         QFileSystemModelPrivate::QFileSystemNode *parentNode = indexNode->parent;
-        int visibleLocation = parentNode->visibleLocation(parentNode->children.value(indexNode->fileName)->fileName);
+        int visibleLocation = parentNode->visibleLocation(indexNode);
 
         parentNode->visibleChildren.removeAt(visibleLocation);
         std::unique_ptr<QFileSystemModelPrivate::QFileSystemNode> nodeToRename(parentNode->children.take(oldName));
@@ -930,6 +930,7 @@ bool QFileSystemModel::setData(const QModelIndex &idx, const QVariant &value, in
         parentNode->children[newName] = nodeToRename.release();
         parentNode->visibleChildren.insert(visibleLocation, newName);
 
+        d->fullSortNeeded = true;
         d->delayedSort();
         emit fileRenamed(parentPath, oldName, newName);
     }
@@ -1114,25 +1115,45 @@ void QFileSystemModelPrivate::sortChildren(int column, const QModelIndex &parent
     if (indexNode->children.size() == 0)
         return;
 
-    QList<QFileSystemModelPrivate::QFileSystemNode *> values;
-
-    for (auto iterator = indexNode->children.constBegin(), cend = indexNode->children.constEnd(); iterator != cend; ++iterator) {
-        if (filtersAcceptsNode(iterator.value())) {
-            values.append(iterator.value());
+    // Unless the order or the filters changed, only the files that arrived
+    // since the last sort are sorted, and then merged into the ones that are
+    // sorted already.
+    const bool merge = !fullSortNeeded && column == sortColumn;
+    if (!merge || indexNode->dirtyChildrenIndex != -1) {
+        QList<QFileSystemModelPrivate::QFileSystemNode *> values;
+        QFileSystemModelSorter ms(column);
+        if (merge) {
+            values.reserve(indexNode->visibleChildren.size());
+            qsizetype sorted = 0;
+            for (qsizetype i = 0; i < indexNode->visibleChildren.size(); ++i) {
+                if (QFileSystemNode *child = indexNode->children.value(indexNode->visibleChildren.at(i))) {
+                    values.append(child);
+                    if (i < indexNode->dirtyChildrenIndex)
+                        ++sorted;
+                }
+            }
+            const auto middle = values.begin() + sorted;
+            std::sort(middle, values.end(), ms);
+            std::inplace_merge(values.begin(), middle, values.end(), ms);
         } else {
-            iterator.value()->isVisible = false;
+            for (auto iterator = indexNode->children.constBegin(), cend = indexNode->children.constEnd(); iterator != cend; ++iterator) {
+                if (filtersAcceptsNode(iterator.value())) {
+                    values.append(iterator.value());
+                } else {
+                    iterator.value()->isVisible = false;
+                }
+            }
+            std::sort(values.begin(), values.end(), ms);
+        }
+        // First update the new visible list
+        indexNode->visibleChildren.clear();
+        //No more dirty item we reset our internal dirty index
+        indexNode->dirtyChildrenIndex = -1;
+        indexNode->visibleChildren.reserve(values.size());
+        for (QFileSystemNode *node : std::as_const(values)) {
+            indexNode->appendVisibleChild(node);
+            node->isVisible = true;
         }
-    }
-    QFileSystemModelSorter ms(column);
-    std::sort(values.begin(), values.end(), ms);
-    // First update the new visible list
-    indexNode->visibleChildren.clear();
-    //No more dirty item we reset our internal dirty index
-    indexNode->dirtyChildrenIndex = -1;
-    indexNode->visibleChildren.reserve(values.size());
-    for (QFileSystemNode *node : std::as_const(values)) {
-        indexNode->visibleChildren.append(node->fileName);
-        node->isVisible = true;
     }
 
     if (!disableRecursiveSort) {
@@ -1169,6 +1190,7 @@ void QFileSystemModel::sort(int column, Qt::SortOrder order)
         d->sortChildren(column, index(rootPath()));
         d->sortColumn = column;
         d->forceSort = false;
+        d->fullSortNeeded = false;
     }
     d->sortOrder = order;
 
@@ -1550,6 +1572,7 @@ QModelIndex QFileSystemModel::setRootPath(const QString &newPath)
     fetchMore(newRootIndex);
     emit rootPathChanged(longNewPath);
     d->forceSort = true;
+    d->fullSortNeeded = true;
     d->delayedSort();
     return newRootIndex;
 }
@@ -1623,6 +1646,7 @@ void QFileSystemModel::setFilter(QDir::Filters filters)
     if (changingCaseSensitivity)
         d->rebuildNameFilterRegexps();
     d->forceSort = true;
+    d->fullSortNeeded = true;
     d->delayedSort();
 }
 
@@ -1704,6 +1728,7 @@ void QFileSystemModel::setNameFilterDisables(bool enable)
         return;
     d->nameFilterDisables = enable;
     d->forceSort = true;
+    d->fullSortNeeded = true;
     d->delayedSort();
 }
 
@@ -1742,6 +1767,7 @@ void QFileSystemModel::setNameFilters(const QStringList &filters)
     d->nameFilters = filters;
     d->rebuildNameFilterRegexps();
     d->forceSort = true;
+    d->fullSortNeeded = true;
     d->delayedSort();
 #else
     Q_UNUSED(filters);
@@ -1907,8 +1933,9 @@ void QFileSystemModelPrivate::addVisibleFiles(QFileSystemNode *parentNode, const
         parentNode->dirtyChildrenIndex = parentNode->visibleChildren.size();
 
     for (const auto &newFile : newFiles) {
-        parentNode->visibleChildren.append(newFile);
-        parentNode->children.value(newFile)->isVisible = true;
+        QFileSystemNode *node = parentNode->children.value(newFile);
+        parentNode->appendVisibleChild(node);
+        node->isVisible = true;
     }
     if (!indexHidden)
       q->endInsertRows();
@@ -1933,6 +1960,8 @@ void QFileSystemModelPrivate::removeVisibleFile(QFileSystemNode *parentNode, int
                                        translateVisibleLocation(parentNode, vLocation));
     parentNode->children.value(parentNode->visibleChildren.at(vLocation))->isVisible = false;
     parentNode->visibleChildren.removeAt(vLocation);
+    if (vLocation < parentNode->dirtyChildrenIndex)
+        --parentNode->dirtyChildrenIndex;
     if (!indexHidden)
         q->endRemoveRows();
 }
@@ -1981,6 +2010,7 @@ void QFileSystemModelPrivate::fileSystemChanged(const QString &path,
         }
 
         if (*node != info ) {
+            const bool wasDir = node->isDir();
             node->populate(info);
             bypassFilters.remove(node);
             // brand new information.
@@ -1989,6 +2019,9 @@ void QFileSystemModelPrivate::fileSystemChanged(const QString &path,
                     newFiles.append(fileName);
                 } else {
                     rowsToUpdate.append(fileName);
+                    // directories are sorted first
+                    if (sortColumn != NameColumn || node->isDir() != wasDir)
+                        fullSortNeeded = true;
                 }
             } else {
                 if (node->isVisible) {
@@ -2002,44 +2035,28 @@ void QFileSystemModelPrivate::fileSystemChanged(const QString &path,
     }
 
     // bundle up all of the changed signals into as few as possible.
-    std::sort(rowsToUpdate.begin(), rowsToUpdate.end());
-    QString min;
-    QString max;
+    QList<int> visibleRows;
+    visibleRows.reserve(rowsToUpdate.size());
     for (const QString &value : std::as_const(rowsToUpdate)) {
-        //##TODO is there a way to bundle signals with QString as the content of the list?
-        /*if (min.isEmpty()) {
-            min = value;
-            if (i != rowsToUpdate.count() - 1)
-                continue;
-        }
-        if (i != rowsToUpdate.count() - 1) {
-            if ((value == min + 1 && max.isEmpty()) || value == max + 1) {
-                max = value;
-                continue;
-            }
-        }*/
-        max = value;
-        min = value;
-        int visibleMin = parentNode->visibleLocation(min);
-        int visibleMax = parentNode->visibleLocation(max);
-        if (visibleMin >= 0
-            && visibleMin < parentNode->visibleChildren.size()
-            && parentNode->visibleChildren.at(visibleMin) == min
-            && visibleMax >= 0) {
-            // don't use NumColumns here, a subclass might override columnCount
-            const int lastColumn = q->columnCount(parentIndex) - 1;
-            const QModelIndex top = q->index(translateVisibleLocation(parentNode, visibleMin),
-                                             QFileSystemModelPrivate::NameColumn, parentIndex);
-            const QModelIndex bottom = q->index(translateVisibleLocation(parentNode, visibleMax),
-                                                lastColumn, parentIndex);
-            // We document that emitting dataChanged with indexes that don't have the
-            // same parent is undefined behavior.
-            Q_ASSERT(bottom.parent() == top.parent());
-            emit q->dataChanged(top, bottom);
-        }
-
-        /*min = QString();
-        max = QString();*/
+        const int visibleLocation = parentNode->visibleLocation(value);
+        if (visibleLocation >= 0)
+            visibleRows.append(translateVisibleLocation(parentNode, visibleLocation));
+    }
+    std::sort(visibleRows.begin(), visibleRows.end());
+    // don't use NumColumns here, a subclass might override columnCount
+    const int lastColumn = visibleRows.isEmpty() ? 0 : q->columnCount(parentIndex) - 1;
+    for (qsizetype first = 0; first < visibleRows.size();) {
+        qsizetype last = first;
+        while (last + 1 < visibleRows.size() && visibleRows.at(last + 1) <= visibleRows.at(last) + 1)
+            ++last;
+        const QModelIndex top = q->index(visibleRows.at(first),
+                                         QFileSystemModelPrivate::NameColumn, parentIndex);
+        const QModelIndex bottom = q->index(visibleRows.at(last), lastColumn, parentIndex);
+        // We document that emitting dataChanged with indexes that don't have the
+        // same parent is undefined behavior.
+        Q_ASSERT(bottom.parent() == top.parent());
+        emit q->dataChanged(top, bottom);
+        first = last + 1;
     }
 
     if (newFiles.size() > 0) {
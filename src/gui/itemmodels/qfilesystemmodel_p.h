@@ -147,8 +147,39 @@ public:
 
         // children shouldn't normally be accessed directly, use node()
         inline int visibleLocation(const QString &childName) {
+            if (const QFileSystemNode *child = children.value(childName))
+                return visibleLocation(child);
             return visibleChildren.indexOf(childName);
         }
+        // visibleIndex is only a hint; when it is found to be stale, all children
+        // are renumbered at once, so that mapping nodes to rows stays O(1) even in
+        // directories with hundreds of thousands of entries.
+        int visibleLocation(const QFileSystemNode *child) {
+            if (!child->isVisible)
+                return -1;
+            if (!hasVisibleIndex(child)) {
+                reindexVisibleChildren();
+                if (!hasVisibleIndex(child))
+                    return -1;
+            }
+            return child->visibleIndex;
+        }
+        void appendVisibleChild(QFileSystemNode *child) {
+            child->visibleIndex = int(visibleChildren.size());
+            visibleChildren.append(child->fileName);
+        }
+        bool hasVisibleIndex(const QFileSystemNode *child) const {
+            const int hint = child->visibleIndex;
+            return hint >= 0 && hint < visibleChildren.size()
+                    && visibleChildren.at(hint) == child->fileName;
+        }
+        void reindexVisibleChildren() {
+            for (int i = 0; i < visibleChildren.size(); ++i) {
+                if (QFileSystemNode *child = children.value(visibleChildren.at(i)))
+                    child->visibleIndex = i;
+            }
+        }
+
         void updateIcon(QAbstractFileIconProvider *iconProvider, const QString &path) {
             if (!iconProvider)
                 return;
@@ -191,6 +222,7 @@ public:
         QExtendedInformation *info = nullptr;
         QFileSystemNode *parent;
         int dirtyChildrenIndex = -1;
+        int visibleIndex = -1;
         bool populatedChildren = false;
         bool isVisible = false;
     };
@@ -294,6 +326,9 @@ public:
     int sortColumn = 0;
     Qt::SortOrder sortOrder = Qt::AscendingOrder;
     bool forceSort = true;
+    // Unless set, the visible children before dirtyChildrenIndex are still
+    // sorted by sortColumn, and only the ones after it need to be merged in.
+    bool fullSortNeeded = true;
     bool readOnly = true;
     bool setRootPath = false;
     bool nameFilterDisables = true; // false on windows, true on mac and unix
@@ -1489,6 +1489,31 @@ const QRgba64 *QT_FASTCALL fetchRGBA16FToRGBA64PM_avx2(QRgba64 *buffer, const uc
     return buffer;
 }
 
+void QT_FASTCALL storeRGB888FromRGB32_avx2(uchar *dest, const uint *src, int index, int count,
+                                           const QList<QRgb> *, QDitherInfo *)
+{
+    uchar *d = dest + index * 3;
+    // Drop the alpha byte and swap to RGB order within each lane, then move
+    // the two 12-byte halves next to each other.
+    const __m256i shuffleMask = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                                 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m256i permuteMask = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+    int i = 0;
+    for (; i < count - 7; i += 8) {
+        __m256i vs = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        vs = _mm256_shuffle_epi8(vs, shuffleMask);
+        vs = _mm256_permutevar8x32_epi32(vs, permuteMask);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(d + i * 3), _mm256_castsi256_si128(vs));
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(d + i * 3 + 16), _mm256_extracti128_si256(vs, 1));
+    }
+    for (; i < count; ++i) {
+        const uint s = src[i];
+        d[i * 3 + 0] = uchar(s >> 16);
+        d[i * 3 + 1] = uchar(s >> 8);
+        d[i * 3 + 2] = uchar(s);
+    }
+}
+
 void QT_FASTCALL storeRGB16FFromRGB32_avx2(uchar *dest, const uint *src, int index, int count,
                                            const QList<QRgb> *, QDitherInfo *)
 {
@@ -3,6 +3,9 @@
 
 #include <QtCore/qglobal.h>
 #include <QtCore/qmutex.h>
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/private/qthreadpool_p.h>
 
 #define QT_FT_BEGIN_HEADER
 #define QT_FT_END_HEADER
@@ -3559,6 +3562,142 @@ static inline uchar *alignAddress(uchar *address, quintptr alignmentMask)
     return (uchar *)(((quintptr)address + alignmentMask) & ~alignmentMask);
 }
 
+static void qt_collect_spans(int count, const QT_FT_Span *spans, void *userData)
+{
+    auto *buffer = static_cast<std::vector<QT_FT_Span> *>(userData);
+    buffer->insert(buffer->end(), spans, spans + count);
+}
+
+// Renders the part of outline within clipBox with raster and passes the
+// spans to callback. The raster starts out with rasterPool, which must hold
+// MINIMUM_POOL_SIZE bytes; whenever that runs out, rendering continues with
+// a larger pool on the heap, skipping the spans that were already passed on.
+static void qt_render_outline(QT_FT_Raster *raster, uchar *rasterPool, QT_FT_Outline *outline,
+                              const QT_FT_BBox &clipBox, ProcessSpans callback, void *userData)
+{
+    int rasterPoolSize = MINIMUM_POOL_SIZE;
+    uchar *rasterPoolOnHeap = nullptr;
+
+    qt_ft_grays_raster.raster_reset(*raster, rasterPool, rasterPoolSize);
+
+    QT_FT_Raster_Params rasterParams;
+    rasterParams.target = nullptr;
+    rasterParams.source = outline;
+    rasterParams.flags = QT_FT_RASTER_FLAG_CLIP | QT_FT_RASTER_FLAG_AA | QT_FT_RASTER_FLAG_DIRECT;
+    rasterParams.gray_spans = callback;
+    rasterParams.black_spans = nullptr;
+    rasterParams.bit_test = nullptr;
+    rasterParams.bit_set = nullptr;
+    rasterParams.user = userData;
+    rasterParams.clip_box = clipBox;
+
+    int rendered_spans = 0;
+    while (true) {
+        rasterParams.skip_spans = rendered_spans;
+        const int error = qt_ft_grays_raster.raster_render(*raster, &rasterParams);
+
+        // Out of memory, reallocate some more and try again...
+        if (error != -6) // ErrRaster_OutOfMemory from qgrayraster.c
+            break;
+
+        rasterPoolSize *= 2;
+        if (rasterPoolSize > 1024 * 1024) {
+            qWarning("QPainter: Rasterization of primitive failed");
+            break;
+        }
+
+        rendered_spans += q_gray_rendered_spans(*raster);
+
+        free(rasterPoolOnHeap);
+        rasterPoolOnHeap = (uchar *)malloc(rasterPoolSize + 0xf);
+
+        Q_CHECK_PTR(rasterPoolOnHeap); // note: we just freed the old rasterPoolBase. I hope it's not fatal.
+
+        qt_ft_grays_raster.raster_done(*raster);
+        qt_ft_grays_raster.raster_new(raster);
+        qt_ft_grays_raster.raster_reset(*raster, alignAddress(rasterPoolOnHeap, 0xf), rasterPoolSize);
+    }
+
+    free(rasterPoolOnHeap);
+}
+
+// Rasterizes the part of outline within clipBox into spans, with a raster of
+// its own so that several bands can be rendered at the same time.
+static void qt_rasterize_band(QT_FT_Outline *outline, const QT_FT_BBox &clipBox,
+                              std::vector<QT_FT_Span> *spans)
+{
+    QT_FT_Raster raster;
+    if (qt_ft_grays_raster.raster_new(&raster))
+        return;
+
+    uchar rasterPoolOnStack[MINIMUM_POOL_SIZE + 0xf];
+    qt_render_outline(&raster, alignAddress(rasterPoolOnStack, 0xf), outline, clipBox,
+                      qt_collect_spans, spans);
+
+    qt_ft_grays_raster.raster_done(raster);
+}
+
+// Rasterizes a large outline in horizontal bands on the Qt GUI thread pool.
+// The spans of each band are collected and passed to callback in order, so
+// the spans are the same as when rasterizing the outline in one go.
+static bool qt_rasterize_parallel(QT_FT_Outline *outline, const QRect &deviceRect,
+                                  ProcessSpans callback, void *userData)
+{
+    constexpr int MinimumBandHeight = 32;
+
+    const int threshold = qt_parallelPaintThreshold();
+    if (threshold <= 0 || outline->n_points < threshold)
+        return false;
+
+    QThreadPool *threadPool = QThreadPoolPrivate::qtGuiInstance();
+    if (!threadPool || threadPool->maxThreadCount() < 2 || threadPool->contains(QThread::currentThread()))
+        return false;
+
+    // the outline points are in 26.6 fixed point
+    QT_FT_Pos minY = outline->points[0].y;
+    QT_FT_Pos maxY = minY;
+    for (int i = 1; i < outline->n_points; ++i) {
+        minY = qMin(minY, outline->points[i].y);
+        maxY = qMax(maxY, outline->points[i].y);
+    }
+    const int top = qMax(int(minY >> 6), deviceRect.y());
+    const int bottom = qMin(int((maxY + 63) >> 6), deviceRect.y() + deviceRect.height());
+    const int bandCount = qMin(threadPool->maxThreadCount() * 2, (bottom - top) / MinimumBandHeight);
+    if (bandCount < 2)
+        return false;
+
+    std::vector<std::vector<QT_FT_Span>> bands(bandCount);
+    QAtomicInt next;
+    const auto rasterizeBands = [&]() {
+        for (int band = next.fetchAndAddRelaxed(1); band < bandCount; band = next.fetchAndAddRelaxed(1)) {
+            const QT_FT_BBox clipBox = { deviceRect.x(),
+                                         top + int(qint64(bottom - top) * band / bandCount),
+                                         deviceRect.x() + deviceRect.width(),
+                                         top + int(qint64(bottom - top) * (band + 1) / bandCount) };
+            qt_rasterize_band(outline, clipBox, &bands[band]);
+        }
+    };
+
+    const int tasks = qMin(threadPool->maxThreadCount(), bandCount - 1);
+    QSemaphore semaphore;
+    for (int i = 0; i < tasks; ++i) {
+        threadPool->start([&]() {
+            rasterizeBands();
+            semaphore.release(1);
+        });
+    }
+    rasterizeBands();
+    semaphore.acquire(tasks);
+
+    // the same batch size as qgrayraster.c uses
+    constexpr size_t MaximumSpans = 256;
+    for (const std::vector<QT_FT_Span> &spans : bands) {
+        for (size_t i = 0; i < spans.size(); i += MaximumSpans)
+            callback(int(qMin(spans.size() - i, MaximumSpans)), spans.data() + i, userData);
+    }
+    return true;
+}
+
 void QRasterPaintEnginePrivate::rasterize(QT_FT_Outline *outline,
                                           ProcessSpans callback,
                                           void *userData, QRasterBuffer *)
@@ -3582,73 +3721,22 @@ void QRasterPaintEnginePrivate::rasterize(QT_FT_Outline *outline,
         return;
     }
 
+    if (qt_rasterize_parallel(outline, deviceRect, callback, userData))
+        return;
+
     // Initial size for raster pool is MINIMUM_POOL_SIZE so as to
     // minimize memory reallocations. However if initial size for
     // raster pool is changed for lower value, reallocations will
     // occur normally.
-    int rasterPoolSize = MINIMUM_POOL_SIZE;
     uchar rasterPoolOnStack[MINIMUM_POOL_SIZE + 0xf];
-    uchar *rasterPoolBase = alignAddress(rasterPoolOnStack, 0xf);
-    uchar *rasterPoolOnHeap = nullptr;
-
-    qt_ft_grays_raster.raster_reset(*grayRaster.data(), rasterPoolBase, rasterPoolSize);
-
-    void *data = userData;
 
     QT_FT_BBox clip_box = { deviceRect.x(),
                             deviceRect.y(),
                             deviceRect.x() + deviceRect.width(),
                             deviceRect.y() + deviceRect.height() };
 
-    QT_FT_Raster_Params rasterParams;
-    rasterParams.target = nullptr;
-    rasterParams.source = outline;
-    rasterParams.flags = QT_FT_RASTER_FLAG_CLIP;
-    rasterParams.gray_spans = nullptr;
-    rasterParams.black_spans = nullptr;
-    rasterParams.bit_test = nullptr;
-    rasterParams.bit_set = nullptr;
-    rasterParams.user = data;
-    rasterParams.clip_box = clip_box;
-
-    bool done = false;
-    int error;
-
-    int rendered_spans = 0;
-
-    while (!done) {
-
-        rasterParams.flags |= (QT_FT_RASTER_FLAG_AA | QT_FT_RASTER_FLAG_DIRECT);
-        rasterParams.gray_spans = callback;
-        rasterParams.skip_spans = rendered_spans;
-        error = qt_ft_grays_raster.raster_render(*grayRaster.data(), &rasterParams);
-
-        // Out of memory, reallocate some more and try again...
-        if (error == -6) { // ErrRaster_OutOfMemory from qgrayraster.c
-            rasterPoolSize *= 2;
-            if (rasterPoolSize > 1024 * 1024) {
-                qWarning("QPainter: Rasterization of primitive failed");
-                break;
-            }
-
-            rendered_spans += q_gray_rendered_spans(*grayRaster.data());
-
-            free(rasterPoolOnHeap);
-            rasterPoolOnHeap = (uchar *)malloc(rasterPoolSize + 0xf);
-
-            Q_CHECK_PTR(rasterPoolOnHeap); // note: we just freed the old rasterPoolBase. I hope it's not fatal.
-
-            rasterPoolBase = alignAddress(rasterPoolOnHeap, 0xf);
-
-            qt_ft_grays_raster.raster_done(*grayRaster.data());
-            qt_ft_grays_raster.raster_new(grayRaster.data());
-            qt_ft_grays_raster.raster_reset(*grayRaster.data(), rasterPoolBase, rasterPoolSize);
-        } else {
-            done = true;
-        }
-    }
-
-    free(rasterPoolOnHeap);
+    qt_render_outline(grayRaster.data(), alignAddress(rasterPoolOnStack, 0xf), outline, clip_box,
+                      callback, userData);
 }
 
 void QRasterPaintEnginePrivate::updateClipping()
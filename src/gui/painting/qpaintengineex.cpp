@@ -11,6 +11,11 @@
 
 #include <qvarlengtharray.h>
 #include <qdebug.h>
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/private/qthreadpool_p.h>
+
+#include <memory>
 
 
 QT_BEGIN_NAMESPACE
@@ -328,6 +333,172 @@ static void qpaintengineex_cubicTo(qreal c1x, qreal c1y, qreal c2x, qreal c2y, q
     ((StrokeHandler *) data)->types.add(QPainterPath::CurveToDataElement);
 }
 
+static QBasicAtomicInt qt_parallel_paint_threshold = Q_BASIC_ATOMIC_INITIALIZER(-1);
+
+int qt_parallelPaintThreshold()
+{
+    int threshold = qt_parallel_paint_threshold.loadRelaxed();
+    if (threshold < 0) {
+        bool ok = false;
+        threshold = qEnvironmentVariableIntValue("QT_PAINT_PARALLEL_THRESHOLD", &ok);
+        if (!ok || threshold < 0)
+            threshold = 64 * 1024;
+        qt_parallel_paint_threshold.storeRelaxed(threshold);
+    }
+    return threshold;
+}
+
+void qt_setParallelPaintThreshold(int threshold)
+{
+    qt_parallel_paint_threshold.storeRelaxed(threshold);
+}
+
+// Feeds the elements [begin, end) of a path with element types to a stroker,
+// mapping the points through matrix if there is one.
+static void qpaintengineex_strokeElements(QStrokerOps *stroker, const QPainterPath::ElementType *types,
+                                          const qreal *points, int begin, int end, const QTransform *matrix)
+{
+    const auto map = [matrix](const qreal *p) {
+        const QPointF pt(p[0], p[1]);
+        return matrix ? pt * *matrix : pt;
+    };
+
+    for (int i = begin; i < end; ) {
+        const qreal *p = points + 2 * i;
+        switch (types[i]) {
+        case QPainterPath::MoveToElement: {
+            const QPointF pt = map(p);
+            stroker->moveTo(pt.x(), pt.y());
+            ++i;
+            break;
+        }
+        case QPainterPath::LineToElement: {
+            const QPointF pt = map(p);
+            stroker->lineTo(pt.x(), pt.y());
+            ++i;
+            break;
+        }
+        case QPainterPath::CurveToElement: {
+            const QPointF c1 = map(p);
+            const QPointF c2 = map(p + 2);
+            const QPointF e = map(p + 4);
+            stroker->cubicTo(c1.x(), c1.y(), c2.x(), c2.y(), e.x(), e.y());
+            i += 3;
+            break;
+        }
+        default:
+            ++i;
+            break;
+        }
+    }
+}
+
+/*
+    Strokes a path with many subpaths with the solid line stroker on the Qt
+    GUI thread pool, and appends the result to strokeHandler. The stroker
+    outlines each subpath on its own, so the path is split at subpath starts
+    and the outlines are concatenated in order, which gives the same result
+    as stroking the path in one go.
+
+    Dashed lines are not split, as the dash pattern continues across
+    subpaths.
+*/
+bool QPaintEngineExPrivate::strokeParallel(const QVectorPath &path, const QTransform *matrix, uint *flags)
+{
+    constexpr int MinimumChunkSize = 4096;
+
+    const QPainterPath::ElementType *types = path.elements();
+    const int elementCount = path.elementCount();
+    const int threshold = qt_parallelPaintThreshold();
+    if (activeStroker != &stroker || !types || path.hasImplicitClose()
+            || threshold <= 0 || elementCount < qMax(threshold, 2 * MinimumChunkSize)) {
+        return false;
+    }
+
+    QThreadPool *threadPool = QThreadPoolPrivate::qtGuiInstance();
+    if (!threadPool || threadPool->maxThreadCount() < 2 || threadPool->contains(QThread::currentThread()))
+        return false;
+
+    const int maxChunks = qMin(threadPool->maxThreadCount() * 4, elementCount / MinimumChunkSize);
+    QVarLengthArray<int, 64> starts;
+    starts.append(0);
+    for (int chunk = 1; chunk < maxChunks; ++chunk) {
+        int i = qMax(starts.last() + 1, int(qint64(elementCount) * chunk / maxChunks));
+        while (i < elementCount && types[i] != QPainterPath::MoveToElement)
+            ++i;
+        if (i >= elementCount)
+            break;
+        starts.append(i);
+    }
+    starts.append(elementCount);
+    const int chunkCount = int(starts.size()) - 1;
+    if (chunkCount < 2)
+        return false;
+
+    std::vector<std::unique_ptr<StrokeHandler>> handlers(chunkCount);
+    QAtomicInt next;
+    const auto strokeChunks = [&]() {
+        for (int chunk = next.fetchAndAddRelaxed(1); chunk < chunkCount; chunk = next.fetchAndAddRelaxed(1)) {
+            const int begin = starts[chunk];
+            const int end = starts[chunk + 1];
+            auto handler = std::make_unique<StrokeHandler>(2 * (end - begin) + 4);
+
+            QStroker chunkStroker;
+            chunkStroker.setMoveToHook(qpaintengineex_moveTo);
+            chunkStroker.setLineToHook(qpaintengineex_lineTo);
+            chunkStroker.setCubicToHook(qpaintengineex_cubicTo);
+            chunkStroker.setStrokeWidth(stroker.strokeWidth());
+            chunkStroker.setCurveThreshold(stroker.curveThreshold());
+            chunkStroker.setCapStyle(stroker.capStyle());
+            chunkStroker.setJoinStyle(stroker.joinStyle());
+            chunkStroker.setMiterLimit(stroker.miterLimit());
+            chunkStroker.setForceOpen(stroker.forceOpen());
+            chunkStroker.setClipRect(stroker.clipRect());
+
+            chunkStroker.begin(handler.get());
+            qpaintengineex_strokeElements(&chunkStroker, types, path.points(), begin, end, matrix);
+            chunkStroker.end();
+            handlers[chunk] = std::move(handler);
+        }
+    };
+
+    const int tasks = qMin(threadPool->maxThreadCount(), chunkCount - 1);
+    QSemaphore semaphore;
+    for (int i = 0; i < tasks; ++i) {
+        threadPool->start([&]() {
+            strokeChunks();
+            semaphore.release(1);
+        });
+    }
+    strokeChunks();
+    semaphore.acquire(tasks);
+
+    qsizetype typeCount = strokeHandler->types.size();
+    qsizetype pointCount = strokeHandler->pts.size();
+    for (const auto &handler : handlers) {
+        typeCount += handler->types.size();
+        pointCount += handler->pts.size();
+    }
+    strokeHandler->types.reserve(typeCount);
+    strokeHandler->pts.reserve(pointCount);
+    for (const auto &handler : handlers) {
+        memcpy(strokeHandler->types.data() + strokeHandler->types.size(), handler->types.data(),
+               handler->types.size() * sizeof(QPainterPath::ElementType));
+        strokeHandler->types.resize(strokeHandler->types.size() + handler->types.size());
+        memcpy(strokeHandler->pts.data() + strokeHandler->pts.size(), handler->pts.data(),
+               handler->pts.size() * sizeof(qreal));
+        strokeHandler->pts.resize(strokeHandler->pts.size() + handler->pts.size());
+    }
+
+    for (int i = 0; i < elementCount; ++i) {
+        if (types[i] == QPainterPath::CurveToElement) {
+            *flags |= QVectorPath::CurvedShapeMask;
+            break;
+        }
+    }
+    return true;
+}
+
 QPaintEngineEx::QPaintEngineEx()
     : QPaintEngine(*new QPaintEngineExPrivate, AllFeatures)
 {
@@ -458,7 +629,9 @@ void QPaintEngineEx::stroke(const QVectorPath &path, const QPen &inPen)
         // later, so they are also covered here..
         d->activeStroker->setCurveThresholdFromTransform(state()->matrix);
         d->activeStroker->begin(d->strokeHandler);
-        if (types) {
+        if (d->strokeParallel(path, nullptr, &flags)) {
+            // stroked on the thread pool
+        } else if (types) {
             while (points < lastPoint) {
                 switch (*types) {
                 case QPainterPath::MoveToElement:
@@ -514,7 +687,9 @@ void QPaintEngineEx::stroke(const QVectorPath &path, const QPen &inPen)
         } else {
             d->activeStroker->setCurveThresholdFromTransform(QTransform());
             d->activeStroker->begin(d->strokeHandler);
-            if (types) {
+            if (d->strokeParallel(path, &state()->matrix, &flags)) {
+                // stroked on the thread pool
+            } else if (types) {
                 while (points < lastPoint) {
                     switch (*types) {
                     case QPainterPath::MoveToElement: {
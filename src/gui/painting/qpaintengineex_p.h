@@ -36,6 +36,12 @@ struct StrokeHandler;
 QDebug Q_GUI_EXPORT &operator<<(QDebug &, const QVectorPath &path);
 #endif
 
+// Paths with at least this many elements are stroked, and outlines with at
+// least this many points rasterized, on the Qt GUI thread pool. 0 disables
+// it. The default can be changed with QT_PAINT_PARALLEL_THRESHOLD.
+Q_AUTOTEST_EXPORT int qt_parallelPaintThreshold();
+Q_AUTOTEST_EXPORT void qt_setParallelPaintThreshold(int threshold);
+
 class Q_GUI_EXPORT QPaintEngineEx : public QPaintEngine
 {
     Q_DECLARE_PRIVATE(QPaintEngineEx)
@@ -132,6 +138,7 @@ public:
 
     void replayClipOperations();
     bool hasClipOperations() const;
+    bool strokeParallel(const QVectorPath &path, const QTransform *matrix, uint *flags);
 
     QStroker stroker;
     QDashStroker dasher;
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include "qregion.h"
+#include "qregion_p.h"
 #include "qpainterpath.h"
 #include "qpolygon.h"
 #include "qbuffer.h"
@@ -14,6 +15,7 @@
 
 #include <memory>
 #include <private/qdebug_p.h>
+#include <private/qsimd_p.h>
 
 #ifdef Q_OS_WIN
 #  include <qt_windows.h>
@@ -1962,6 +1964,48 @@ static void miIntersectO(QRegionPrivate &dest, const QRect *r1, const QRect *r1E
  *          Generic Region Operator
  *====================================================================*/
 
+/*
+ * Returns the end of the band starting at r, that is the first rectangle
+ * in [r, rEnd) that has a different top than r.
+ */
+static inline const QRect *miBandEnd(const QRect *r, const QRect *rEnd)
+{
+    const int y = r->top();
+    const QRect *it = r + 1;
+#ifdef __SSE2__
+    // QRect is stored as x1, y1, x2, y2; compare the tops of four at a time
+    static_assert(sizeof(QRect) == 4 * sizeof(int));
+    const __m128i vy = _mm_set1_epi32(y);
+    for (; rEnd - it >= 4; it += 4) {
+        const __m128i r0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(it));
+        const __m128i r1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(it + 1));
+        const __m128i r2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(it + 2));
+        const __m128i r3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(it + 3));
+        const __m128i tops = _mm_unpackhi_epi64(_mm_unpacklo_epi32(r0, r1),
+                                                _mm_unpacklo_epi32(r2, r3));
+        const uint equal = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(tops, vy)));
+        if (equal != 0xf)
+            return it + qCountTrailingZeroBits(~equal);
+    }
+#endif
+    while (it != rEnd && it->top() == y)
+        ++it;
+    return it;
+}
+
+/*
+ * Returns \c true if the n rectangles starting at a have the same left and
+ * right edges as the n rectangles starting at b.
+ */
+static inline bool miBandsLineUp(const QRect *a, const QRect *b, int n)
+{
+    for (; n; --n, ++a, ++b) {
+        if (a->left() != b->left() || a->right() != b->right())
+            return false;
+    }
+    return true;
+}
+
 /*-
  *-----------------------------------------------------------------------
  * miCoalesce --
@@ -1986,7 +2030,6 @@ static int miCoalesce(QRegionPrivate &dest, int prevStart, int curStart)
     QRect *pRegEnd;    /* End of region */
     int curNumRects;    /* Number of rectangles in current band */
     int prevNumRects;   /* Number of rectangles in previous band */
-    int bandY1;         /* Y1 coordinate for current band */
     QRect *rData = dest.rects.data();
 
     pRegEnd = rData + dest.numRects;
@@ -1999,11 +2042,8 @@ static int miCoalesce(QRegionPrivate &dest, int prevStart, int curStart)
      * this because multiple bands could have been added in miRegionOp
      * at the end when one region has been exhausted.
      */
-    pCurBox = rData + curStart;
-    bandY1 = pCurBox->top();
-    for (curNumRects = 0; pCurBox != pRegEnd && pCurBox->top() == bandY1; ++curNumRects) {
-        ++pCurBox;
-    }
+    pCurBox = const_cast<QRect *>(miBandEnd(rData + curStart, pRegEnd));
+    curNumRects = pCurBox - (rData + curStart);
 
     if (pCurBox != pRegEnd) {
         /*
@@ -2032,19 +2072,12 @@ static int miCoalesce(QRegionPrivate &dest, int prevStart, int curStart)
              * cover the most area possible. I.e. two boxes in a band must
              * have some horizontal space between them.
              */
-            do {
-                if (pPrevBox->left() != pCurBox->left() || pPrevBox->right() != pCurBox->right()) {
-                     // The bands don't line up so they can't be coalesced.
-                    return curStart;
-                }
-                ++pPrevBox;
-                ++pCurBox;
-                --prevNumRects;
-            } while (prevNumRects != 0);
+            if (!miBandsLineUp(pPrevBox, pCurBox, prevNumRects)) {
+                // The bands don't line up so they can't be coalesced.
+                return curStart;
+            }
 
             dest.numRects -= curNumRects;
-            pCurBox -= curNumRects;
-            pPrevBox -= curNumRects;
 
             /*
              * The bands may be merged, so set the bottom y of each box
@@ -2206,13 +2239,8 @@ static void miRegionOp(QRegionPrivate &dest,
          * rectangle after the last one in the current band for their
          * respective regions.
          */
-        r1BandEnd = r1;
-        while (r1BandEnd != r1End && r1BandEnd->top() == r1->top())
-            ++r1BandEnd;
-
-        r2BandEnd = r2;
-        while (r2BandEnd != r2End && r2BandEnd->top() == r2->top())
-            ++r2BandEnd;
+        r1BandEnd = miBandEnd(r1, r1End);
+        r2BandEnd = miBandEnd(r2, r2End);
 
         /*
          * First handle the band that doesn't intersect, if any.
@@ -2278,18 +2306,14 @@ static void miRegionOp(QRegionPrivate &dest,
     if (r1 != r1End) {
         if (nonOverlap1Func != nullptr) {
             do {
-                r1BandEnd = r1;
-                while (r1BandEnd < r1End && r1BandEnd->top() == r1->top())
-                    ++r1BandEnd;
+                r1BandEnd = miBandEnd(r1, r1End);
                 (*nonOverlap1Func)(dest, r1, r1BandEnd, qMax(r1->top(), ybot + 1), r1->bottom());
                 r1 = r1BandEnd;
             } while (r1 != r1End);
         }
     } else if ((r2 != r2End) && (nonOverlap2Func != nullptr)) {
         do {
-            r2BandEnd = r2;
-            while (r2BandEnd < r2End && r2BandEnd->top() == r2->top())
-                 ++r2BandEnd;
+            r2BandEnd = miBandEnd(r2, r2End);
             (*nonOverlap2Func)(dest, r2, r2BandEnd, qMax(r2->top(), ybot + 1), r2->bottom());
             r2 = r2BandEnd;
         } while (r2 != r2End);
@@ -4278,6 +4302,135 @@ void QRegion::setRects(QSpan<const QRect> rects)
     }
 }
 
+/*
+    Returns the union of the (possibly overlapping) rectangles \a rects.
+
+    Instead of uniting the rectangles one by one, which copies the whole
+    region for each rectangle, this sweeps over the rectangles from top to
+    bottom once and builds the bands of the region from the horizontal spans
+    of the rectangles that cover each of them.
+*/
+QRegion qt_regionFromRects(QSpan<const QRect> rects)
+{
+    QVarLengthArray<QRect, 32> sorted;
+    sorted.reserve(rects.size());
+    for (const QRect &rect : rects) {
+        if (!rect.isEmpty())
+            sorted.append(rect);
+    }
+    if (sorted.size() < 2)
+        return sorted.isEmpty() ? QRegion() : QRegion(sorted.first());
+
+    // every band starts at the top or below the bottom of a rectangle
+    QVarLengthArray<int, 64> edges;
+    edges.reserve(sorted.size() * 2);
+    for (const QRect &rect : std::as_const(sorted)) {
+        edges.append(rect.top());
+        edges.append(rect.bottom() + 1);
+    }
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+    std::sort(sorted.begin(), sorted.end(), [](const QRect &a, const QRect &b) {
+        return a.top() < b.top();
+    });
+
+    QList<QRect> result;
+    QVarLengthArray<QRect, 32> active;
+    QVarLengthArray<QRect, 32> spans;
+    qsizetype prevBand = -1;    // start of the last band in result
+    qsizetype next = 0;         // next rectangle in sorted to become active
+    for (qsizetype i = 0; i + 1 < edges.size(); ++i) {
+        const int top = edges.at(i);
+        const int bottom = edges.at(i + 1) - 1;
+        active.removeIf([top](const QRect &rect) { return rect.bottom() < top; });
+        for (; next < sorted.size() && sorted.at(next).top() == top; ++next)
+            active.append(sorted.at(next));
+        if (active.isEmpty()) {
+            prevBand = -1;
+            continue;
+        }
+
+        std::sort(active.begin(), active.end(), [](const QRect &a, const QRect &b) {
+            return a.left() < b.left();
+        });
+        spans.clear();
+        for (const QRect &rect : std::as_const(active)) {
+            if (!spans.isEmpty() && rect.left() <= spans.last().right() + 1)
+                spans.last().setRight(qMax(spans.last().right(), rect.right()));
+            else
+                spans.append(QRect(QPoint(rect.left(), top), QPoint(rect.right(), bottom)));
+        }
+
+        // extend the previous band downwards if it has the same spans
+        const qsizetype prevCount = prevBand < 0 ? 0 : result.size() - prevBand;
+        if (prevCount == spans.size()
+                && miBandsLineUp(result.constData() + prevBand, spans.constData(), int(prevCount))) {
+            for (qsizetype j = prevBand; j < result.size(); ++j)
+                result[j].setBottom(bottom);
+        } else {
+            prevBand = result.size();
+            for (const QRect &span : std::as_const(spans))
+                result.append(span);
+        }
+    }
+
+    QRegion region;
+    region.setRects(result);
+    return region;
+}
+
+/*
+    Returns a region that contains \a region and consists of fewer, larger
+    rectangles.
+
+    Neighboring rectangles are merged into their bounding rectangle as long
+    as at most the fraction \a maxWaste of it lies outside of \a region. This
+    is meant for regions that are only used to decide what to repaint, where
+    painting a little more is cheaper than managing thousands of rectangles.
+*/
+QRegion qt_regionSimplified(const QRegion &region, qreal maxWaste)
+{
+    if (region.rectCount() < 2 || maxWaste <= 0)
+        return region;
+
+    // how many of the most recently merged rectangles each rectangle is
+    // tried against; the rectangles come in bands, so these are its
+    // neighbors on the left and above
+    constexpr qsizetype Window = 16;
+
+    struct Merged {
+        QRect rect;
+        qint64 covered;     // area of the region inside rect
+    };
+    const auto area = [](const QRect &rect) { return qint64(rect.width()) * rect.height(); };
+
+    QVarLengthArray<Merged, 32> merged;
+    for (const QRect &rect : region) {
+        Merged current = { rect, area(rect) };
+        for (bool grown = true; grown; ) {
+            grown = false;
+            const qsizetype first = qMax(qsizetype(0), merged.size() - Window);
+            for (qsizetype i = merged.size() - 1; i >= first; --i) {
+                const QRect bounds = merged.at(i).rect | current.rect;
+                const qint64 covered = merged.at(i).covered + current.covered;
+                if (area(bounds) - covered <= maxWaste * area(bounds)) {
+                    current = { bounds, covered };
+                    merged.remove(i);
+                    grown = true;
+                    break;
+                }
+            }
+        }
+        merged.append(current);
+    }
+
+    QVarLengthArray<QRect, 32> rects;
+    rects.reserve(merged.size());
+    for (const Merged &m : std::as_const(merged))
+        rects.append(m.rect);
+    return qt_regionFromRects(rects);
+}
+
 /*!
     \since 6.8
 
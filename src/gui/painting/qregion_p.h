@@ -0,0 +1,29 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QREGION_P_H
+#define QREGION_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtGui/private/qtguiglobal_p.h>
+#include <QtGui/qregion.h>
+#include <QtCore/qspan.h>
+
+QT_BEGIN_NAMESPACE
+
+Q_GUI_EXPORT QRegion qt_regionFromRects(QSpan<const QRect> rects);
+Q_GUI_EXPORT QRegion qt_regionSimplified(const QRegion &region, qreal maxWaste);
+
+QT_END_NAMESPACE
+
+#endif // QREGION_P_H
@@ -3,9 +3,19 @@
 
 #include "qdistancefield_p.h"
 #include <qmath.h>
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qsavefile.h>
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qthreadpool.h>
 #include <private/qdatabuffer_p.h>
 #include <private/qimage_p.h>
 #include <private/qpathsimplifier_p.h>
+#include <private/qthreadpool_p.h>
+
+#include <algorithm>
 
 QT_BEGIN_NAMESPACE
 
@@ -1084,5 +1094,349 @@ QImage QDistanceField::toImage(QImage::Format format) const
     return image;
 }
 
-QT_END_NAMESPACE
+namespace {
+// Packs rectangles into a strip of a fixed width that grows downwards. The
+// skyline is the top edge of the free space, as segments from left to right;
+// each rectangle goes where its bottom ends up highest.
+class SkylinePacker
+{
+public:
+    explicit SkylinePacker(int width) : m_width(width) { m_skyline.append({ 0, 0, width }); }
+
+    QPoint insert(QSize size);
+    int height() const { return m_height; }
+
+private:
+    struct Segment
+    {
+        int x;
+        int y;
+        int width;
+    };
+
+    QList<Segment> m_skyline;
+    int m_width;
+    int m_height = 0;
+};
+
+QPoint SkylinePacker::insert(QSize size)
+{
+    Q_ASSERT(size.width() <= m_width);
+
+    qsizetype best = -1;
+    int bestY = 0;
+    int bestBottom = INT_MAX;
+    int bestWidth = INT_MAX;
+    for (qsizetype i = 0; i < m_skyline.size(); ++i) {
+        if (m_skyline.at(i).x + size.width() > m_width)
+            break;
+        int y = 0;
+        int remaining = size.width();
+        for (qsizetype j = i; remaining > 0; ++j) {
+            y = qMax(y, m_skyline.at(j).y);
+            remaining -= m_skyline.at(j).width;
+        }
+        const int bottom = y + size.height();
+        if (bottom < bestBottom || (bottom == bestBottom && m_skyline.at(i).width < bestWidth)) {
+            best = i;
+            bestY = y;
+            bestBottom = bottom;
+            bestWidth = m_skyline.at(i).width;
+        }
+    }
+    Q_ASSERT(best >= 0);
+
+    const QPoint position(m_skyline.at(best).x, bestY);
+    m_skyline.insert(best, { position.x(), bestBottom, size.width() });
+
+    // cut the segments that are now covered
+    for (qsizetype i = best + 1; i < m_skyline.size(); ) {
+        const Segment &previous = m_skyline.at(i - 1);
+        Segment &segment = m_skyline[i];
+        const int overlap = previous.x + previous.width - segment.x;
+        if (overlap <= 0)
+            break;
+        segment.x += overlap;
+        segment.width -= overlap;
+        if (segment.width > 0)
+            break;
+        m_skyline.removeAt(i);
+    }
+
+    for (qsizetype i = 0; i + 1 < m_skyline.size(); ) {
+        if (m_skyline.at(i).y == m_skyline.at(i + 1).y) {
+            m_skyline[i].width += m_skyline.at(i + 1).width;
+            m_skyline.removeAt(i + 1);
+        } else {
+            ++i;
+        }
+    }
+
+    m_height = qMax(m_height, bestBottom);
+    return position;
+}
+}
+
+static constexpr quint32 DistanceFieldAtlasMagic = 0x51444641; // "QDFA"
+static constexpr quint32 DistanceFieldAtlasVersion = 1;
+
+/*!
+    \internal
+
+    Returns the key under which create() caches the atlas of \a glyphs in
+    \a font. The key is based on the font file, through its \c head table,
+    which holds a checksum of the whole file, and on everything else that
+    the distance fields depend on.
+*/
+QByteArray QDistanceFieldAtlas::cacheKey(const QRawFont &font, const QList<glyph_t> &glyphs,
+                                         bool doubleResolution, int width)
+{
+    QList<glyph_t> sortedGlyphs = glyphs;
+    std::sort(sortedGlyphs.begin(), sortedGlyphs.end());
+    sortedGlyphs.erase(std::unique(sortedGlyphs.begin(), sortedGlyphs.end()), sortedGlyphs.end());
+
+    QCryptographicHash keyBuilder(QCryptographicHash::Sha1);
+    QByteArray parameters;
+    {
+        QDataStream stream(&parameters, QIODevice::WriteOnly);
+        stream << DistanceFieldAtlasVersion << font.familyName() << font.styleName()
+               << qint32(font.weight()) << qint32(font.style()) << doubleResolution << qint32(width)
+               << qint32(QT_DISTANCEFIELD_BASEFONTSIZE(doubleResolution))
+               << qint32(QT_DISTANCEFIELD_SCALE(doubleResolution))
+               << qint32(QT_DISTANCEFIELD_RADIUS(doubleResolution));
+    }
+    keyBuilder.addData(parameters);
+    keyBuilder.addData(font.fontTable("head"));
+    keyBuilder.addData(font.fontTable("maxp"));
+    keyBuilder.addData(QByteArrayView(reinterpret_cast<const char *>(sortedGlyphs.constData()),
+                                      sortedGlyphs.size() * qsizetype(sizeof(glyph_t))));
+    return keyBuilder.result().toHex();
+}
+
+/*!
+    \internal
+
+    Generates the distance fields of \a glyphs in \a font on the Qt GUI
+    thread pool, and packs them into an image that is \a width pixels wide,
+    or as wide as the widest distance field.
+
+    If \a cacheDirectory is not empty, the atlas is read from there if it was
+    generated before with the same parameters for the same font file, and
+    written there otherwise.
+*/
+QDistanceFieldAtlas QDistanceFieldAtlas::create(const QRawFont &font, const QList<glyph_t> &glyphs,
+                                                bool doubleResolution, int width,
+                                                const QString &cacheDirectory)
+{
+    if (!font.isValid() || glyphs.isEmpty() || width <= 0)
+        return QDistanceFieldAtlas();
+
+    QString cacheFileName;
+    QByteArray key;
+    if (!cacheDirectory.isEmpty()) {
+        key = cacheKey(font, glyphs, doubleResolution, width);
+        cacheFileName = cacheDirectory + u'/' + QString::fromLatin1(key) + ".qdfa"_L1;
+        QFile file(cacheFileName);
+        if (file.open(QIODevice::ReadOnly)) {
+            QDistanceFieldAtlas atlas = load(&file, key);
+            if (!atlas.isNull()) {
+                qCDebug(lcDistanceField) << "loaded distance field atlas" << cacheFileName;
+                return atlas;
+            }
+        }
+    }
+
+    QList<glyph_t> sortedGlyphs = glyphs;
+    std::sort(sortedGlyphs.begin(), sortedGlyphs.end());
+    sortedGlyphs.erase(std::unique(sortedGlyphs.begin(), sortedGlyphs.end()), sortedGlyphs.end());
+
+    // the outlines come from the font engine, which is not thread-safe
+    const int scale = QT_DISTANCEFIELD_SCALE(doubleResolution);
+    QRawFont renderFont = font;
+    renderFont.setPixelSize(QT_DISTANCEFIELD_BASEFONTSIZE(doubleResolution) * scale);
+    QList<QPainterPath> paths;
+    QList<QDistanceFieldAtlas::Glyph> atlasGlyphs;
+    paths.reserve(sortedGlyphs.size());
+    atlasGlyphs.reserve(sortedGlyphs.size());
+    for (glyph_t glyph : std::as_const(sortedGlyphs)) {
+        QPainterPath path = renderFont.pathForGlyph(glyph);
+        const QRectF boundingRect = path.boundingRect();
+        path.translate(-boundingRect.topLeft());
+        path.setFillRule(Qt::WindingFill);
+        paths.append(path);
+        atlasGlyphs.append({ glyph, QRect(), QRectF(boundingRect.topLeft() / scale,
+                                                    boundingRect.size() / scale) });
+    }
 
+    QList<QDistanceField> fields(paths.size());
+    QAtomicInt next;
+    const auto makeFields = [&]() {
+        for (int i = next.fetchAndAddRelaxed(1); i < paths.size(); i = next.fetchAndAddRelaxed(1))
+            fields[i] = QDistanceField(paths.at(i), sortedGlyphs.at(i), doubleResolution);
+    };
+
+    QThreadPool *threadPool = QThreadPoolPrivate::qtGuiInstance();
+    if (!threadPool || paths.size() < 2 || threadPool->contains(QThread::currentThread())) {
+        makeFields();
+    } else {
+        const int tasks = qMin(threadPool->maxThreadCount(), int(paths.size()) - 1);
+        QSemaphore semaphore;
+        for (int i = 0; i < tasks; ++i) {
+            threadPool->start([&]() {
+                makeFields();
+                semaphore.release(1);
+            });
+        }
+        makeFields();
+        semaphore.acquire(tasks);
+    }
+
+    // one pixel apart, so that sampling at the edge of one distance field
+    // does not pick up its neighbor
+    constexpr int padding = 1;
+    QList<qsizetype> order(fields.size());
+    for (qsizetype i = 0; i < order.size(); ++i) {
+        order[i] = i;
+        width = qMax(width, fields.at(i).width() + padding);
+    }
+    std::stable_sort(order.begin(), order.end(), [&](qsizetype a, qsizetype b) {
+        return fields.at(a).height() > fields.at(b).height();
+    });
+
+    SkylinePacker packer(width);
+    for (qsizetype i : std::as_const(order)) {
+        const QDistanceField &field = fields.at(i);
+        const QPoint position = packer.insert(QSize(field.width() + padding, field.height() + padding));
+        atlasGlyphs[i].rect = QRect(position, QSize(field.width(), field.height()));
+    }
+
+    QDistanceFieldAtlas atlas;
+    atlas.m_image = QImage(width, qMax(packer.height(), 1), QImage::Format_Alpha8);
+    if (atlas.m_image.isNull())
+        return QDistanceFieldAtlas();
+    atlas.m_image.fill(0);
+    for (qsizetype i = 0; i < fields.size(); ++i) {
+        const QDistanceField &field = fields.at(i);
+        const QRect &rect = atlasGlyphs.at(i).rect;
+        for (int y = 0; y < field.height(); ++y)
+            memcpy(atlas.m_image.scanLine(rect.y() + y) + rect.x(), field.constScanLine(y), field.width());
+    }
+    atlas.m_glyphs = std::move(atlasGlyphs);
+    atlas.m_cacheKey = key;
+
+    if (!cacheFileName.isEmpty()) {
+        QDir().mkpath(cacheDirectory);
+#if QT_CONFIG(temporaryfile)
+        QSaveFile file(cacheFileName);
+        if (file.open(QIODevice::WriteOnly) && atlas.save(&file))
+            file.commit();
+#else
+        QFile file(cacheFileName);
+        if (file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+            atlas.save(&file);
+#endif
+    }
+
+    return atlas;
+}
+
+/*!
+    \internal
+
+    Returns where the distance field of \a glyph is in the atlas, or a glyph
+    with a null rect if the atlas does not contain it.
+*/
+QDistanceFieldAtlas::Glyph QDistanceFieldAtlas::glyph(glyph_t glyph) const
+{
+    const auto it = std::lower_bound(m_glyphs.cbegin(), m_glyphs.cend(), glyph,
+                                     [](const Glyph &g, glyph_t glyph) { return g.glyph < glyph; });
+    if (it == m_glyphs.cend() || it->glyph != glyph)
+        return Glyph();
+    return *it;
+}
+
+bool QDistanceFieldAtlas::save(QIODevice *device) const
+{
+    if (isNull())
+        return false;
+
+    QDataStream stream(device);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << DistanceFieldAtlasMagic << DistanceFieldAtlasVersion << m_cacheKey
+           << qint32(m_image.width()) << qint32(m_image.height()) << quint32(m_glyphs.size());
+    for (const Glyph &glyph : m_glyphs)
+        stream << quint32(glyph.glyph) << glyph.rect << glyph.boundingRect;
+    for (int y = 0; y < m_image.height(); ++y)
+        stream.writeRawData(reinterpret_cast<const char *>(m_image.constScanLine(y)), m_image.width());
+    return stream.status() == QDataStream::Ok;
+}
+
+/*!
+    \internal
+
+    Reads an atlas written with save() from \a device. If \a cacheKey is
+    not empty, the atlas must have been created with that key.
+*/
+QDistanceFieldAtlas QDistanceFieldAtlas::load(QIODevice *device, const QByteArray &cacheKey)
+{
+    QDataStream stream(device);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    QByteArray key;
+    qint32 width = 0;
+    qint32 height = 0;
+    quint32 glyphCount = 0;
+    stream >> magic >> version >> key >> width >> height >> glyphCount;
+    if (stream.status() != QDataStream::Ok || magic != DistanceFieldAtlasMagic
+            || version != DistanceFieldAtlasVersion || (!cacheKey.isEmpty() && key != cacheKey)
+            || width <= 0 || height <= 0) {
+        return QDistanceFieldAtlas();
+    }
+
+    // glyph index, rect and bounding rect, as written by save()
+    constexpr qint64 GlyphEntrySize = sizeof(quint32) + 4 * sizeof(qint32) + 4 * sizeof(double);
+    const qint64 imageSize = qint64(width) * qint64(height);
+    qint64 glyphCapacity = glyphCount;
+    if (!device->isSequential()) {
+        // the file is not trusted, so don't allocate more than it can hold
+        const qint64 available = device->size() - device->pos();
+        if (available < imageSize || (available - imageSize) / GlyphEntrySize < glyphCount)
+            return QDistanceFieldAtlas();
+    } else {
+        glyphCapacity = qMin(glyphCapacity, qint64(4096));
+    }
+
+    const QRect bounds(0, 0, width, height);
+    QList<Glyph> glyphs;
+    glyphs.reserve(glyphCapacity);
+    for (quint32 i = 0; i < glyphCount; ++i) {
+        quint32 index = 0;
+        Glyph glyph;
+        stream >> index >> glyph.rect >> glyph.boundingRect;
+        glyph.glyph = index;
+        if (stream.status() != QDataStream::Ok || !bounds.contains(glyph.rect))
+            return QDistanceFieldAtlas();
+        // glyph() relies on the glyphs being sorted
+        if (!glyphs.isEmpty() && glyphs.constLast().glyph >= glyph.glyph)
+            return QDistanceFieldAtlas();
+        glyphs.append(glyph);
+    }
+
+    QImage image(width, height, QImage::Format_Alpha8);
+    if (image.isNull())
+        return QDistanceFieldAtlas();
+    for (int y = 0; y < height; ++y) {
+        if (stream.readRawData(reinterpret_cast<char *>(image.scanLine(y)), width) != width)
+            return QDistanceFieldAtlas();
+    }
+
+    QDistanceFieldAtlas atlas;
+    atlas.m_cacheKey = key;
+    atlas.m_image = std::move(image);
+    atlas.m_glyphs = std::move(glyphs);
+    return atlas;
+}
+
+QT_END_NAMESPACE
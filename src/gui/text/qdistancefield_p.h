@@ -18,6 +18,7 @@
 #include <QtGui/private/qtguiglobal_p.h>
 #include <qrawfont.h>
 #include <private/qfontengine_p.h>
+#include <QtCore/qlist.h>
 #include <QtCore/qshareddata.h>
 #include <QtCore/qglobal.h>
 #include <QLoggingCategory>
@@ -91,6 +92,46 @@ private:
     friend class QDistanceFieldData;
 };
 
+class QIODevice;
+
+// The distance fields of a set of glyphs, packed into a single image.
+class Q_GUI_EXPORT QDistanceFieldAtlas
+{
+public:
+    struct Glyph
+    {
+        glyph_t glyph = 0;
+        // where the distance field is in image()
+        QRect rect;
+        // the outline of the glyph at QT_DISTANCEFIELD_BASEFONTSIZE, which
+        // the distance field covers with a margin of
+        // QT_DISTANCEFIELD_RADIUS / QT_DISTANCEFIELD_SCALE pixels
+        QRectF boundingRect;
+    };
+
+    QDistanceFieldAtlas() = default;
+
+    static QDistanceFieldAtlas create(const QRawFont &font, const QList<glyph_t> &glyphs,
+                                      bool doubleResolution = false, int width = 1024,
+                                      const QString &cacheDirectory = QString());
+    static QByteArray cacheKey(const QRawFont &font, const QList<glyph_t> &glyphs,
+                               bool doubleResolution = false, int width = 1024);
+
+    bool isNull() const { return m_image.isNull(); }
+    QImage image() const { return m_image; }
+    QList<Glyph> glyphs() const { return m_glyphs; }
+    Glyph glyph(glyph_t glyph) const;
+
+    bool save(QIODevice *device) const;
+    static QDistanceFieldAtlas load(QIODevice *device, const QByteArray &cacheKey = QByteArray());
+
+private:
+    QByteArray m_cacheKey;
+    QImage m_image;
+    // sorted by glyph index
+    QList<Glyph> m_glyphs;
+};
+
 QT_END_NAMESPACE
 
 #endif // QDISTANCEFIELD_H
@@ -4,6 +4,7 @@
 #include <qdebug.h>
 #include <private/qfontengine_p.h>
 #include <private/qfontengineglyphcache_p.h>
+#include <private/qtextshapingcache_p.h>
 #include <private/qguiapplication_p.h>
 
 #include <qpa/qplatformfontdatabase.h>
@@ -125,6 +126,7 @@ QFontEngine::QFontEngine(Type type)
 
 QFontEngine::~QFontEngine()
 {
+    QTextShapingCache::removeFontEngine(this);
 #ifdef QT_BUILD_INTERNAL
     if (enginesCollector)
         enginesCollector->removeOne(this);
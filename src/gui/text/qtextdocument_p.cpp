@@ -230,7 +230,7 @@ void QTextDocumentPrivate::clear()
 
         title.clear();
         clearUndoRedoStacks(QTextDocument::UndoAndRedoStacks);
-        text = QString();
+        text.clear();
         unreachableCharacterCount = 0;
         modifiedState = 0;
         modified = false;
@@ -291,7 +291,7 @@ void QTextDocumentPrivate::setLayout(QAbstractTextDocumentLayout *layout)
 void QTextDocumentPrivate::insert_string(int pos, uint strPos, uint length, int format, QTextUndoCommand::Operation op)
 {
     // ##### optimize when only appending to the fragment!
-    Q_ASSERT(noBlockInString(QStringView{text}.mid(strPos, length)));
+    Q_ASSERT(noBlockInString(text.view(strPos, length)));
 
     split(pos);
     uint x = fragments.insert_single(pos, length);
@@ -377,8 +377,7 @@ int QTextDocumentPrivate::insertBlock(QChar blockSeparator,
 
     beginEditBlock();
 
-    int strPos = text.size();
-    text.append(blockSeparator);
+    const int strPos = text.append(blockSeparator);
 
     int ob = blocks.findNode(pos);
     bool atBlockEnd = true;
@@ -454,8 +453,7 @@ void QTextDocumentPrivate::insert(int pos, QStringView str, int format)
 
     Q_ASSERT(noBlockInString(str));
 
-    int strPos = text.size();
-    text.append(str);
+    const int strPos = text.append(str);
     insert(pos, strPos, str.size(), format);
 }
 
@@ -470,7 +468,7 @@ int QTextDocumentPrivate::remove_string(int pos, uint length, QTextUndoCommand::
 
     Q_ASSERT(blocks.size(b) > length);
     Q_ASSERT(x && q20::cmp_equal(fragments.position(x), pos) && fragments.size(x) == length);
-    Q_ASSERT(noBlockInString(QStringView{text}.mid(fragments.fragment(x)->stringPosition, length)));
+    Q_ASSERT(noBlockInString(text.view(fragments.fragment(x)->stringPosition, length)));
 
     blocks.setSize(b, blocks.size(b)-length);
 
@@ -605,7 +603,7 @@ void QTextDocumentPrivate::move(int pos, int to, int length, QTextUndoCommand::O
 
         if (key+1 != blocks.position(b)) {
 //          qDebug("remove_string from %d length %d", key, X->size_array[0]);
-            Q_ASSERT(noBlockInString(QStringView{text}.mid(X->stringPosition, X->size_array[0])));
+            Q_ASSERT(noBlockInString(text.view(X->stringPosition, X->size_array[0])));
             w = remove_string(key, X->size_array[0], op);
 
             if (needsInsert) {
@@ -1310,11 +1308,10 @@ QString QTextDocumentPrivate::plainText() const
 {
     QString result;
     result.resize(length());
-    const QChar *text_unicode = text.unicode();
     QChar *data = result.data();
     for (QTextDocumentPrivate::FragmentIterator it = begin(); it != end(); ++it) {
         const QTextFragmentData *f = *it;
-        ::memcpy(data, text_unicode + f->stringPosition, f->size_array[0] * sizeof(QChar));
+        ::memcpy(data, text.data(f->stringPosition), f->size_array[0] * sizeof(QChar));
         data += f->size_array[0];
     }
     // remove trailing block separator
@@ -1645,29 +1642,23 @@ void QTextDocumentPrivate::compressPieceTable()
 
     const uint garbageCollectionThreshold = 96 * 1024; // bytes
 
-    //qDebug() << "unreachable bytes:" << unreachableCharacterCount * sizeof(QChar) << " -- limit" << garbageCollectionThreshold << "text size =" << text.size() << "capacity:" << text.capacity();
+    //qDebug() << "unreachable bytes:" << unreachableCharacterCount * sizeof(QChar) << " -- limit" << garbageCollectionThreshold << "text size =" << text.size();
 
+    // the buffer is chunked and never reallocated as a whole, so collect once
+    // at least half of it is garbage; that keeps the copying linear in the
+    // number of removed characters
     bool compressTable = unreachableCharacterCount * sizeof(QChar) > garbageCollectionThreshold
-                         && text.size() >= text.capacity() * 0.9;
+                         && qsizetype(unreachableCharacterCount) * 2 >= text.size();
     if (!compressTable)
         return;
 
-    QString newText;
-    newText.resize(text.size());
-    QChar *newTextPtr = newText.data();
-    int newLen = 0;
+    QTextDocumentBuffer newText;
+    for (FragmentMap::Iterator it = fragments.begin(); !it.atEnd(); ++it)
+        it->stringPosition = newText.append(text.view(it->stringPosition, it->size_array[0]));
 
-    for (FragmentMap::Iterator it = fragments.begin(); !it.atEnd(); ++it) {
-        memcpy(newTextPtr, text.constData() + it->stringPosition, it->size_array[0] * sizeof(QChar));
-        it->stringPosition = newLen;
-        newTextPtr += it->size_array[0];
-        newLen += it->size_array[0];
-    }
-
-    newText.resize(newLen);
     newText.squeeze();
     //qDebug() << "removed" << text.size() - newText.size() << "characters";
-    text = newText;
+    text = std::move(newText);
     unreachableCharacterCount = 0;
 }
 
@@ -34,6 +34,7 @@
 #endif
 #include "private/qfragmentmap_p.h"
 #include "private/qobject_p.h"
+#include "private/qtextdocumentbuffer_p.h"
 #include "private/qtextformat_p.h"
 
 // #define QT_QMAP_DEBUG
@@ -185,7 +186,7 @@ public:
     inline int availableUndoSteps() const { return undoEnabled ? undoState : 0; }
     inline int availableRedoSteps() const { return undoEnabled ? qMax(undoStack.size() - undoState - 1, 0) : 0; }
 
-    inline QString buffer() const { return text; }
+    inline const QTextDocumentBuffer &buffer() const { return text; }
     QString plainText() const;
     inline int length() const { return fragments.length(); }
 
@@ -307,7 +308,7 @@ private:
 
     void compressPieceTable();
 
-    QString text;
+    QTextDocumentBuffer text;
     uint unreachableCharacterCount;
 
     QList<QTextUndoCommand> undoStack;
@@ -0,0 +1,40 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qtextdocumentbuffer_p.h"
+
+QT_BEGIN_NAMESPACE
+
+int QTextDocumentBuffer::append(QStringView str)
+{
+    if (!chunks.isEmpty()) {
+        Chunk &last = chunks.last();
+        if (last.text.size() + str.size() <= ChunkSize) {
+            const int pos = last.position + int(last.text.size());
+            last.text.append(str);
+            return pos;
+        }
+    }
+
+    // Leave a gap of one position, so that pieces in different chunks are
+    // never adjacent. Strings that are larger than a chunk get their own.
+    const int pos = chunks.isEmpty() ? 0 : end() + 1;
+    chunks.append(Chunk{ pos, str.toString() });
+    return pos;
+}
+
+qsizetype QTextDocumentBuffer::size() const
+{
+    qsizetype size = 0;
+    for (const Chunk &chunk : chunks)
+        size += chunk.text.size();
+    return size;
+}
+
+void QTextDocumentBuffer::squeeze()
+{
+    for (Chunk &chunk : chunks)
+        chunk.text.squeeze();
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,90 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QTEXTDOCUMENTBUFFER_P_H
+#define QTEXTDOCUMENTBUFFER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtGui/private/qtguiglobal_p.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qstring.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+// The append-only text buffer behind the piece table of QTextDocumentPrivate.
+//
+// The text is kept in chunks of up to ChunkSize characters, so that
+// appending to a large document never reallocates and copies all of it.
+// Every appended string is stored contiguously in a single chunk and can be
+// read with data() or view(). Positions are not contiguous across chunks:
+// each chunk starts one position after the end of the previous one, so two
+// pieces can only be adjacent when they are adjacent in memory.
+class Q_GUI_EXPORT QTextDocumentBuffer
+{
+public:
+    enum { ChunkSize = 64 * 1024 };
+
+    // Returns the position of the first appended character.
+    int append(QStringView str);
+    int append(QChar ch) { return append(QStringView(&ch, 1)); }
+
+    inline QChar at(int pos) const
+    {
+        const Chunk &c = chunkAt(pos);
+        return c.text.at(pos - c.position);
+    }
+    // The characters from pos to the end of the string appended with it.
+    inline const QChar *data(int pos) const
+    {
+        const Chunk &c = chunkAt(pos);
+        return c.text.constData() + (pos - c.position);
+    }
+    inline QStringView view(int pos, qsizetype length) const
+    { return QStringView(data(pos), length); }
+
+    // The position the next character would be appended at, if it fits
+    // into the last chunk.
+    inline int end() const
+    { return chunks.isEmpty() ? 0 : chunks.constLast().position + int(chunks.constLast().text.size()); }
+    qsizetype size() const;
+    inline bool isEmpty() const { return chunks.isEmpty(); }
+
+    void clear() { chunks.clear(); }
+    void squeeze();
+
+private:
+    struct Chunk
+    {
+        int position;
+        QString text;
+    };
+
+    inline const Chunk &chunkAt(int pos) const
+    {
+        Q_ASSERT(!chunks.isEmpty() && pos >= 0 && pos < end());
+        const Chunk &last = chunks.constLast();
+        if (pos >= last.position)
+            return last;
+        const auto it = std::upper_bound(chunks.cbegin(), chunks.cend(), pos,
+                                         [](int pos, const Chunk &c) { return pos < c.position; });
+        return *(it - 1);
+    }
+
+    QList<Chunk> chunks;
+};
+
+QT_END_NAMESPACE
+
+#endif // QTEXTDOCUMENTBUFFER_P_H
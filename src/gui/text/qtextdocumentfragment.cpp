@@ -22,11 +22,7 @@ QT_BEGIN_NAMESPACE
 using namespace Qt::StringLiterals;
 
 QTextCopyHelper::QTextCopyHelper(const QTextCursor &_source, const QTextCursor &_destination, bool forceCharFormat, const QTextCharFormat &fmt)
-#if defined(Q_CC_DIAB) // compiler bug
-    : formatCollection(*_destination.d->priv->formatCollection()), originalText((const QString)_source.d->priv->buffer())
-#else
     : formatCollection(*_destination.d->priv->formatCollection()), originalText(_source.d->priv->buffer())
-#endif
 {
     src = _source.d->priv;
     dst = _destination.d->priv;
@@ -83,7 +79,7 @@ int QTextCopyHelper::appendFragment(int pos, int endPos, int objectIndex)
         dst->setCharFormat(-1, 1, convertFormat(src->blocksBegin().charFormat()).toCharFormat());
     }
 
-    QString txtToInsert(originalText.constData() + frag->stringPosition + inFragmentOffset, charsToCopy);
+    QString txtToInsert = originalText.view(frag->stringPosition + inFragmentOffset, charsToCopy).toString();
     if (txtToInsert.size() == 1
         && (txtToInsert.at(0) == QChar::ParagraphSeparator
             || txtToInsert.at(0) == QTextBeginningOfFrame
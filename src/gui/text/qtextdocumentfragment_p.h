@@ -56,7 +56,7 @@ private:
     QTextDocumentPrivate *dst;
     QTextDocumentPrivate *src;
     QTextFormatCollection &formatCollection;
-    const QString originalText;
+    const QTextDocumentBuffer originalText;
     QMap<int, int> objectIndexMap;
 };
 
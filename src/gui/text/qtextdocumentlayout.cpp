@@ -26,6 +26,12 @@
 #include "private/qfunctions_p.h"
 #include <qloggingcategory.h>
 #include <QtCore/qpointer.h>
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/private/qthreadpool_p.h>
+#include "qfont_p.h"
+#include "qtextformat_p.h"
 
 #include <algorithm>
 
@@ -502,7 +508,17 @@ public:
     qreal idealWidth;
     bool contentHasAlignment;
 
+    bool parallelLayout;
+    // blocks that were already broken into lines on the thread pool, with
+    // the line width they were broken at, and the position up to which
+    // blocks were checked
+    QHash<const QTextLayout *, QFixed> prelaidLayouts;
+    int prelayoutEnd;
+
     QFixed blockIndent(const QTextBlockFormat &blockFormat) const;
+    QTextOption blockTextOption(const QTextBlockFormat &blockFormat, Qt::LayoutDirection dir) const;
+    void blockMargins(const QTextBlock &bl, const QTextBlockFormat &blockFormat, Qt::LayoutDirection dir,
+                      QFixed *totalLeftMargin, QFixed *totalRightMargin) const;
 
     void drawFrame(const QPointF &offset, QPainter *painter, const QAbstractTextDocumentLayout::PaintContext &context,
                    QTextFrame *f) const;
@@ -547,6 +563,7 @@ public:
     void layoutBlock(const QTextBlock &bl, int blockPosition, const QTextBlockFormat &blockFormat,
                      QTextLayoutStruct *layoutStruct, int layoutFrom, int layoutTo, const QTextBlockFormat *previousBlockFormat);
     void layoutFlow(QTextFrame::Iterator it, QTextLayoutStruct *layoutStruct, int layoutFrom, int layoutTo, QFixed width = 0);
+    void prelayoutBlocks(QTextFrame::Iterator it, const QTextLayoutStruct *layoutStruct, int layoutFrom, int layoutTo);
 
     void floatMargins(QFixed y, const QTextLayoutStruct *layoutStruct, QFixed *left, QFixed *right) const;
     QFixed findY(QFixed yFrom, const QTextLayoutStruct *layoutStruct, QFixed requiredWidth) const;
@@ -573,7 +590,9 @@ QTextDocumentLayoutPrivate::QTextDocumentLayoutPrivate()
       cursorWidth(1),
       currentLazyLayoutPosition(-1),
       lazyLayoutStepSize(1000),
-      lastPageCount(-1)
+      lastPageCount(-1),
+      parallelLayout(qEnvironmentVariableIntValue("QT_TEXT_PARALLEL_LAYOUT") > 0),
+      prelayoutEnd(-1)
 {
     showLayoutProgress = true;
     insideDocumentChange = false;
@@ -858,6 +877,38 @@ QFixed QTextDocumentLayoutPrivate::blockIndent(const QTextBlockFormat &blockForm
     return QFixed::fromReal(indent * scale * document->indentWidth());
 }
 
+QTextOption QTextDocumentLayoutPrivate::blockTextOption(const QTextBlockFormat &blockFormat, Qt::LayoutDirection dir) const
+{
+    QTextOption option = docPrivate->defaultTextOption;
+    option.setTextDirection(dir);
+    option.setTabs( blockFormat.tabPositions() );
+
+    Qt::Alignment align = docPrivate->defaultTextOption.alignment();
+    if (blockFormat.hasProperty(QTextFormat::BlockAlignment))
+        align = blockFormat.alignment();
+    option.setAlignment(QGuiApplicationPrivate::visualAlignment(dir, align)); // for paragraph that are RTL, alignment is auto-reversed;
+
+    if (blockFormat.nonBreakableLines() || document->pageSize().width() < 0) {
+        option.setWrapMode(QTextOption::ManualWrap);
+    }
+    return option;
+}
+
+void QTextDocumentLayoutPrivate::blockMargins(const QTextBlock &bl, const QTextBlockFormat &blockFormat,
+                                              Qt::LayoutDirection dir,
+                                              QFixed *totalLeftMargin, QFixed *totalRightMargin) const
+{
+    QFixed extraMargin;
+    if (docPrivate->defaultTextOption.flags() & QTextOption::AddSpaceForLineAndParagraphSeparators) {
+        QFontMetricsF fm(bl.charFormat().font());
+        extraMargin = QFixed::fromReal(fm.horizontalAdvance(u'\x21B5'));
+    }
+
+    const QFixed indent = this->blockIndent(blockFormat);
+    *totalLeftMargin = QFixed::fromReal(blockFormat.leftMargin()) + (dir == Qt::RightToLeft ? extraMargin : indent);
+    *totalRightMargin = QFixed::fromReal(blockFormat.rightMargin()) + (dir == Qt::RightToLeft ? indent : extraMargin);
+}
+
 struct BorderPaginator
 {
     BorderPaginator(QTextDocument *document, const QRectF &rect, qreal topMarginAfterPageBreak, qreal bottomMargin, qreal border) :
@@ -3284,6 +3335,9 @@ void QTextDocumentLayoutPrivate::layoutFlow(QTextFrame::Iterator it, QTextLayout
             if (lastIt.currentBlock().isValid())
                 previousBlockFormatPtr = &previousBlockFormat;
 
+            if (parallelLayout && inRootFrame && docPos >= prelayoutEnd)
+                prelayoutBlocks(previousIt, layoutStruct, layoutFrom, layoutTo);
+
             // layout and position child block
             layoutBlock(block, docPos, blockFormat, layoutStruct, layoutFrom, layoutTo, previousBlockFormatPtr);
 
@@ -3392,6 +3446,168 @@ void QTextDocumentLayoutPrivate::layoutFlow(QTextFrame::Iterator it, QTextLayout
     fd->currentLayoutStruct = nullptr;
 }
 
+namespace {
+struct QTextBlockPrelayout
+{
+    QTextLayout *layout;
+    QFixed firstLineWidth;
+    QFixed lineWidth;
+};
+}
+
+// Breaks a block into lines the same way as layoutBlock() does when the
+// frame has no floats, so that only the line positions are left to do.
+static void prelayoutBlock(const QTextBlockPrelayout &block, int fixedColumnWidth)
+{
+    QTextLayout *tl = block.layout;
+    QTextOption option = tl->textOption();
+    const bool haveWordOrAnyWrapMode = (option.wrapMode() == QTextOption::WrapAtWordBoundaryOrAnywhere);
+
+    tl->beginLayout();
+    QFixed width = block.firstLineWidth;
+    while (1) {
+        QTextLine line = tl->createLine();
+        if (!line.isValid())
+            break;
+        line.setLeadingIncluded(true);
+
+        if (fixedColumnWidth != -1) {
+            line.setNumColumns(fixedColumnWidth, width.toReal());
+        } else {
+            line.setLineWidth(width.toReal());
+            if (QFixed::fromReal(line.naturalTextWidth()) > width) {
+                line.setLineWidth(width.toReal());
+                if (QFixed::fromReal(line.naturalTextWidth()) > width) {
+                    if (haveWordOrAnyWrapMode) {
+                        option.setWrapMode(QTextOption::WrapAnywhere);
+                        tl->setTextOption(option);
+                    }
+
+                    line.setLineWidth(qMax<qreal>(line.naturalTextWidth(), width.toReal()));
+
+                    if (haveWordOrAnyWrapMode) {
+                        option.setWrapMode(QTextOption::WordWrap);
+                        tl->setTextOption(option);
+                    }
+                }
+            }
+        }
+        width = block.lineWidth;
+    }
+    tl->endLayout();
+
+    // the font engines belong to this thread's font cache, don't let
+    // the GUI thread pick them up later
+    tl->engine()->resetFontEngineCache();
+}
+
+#ifdef QT_BUILD_INTERNAL
+// for testing purpose only
+Q_CONSTINIT static QBasicAtomicInt prelaidOutBlockCount = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+Q_AUTOTEST_EXPORT int qt_textDocumentLayout_prelaidOutBlockCount()
+{
+    return prelaidOutBlockCount.loadRelaxed();
+}
+#endif
+
+// Breaks the blocks that follow \a it into lines on the GUI thread pool,
+// up to the next child frame. layoutBlock() then only has to position their
+// lines. Only blocks that don't depend on the layout of anything before
+// them qualify: the frame must not have floats, and the blocks must not
+// contain inline objects, preedit text or additional formats.
+void QTextDocumentLayoutPrivate::prelayoutBlocks(QTextFrame::Iterator it, const QTextLayoutStruct *layoutStruct,
+                                                 int layoutFrom, int layoutTo)
+{
+    constexpr qsizetype MinimumTextLength = 16 * 1024;
+    constexpr qsizetype MaximumTextLength = 512 * 1024;
+
+    QThreadPool *threadPool = QThreadPoolPrivate::qtGuiInstance();
+    if (!threadPool || threadPool->contains(QThread::currentThread()))
+        return;
+    if (!data(layoutStruct->frame)->floats.isEmpty())
+        return;
+
+    // a lazy layout step is too small to be worth it, so break a few steps
+    // ahead; the lines are kept until the block is positioned
+    const int scanEnd = currentLazyLayoutPosition != -1
+            ? currentLazyLayoutPosition + qMax(lazyLayoutStepSize, int(4 * MinimumTextLength))
+            : INT_MAX;
+    QList<QTextBlockPrelayout> blocks;
+    qsizetype textLength = 0;
+    for (; !it.atEnd() && textLength < MaximumTextLength; ++it) {
+        if (it.currentFrame())
+            break;
+        const QTextBlock block = it.currentBlock();
+        const int blockPosition = block.position();
+        prelayoutEnd = blockPosition + block.length();
+        if (blockPosition > scanEnd)
+            break;
+        if (!block.isVisible())
+            continue;
+        if (!layoutStruct->fullLayout && (blockPosition + block.length() <= layoutFrom || blockPosition > layoutTo))
+            continue;
+
+        // inline objects can be floats, which change the width of all lines after them
+        const QString text = block.text();
+        if (text.contains(QChar::ObjectReplacementCharacter))
+            break;
+        QTextLayout *tl = block.layout();
+        if (!tl->formats().isEmpty() || !tl->preeditAreaText().isEmpty())
+            continue;
+
+        const QTextBlockFormat blockFormat = block.blockFormat();
+        const Qt::LayoutDirection dir = block.textDirection();
+        QFixed totalLeftMargin, totalRightMargin;
+        blockMargins(block, blockFormat, dir, &totalLeftMargin, &totalRightMargin);
+        const QFixed left = qMax(layoutStruct->x_left, layoutStruct->x_left + totalLeftMargin);
+        const QFixed right = qMin(layoutStruct->x_right, layoutStruct->x_right - totalRightMargin);
+        const QFixed textIndent = QFixed::fromReal(blockFormat.textIndent());
+
+        tl->setTextOption(blockTextOption(blockFormat, dir));
+        blocks.append({ tl, right - left - textIndent, right - left });
+        textLength += text.size();
+    }
+    if (blocks.size() < 2 || textLength < MinimumTextLength)
+        return;
+
+    // QTextFormat resolves its font on first use; do that here so that the
+    // threads only read the formats they share
+    const QTextFormatCollection *formats = docPrivate->formatCollection();
+    for (int i = 0; i < formats->numFormats(); ++i) {
+        const QTextFormat format = formats->format(i);
+        if (format.isCharFormat()) {
+            const QFont font = format.toCharFormat().font();
+            if (font.capitalization() == QFont::SmallCaps)
+                QFontPrivate::get(font)->smallCapsFontPrivate();
+        }
+    }
+
+    const int columnWidth = fixedColumnWidth;
+    QAtomicInt next;
+    const auto layoutBlocks = [&]() {
+        for (int i = next.fetchAndAddRelaxed(1); i < blocks.size(); i = next.fetchAndAddRelaxed(1))
+            prelayoutBlock(blocks.at(i), columnWidth);
+    };
+
+    const int tasks = qMin(threadPool->maxThreadCount(), int(blocks.size()) - 1);
+    QSemaphore semaphore;
+    for (int i = 0; i < tasks; ++i) {
+        threadPool->start([&]() {
+            layoutBlocks();
+            semaphore.release(1);
+        });
+    }
+    layoutBlocks();
+    semaphore.acquire(tasks);
+#ifdef QT_BUILD_INTERNAL
+    prelaidOutBlockCount.fetchAndAddRelaxed(int(blocks.size()));
+#endif
+
+    for (const QTextBlockPrelayout &block : std::as_const(blocks))
+        prelaidLayouts.insert(block.layout, block.lineWidth);
+}
+
 static inline void getLineHeightParams(const QTextBlockFormat &blockFormat, const QTextLine &line, qreal scaling,
                                        QFixed *lineAdjustment, QFixed *lineBreakHeight, QFixed *lineHeight, QFixed *lineBottom)
 {
@@ -3439,15 +3655,8 @@ void QTextDocumentLayoutPrivate::layoutBlock(const QTextBlock &bl, int blockPosi
 
     Qt::LayoutDirection dir = bl.textDirection();
 
-    QFixed extraMargin;
-    if (docPrivate->defaultTextOption.flags() & QTextOption::AddSpaceForLineAndParagraphSeparators) {
-        QFontMetricsF fm(bl.charFormat().font());
-        extraMargin = QFixed::fromReal(fm.horizontalAdvance(u'\x21B5'));
-    }
-
-    const QFixed indent = this->blockIndent(blockFormat);
-    const QFixed totalLeftMargin = QFixed::fromReal(blockFormat.leftMargin()) + (dir == Qt::RightToLeft ? extraMargin : indent);
-    const QFixed totalRightMargin = QFixed::fromReal(blockFormat.rightMargin()) + (dir == Qt::RightToLeft ? indent : extraMargin);
+    QFixed totalLeftMargin, totalRightMargin;
+    blockMargins(bl, blockFormat, dir, &totalLeftMargin, &totalRightMargin);
 
     const QPointF oldPosition = tl->position();
     tl->setPosition(QPointF(layoutStruct->x_left.toReal(), layoutStruct->y.toReal()));
@@ -3458,21 +3667,7 @@ void QTextDocumentLayoutPrivate::layoutBlock(const QTextBlock &bl, int blockPosi
         || (layoutStruct->pageHeight != QFIXED_MAX && layoutStruct->absoluteY() + QFixed::fromReal(tl->boundingRect().height()) > layoutStruct->pageBottom)) {
 
         qCDebug(lcLayout) << "do layout";
-        QTextOption option = docPrivate->defaultTextOption;
-        option.setTextDirection(dir);
-        option.setTabs( blockFormat.tabPositions() );
-
-        Qt::Alignment align = docPrivate->defaultTextOption.alignment();
-        if (blockFormat.hasProperty(QTextFormat::BlockAlignment))
-            align = blockFormat.alignment();
-        option.setAlignment(QGuiApplicationPrivate::visualAlignment(dir, align)); // for paragraph that are RTL, alignment is auto-reversed;
-
-        if (blockFormat.nonBreakableLines() || document->pageSize().width() < 0) {
-            option.setWrapMode(QTextOption::ManualWrap);
-        }
-
-        tl->setTextOption(option);
-
+        QTextOption option = blockTextOption(blockFormat, dir);
         const bool haveWordOrAnyWrapMode = (option.wrapMode() == QTextOption::WrapAtWordBoundaryOrAnywhere);
 
 //         qDebug() << "    layouting block at" << bl.position();
@@ -3481,33 +3676,55 @@ void QTextDocumentLayoutPrivate::layoutBlock(const QTextBlock &bl, int blockPosi
         const QFixed r = layoutStruct->x_right - totalRightMargin;
         QFixed bottom;
 
-        tl->beginLayout();
+        // the lines of blocks broken by prelayoutBlocks() only need to be
+        // positioned, as long as nothing changed the width they were broken at
+        const auto prelaidWidth = prelaidLayouts.constFind(tl);
+        const bool prelaid = prelaidWidth != prelaidLayouts.cend()
+                && *prelaidWidth == qMin(layoutStruct->x_right, r) - qMax(layoutStruct->x_left, l)
+                && data(layoutStruct->frame)->floats.isEmpty()
+                && tl->lineCount() > 0;
+        if (prelaidWidth != prelaidLayouts.cend())
+            prelaidLayouts.erase(prelaidWidth);
+        if (!prelaid)
+            tl->setTextOption(option);
+
+        if (!prelaid)
+            tl->beginLayout();
         bool firstLine = true;
+        int lineIndex = 0;
         while (1) {
-            QTextLine line = tl->createLine();
+            QTextLine line;
+            if (!prelaid)
+                line = tl->createLine();
+            else if (lineIndex < tl->lineCount())
+                line = tl->lineAt(lineIndex++);
             if (!line.isValid())
                 break;
-            line.setLeadingIncluded(true);
 
-            QFixed left, right;
-            floatMargins(layoutStruct->y, layoutStruct, &left, &right);
-            left = qMax(left, l);
-            right = qMin(right, r);
             QFixed text_indent;
             if (firstLine) {
                 text_indent = QFixed::fromReal(blockFormat.textIndent());
+                firstLine = false;
+            }
+
+            QFixed left, right;
+            if (!prelaid) {
+                line.setLeadingIncluded(true);
+
+                floatMargins(layoutStruct->y, layoutStruct, &left, &right);
+                left = qMax(left, l);
+                right = qMin(right, r);
                 if (dir == Qt::LeftToRight)
                     left += text_indent;
                 else
                     right -= text_indent;
-                firstLine = false;
-            }
-//         qDebug() << "layout line y=" << currentYPos << "left=" << left << "right=" <<right;
+//             qDebug() << "layout line y=" << currentYPos << "left=" << left << "right=" <<right;
 
-            if (fixedColumnWidth != -1)
-                line.setNumColumns(fixedColumnWidth, (right - left).toReal());
-            else
-                line.setLineWidth((right - left).toReal());
+                if (fixedColumnWidth != -1)
+                    line.setNumColumns(fixedColumnWidth, (right - left).toReal());
+                else
+                    line.setLineWidth((right - left).toReal());
+            }
 
 //        qDebug() << "layoutBlock; layouting line with width" << right - left << "->textWidth" << line.textWidth();
             floatMargins(layoutStruct->y, layoutStruct, &left, &right);
@@ -3518,7 +3735,7 @@ void QTextDocumentLayoutPrivate::layoutBlock(const QTextBlock &bl, int blockPosi
             else
                 right -= text_indent;
 
-            if (fixedColumnWidth == -1 && QFixed::fromReal(line.naturalTextWidth()) > right-left) {
+            if (!prelaid && fixedColumnWidth == -1 && QFixed::fromReal(line.naturalTextWidth()) > right-left) {
                 // float has been added in the meantime, redo
                 layoutStruct->pendingFloats.clear();
 
@@ -3586,7 +3803,8 @@ void QTextDocumentLayoutPrivate::layoutBlock(const QTextBlock &bl, int blockPosi
             layoutStruct->pendingFloats.clear();
         }
         layoutStruct->y = qMax(layoutStruct->y, bottom);
-        tl->endLayout();
+        if (!prelaid)
+            tl->endLayout();
     } else {
         const int cnt = tl->lineCount();
         QFixed bottom;
@@ -3730,6 +3948,34 @@ void QTextDocumentLayout::draw(QPainter *painter, const PaintContext &context)
     fd->size.width = width;
 }
 
+/*!
+    \internal
+
+    Enables or disables laying out paragraphs on the Qt GUI thread pool.
+
+    When enabled, runs of paragraphs that don't depend on each other are
+    broken into lines concurrently before they are positioned in order on
+    the calling thread. Only paragraphs outside tables and child frames, in
+    frames without floats, qualify. Small changes are still laid out on the
+    calling thread only.
+
+    The default is off, unless the \c QT_TEXT_PARALLEL_LAYOUT environment
+    variable is set to 1.
+*/
+void QTextDocumentLayout::setParallelLayoutEnabled(bool enable)
+{
+    Q_D(QTextDocumentLayout);
+    d->parallelLayout = enable;
+    d->prelaidLayouts.clear();
+    d->prelayoutEnd = -1;
+}
+
+bool QTextDocumentLayout::isParallelLayoutEnabled() const
+{
+    Q_D(const QTextDocumentLayout);
+    return d->parallelLayout;
+}
+
 void QTextDocumentLayout::setViewport(const QRectF &viewport)
 {
     Q_D(QTextDocumentLayout);
@@ -3773,6 +4019,8 @@ void QTextDocumentLayout::documentChanged(int from, int oldLength, int length)
     QRectF updateRect;
 
     d->lazyLayoutStepSize = 1000;
+    d->prelaidLayouts.clear();
+    d->prelayoutEnd = -1;
     d->sizeChangedTimer.stop();
     d->insideDocumentChange = true;
 
@@ -4038,6 +4286,8 @@ void QTextDocumentLayout::setFixedColumnWidth(int width)
 {
     Q_D(QTextDocumentLayout);
     d->fixedColumnWidth = width;
+    d->prelaidLayouts.clear();
+    d->prelayoutEnd = -1;
 }
 
 QRectF QTextDocumentLayout::tableCellBoundingRect(QTextTable *table, const QTextTableCell &cell) const
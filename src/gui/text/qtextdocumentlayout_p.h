@@ -55,6 +55,9 @@ public:
     // internal for QTextEdit's NoWrap mode
     void setViewport(const QRectF &viewport);
 
+    void setParallelLayoutEnabled(bool enable);
+    bool isParallelLayoutEnabled() const;
+
     virtual QRectF frameBoundingRect(QTextFrame *frame) const override;
     virtual QRectF blockBoundingRect(const QTextBlock &block) const override;
     QRectF tableBoundingRect(QTextTable *table) const;
@@ -6,6 +6,7 @@
 #include "qtextformat.h"
 #include "qtextformat_p.h"
 #include "qtextengine_p.h"
+#include "qtextshapingcache_p.h"
 #include "qabstracttextdocumentlayout.h"
 #include "qabstracttextdocumentlayout_p.h"
 #include "qtextlayout.h"
@@ -1434,6 +1435,57 @@ void QTextEngine::shapeText(int item) const
             letterSpacing *= font.d->dpi / qt_defaultDpiY();
     }
 
+    // short items, as in item views and labels, are often shaped again with
+    // the same font, so look them up in the process wide cache first
+    const bool useShapingCache = itemLength <= QTextShapingCache::MaximumTextLength
+            && QTextShapingCache::isEnabled();
+    QTextShapingCacheKey cacheKey;
+    if (useShapingCache) {
+        cacheKey.text = QString(reinterpret_cast<const QChar *>(string), itemLength);
+        cacheKey.fontEngine = fontEngine;
+        cacheKey.features = features;
+        cacheKey.letterSpacing = letterSpacing;
+        cacheKey.wordSpacing = wordSpacing;
+        cacheKey.script = si.analysis.script;
+        cacheKey.flags = si.analysis.flags;
+        if (si.analysis.bidiLevel % 2)
+            cacheKey.options |= QTextShapingCacheKey::RightToLeft;
+        if (shapingEnabled)
+            cacheKey.options |= QTextShapingCacheKey::ShapingEnabled;
+#if QT_CONFIG(harfbuzz)
+        if (kerningEnabled)
+            cacheKey.options |= QTextShapingCacheKey::KerningEnabled;
+#endif
+        if (letterSpacingIsAbsolute)
+            cacheKey.options |= QTextShapingCacheKey::LetterSpacingIsAbsolute;
+        if (option.useDesignMetrics())
+            cacheKey.options |= QTextShapingCacheKey::DesignMetrics;
+        if (option.flags() & QTextOption::ShowDefaultIgnorables)
+            cacheKey.options |= QTextShapingCacheKey::ShowDefaultIgnorables;
+
+        QTextShapedRun run;
+        if (QTextShapingCache::find(cacheKey, &run)) {
+            const int numGlyphs = int(run.glyphs.size());
+            if (Q_UNLIKELY(!ensureSpace(numGlyphs))) {
+                Q_UNREACHABLE_RETURN(); // ### report OOM error somehow
+            }
+
+            QGlyphLayout g = availableGlyphs(&si);
+            memcpy(g.glyphs, run.glyphs.constData(), numGlyphs * sizeof(glyph_t));
+            memcpy(static_cast<void *>(g.advances), run.advances.constData(), numGlyphs * sizeof(QFixed));
+            memcpy(static_cast<void *>(g.offsets), run.offsets.constData(), numGlyphs * sizeof(QFixedPoint));
+            memcpy(static_cast<void *>(g.attributes), run.attributes.constData(), numGlyphs * sizeof(QGlyphAttributes));
+            memcpy(logClusters(&si), run.logClusters.constData(), itemLength * sizeof(ushort));
+            si.num_glyphs = numGlyphs;
+            si.ascent = run.ascent;
+            si.descent = run.descent;
+            si.leading = run.leading;
+            si.width = run.width;
+            layoutData->used += numGlyphs;
+            return;
+        }
+    }
+
     // split up the item into parts that come from different font engines
     // k * 3 entries, array[k] == index in string, array[k + 1] == index in glyphs, array[k + 2] == engine index
     QVarLengthArray<uint, 24> itemBoundaries;
@@ -1588,6 +1640,21 @@ void QTextEngine::shapeText(int item) const
 
     for (int i = 0; i < si.num_glyphs; ++i)
         si.width += glyphs.advances[i] * !glyphs.attributes[i].dontPrint;
+
+    if (useShapingCache) {
+        QTextShapedRun run;
+        run.glyphs.assign(glyphs.glyphs, glyphs.glyphs + si.num_glyphs);
+        run.advances.assign(glyphs.advances, glyphs.advances + si.num_glyphs);
+        run.offsets.assign(glyphs.offsets, glyphs.offsets + si.num_glyphs);
+        run.attributes.assign(glyphs.attributes, glyphs.attributes + si.num_glyphs);
+        const ushort *log_clusters = logClusters(&si);
+        run.logClusters.assign(log_clusters, log_clusters + itemLength);
+        run.ascent = si.ascent;
+        run.descent = si.descent;
+        run.leading = si.leading;
+        run.width = si.width;
+        QTextShapingCache::insert(cacheKey, run);
+    }
 }
 
 #if QT_CONFIG(harfbuzz)
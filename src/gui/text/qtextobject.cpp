@@ -1074,14 +1074,14 @@ Qt::LayoutDirection QTextBlock::textDirection() const
     if (dir != Qt::LayoutDirectionAuto)
         return dir;
 
-    const QString buffer = p->buffer();
+    const QTextDocumentBuffer &buffer = p->buffer();
 
     const int pos = position();
     QTextDocumentPrivate::FragmentIterator it = p->find(pos);
     QTextDocumentPrivate::FragmentIterator end = p->find(pos + length() - 1); // -1 to omit the block separator char
     for (; it != end; ++it) {
         const QTextFragmentData * const frag = it.value();
-        const QChar *p = buffer.constData() + frag->stringPosition;
+        const QChar *p = buffer.data(frag->stringPosition);
         const QChar * const end = p + frag->size_array[0];
         while (p < end) {
             uint ucs4 = p->unicode();
@@ -1117,7 +1117,7 @@ QString QTextBlock::text() const
     if (!p || !n)
         return QString();
 
-    const QString buffer = p->buffer();
+    const QTextDocumentBuffer &buffer = p->buffer();
     QString text;
     text.reserve(length());
 
@@ -1126,7 +1126,7 @@ QString QTextBlock::text() const
     QTextDocumentPrivate::FragmentIterator end = p->find(pos + length() - 1); // -1 to omit the block separator char
     for (; it != end; ++it) {
         const QTextFragmentData * const frag = it.value();
-        text += QStringView(buffer.constData() + frag->stringPosition, frag->size_array[0]);
+        text += buffer.view(frag->stringPosition, frag->size_array[0]);
     }
 
     return text;
@@ -1745,11 +1745,11 @@ QString QTextFragment::text() const
         return QString();
 
     QString result;
-    QString buffer = p->buffer();
+    const QTextDocumentBuffer &buffer = p->buffer();
     int f = n;
     while (f != ne) {
         const QTextFragmentData * const frag = p->fragmentMap().fragment(f);
-        result += QString(buffer.constData() + frag->stringPosition, frag->size_array[0]);
+        result += buffer.view(frag->stringPosition, frag->size_array[0]);
         f = p->fragmentMap().next(f);
     }
     return result;
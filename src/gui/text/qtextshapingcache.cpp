@@ -0,0 +1,167 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qtextshapingcache_p.h"
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qcache.h>
+#include <QtCore/qmutex.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    QTextShapingCache keeps the glyphs of recently shaped script items, so
+    that laying out the same short string again with the same font, for
+    instance when an item view repaints, does not run HarfBuzz again.
+
+    The cache is shared by all threads and bounded by a byte limit. The
+    limit is 4 MB by default, and can be changed with setByteLimit() or in
+    kilobytes with the QT_TEXT_SHAPING_CACHE_SIZE environment variable. A
+    limit of 0 disables the cache.
+
+    Entries are keyed on the font engine pointer, so the font engine
+    removes its entries when it is destroyed.
+*/
+
+static qint64 defaultByteLimit()
+{
+    bool ok = false;
+    const int kilobytes = qEnvironmentVariableIntValue("QT_TEXT_SHAPING_CACHE_SIZE", &ok);
+    if (ok && kilobytes >= 0)
+        return qint64(kilobytes) * 1024;
+    return 4 * 1024 * 1024;
+}
+
+namespace {
+struct ShapingCache
+{
+    ShapingCache()
+        : runs(qsizetype(defaultByteLimit()))
+    {
+        enabled.storeRelaxed(runs.maxCost() > 0 ? 1 : 0);
+    }
+
+    QMutex mutex;
+    QCache<QTextShapingCacheKey, QTextShapedRun> runs;
+    QTextShapingCache::Statistics stats;
+    QAtomicInt enabled;
+};
+}
+
+Q_GLOBAL_STATIC(ShapingCache, shapingCache)
+
+qsizetype QTextShapedRun::cost() const
+{
+    return sizeof(QTextShapedRun) + sizeof(QTextShapingCacheKey)
+            + glyphs.size() * qsizetype(sizeof(glyph_t) + sizeof(QFixed) + sizeof(QFixedPoint)
+                                        + sizeof(QGlyphAttributes))
+            + logClusters.size() * qsizetype(sizeof(ushort) + sizeof(QChar));
+}
+
+bool QTextShapingCache::find(const QTextShapingCacheKey &key, QTextShapedRun *run)
+{
+    ShapingCache *cache = shapingCache();
+    if (!cache || !cache->enabled.loadRelaxed())
+        return false;
+
+    QMutexLocker locker(&cache->mutex);
+    if (const QTextShapedRun *cached = cache->runs.object(key)) {
+        ++cache->stats.hits;
+        *run = *cached;
+        return true;
+    }
+    ++cache->stats.misses;
+    return false;
+}
+
+void QTextShapingCache::insert(const QTextShapingCacheKey &key, const QTextShapedRun &run)
+{
+    ShapingCache *cache = shapingCache();
+    if (!cache || !cache->enabled.loadRelaxed())
+        return;
+
+    const qsizetype cost = run.cost();
+    QMutexLocker locker(&cache->mutex);
+    if (cost > cache->runs.maxCost())
+        return;
+    cache->runs.insert(key, new QTextShapedRun(run), cost);
+    ++cache->stats.insertions;
+}
+
+void QTextShapingCache::removeFontEngine(const QFontEngine *fontEngine)
+{
+    if (!shapingCache.exists() || shapingCache.isDestroyed())
+        return;
+
+    ShapingCache *cache = shapingCache();
+    QMutexLocker locker(&cache->mutex);
+    if (cache->runs.isEmpty())
+        return;
+    const QList<QTextShapingCacheKey> keys = cache->runs.keys();
+    for (const QTextShapingCacheKey &key : keys) {
+        if (key.fontEngine == fontEngine)
+            cache->runs.remove(key);
+    }
+}
+
+void QTextShapingCache::clear()
+{
+    ShapingCache *cache = shapingCache();
+    if (!cache)
+        return;
+
+    QMutexLocker locker(&cache->mutex);
+    cache->runs.clear();
+}
+
+bool QTextShapingCache::isEnabled()
+{
+    ShapingCache *cache = shapingCache();
+    return cache && cache->enabled.loadRelaxed();
+}
+
+qint64 QTextShapingCache::byteLimit()
+{
+    ShapingCache *cache = shapingCache();
+    if (!cache)
+        return 0;
+
+    QMutexLocker locker(&cache->mutex);
+    return cache->runs.maxCost();
+}
+
+void QTextShapingCache::setByteLimit(qint64 bytes)
+{
+    ShapingCache *cache = shapingCache();
+    if (!cache)
+        return;
+
+    QMutexLocker locker(&cache->mutex);
+    cache->runs.setMaxCost(qsizetype(qMax<qint64>(bytes, 0)));
+    cache->enabled.storeRelaxed(bytes > 0 ? 1 : 0);
+}
+
+QTextShapingCache::Statistics QTextShapingCache::statistics()
+{
+    ShapingCache *cache = shapingCache();
+    if (!cache)
+        return {};
+
+    QMutexLocker locker(&cache->mutex);
+    Statistics stats = cache->stats;
+    stats.totalCost = cache->runs.totalCost();
+    stats.count = cache->runs.size();
+    return stats;
+}
+
+void QTextShapingCache::resetStatistics()
+{
+    ShapingCache *cache = shapingCache();
+    if (!cache)
+        return;
+
+    QMutexLocker locker(&cache->mutex);
+    cache->stats = {};
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,116 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QTEXTSHAPINGCACHE_P_H
+#define QTEXTSHAPINGCACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtGui/private/qtguiglobal_p.h>
+#include <QtGui/qfont.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qstring.h>
+
+#include "private/qfixed_p.h"
+#include "private/qtextengine_p.h"
+
+QT_BEGIN_NAMESPACE
+
+class QFontEngine;
+
+// Everything that QTextEngine::shapeText() takes into account for one
+// script item. Two items with equal keys are shaped to the same glyphs.
+struct QTextShapingCacheKey
+{
+    QString text;
+    const QFontEngine *fontEngine = nullptr;
+    QHash<QFont::Tag, quint32> features;
+    QFixed letterSpacing;
+    QFixed wordSpacing;
+    ushort script = 0;
+    ushort flags = 0;
+    // Bidi direction and the remaining font and QTextOption settings
+    enum Option : uint {
+        RightToLeft = 0x01,
+        ShapingEnabled = 0x02,
+        KerningEnabled = 0x04,
+        LetterSpacingIsAbsolute = 0x08,
+        DesignMetrics = 0x10,
+        ShowDefaultIgnorables = 0x20,
+    };
+    uint options = 0;
+
+    friend bool operator==(const QTextShapingCacheKey &lhs, const QTextShapingCacheKey &rhs) noexcept
+    {
+        return lhs.fontEngine == rhs.fontEngine && lhs.script == rhs.script
+                && lhs.flags == rhs.flags && lhs.options == rhs.options
+                && lhs.letterSpacing == rhs.letterSpacing && lhs.wordSpacing == rhs.wordSpacing
+                && lhs.text == rhs.text && lhs.features == rhs.features;
+    }
+    friend bool operator!=(const QTextShapingCacheKey &lhs, const QTextShapingCacheKey &rhs) noexcept
+    { return !(lhs == rhs); }
+    friend size_t qHash(const QTextShapingCacheKey &key, size_t seed = 0) noexcept
+    {
+        return qHashMulti(seed, key.text, key.fontEngine, key.script, key.flags, key.options,
+                          key.letterSpacing.value(), key.wordSpacing.value(), key.features.size());
+    }
+};
+
+// The result of shaping one script item: its glyphs, the log clusters that
+// map characters to them, and the metrics stored in the QScriptItem.
+struct QTextShapedRun
+{
+    QList<glyph_t> glyphs;
+    QList<QFixed> advances;
+    QList<QFixedPoint> offsets;
+    QList<QGlyphAttributes> attributes;
+    QList<ushort> logClusters;
+    QFixed ascent;
+    QFixed descent;
+    QFixed leading;
+    QFixed width;
+
+    qsizetype cost() const;
+};
+
+class Q_GUI_EXPORT QTextShapingCache
+{
+public:
+    struct Statistics
+    {
+        qint64 hits = 0;
+        qint64 misses = 0;
+        qint64 insertions = 0;
+        qint64 totalCost = 0;
+        qsizetype count = 0;
+    };
+
+    // Items longer than this are shaped without looking at the cache.
+    static constexpr int MaximumTextLength = 256;
+
+    static bool find(const QTextShapingCacheKey &key, QTextShapedRun *run);
+    static void insert(const QTextShapingCacheKey &key, const QTextShapedRun &run);
+    static void removeFontEngine(const QFontEngine *fontEngine);
+    static void clear();
+
+    static bool isEnabled();
+    static qint64 byteLimit();
+    static void setByteLimit(qint64 bytes);
+
+    static Statistics statistics();
+    static void resetStatistics();
+};
+
+QT_END_NAMESPACE
+
+#endif // QTEXTSHAPINGCACHE_P_H
@@ -269,7 +269,8 @@ bool BitIStream::read(QByteArray *dstPtr)
                 return true;
             }
 
-            BitIStream slice(first + offset / 8, first + offset / 8 + len);
+            const QByteArrayView slice(first + offset / 8, len);
+            dst.clear();
             if (huffman_decode_string(slice, &dst)) {
                 offset += quint64(len) * 8;
                 return true;
@@ -133,7 +133,7 @@ bool FieldLookupTable::prependField(const QByteArray &name, const QByteArray &va
 
     if (!begin) {
         // Either no more space or empty table ...
-        chunks.push_front(ChunkPtr(new Chunk(ChunkSize)));
+        chunks.push_front(spareChunk ? std::move(spareChunk) : ChunkPtr(new Chunk(ChunkSize)));
         end += ChunkSize;
         begin = ChunkSize;
     }
@@ -183,6 +183,11 @@ void FieldLookupTable::evictEntry()
         end = ChunkSize;
         begin = end;
     } else if (!(end % ChunkSize)) {
+        // A table in use keeps prepending and evicting entries, so the chunk
+        // we release now is very likely needed again soon; keep it around
+        // instead of reallocating. Drop the fields, they were evicted.
+        spareChunk = std::move(chunks.back());
+        std::fill(spareChunk->begin(), spareChunk->end(), HeaderField());
         chunks.pop_back();
     }
 }
@@ -211,6 +216,7 @@ void FieldLookupTable::clearDynamicTable()
 {
     searchIndex.clear();
     chunks.clear();
+    spareChunk.reset();
     begin = 0;
     end = 0;
     nDynamic = 0;
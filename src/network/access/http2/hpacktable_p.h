@@ -152,6 +152,8 @@ private:
     using ChunkPtr = std::unique_ptr<Chunk>;
     std::deque<ChunkPtr> chunks;
     using size_type = std::deque<ChunkPtr>::size_type;
+    // The last chunk released by evictEntry(), reused by prependField().
+    ChunkPtr spareChunk;
 
     struct SearchEntry;
     friend struct SearchEntry;
@@ -316,30 +316,6 @@ const CodeEntry staticHuffmanCodeTable[]
     {256, 0xfffffffcul, 30}   // EOS 11111111|11111111|11111111|111111
 };
 
-void write_huffman_code(BitOStream &outputStream, CodeEntry code)
-{
-    // Append octet by octet.
-    auto bitLength = code.bitLength;
-    const auto hc = code.huffmanCode >> (32 - bitLength);
-
-    if (bitLength > 24) {
-        outputStream.writeBits(uchar(hc >> 24), bitLength - 24);
-        bitLength = 24;
-    }
-
-    if (bitLength > 16) {
-        outputStream.writeBits(uchar(hc >> 16), bitLength - 16);
-        bitLength = 16;
-    }
-
-    if (bitLength > 8) {
-        outputStream.writeBits(uchar(hc >> 8), bitLength - 8);
-        bitLength = 8;
-    }
-
-    outputStream.writeBits(uchar(hc), bitLength);
-}
-
 }
 
 // That's from HPACK's specs - we deal with octets.
@@ -348,19 +324,32 @@ static_assert(std::numeric_limits<uchar>::digits == 8, "octets expected");
 quint64 huffman_encoded_bit_length(QByteArrayView inputData)
 {
     quint64 bitLength = 0;
-    for (int i = 0, e = inputData.size(); i < e; ++i)
-        bitLength += staticHuffmanCodeTable[int(inputData[i])].bitLength;
+    for (const char c : inputData)
+        bitLength += staticHuffmanCodeTable[uchar(c)].bitLength;
 
     return bitLength;
 }
 
 void huffman_encode_string(QByteArrayView inputData, BitOStream &outputStream)
 {
-    for (int i = 0, e = inputData.size(); i < e; ++i) {
-        const auto value = uchar(inputData[i]);
-        write_huffman_code(outputStream, staticHuffmanCodeTable[value]);
+    // Codes are collected right-aligned in 'bits' and written out octet by
+    // octet. At most 7 bits are left over after each code and the longest
+    // code is 30 bits, so 64 bits are always enough.
+    quint64 bits = 0;
+    quint32 nBits = 0;
+    for (const char c : inputData) {
+        const CodeEntry &code = staticHuffmanCodeTable[uchar(c)];
+        bits = (bits << code.bitLength) | (code.huffmanCode >> (32 - code.bitLength));
+        nBits += code.bitLength;
+        while (nBits >= 8) {
+            nBits -= 8;
+            outputStream.writeBits(uchar(bits >> nBits), 8);
+        }
     }
 
+    if (nBits)
+        outputStream.writeBits(uchar(bits), quint8(nBits));
+
     // Pad bits ...
     if (outputStream.bitLength() % 8)
         outputStream.writeBits(0xff, 8 - outputStream.bitLength() % 8);
@@ -457,17 +446,39 @@ HuffmanDecoder::HuffmanDecoder()
     }
 }
 
-bool HuffmanDecoder::decodeStream(BitIStream &inputStream, QByteArray &outputBuffer)
+bool HuffmanDecoder::decodeStream(QByteArrayView inputData, QByteArray &outputBuffer)
 {
+    // Every symbol takes at least minCodeLength bits, which bounds the
+    // decoded size; we write into a pre-sized buffer and trim it at the end.
+    const qsizetype oldSize = outputBuffer.size();
+    outputBuffer.resize(oldSize + inputData.size() * 8 / minCodeLength);
+    char *const outBegin = outputBuffer.data() + oldSize;
+    char *out = outBegin;
+
+    const auto *src = reinterpret_cast<const uchar *>(inputData.data());
+    const auto *const srcEnd = src + inputData.size();
+    // Not yet decoded bits, aligned to the most significant bit:
+    quint64 bits = 0;
+    quint32 nBits = 0;
+
+    bool ok = false;
     while (true) {
-        quint32 chunk = 0;
-        const quint32 readBits = inputStream.peekBits(inputStream.streamOffset(), 32, &chunk);
-        if (!readBits)
-            return !inputStream.hasMoreBits();
+        while (nBits <= 56 && src != srcEnd) {
+            bits |= quint64(*src++) << (56 - nBits);
+            nBits += 8;
+        }
+
+        if (!nBits) {
+            ok = true;
+            break;
+        }
 
+        // This is what BitIStream::peekBits(offset, 32) would give us:
+        const quint32 chunk = quint32(bits >> 32);
+        const quint32 readBits = std::min(nBits, 32u);
         if (readBits < minCodeLength) {
-            inputStream.skipBits(readBits);
-            return padding_is_valid(chunk, readBits);
+            ok = padding_is_valid(chunk, readBits);
+            break;
         }
 
         quint32 tableIndex = 0;
@@ -486,21 +497,22 @@ bool HuffmanDecoder::decodeStream(BitIStream &inputStream, QByteArray &outputBuf
         }
 
         if (entry.bitLength > readBits) {
-            inputStream.skipBits(readBits);
-            return padding_is_valid(chunk, readBits);
+            ok = padding_is_valid(chunk, readBits);
+            break;
         }
 
         if (!entry.bitLength || entry.byteValue == 256) {
             //EOS (256) == compression error (HPACK).
-            inputStream.skipBits(readBits);
-            return false;
+            break;
         }
 
-        outputBuffer.append(entry.byteValue);
-        inputStream.skipBits(entry.bitLength);
+        *out++ = char(entry.byteValue);
+        bits <<= entry.bitLength;
+        nBits -= entry.bitLength;
     }
 
-    return false;
+    outputBuffer.truncate(oldSize + (out - outBegin));
+    return ok;
 }
 
 quint32 HuffmanDecoder::addTable(quint32 prefix, quint32 index)
@@ -527,12 +539,12 @@ void HuffmanDecoder::setTableEntry(PrefixTable table, quint32 index,
     tableData[table.offset + index] = entry;
 }
 
-bool huffman_decode_string(BitIStream &inputStream, QByteArray *outputBuffer)
+bool huffman_decode_string(QByteArrayView inputData, QByteArray *outputBuffer)
 {
     Q_ASSERT(outputBuffer);
 
     static HuffmanDecoder decoder;
-    return decoder.decodeStream(inputStream, *outputBuffer);
+    return decoder.decodeStream(inputData, *outputBuffer);
 }
 
 }
@@ -96,8 +96,6 @@ struct PrefixTableEntry
     quint32 byteValue;
 };
 
-class BitIStream;
-
 class HuffmanDecoder
 {
 public:
@@ -109,7 +107,7 @@ public:
 
     HuffmanDecoder();
 
-    bool decodeStream(BitIStream &inputStream, QByteArray &outputBuffer);
+    bool decodeStream(QByteArrayView inputData, QByteArray &outputBuffer);
 
 private:
     quint32 addTable(quint32 prefixLength, quint32 indexLength);
@@ -121,7 +119,7 @@ private:
     quint32 minCodeLength;
 };
 
-bool huffman_decode_string(BitIStream &inputStream, QByteArray *outputBuffer);
+bool huffman_decode_string(QByteArrayView inputData, QByteArray *outputBuffer);
 
 } // namespace HPack
 
@@ -27,6 +27,9 @@
 #include "private/qobject_p.h"
 #include "private/qurl_p.h"
 
+#include <chrono>
+#include <optional>
+
 #if QT_CONFIG(ssl)
 #  include "qsslconfiguration.h"
 #endif
@@ -211,6 +214,9 @@ public:
     QDnsLookupRunnable(const QDnsLookupPrivate *d);
     void run() override;
     bool sendDnsOverTls(QDnsLookupReply *reply, QSpan<unsigned char> query, ReplyBuffer &response);
+#if QT_CONFIG(libresolv)
+    static void parseReply(QDnsLookupReply *reply, unsigned char *response, int responseLength);
+#endif
 
 signals:
     void finished(const QDnsLookupReply &reply);
@@ -234,6 +240,31 @@ private:
     friend QDebug operator<<(QDebug &, QDnsLookupRunnable *);
 };
 
+#if QT_CONFIG(libresolv)
+// Resolves host names for QHostInfo without getaddrinfo(): the A and AAAA
+// queries are sent at the same time over one non-blocking socket and the
+// answers are parsed with the QDnsLookup code.
+class QDnsHostResolver
+{
+public:
+    // How long to keep waiting for the AAAA answer once the A answer has
+    // arrived (RFC 8305, section 3)
+    static constexpr std::chrono::milliseconds ResolutionDelay{50};
+
+    struct Result
+    {
+        QList<QHostAddress> addresses; // in the order connections should be attempted
+        std::chrono::seconds timeToLive{0};
+        QDnsLookup::Error error = QDnsLookup::NoError;
+    };
+
+    // Returns std::nullopt if the name server could not give a definite
+    // answer, in which case the caller should ask the system resolver.
+    static std::optional<Result> resolve(const QByteArray &aceName,
+                                         const QHostAddress &nameserver = {}, quint16 port = 0);
+};
+#endif // libresolv
+
 class QDnsRecordPrivate : public QSharedData
 {
 public:
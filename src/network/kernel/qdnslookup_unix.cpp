@@ -4,12 +4,14 @@
 
 #include "qdnslookup_p.h"
 
+#include <qdeadlinetimer.h>
 #include <qendian.h>
 #include <qscopedpointer.h>
 #include <qspan.h>
 #include <qurl.h>
 #include <qvarlengtharray.h>
 #include <private/qnativesocketengine_p.h>      // for setSockAddr
+#include <private/qnet_unix_p.h>
 #include <private/qtnetwork-config_p.h>
 
 QT_REQUIRE_CONFIG(libresolv);
@@ -267,17 +269,22 @@ void QDnsLookupRunnable::query(QDnsLookupReply *reply)
     if (responseLength < 0)
         return;
 
+    parseReply(reply, buffer.data(), responseLength);
+}
+
+void QDnsLookupRunnable::parseReply(QDnsLookupReply *reply, unsigned char *response,
+                                    int responseLength)
+{
     // Check the reply is valid.
     if (responseLength < int(sizeof(HEADER)))
         return reply->makeInvalidReplyError();
 
     // Parse the reply.
-    auto header = reinterpret_cast<HEADER *>(buffer.data());
+    auto header = reinterpret_cast<HEADER *>(response);
     if (header->rcode)
         return reply->makeDnsRcodeError(header->rcode);
 
     qptrdiff offset = sizeof(HEADER);
-    unsigned char *response = buffer.data();
     int status;
 
     auto expandHost = [&, cache = Cache{}](qptrdiff offset) mutable {
@@ -446,4 +453,229 @@ void QDnsLookupRunnable::query(QDnsLookupReply *reply)
     }
 }
 
+namespace {
+struct HostQuery
+{
+    explicit HostQuery(ns_type type) : type(type) {}
+
+    ns_type type;
+    QueryBuffer buffer = {};
+    int length = 0;
+    bool answered = false;
+    QDnsLookupReply reply;
+    quint32 negativeTimeToLive = 0;
+
+    quint16 id() const { return reinterpret_cast<const HEADER *>(buffer.data())->id; }
+    bool hasAddresses() const { return !reply.hostAddressRecords.isEmpty(); }
+    // NXDOMAIN or NODATA: the name server said there is nothing to find
+    bool isNegative() const
+    {
+        return answered && !hasAddresses()
+                && (reply.error == QDnsLookup::NoError || reply.error == QDnsLookup::NotFoundError);
+    }
+    bool isNameError() const { return reply.error == QDnsLookup::NotFoundError; }
+};
+
+// glibc keeps the IPv6 name servers of resolv.conf in _u._ext.nsaddrs, and
+// leaves their slot in nsaddr_list empty.
+template <typename State>
+auto ipv6NameServer(const State &state, int i, quint16 *port, int)
+    -> decltype(state._u._ext.nsaddrs[i], QHostAddress())
+{
+    const sockaddr_in6 *sin6 = state._u._ext.nsaddrs[i];
+    if (!sin6 || sin6->sin6_family != AF_INET6)
+        return {};
+    *port = ntohs(sin6->sin6_port);
+    return QHostAddress(sin6->sin6_addr.s6_addr);
+}
+
+template <typename State>
+QHostAddress ipv6NameServer(const State &, int, quint16 *, long)
+{
+    // fallback
+    return {};
+}
+}
+
+// For negative answers, the time to cache them for comes from the SOA record
+// in the authority section (RFC 2308, section 5). Returns 0 if there is none.
+static quint32 negativeTimeToLive(const unsigned char *response, int responseLength)
+{
+    const unsigned char *p = response + HFIXEDSZ;
+    const unsigned char *end = response + responseLength;
+    const auto header = reinterpret_cast<const HEADER *>(response);
+
+    for (int i = 0; i < ntohs(header->qdcount); ++i) {
+        const int n = dn_skipname(p, end);
+        if (n < 0 || p + n + QFIXEDSZ > end)
+            return 0;
+        p += n + QFIXEDSZ;
+    }
+
+    const int answerCount = ntohs(header->ancount);
+    const int recordCount = answerCount + ntohs(header->nscount);
+    for (int i = 0; i < recordCount; ++i) {
+        const int n = dn_skipname(p, end);
+        if (n < 0 || p + n + RRFIXEDSZ > end)
+            return 0;
+        p += n;
+        const quint16 type = qFromBigEndian<quint16>(p);
+        const quint32 ttl = qFromBigEndian<quint32>(p + 4);
+        const quint16 size = qFromBigEndian<quint16>(p + 8);
+        p += RRFIXEDSZ;
+        if (p + size > end)
+            return 0;
+        // the SOA record ends with the MINIMUM field
+        if (i >= answerCount && type == ns_t_soa && size >= 22)
+            return qMin(ttl, qFromBigEndian<quint32>(p + size - 4));
+        p += size;
+    }
+    return 0;
+}
+
+std::optional<QDnsHostResolver::Result>
+QDnsHostResolver::resolve(const QByteArray &aceName, const QHostAddress &nameserver, quint16 port)
+{
+    std::remove_pointer_t<res_state> state = {};
+    if (res_ninit(&state) < 0)
+        return std::nullopt;
+    auto guard = qScopeGuard([&] { res_nclose(&state); });
+
+    QHostAddress server = nameserver;
+    quint16 serverPort = port ? port : DnsPort;
+    for (int i = 0; server.isNull() && i < qMin(state.nscount, MAXNS); ++i) {
+        const sockaddr_in &sin = state.nsaddr_list[i];
+        if (sin.sin_family == AF_INET) {
+            server.setAddress(ntohl(sin.sin_addr.s_addr));
+            serverPort = ntohs(sin.sin_port);
+        } else {
+            server = ipv6NameServer(state, i, &serverPort, 0);
+        }
+    }
+    if (server.isNull())
+        return std::nullopt;
+
+    // AAAA first: the answers are interleaved starting with IPv6 (RFC 8305, section 4)
+    std::array<HostQuery, 2> queries = { HostQuery(ns_t_aaaa), HostQuery(ns_t_a) };
+    for (HostQuery &query : queries) {
+        query.length = prepareQueryBuffer(&state, query.buffer, aceName.constData(), ns_rcode(query.type));
+        if (query.length < 0)
+            return std::nullopt;
+    }
+    HostQuery &ipv6 = queries[0];
+    HostQuery &ipv4 = queries[1];
+    if (ipv4.id() == ipv6.id())
+        reinterpret_cast<HEADER *>(ipv4.buffer.data())->id = ipv6.id() ^ 1;
+
+    sockaddr_storage address;
+    const QT_SOCKLEN_T addressLength = setSockaddr(reinterpret_cast<sockaddr *>(&address), server, serverPort);
+    const int fd = qt_safe_socket(address.ss_family, SOCK_DGRAM, 0, O_NONBLOCK);
+    if (fd < 0)
+        return std::nullopt;
+    auto closeGuard = qScopeGuard([fd] { qt_safe_close(fd); });
+    // connected, so that only replies from the name server are received
+    if (qt_safe_connect(fd, reinterpret_cast<sockaddr *>(&address), addressLength) < 0)
+        return std::nullopt;
+
+    const int attempts = qBound(1, state.retry, 3);
+    const std::chrono::seconds attemptTimeout(qBound(1, state.retrans, 5));
+    QDnsLookupRunnable::ReplyBuffer buffer(QDnsLookupRunnable::ReplyBufferSize);
+    QDeadlineTimer resolutionDelay = QDeadlineTimer::Forever;
+
+    const auto allAnswered = [&] { return ipv4.answered && ipv6.answered; };
+    for (int attempt = 0; attempt < attempts && !allAnswered(); ++attempt) {
+        for (const HostQuery &query : queries) {
+            if (query.answered)
+                continue;
+            qint64 sent;
+            QT_EINTR_LOOP(sent, ::send(fd, query.buffer.data(), query.length, 0));
+            if (sent < 0)
+                return std::nullopt;
+        }
+
+        const QDeadlineTimer attemptDeadline(attemptTimeout);
+        while (!allAnswered()) {
+            pollfd pfd = qt_make_pollfd(fd, POLLIN);
+            const int ready = qt_safe_poll(&pfd, 1, qMin(attemptDeadline, resolutionDelay));
+            if (ready < 0)
+                return std::nullopt;
+            if (ready == 0)
+                break;
+
+            qint64 received;
+            QT_EINTR_LOOP(received, ::recv(fd, buffer.data(), buffer.size(), 0));
+            if (received < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                    continue;
+                return std::nullopt;    // e.g. ECONNREFUSED
+            }
+            if (received < HFIXEDSZ)
+                continue;
+
+            const auto header = reinterpret_cast<const HEADER *>(buffer.data());
+            const auto it = std::find_if(queries.begin(), queries.end(), [&](const HostQuery &q) {
+                return !q.answered && q.id() == header->id;
+            });
+            if (!header->qr || it == queries.end())
+                continue;               // not an answer to us, or a duplicate
+            if (header->tc)
+                return std::nullopt;    // leave the TCP retry to the system resolver
+
+            it->answered = true;
+            QDnsLookupRunnable::parseReply(&it->reply, buffer.data(), int(received));
+            if (it->isNegative())
+                it->negativeTimeToLive = negativeTimeToLive(buffer.data(), int(received));
+            if (ipv4.hasAddresses() && !ipv6.answered && resolutionDelay.isForever())
+                resolutionDelay.setRemainingTime(ResolutionDelay);
+        }
+
+        if (resolutionDelay.hasExpired())
+            break;              // we have IPv4 addresses and won't wait for IPv6 any longer
+    }
+
+    Result result;
+    if (ipv4.hasAddresses() || ipv6.hasAddresses()) {
+        quint32 ttl = std::numeric_limits<quint32>::max();
+        const auto addresses = [&ttl](const HostQuery &query) {
+            QList<QHostAddress> list;
+            for (const QDnsHostAddressRecord &record : query.reply.hostAddressRecords) {
+                ttl = qMin(ttl, record.timeToLive());
+                if (!list.contains(record.value()))
+                    list.append(record.value());
+            }
+            for (const QDnsDomainNameRecord &record : query.reply.canonicalNameRecords)
+                ttl = qMin(ttl, record.timeToLive());
+            return list;
+        };
+        const QList<QHostAddress> ipv6Addresses = addresses(ipv6);
+        const QList<QHostAddress> ipv4Addresses = addresses(ipv4);
+        for (qsizetype i = 0; i < qMax(ipv6Addresses.size(), ipv4Addresses.size()); ++i) {
+            if (i < ipv6Addresses.size())
+                result.addresses.append(ipv6Addresses.at(i));
+            if (i < ipv4Addresses.size())
+                result.addresses.append(ipv4Addresses.at(i));
+        }
+        result.timeToLive = std::chrono::seconds(ttl);
+        return result;
+    }
+
+    if (ipv4.isNegative() && ipv6.isNegative()) {
+        // Each answer may only be cached for the time its own SOA allows
+        // (RFC 2308, section 5), but NXDOMAIN says that the name has no
+        // records of any type: one of those with an SOA covers both types.
+        quint32 ttl = std::numeric_limits<quint32>::max();
+        for (const HostQuery &query : queries) {
+            if (query.negativeTimeToLive)
+                ttl = qMin(ttl, query.negativeTimeToLive);
+            else if (!query.isNameError())
+                ttl = 0;    // NODATA without SOA: this type must not be cached
+        }
+        result.error = QDnsLookup::NotFoundError;
+        result.timeToLive = std::chrono::seconds(ttl == std::numeric_limits<quint32>::max() ? 0 : ttl);
+        return result;
+    }
+
+    return std::nullopt;        // timed out or the server failed
+}
+
 QT_END_NAMESPACE
@@ -344,9 +344,10 @@ QHostInfo QHostInfo::fromName(const QString &name)
 #ifdef Q_OS_WASM
     return QHostInfoAgent::lookup(name);
 #else
-    QHostInfo hostInfo = QHostInfoAgent::fromName(name);
+    std::optional<std::chrono::seconds> timeToLive;
+    QHostInfo hostInfo = QHostInfoAgent::fromName(name, &timeToLive);
     QHostInfoLookupManager* manager = theHostInfoLookupManager();
-    manager->cache.put(name, hostInfo);
+    manager->cache.put(name, hostInfo, timeToLive);
     return hostInfo;
 #endif
 }
@@ -850,8 +851,9 @@ void QHostInfoRunnable::run()
         hostInfo = manager->cache.get(toBeLookedUp, &valid);
         if (!valid) {
             // not in cache, we need to do the lookup and store the result in the cache
-            hostInfo = QHostInfoAgent::fromName(toBeLookedUp);
-            manager->cache.put(toBeLookedUp, hostInfo);
+            std::optional<std::chrono::seconds> timeToLive;
+            hostInfo = QHostInfoAgent::fromName(toBeLookedUp, &timeToLive);
+            manager->cache.put(toBeLookedUp, hostInfo, timeToLive);
         }
     } else {
         // cache is not enabled, just do the lookup and continue
@@ -1105,7 +1107,7 @@ void qt_qhostinfo_cache_inject(const QString &hostname, const QHostInfo &resolut
 }
 #endif
 
-// cache for 60 seconds
+// cache for 60 seconds, unless the name server says otherwise
 // cache 128 items
 QHostInfoCache::QHostInfoCache() : max_age(60), enabled(true), cache(128)
 {
@@ -1120,7 +1122,7 @@ QHostInfo QHostInfoCache::get(const QString &name, bool *valid)
 
     *valid = false;
     if (QHostInfoCacheElement *element = cache.object(name)) {
-        if (element->age.elapsed() < max_age*1000)
+        if (!element->expiry.hasExpired())
             *valid = true;
         return element->info;
 
@@ -1132,16 +1134,30 @@ QHostInfo QHostInfoCache::get(const QString &name, bool *valid)
     return QHostInfo();
 }
 
-void QHostInfoCache::put(const QString &name, const QHostInfo &info)
+/*
+    Stores \a info for \a name. If \a timeToLive is set, it is the lifetime the
+    name server gave for the answer; the entry then expires with it, and a
+    reply that the name does not exist is cached as well (RFC 2308). Without
+    it, only successful lookups are cached, for max_age seconds.
+*/
+void QHostInfoCache::put(const QString &name, const QHostInfo &info,
+                         std::optional<std::chrono::seconds> timeToLive)
 {
-    // if the lookup failed, don't cache
-    if (info.error() != QHostInfo::NoError)
+    std::chrono::seconds lifetime(max_age);
+    if (timeToLive) {
+        if (info.error() != QHostInfo::NoError && info.error() != QHostInfo::HostNotFound)
+            return;
+        lifetime = qMin(*timeToLive, MaxTimeToLive);
+        if (lifetime <= std::chrono::seconds::zero())
+            return;
+    } else if (info.error() != QHostInfo::NoError) {
+        // if the lookup failed, don't cache
         return;
+    }
 
     QHostInfoCacheElement* element = new QHostInfoCacheElement();
     element->info = info;
-    element->age = QElapsedTimer();
-    element->age.start();
+    element->expiry = QDeadlineTimer(lifetime);
 
     QMutexLocker locker(&this->mutex);
     cache.insert(name, element); // cache will take ownership
@@ -31,10 +31,12 @@
 #include "QtCore/qrunnable.h"
 #include "QtCore/qlist.h"
 #include "QtCore/qqueue.h"
-#include <QElapsedTimer>
+#include <QDeadlineTimer>
 #include <QCache>
 
 #include <atomic>
+#include <chrono>
+#include <optional>
 
 QT_BEGIN_NAMESPACE
 
@@ -75,7 +77,9 @@ private:
 class QHostInfoAgent
 {
 public:
-    static QHostInfo fromName(const QString &hostName);
+    // timeToLive is set when the answer said how long it may be cached
+    static QHostInfo fromName(const QString &hostName,
+                              std::optional<std::chrono::seconds> *timeToLive = nullptr);
     static QHostInfo lookup(const QString &hostName);
     static QHostInfo reverseLookup(const QHostAddress &address);
 };
@@ -107,15 +111,22 @@ QHostInfo Q_NETWORK_EXPORT qt_qhostinfo_lookup(const QString &name, QObject *rec
 void Q_AUTOTEST_EXPORT qt_qhostinfo_clear_cache();
 void Q_AUTOTEST_EXPORT qt_qhostinfo_enable_cache(bool e);
 void Q_AUTOTEST_EXPORT qt_qhostinfo_cache_inject(const QString &hostname, const QHostInfo &resolution);
+#if QT_CONFIG(dnslookup) && QT_CONFIG(libresolv)
+void Q_AUTOTEST_EXPORT qt_qhostinfo_use_dns_resolver(bool enable, const QHostAddress &nameserver = {},
+                                                     quint16 port = 0);
+#endif
 
 class QHostInfoCache
 {
 public:
     QHostInfoCache();
-    const int max_age; // seconds
+    const int max_age; // seconds, for answers that don't say how long they're valid
+    // upper bound for the lifetimes reported by the name server
+    static constexpr std::chrono::seconds MaxTimeToLive{60 * 60};
 
     QHostInfo get(const QString &name, bool *valid);
-    void put(const QString &name, const QHostInfo &info);
+    void put(const QString &name, const QHostInfo &info,
+             std::optional<std::chrono::seconds> timeToLive = std::nullopt);
     void clear();
 
     bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
@@ -126,7 +137,7 @@ private:
     std::atomic<bool> enabled;
     struct QHostInfoCacheElement {
         QHostInfo info;
-        QElapsedTimer age;
+        QDeadlineTimer expiry;
     };
     QCache<QString,QHostInfoCacheElement> cache;
     QMutex mutex;
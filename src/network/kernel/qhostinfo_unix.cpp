@@ -7,6 +7,7 @@
 
 #include <qbytearray.h>
 #include <qfile.h>
+#include <qglobalstatic.h>
 #include <qplatformdefs.h>
 #include <qurl.h>
 
@@ -18,6 +19,10 @@
 #  include <resolv.h>
 #endif
 
+#if QT_CONFIG(dnslookup) && QT_CONFIG(libresolv)
+#  include "qdnslookup_p.h"
+#endif
+
 #ifndef _PATH_RESCONF
 #  define _PATH_RESCONF "/etc/resolv.conf"
 #endif
@@ -75,7 +80,82 @@ static void maybeRefreshResolver()
 #endif
 }
 
-QHostInfo QHostInfoAgent::fromName(const QString &hostName)
+#if QT_CONFIG(dnslookup) && QT_CONFIG(libresolv)
+namespace {
+struct DnsResolverSettings
+{
+    QMutex mutex;
+    bool enabled = qEnvironmentVariable("QT_HOSTINFO_RESOLVER") == "dns"_L1;
+    QHostAddress nameserver;
+    quint16 port = 0;
+};
+}
+Q_GLOBAL_STATIC(DnsResolverSettings, dnsResolverSettings)
+
+/*
+    Makes QHostInfo resolve host names by querying \a nameserver on \a port
+    directly (or the name server configured for the system, if
+    \a nameserver is null) instead of calling getaddrinfo(). This can also be
+    turned on by setting the QT_HOSTINFO_RESOLVER environment variable to
+    "dns".
+*/
+void qt_qhostinfo_use_dns_resolver(bool enable, const QHostAddress &nameserver, quint16 port)
+{
+    DnsResolverSettings *settings = dnsResolverSettings();
+    if (!settings)
+        return;
+    QMutexLocker locker(&settings->mutex);
+    settings->enabled = enable;
+    settings->nameserver = nameserver;
+    settings->port = port;
+}
+
+// Names that the system may resolve without DNS -- single labels completed
+// with the search list, mDNS -- are left to getaddrinfo(), and so is
+// everything the name server gave no definite answer for. A name the name
+// server has no addresses for is reported as not found.
+static std::optional<QHostInfo> lookupWithDns(const QString &hostName,
+                                              std::optional<std::chrono::seconds> *timeToLive)
+{
+    DnsResolverSettings *settings = dnsResolverSettings();
+    if (!settings)
+        return std::nullopt;
+    QMutexLocker locker(&settings->mutex);
+    if (!settings->enabled)
+        return std::nullopt;
+    const QHostAddress nameserver = settings->nameserver;
+    const quint16 port = settings->port;
+    locker.unlock();
+
+    QByteArray aceHostname = QUrl::toAce(hostName);
+    if (aceHostname.endsWith('.'))
+        aceHostname.chop(1);
+    if (!aceHostname.contains('.') || aceHostname.endsWith(".localhost")
+            || aceHostname.endsWith(".local")) {
+        return std::nullopt;
+    }
+
+    const std::optional<QDnsHostResolver::Result> answer =
+            QDnsHostResolver::resolve(aceHostname, nameserver, port);
+    if (!answer)
+        return std::nullopt;
+
+    QHostInfo results;
+    results.setHostName(hostName);
+    if (answer->error == QDnsLookup::NoError && !answer->addresses.isEmpty()) {
+        results.setAddresses(answer->addresses);
+    } else {
+        results.setError(QHostInfo::HostNotFound);
+        results.setErrorString(QCoreApplication::translate("QHostInfoAgent", "Host not found"));
+    }
+    if (timeToLive)
+        *timeToLive = answer->timeToLive;
+    return results;
+}
+#endif // dnslookup && libresolv
+
+QHostInfo QHostInfoAgent::fromName(const QString &hostName,
+                                   std::optional<std::chrono::seconds> *timeToLive)
 {
     QHostInfo results;
 
@@ -90,6 +170,24 @@ QHostInfo QHostInfoAgent::fromName(const QString &hostName)
     if (address.setAddress(hostName))
         return reverseLookup(address);
 
+#if QT_CONFIG(dnslookup) && QT_CONFIG(libresolv)
+    if (std::optional<QHostInfo> dnsResults = lookupWithDns(hostName, timeToLive)) {
+        if (dnsResults->error() == QHostInfo::NoError)
+            return *std::move(dnsResults);
+        // The name may still be in the hosts file, or be found once
+        // getaddrinfo() applies the search list to it. Otherwise the answer
+        // of the name server stands, with its time to live.
+        results = lookup(hostName);
+        if (results.error() != QHostInfo::NoError)
+            return *std::move(dnsResults);
+        if (timeToLive)
+            timeToLive->reset();
+        return results;
+    }
+#else
+    Q_UNUSED(timeToLive);
+#endif
+
     return lookup(hostName);
 }
 
@@ -19,8 +19,11 @@ QT_BEGIN_NAMESPACE
 #define NI_MAXHOST 1024
 #endif
 
-QHostInfo QHostInfoAgent::fromName(const QString &hostName)
+QHostInfo QHostInfoAgent::fromName(const QString &hostName,
+                                   std::optional<std::chrono::seconds> *timeToLive)
 {
+    Q_UNUSED(timeToLive);
+
     QSysInfo::machineHostName();        // this initializes ws2_32.dll
 
     QHostInfo results;
@@ -435,6 +435,7 @@
 #include "private/qhostinfo_p.h"
 
 #include <qabstracteventdispatcher.h>
+#include <qfile.h>
 #include <qhostaddress.h>
 #include <qhostinfo.h>
 #include <qmetaobject.h>
@@ -517,6 +518,7 @@ void QAbstractSocketPrivate::resetSocketLayer()
 #endif
 
     hasPendingData = false;
+    stopFileTransmission();
     if (socketEngine) {
         socketEngine->close();
         socketEngine->disconnect();
@@ -751,6 +753,15 @@ void QAbstractSocketPrivate::connectionNotification()
 bool QAbstractSocketPrivate::writeToSocket()
 {
     Q_Q(QAbstractSocket);
+    if (transmitRemaining > 0 && writeBuffer.isEmpty() && socketEngine && socketEngine->isValid()
+        && socketEngine->bytesToWrite() == 0) {
+        // Everything written before transmitFile() is out; continue with the file.
+        if (transmitDirectly)
+            return sendFileToSocket();
+        if (!bufferFileChunk())
+            return false;
+    }
+
     if (!socketEngine || !socketEngine->isValid() || (writeBuffer.isEmpty()
         && socketEngine->bytesToWrite() == 0)) {
 #if defined (QABSTRACTSOCKET_DEBUG)
@@ -798,14 +809,168 @@ bool QAbstractSocketPrivate::writeToSocket()
         emitBytesWritten(written);
     }
 
-    if (writeBuffer.isEmpty() && socketEngine && !socketEngine->bytesToWrite())
+    if (writeBuffer.isEmpty() && socketEngine && !socketEngine->bytesToWrite()
+        && transmitRemaining == 0) {
         socketEngine->setWriteNotificationEnabled(false);
+    }
     if (state == QAbstractSocket::ClosingState)
         q->disconnectFromHost();
 
     return written > 0;
 }
 
+/*! \internal
+
+    Returns \c true if the file passed to transmitFile() can be handed to the
+    socket engine as a file descriptor, so that the kernel copies the data
+    without passing it through user space.
+*/
+bool QAbstractSocketPrivate::canTransmitFileDirectly() const
+{
+    return socketType == QAbstractSocket::TcpSocket;
+}
+
+/*! \internal
+
+    Starts writing the file set up by transmitFile(). The data is written from
+    writeToSocket() once the write buffer has been flushed.
+*/
+void QAbstractSocketPrivate::startFileTransmission()
+{
+    transmitDirectly = canTransmitFileDirectly() && transmittedFile->handle() != -1;
+    if (socketEngine)
+        socketEngine->setWriteNotificationEnabled(true);
+}
+
+/*! \internal
+
+    Lets the socket engine write the next part of the transmitted file
+    directly from its file descriptor. Falls back to bufferFileChunk() if the
+    engine does not support that.
+
+    Emits bytesWritten().
+*/
+bool QAbstractSocketPrivate::sendFileToSocket()
+{
+    Q_Q(QAbstractSocket);
+    if (!transmittedFile) {
+        stopFileTransmission();
+        setErrorAndEmit(QAbstractSocket::UnknownSocketError,
+                        QAbstractSocket::tr("File destroyed during transmission"));
+        q->abort();
+        return false;
+    }
+
+    qint64 written = socketEngine->sendFile(transmittedFile->handle(), transmitOffset,
+                                            transmitRemaining);
+    if (written < 0) {
+        if (socketEngine->error() == QAbstractSocket::UnsupportedSocketOperationError) {
+            // Not possible for this file or platform, copy it instead.
+            transmitDirectly = false;
+            return bufferFileChunk() && writeToSocket();
+        }
+        setErrorAndEmit(socketEngine->error(), socketEngine->errorString());
+        q->abort();
+        return false;
+    }
+
+#if defined (QABSTRACTSOCKET_DEBUG)
+    qDebug("QAbstractSocketPrivate::sendFileToSocket() %lld bytes of file sent to the network",
+           written);
+#endif
+
+    transmitOffset += written;
+    transmitRemaining -= written;
+    if (transmitRemaining == 0) {
+        finishFileTransmission();
+        if (writeBuffer.isEmpty())
+            socketEngine->setWriteNotificationEnabled(false);
+    }
+
+    if (written > 0)
+        emitBytesWritten(written);
+
+    if (state == QAbstractSocket::ClosingState)
+        q->disconnectFromHost();
+
+    return written > 0;
+}
+
+/*! \internal
+
+    Reads the next chunk of the file passed to transmitFile(). Returns an
+    empty byte array and sets the socket error if the file could not be read.
+*/
+QByteArray QAbstractSocketPrivate::readFileChunk()
+{
+    QByteArray chunk;
+    if (transmittedFile && transmittedFile->seek(transmitOffset)) {
+        chunk.resize(qMin(transmitRemaining, TransmitChunkSize));
+        const qint64 readBytes = transmittedFile->read(chunk.data(), chunk.size());
+        chunk.resize(qMax(readBytes, Q_INT64_C(0)));
+    }
+
+    if (chunk.isEmpty()) {
+        const QString reason = transmittedFile ? transmittedFile->errorString()
+                                               : QAbstractSocket::tr("File destroyed during transmission");
+        stopFileTransmission();
+        setErrorAndEmit(QAbstractSocket::UnknownSocketError, reason);
+        return chunk;
+    }
+
+    transmitOffset += chunk.size();
+    transmitRemaining -= chunk.size();
+    return chunk;
+}
+
+/*! \internal
+
+    Appends the next chunk of the transmitted file to the write buffer.
+    Returns \c false if the file could not be read.
+*/
+bool QAbstractSocketPrivate::bufferFileChunk()
+{
+    Q_Q(QAbstractSocket);
+    const QByteArray chunk = readFileChunk();
+    if (chunk.isEmpty()) {
+        q->abort();
+        return false;
+    }
+    writeBuffer.append(chunk);
+    if (transmitRemaining == 0)
+        finishFileTransmission();
+    return true;
+}
+
+/*! \internal
+
+    Called once the whole file passed to transmitFile() has been handed over
+    to the write buffer or the socket engine. Data written while the
+    transmission was in progress is queued after it.
+*/
+void QAbstractSocketPrivate::finishFileTransmission()
+{
+    Q_Q(QAbstractSocket);
+    const QByteArray trailer = std::exchange(transmitTrailer, {});
+    stopFileTransmission();
+    if (!trailer.isEmpty())
+        q->write(trailer);
+}
+
+/*! \internal
+
+    Forgets about the file passed to transmitFile() and anything written
+    after it.
+*/
+void QAbstractSocketPrivate::stopFileTransmission()
+{
+    transmittedFile = nullptr;
+    transmitOffset = 0;
+    transmitRemaining = 0;
+    transmitDirectly = false;
+    transmitTrailer.clear();
+}
+
 /*! \internal
 
     Writes pending data in the write buffers to the socket. The function
@@ -816,7 +981,7 @@ bool QAbstractSocketPrivate::flush()
 {
     bool dataWasWritten = false;
 
-    while (!allWriteBuffersEmpty() && writeToSocket())
+    while ((!allWriteBuffersEmpty() || transmitRemaining > 0) && writeToSocket())
         dataWasWritten = true;
 
     return dataWasWritten;
@@ -1740,7 +1905,9 @@ void QAbstractSocket::connectToHost(const QHostAddress &address, quint16 port,
 */
 qint64 QAbstractSocket::bytesToWrite() const
 {
-    const qint64 pendingBytes = QIODevice::bytesToWrite();
+    Q_D(const QAbstractSocket);
+    const qint64 pendingBytes = QIODevice::bytesToWrite() + d->transmitRemaining
+                                + d->transmitTrailer.size();
 #if defined(QABSTRACTSOCKET_DEBUG)
     qDebug("QAbstractSocket::bytesToWrite() == %lld", pendingBytes);
 #endif
@@ -2165,7 +2332,8 @@ bool QAbstractSocket::waitForReadyRead(int msecs)
 
         bool readyToRead = false;
         bool readyToWrite = false;
-        if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, true, !d->writeBuffer.isEmpty(),
+        if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, true,
+                                                 !d->writeBuffer.isEmpty() || d->transmitRemaining > 0,
                                                  deadline)) {
 #if defined (QABSTRACTSOCKET_DEBUG)
             qDebug("QAbstractSocket::waitForReadyRead(%i) failed (%i, %s)",
@@ -2217,7 +2385,7 @@ bool QAbstractSocket::waitForBytesWritten(int msecs)
         return false;
     }
 
-    if (d->writeBuffer.isEmpty())
+    if (d->writeBuffer.isEmpty() && d->transmitRemaining == 0)
         return false;
 
     QDeadlineTimer deadline{msecs};
@@ -2233,7 +2401,7 @@ bool QAbstractSocket::waitForBytesWritten(int msecs)
         bool readyToWrite = false;
         if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite,
                                   !d->readBufferMaxSize || d->buffer.size() < d->readBufferMaxSize,
-                                  !d->writeBuffer.isEmpty(),
+                                  !d->writeBuffer.isEmpty() || d->transmitRemaining > 0,
                                   deadline)) {
 #if defined (QABSTRACTSOCKET_DEBUG)
             qDebug("QAbstractSocket::waitForBytesWritten(%i) failed (%i, %s)",
@@ -2312,7 +2480,7 @@ bool QAbstractSocket::waitForDisconnected(int msecs)
         bool readyToRead = false;
         bool readyToWrite = false;
         if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, state() == ConnectedState,
-                                               !d->writeBuffer.isEmpty(),
+                                               !d->writeBuffer.isEmpty() || d->transmitRemaining > 0,
                                                deadline)) {
 #if defined (QABSTRACTSOCKET_DEBUG)
             qDebug("QAbstractSocket::waitForReadyRead(%i) failed (%i, %s)",
@@ -2379,6 +2547,66 @@ bool QAbstractSocket::flush()
     return d_func()->flush();
 }
 
+/*!
+    \since 6.9
+
+    Starts writing \a length bytes of \a file, beginning at \a offset, to
+    the socket. If \a length is negative or exceeds the end of the file, the
+    rest of the file from \a offset is written. Returns \c true if the
+    transmission was started; otherwise returns \c false.
+
+    The data is written asynchronously, after any data that is already
+    waiting to be written, and progress is reported through the
+    bytesWritten() signal. bytesToWrite() includes the part of the file that
+    has not been written yet. Data written to the socket while the
+    transmission is in progress is sent after the file.
+
+    Where the platform supports it (\c sendfile() on Linux), the contents of
+    \a file are handed to the kernel without being copied into the socket's
+    write buffer. Otherwise, and for sockets that need to process the data
+    themselves, such as QSslSocket on an encrypted connection or sockets
+    connected through a proxy, the file is read and written in chunks of
+    limited size.
+
+    \a file must be open for reading and must remain valid until the
+    transmission has finished. Only one transmission can be in progress at a
+    time, and only TCP sockets in ConnectedState are supported.
+
+    \sa bytesToWrite(), waitForBytesWritten()
+*/
+bool QAbstractSocket::transmitFile(QFile *file, qint64 offset, qint64 length)
+{
+    Q_D(QAbstractSocket);
+    if (d->socketType != TcpSocket || d->state != ConnectedState || !isWritable()) {
+        qWarning("QAbstractSocket::transmitFile() requires a connected and writable TCP socket");
+        return false;
+    }
+    if (!file || !file->isReadable()) {
+        qWarning("QAbstractSocket::transmitFile() requires a file open for reading");
+        return false;
+    }
+    if (d->transmitRemaining > 0) {
+        qWarning("QAbstractSocket::transmitFile() called while a transmission is in progress");
+        return false;
+    }
+
+    const qint64 size = file->size();
+    if (offset < 0 || offset > size) {
+        qWarning("QAbstractSocket::transmitFile() called with an invalid offset");
+        return false;
+    }
+    if (length < 0 || length > size - offset)
+        length = size - offset;
+    if (length == 0)
+        return true;
+
+    d->transmittedFile = file;
+    d->transmitOffset = offset;
+    d->transmitRemaining = length;
+    d->startFileTransmission();
+    return true;
+}
+
 /*! \reimp
 */
 qint64 QAbstractSocket::readData(char *data, qint64 maxSize)
@@ -2430,6 +2658,12 @@ qint64 QAbstractSocket::writeData(const char *data, qint64 size)
         return -1;
     }
 
+    if (d->transmitRemaining > 0) {
+        // Keep the order: this goes out after the file being transmitted.
+        d->transmitTrailer.append(data, size);
+        return size;
+    }
+
     if (!d->isBuffered && d->socketType == TcpSocket
         && d->socketEngine && d->writeBuffer.isEmpty()) {
         // This code is for the new Unbuffered QTcpSocket use case
@@ -2659,7 +2893,7 @@ void QAbstractSocket::disconnectFromHost()
 
         // Wait for pending data to be written.
         if (d->socketEngine && d->socketEngine->isValid() && (!d->allWriteBuffersEmpty()
-            || d->socketEngine->bytesToWrite() > 0)) {
+            || d->socketEngine->bytesToWrite() > 0 || d->transmitRemaining > 0)) {
             d->socketEngine->setWriteNotificationEnabled(true);
 
 #if defined(QABSTRACTSOCKET_DEBUG)
@@ -19,6 +19,7 @@
 #include "QtNetwork/qabstractsocket.h"
 #include "QtCore/qbytearray.h"
 #include "QtCore/qlist.h"
+#include "QtCore/qpointer.h"
 #include "QtCore/qtimer.h"
 #include "private/qiodevice_p.h"
 #include "private/qabstractsocketengine_p.h"
@@ -26,6 +27,7 @@
 
 QT_BEGIN_NAMESPACE
 
+class QFile;
 class QHostInfo;
 
 class QAbstractSocketPrivate : public QIODevicePrivate, public QAbstractSocketEngineReceiver
@@ -104,6 +106,24 @@ public:
     void emitReadyRead(int channel = 0);
     void emitBytesWritten(qint64 bytes, int channel = 0);
 
+    // file transmission (transmitFile())
+    // Large enough to keep the connection busy, small enough to keep the
+    // memory usage of a copying transmission bounded.
+    static constexpr qint64 TransmitChunkSize = 256 * 1024;
+    virtual bool canTransmitFileDirectly() const;
+    virtual void startFileTransmission();
+    bool sendFileToSocket();
+    bool bufferFileChunk();
+    QByteArray readFileChunk();
+    void finishFileTransmission();
+    void stopFileTransmission();
+
+    QPointer<QFile> transmittedFile;
+    qint64 transmitOffset = 0;
+    qint64 transmitRemaining = 0;
+    QByteArray transmitTrailer;
+    bool transmitDirectly = false;
+
     void setError(QAbstractSocket::SocketError errorCode, const QString &errorString);
     void setErrorAndEmit(QAbstractSocket::SocketError errorCode, const QString &errorString);
 
@@ -92,6 +92,28 @@ QAbstractSocketEngine *QAbstractSocketEngine::createSocketEngine(qintptr socketD
     return new QNativeSocketEngine(parent);
 }
 
+/*!
+    \internal
+
+    Writes up to \a len bytes starting at \a offset of the file referred to by
+    \a fileDescriptor directly to the socket, without copying them through
+    user space. Returns the number of bytes written, 0 if the socket cannot
+    accept more data right now, or -1 if an error occurred.
+
+    Engines that cannot transfer files natively set the error to
+    QAbstractSocket::UnsupportedSocketOperationError and return -1; the caller
+    is then expected to fall back to read() and write().
+*/
+qint64 QAbstractSocketEngine::sendFile(qintptr fileDescriptor, qint64 offset, qint64 len)
+{
+    Q_UNUSED(fileDescriptor);
+    Q_UNUSED(offset);
+    Q_UNUSED(len);
+    setError(QAbstractSocket::UnsupportedSocketOperationError,
+             QLatin1StringView(QT_TRANSLATE_NOOP(QSocketLayer, "Unsupported socket operation")));
+    return -1;
+}
+
 QAbstractSocket::SocketError QAbstractSocketEngine::error() const
 {
     return d_func()->socketError;
@@ -882,6 +882,22 @@ qint64 QNativeSocketEngine::write(const char *data, qint64 size)
     return d->nativeWrite(data, size);
 }
 
+/*!
+    Writes up to \a len bytes starting at \a offset of the file referred to
+    by \a fileDescriptor to the socket, letting the kernel copy the data
+    directly. Returns the number of bytes written, or -1 if an error
+    occurred. If the platform or the file does not support this,
+    QAbstractSocket::UnsupportedSocketOperationError is set.
+*/
+qint64 QNativeSocketEngine::sendFile(qintptr fileDescriptor, qint64 offset, qint64 len)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::sendFile(), -1);
+    Q_CHECK_STATE(QNativeSocketEngine::sendFile(), QAbstractSocket::ConnectedState, -1);
+    Q_CHECK_TYPE(QNativeSocketEngine::sendFile(), QAbstractSocket::TcpSocket, -1);
+    return d->nativeSendFile(fileDescriptor, offset, len);
+}
+
 
 qint64 QNativeSocketEngine::bytesToWrite() const
 {
@@ -146,6 +146,7 @@ public:
     qint64 nativeSendDatagram(const char *data, qint64 length, const QIpPacketHeader &header);
     qint64 nativeRead(char *data, qint64 maxLength);
     qint64 nativeWrite(const char *data, qint64 length);
+    qint64 nativeSendFile(qintptr fileDescriptor, qint64 offset, qint64 length);
     int nativeSelect(QDeadlineTimer deadline, bool selectForRead) const;
     int nativeSelect(QDeadlineTimer deadline, bool checkRead, bool checkWrite,
                      bool *selectForRead, bool *selectForWrite) const;
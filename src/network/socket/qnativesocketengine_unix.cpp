@@ -17,9 +17,13 @@
 #include <time.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <limits>
 #ifdef Q_OS_INTEGRITY
 #include <sys/uio.h>
 #endif
+#ifdef Q_OS_LINUX
+#include <sys/sendfile.h>
+#endif
 
 #if defined QNATIVESOCKETENGINE_DEBUG
 #include <private/qdebug_p.h>
@@ -1297,6 +1301,69 @@ qint64 QNativeSocketEnginePrivate::nativeWrite(const char *data, qint64 len)
 
     return qint64(writtenBytes);
 }
+
+qint64 QNativeSocketEnginePrivate::nativeSendFile(qintptr fileDescriptor, qint64 offset, qint64 len)
+{
+#ifdef Q_OS_LINUX
+    Q_Q(QNativeSocketEngine);
+
+    // sendfile() transfers at most 0x7ffff000 bytes per call anyway
+    const size_t count = size_t(qMin<qint64>(len, std::numeric_limits<int>::max()));
+    off_t pos = off_t(offset);
+    qt_ignore_sigpipe();
+    ssize_t writtenBytes;
+    QT_EINTR_LOOP(writtenBytes, ::sendfile(socketDescriptor, int(fileDescriptor), &pos, count));
+
+    if (writtenBytes == 0 && count > 0) {
+        // end of file reached early; let the caller read it to find out why
+        writtenBytes = -1;
+        setError(QAbstractSocket::UnsupportedSocketOperationError, OperationUnsupportedErrorString);
+    } else if (writtenBytes < 0) {
+        switch (errno) {
+        case EPIPE:
+        case ECONNRESET:
+            writtenBytes = -1;
+            setError(QAbstractSocket::RemoteHostClosedError, RemoteHostClosedErrorString);
+            q->close();
+            break;
+#if EWOULDBLOCK != EAGAIN
+        case EWOULDBLOCK:
+#endif
+        case EAGAIN:
+            writtenBytes = 0;
+            break;
+        case EINVAL:
+        case ENOSYS:
+        case EOVERFLOW:
+            // EINVAL: the file does not support mmap-like operations (pipes,
+            // some special and network file systems), is locked, or the
+            // socket was opened with O_APPEND. EOVERFLOW: the transfer would
+            // go past the largest offset the file (e.g. one opened without
+            // O_LARGEFILE) or the socket supports. The caller falls back to
+            // read() and write() in all these cases.
+            setError(QAbstractSocket::UnsupportedSocketOperationError, OperationUnsupportedErrorString);
+            break;
+        default:
+            setError(QAbstractSocket::UnknownSocketError, WriteErrorString);
+            break;
+        }
+    }
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeSendFile(%lld, %lld, %lld) == %lld",
+           qint64(fileDescriptor), offset, len, qint64(writtenBytes));
+#endif
+
+    return qint64(writtenBytes);
+#else
+    Q_UNUSED(fileDescriptor);
+    Q_UNUSED(offset);
+    Q_UNUSED(len);
+    setError(QAbstractSocket::UnsupportedSocketOperationError, OperationUnsupportedErrorString);
+    return -1;
+#endif
+}
+
 /*
 */
 qint64 QNativeSocketEnginePrivate::nativeRead(char *data, qint64 maxSize)
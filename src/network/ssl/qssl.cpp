@@ -126,6 +126,12 @@ Q_LOGGING_CATEGORY(lcSsl, "qt.network.ssl");
     chosen based on the servers preferences rather than the order ciphers were
     sent by the client. This option is only relevant to server sockets, and is
     only honored by the OpenSSL backend.
+    \value SslOptionDisableSessionCache Disables the process-wide cache of TLS
+    sessions. When the cache is enabled, client sockets store the sessions
+    they establish and offer them again when connecting to the same peer with
+    the same configuration, and QSslServer shares session state between its
+    connections so that these sessions can be resumed. This option is
+    currently only honored by the OpenSSL backend. (since 6.9)
 
     By default, SslOptionDisableEmptyFragments is turned on since this causes
     problems with a large number of servers. SslOptionDisableLegacyRenegotiation
@@ -133,6 +139,8 @@ Q_LOGGING_CATEGORY(lcSsl, "qt.network.ssl");
     SslOptionDisableCompression is turned on to prevent the attack publicised by
     CRIME.
     SslOptionDisableSessionPersistence is turned on to optimize memory usage.
+    SslOptionDisableSessionCache is turned on, so that sessions are only
+    shared between connections when the application asks for it.
     The other options are turned off.
 
     \note Availability of above options depends on the version of the SSL
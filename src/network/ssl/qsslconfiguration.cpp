@@ -17,7 +17,8 @@ QT_IMPL_METATYPE_EXTERN(QSslConfiguration)
 const QSsl::SslOptions QSslConfigurationPrivate::defaultSslOptions = QSsl::SslOptionDisableEmptyFragments
                                                                     |QSsl::SslOptionDisableLegacyRenegotiation
                                                                     |QSsl::SslOptionDisableCompression
-                                                                    |QSsl::SslOptionDisableSessionPersistence;
+                                                                    |QSsl::SslOptionDisableSessionPersistence
+                                                                    |QSsl::SslOptionDisableSessionCache;
 
 const char QSslConfiguration::ALPNProtocolHTTP2[] = "h2";
 const char QSslConfiguration::NextProtocolHttp1_1[] = "http/1.1";
@@ -981,6 +982,12 @@ QMap<QByteArray, QVariant> QSslConfiguration::backendConfiguration() const
     {https://www.openssl.org/docs/manmaster/man3/SSL_CONF_cmd.html#EXAMPLES}{examples}
     show how to use some of the options.
 
+    On Linux, setting \c Options to \c KTLS lets the OpenSSL backend hand the
+    encryption of outgoing data over to the kernel, after a TLS 1.3 handshake
+    as a client. QAbstractSocket::transmitFile() can then send files without
+    copying them through the application. If the kernel does not support
+    this, the option has no effect.
+
     \note The backend-specific configuration will be applied after the general
     configuration. Using the backend-specific configuration to set a general
     configuration option again will overwrite the general configuration option.
@@ -180,6 +180,7 @@
 
 #include "qsslserver.h"
 #include "qsslserver_p.h"
+#include "qsslsocket_p.h"
 
 #include <QtNetwork/QSslSocket>
 #include <QtNetwork/QSslCipher>
@@ -223,6 +224,7 @@ void QSslServer::setSslConfiguration(const QSslConfiguration &sslConfiguration)
 {
     Q_D(QSslServer);
     d->sslConfiguration = sslConfiguration;
+    d->sharedContext.reset();
 }
 
 /*!
@@ -270,6 +272,61 @@ int QSslServer::handshakeTimeout() const
     return d->handshakeTimeout;
 }
 
+/*!
+    \since 6.9
+
+    Sets the time after which the keys protecting the session tickets issued
+    by this server are replaced to \a lifetime.
+
+    Session tickets let clients resume earlier sessions, which makes their
+    handshakes considerably cheaper. They are only issued and accepted when
+    QSsl::SslOptionDisableSessionCache is turned off in the
+    \l{setSslConfiguration()}{SSL configuration}; all connections accepted by
+    this server then share their session state. Replacing the keys limits how
+    long a compromised key could be used to decrypt recorded traffic; clients
+    holding tickets issued under the previous keys perform a full handshake.
+
+    By default the keys are replaced every hour. A \a lifetime of zero or less
+    means that they are never replaced automatically.
+
+    \note The new lifetime applies from the next replacement of the keys on.
+
+    \sa sessionTicketKeyLifetime(), rotateSessionTicketKeys()
+*/
+void QSslServer::setSessionTicketKeyLifetime(std::chrono::seconds lifetime)
+{
+    Q_D(QSslServer);
+    d->sessionTicketKeyLifetime = lifetime;
+}
+
+/*!
+    \since 6.9
+
+    Returns the time after which the session ticket keys are replaced.
+
+    \sa setSessionTicketKeyLifetime()
+*/
+std::chrono::seconds QSslServer::sessionTicketKeyLifetime() const
+{
+    const Q_D(QSslServer);
+    return d->sessionTicketKeyLifetime;
+}
+
+/*!
+    \since 6.9
+
+    Replaces the keys protecting session tickets and forgets all sessions
+    established so far. Connections accepted afterwards cannot resume sessions
+    of earlier connections.
+
+    \sa setSessionTicketKeyLifetime()
+*/
+void QSslServer::rotateSessionTicketKeys()
+{
+    Q_D(QSslServer);
+    d->sharedContext.reset();
+}
+
 /*!
     Called when a new connection is established.
 
@@ -301,6 +358,7 @@ void QSslServer::incomingConnection(qintptr socket)
         connect(pSslSocket, &QSslSocket::encrypted, this, [this, pSslSocket]() {
             Q_D(QSslServer);
             d->removeSocketData(quintptr(pSslSocket));
+            d->handshakeFinished(pSslSocket);
             pSslSocket->disconnect(this);
             addPendingConnection(pSslSocket);
         });
@@ -392,10 +450,53 @@ void QSslServerPrivate::checkClientHelloAndContinue()
     if (foundData)
         it->timeoutTimer->start();
 
+    shareTlsContext(socket);
     socket->startServerEncryption();
     Q_EMIT q->startedEncryptionHandshake(socket);
 }
 
+bool QSslServerPrivate::isSessionCacheEnabled() const
+{
+    return !sslConfiguration.testSslOption(QSsl::SslOptionDisableSessionCache);
+}
+
+/*!
+    \internal
+
+    Hands the TLS context of earlier connections to \a socket, so that the
+    client can resume a session it established with this server before.
+*/
+void QSslServerPrivate::shareTlsContext(QSslSocket *socket)
+{
+    if (!isSessionCacheEnabled() || !sharedContext)
+        return;
+
+    if (sessionTicketKeyLifetime.count() > 0 && sharedContextExpiry.hasExpired()) {
+        sharedContext.reset();
+        return;
+    }
+
+    QSslSocketPrivate::checkSettingSslContext(socket, sharedContext);
+}
+
+/*!
+    \internal
+
+    Adopts the TLS context of \a socket for the following connections if
+    there is none yet.
+*/
+void QSslServerPrivate::handshakeFinished(QSslSocket *socket)
+{
+    if (!isSessionCacheEnabled())
+        return;
+
+    if (!sharedContext) {
+        sharedContext = QSslSocketPrivate::sslContext(socket);
+        if (sessionTicketKeyLifetime.count() > 0)
+            sharedContextExpiry.setRemainingTime(sessionTicketKeyLifetime);
+    }
+}
+
 void QSslServerPrivate::handleHandshakeTimedOut(QSslSocket *socket)
 {
     Q_Q(QSslServer);
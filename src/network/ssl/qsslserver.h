@@ -16,6 +16,8 @@ QT_REQUIRE_CONFIG(ssl);
 
 #include <QtCore/QList>
 
+#include <chrono>
+
 QT_BEGIN_NAMESPACE
 
 class QSslSocket;
@@ -36,6 +38,10 @@ public:
     void setHandshakeTimeout(int timeout);
     int handshakeTimeout() const;
 
+    void setSessionTicketKeyLifetime(std::chrono::seconds lifetime);
+    std::chrono::seconds sessionTicketKeyLifetime() const;
+    void rotateSessionTicketKeys();
+
 Q_SIGNALS:
     void sslErrors(QSslSocket *socket, const QList<QSslError> &errors);
     void peerVerifyError(QSslSocket *socket, const QSslError &error);
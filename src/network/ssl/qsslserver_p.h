@@ -18,18 +18,23 @@
 
 #include <QtNetwork/private/qtnetworkglobal_p.h>
 
+#include <QtCore/qdeadlinetimer.h>
 #include <QtCore/qhash.h>
 #include <QtCore/qtimer.h>
 
 #include <QtNetwork/QSslConfiguration>
 #include <QtNetwork/private/qtcpserver_p.h>
+#include <memory>
 #include <utility>
 
 QT_BEGIN_NAMESPACE
 
+class QSslContext;
+
 class Q_NETWORK_EXPORT QSslServerPrivate : public QTcpServerPrivate
 {
     static constexpr int DefaultHandshakeTimeout = 5'000; // 5 seconds
+    static constexpr std::chrono::seconds DefaultSessionTicketKeyLifetime{60 * 60}; // 1 hour
 public:
     Q_DECLARE_PUBLIC(QSslServer)
 
@@ -39,6 +44,9 @@ public:
     void removeSocketData(quintptr socket);
     void handleHandshakeTimedOut(QSslSocket *socket);
     int totalPendingConnections() const override;
+    bool isSessionCacheEnabled() const;
+    void shareTlsContext(QSslSocket *socket);
+    void handshakeFinished(QSslSocket *socket);
 
     struct SocketData {
         QMetaObject::Connection readyReadConnection;
@@ -63,6 +71,13 @@ public:
 
     QSslConfiguration sslConfiguration;
     int handshakeTimeout = DefaultHandshakeTimeout;
+
+    // The TLS context handed to all incoming connections, so that they share
+    // OpenSSL's session cache and session ticket keys. Replacing it discards
+    // both, which is how the ticket keys are rotated.
+    std::shared_ptr<QSslContext> sharedContext;
+    QDeadlineTimer sharedContextExpiry;
+    std::chrono::seconds sessionTicketKeyLifetime = DefaultSessionTicketKeyLifetime;
 };
 
 
@@ -349,6 +349,7 @@
 #include "qsslcipher.h"
 #include "qocspresponse.h"
 #include "qtlsbackend_p.h"
+#include "qtlssessioncache_p.h"
 #include "qsslconfiguration_p.h"
 #include "qsslsocket_p.h"
 
@@ -805,9 +806,10 @@ qint64 QSslSocket::bytesAvailable() const
 qint64 QSslSocket::bytesToWrite() const
 {
     Q_D(const QSslSocket);
+    const qint64 pendingTransmission = d->transmitRemaining + d->transmitTrailer.size();
     if (d->mode == UnencryptedMode)
-        return d->plainSocket ? d->plainSocket->bytesToWrite() : 0;
-    return d->writeBuffer.size();
+        return (d->plainSocket ? d->plainSocket->bytesToWrite() : 0) + pendingTransmission;
+    return d->writeBuffer.size() + pendingTransmission + d->offloadedRemaining;
 }
 
 /*!
@@ -1887,7 +1889,10 @@ void QSslSocket::disconnectFromHost()
     if (d->state == UnconnectedState)
         return;
     if (d->mode == UnencryptedMode && !d->autoStartHandshake) {
-        d->plainSocket->disconnectFromHost();
+        if (d->transmitRemaining > 0)
+            d->pendingClose = true; // feedFileTransmission() disconnects later
+        else
+            d->plainSocket->disconnectFromHost();
         return;
     }
     if (d->state <= ConnectingState) {
@@ -1905,7 +1910,7 @@ void QSslSocket::disconnectFromHost()
         emit stateChanged(d->state);
     }
 
-    if (!d->writeBuffer.isEmpty()) {
+    if (!d->writeBuffer.isEmpty() || d->transmitRemaining > 0) {
         d->pendingClose = true;
         return;
     }
@@ -1951,6 +1956,12 @@ qint64 QSslSocket::writeData(const char *data, qint64 len)
 #ifdef QSSLSOCKET_DEBUG
     qCDebug(lcSsl) << "QSslSocket::writeData(" << (void *)data << ',' << len << ')';
 #endif
+    if (d->transmitRemaining > 0) {
+        // Keep the order: this goes out after the file being transmitted.
+        d->transmitTrailer.append(data, len);
+        return len;
+    }
+
     if (d->mode == UnencryptedMode && !d->autoStartHandshake)
         return d->plainSocket->write(data, len);
 
@@ -2046,6 +2057,13 @@ void QSslSocketPrivate::init()
     abortCalled = false;
     pendingClose = false;
     flushTriggered = false;
+    stopFileTransmission();
+    offloadedAhead = 0;
+    offloadedRemaining = 0;
+    sessionCacheKey.clear();
+    cachedSession.clear();
+    offeredSession.clear();
+    cachedSessionLifetimeHint = -1;
     // We don't want to clear the ignoreErrorsList, so
     // that it is possible setting it before connecting.
 
@@ -2593,10 +2611,81 @@ void QSslSocketPrivate::_q_bytesWrittenSlot(qint64 written)
         emit q->bytesWritten(written);
     else
         emit q->encryptedBytesWritten(written);
+    if (offloadedRemaining > 0) {
+        // The plain socket wrote (a part of) an offloaded file, which the
+        // kernel has encrypted for us.
+        const qint64 skipped = qMin(written, offloadedAhead);
+        offloadedAhead -= skipped;
+        const qint64 fileBytes = qMin(written - skipped, offloadedRemaining);
+        offloadedRemaining -= fileBytes;
+        if (fileBytes > 0)
+            emit q->bytesWritten(fileBytes);
+    }
+    feedFileTransmission();
     if (state == QAbstractSocket::ClosingState && writeBuffer.isEmpty())
         q->disconnectFromHost();
 }
 
+/*!
+    \internal
+
+    QSslSocket has no socket engine of its own; when the file can skip the
+    TLS backend, feedFileTransmission() hands it over to the plain socket
+    instead.
+*/
+bool QSslSocketPrivate::canTransmitFileDirectly() const
+{
+    return false;
+}
+
+/*!
+    \internal
+*/
+void QSslSocketPrivate::startFileTransmission()
+{
+    transmitDirectly = false;
+    feedFileTransmission();
+}
+
+/*!
+    \internal
+
+    Hands the next chunk of the file passed to transmitFile() over to the
+    TLS backend, once the previous one has mostly reached the network.
+*/
+void QSslSocketPrivate::feedFileTransmission()
+{
+    Q_Q(QSslSocket);
+    if (transmitRemaining == 0 || !writeBuffer.isEmpty() || !plainSocket)
+        return;
+    if (offloadFileTransmission() || plainSocket->bytesToWrite() >= TransmitChunkSize)
+        return;
+
+    const QByteArray chunk = readFileChunk();
+    if (chunk.isEmpty()) {
+        q->abort();
+        return;
+    }
+
+    if (mode == QSslSocket::UnencryptedMode && !autoStartHandshake) {
+        plainSocket->write(chunk);
+    } else {
+        writeBuffer.append(chunk);
+        if (!flushTriggered) {
+            flushTriggered = true;
+            QMetaObject::invokeMethod(q, "_q_flushWriteBuffer", Qt::QueuedConnection);
+        }
+    }
+
+    if (transmitRemaining == 0) {
+        finishFileTransmission();
+        if (pendingClose && mode == QSslSocket::UnencryptedMode && !autoStartHandshake) {
+            pendingClose = false;
+            plainSocket->disconnectFromHost();
+        }
+    }
+}
+
 /*!
     \internal
 */
@@ -2616,6 +2705,44 @@ void QSslSocketPrivate::_q_readChannelFinishedSlot()
     emit q->readChannelFinished();
 }
 
+/*!
+    \internal
+
+    Passes the rest of the file over to the plain socket's transmitFile(),
+    which can use sendfile(). This is possible when the connection is not
+    encrypted, or when the backend has offloaded encryption to the kernel.
+    Returns \c true if the file was handed over, or if the plain socket is
+    still busy with an earlier one and we have to wait for it.
+*/
+bool QSslSocketPrivate::offloadFileTransmission()
+{
+    const bool passthrough = mode == QSslSocket::UnencryptedMode && !autoStartHandshake;
+    const bool kernelTls = !passthrough && connectionEncrypted && backend
+                           && backend->hasKernelTlsTransmit();
+    if (!passthrough && !kernelTls)
+        return false;
+
+    const auto *plainD = static_cast<const QAbstractSocketPrivate *>(QObjectPrivate::get(plainSocket));
+    if (plainD->transmitRemaining > 0)
+        return true; // picked up again from _q_bytesWrittenSlot()
+
+    const qint64 ahead = plainSocket->bytesToWrite();
+    const qint64 length = transmitRemaining;
+    if (!transmittedFile || !plainSocket->transmitFile(transmittedFile, transmitOffset, length))
+        return false;
+
+    if (kernelTls) {
+        offloadedAhead = ahead;
+        offloadedRemaining = length;
+    }
+    finishFileTransmission();
+    if (pendingClose && passthrough) {
+        pendingClose = false;
+        plainSocket->disconnectFromHost();
+    }
+    return true;
+}
+
 /*!
     \internal
 */
@@ -2736,7 +2863,96 @@ void QSslSocketPrivate::setMaxReadBufferSize(qint64 maxSize)
 */
 void QSslSocketPrivate::setEncrypted(bool enc)
 {
+    // Backends may report the same handshake more than once.
+    const bool wasEncrypted = connectionEncrypted;
     connectionEncrypted = enc;
+    if (!enc || wasEncrypted || offeredSession.isEmpty())
+        return;
+
+    QTlsSessionCache *cache = QTlsSessionCache::instance();
+    cache->recordResumption(configuration.peerSessionShared);
+    // Otherwise the session the server refused would be offered again on
+    // every connection, until it expires.
+    if (!configuration.peerSessionShared)
+        cache->remove(sessionCacheKey, offeredSession);
+}
+
+/*!
+    \internal
+
+    Returns \c true if the backend has to keep the TLS session in its
+    persistent form: either the configuration asks for it, or the session
+    goes to QTlsSessionCache.
+*/
+bool QSslSocketPrivate::isSessionPersistent() const
+{
+    return !(configuration.sslOptions & QSsl::SslOptionDisableSessionPersistence)
+            || !sessionCacheKey.isEmpty();
+}
+
+/*!
+    \internal
+
+    Returns the configuration the backend creates its TLS context from. When
+    the connection uses QTlsSessionCache, this has session persistence turned
+    on and carries the session found in the cache, without changing the
+    configuration the user sees.
+*/
+QSslConfiguration QSslSocketPrivate::contextConfiguration() const
+{
+    Q_Q(const QSslSocket);
+    QSslConfiguration result = q->sslConfiguration();
+    if (!sessionCacheKey.isEmpty()) {
+        result.setSslOption(QSsl::SslOptionDisableSessionPersistence, false);
+        if (!offeredSession.isEmpty())
+            result.setSessionTicket(offeredSession);
+    }
+    return result;
+}
+
+/*!
+    \internal
+
+    Keeps the session \a asn1 the backend established. It only becomes part
+    of the configuration if QSsl::SslOptionDisableSessionPersistence is turned
+    off; a session that is only needed for QTlsSessionCache stays private.
+*/
+void QSslSocketPrivate::storeSession(const QByteArray &asn1)
+{
+    if (!(configuration.sslOptions & QSsl::SslOptionDisableSessionPersistence))
+        configuration.sslSession = asn1;
+    if (!sessionCacheKey.isEmpty())
+        cachedSession = asn1;
+}
+
+/*!
+    \internal
+
+    Keeps the lifetime \a hint of the session set with storeSession(), which
+    is then complete and goes to QTlsSessionCache.
+*/
+void QSslSocketPrivate::storeSessionLifetimeHint(int hint)
+{
+    if (!(configuration.sslOptions & QSsl::SslOptionDisableSessionPersistence))
+        configuration.sslSessionTicketLifeTimeHint = hint;
+    cachedSessionLifetimeHint = hint;
+    storeSessionInCache();
+}
+
+/*!
+    \internal
+
+    Stores the session of this client connection in QTlsSessionCache, unless
+    the cache is disabled or the connection is only encrypted because
+    verification errors were ignored.
+*/
+void QSslSocketPrivate::storeSessionInCache()
+{
+    if (sessionCacheKey.isEmpty() || cachedSession.isEmpty())
+        return;
+    if (!backend.get() || !backend->tlsErrors().isEmpty())
+        return;
+    QTlsSessionCache::instance()->insert(sessionCacheKey, cachedSession, cachedSessionLifetimeHint);
 }
 
 /*!
@@ -2864,8 +3080,24 @@ bool QSslSocketPrivate::flush()
 */
 void QSslSocketPrivate::startClientEncryption()
 {
-    if (backend.get())
-        backend->startClientEncryption();
+    if (!backend.get())
+        return;
+
+    sessionCacheKey.clear();
+    cachedSession.clear();
+    offeredSession.clear();
+    cachedSessionLifetimeHint = -1;
+    if (!(configuration.sslOptions & QSsl::SslOptionDisableSessionCache)) {
+        const QString peer = verificationPeerName.isEmpty() ? peerName : verificationPeerName;
+        sessionCacheKey = QTlsSessionCache::keyFor(peer, peerPort, configuration);
+        // A session the user set explicitly takes precedence.
+        if (configuration.sslSession.isEmpty()) {
+            cachedSession = QTlsSessionCache::instance()->find(sessionCacheKey);
+            offeredSession = cachedSession;
+        }
+    }
+
+    backend->startClientEncryption();
 }
 
 /*!
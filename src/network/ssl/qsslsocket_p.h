@@ -99,6 +99,10 @@ public:
     bool isPaused() const;
     void setPaused(bool p);
     bool bind(const QHostAddress &address, quint16, QAbstractSocket::BindMode) override;
+    bool canTransmitFileDirectly() const override;
+    void startFileTransmission() override;
+    void feedFileTransmission();
+    bool offloadFileTransmission();
     void _q_connectedSlot();
     void _q_hostFoundSlot();
     void _q_disconnectedSlot();
@@ -146,6 +150,11 @@ public:
     qint64 maxReadBufferSize() const;
     void setMaxReadBufferSize(qint64 maxSize);
     void setEncrypted(bool enc);
+    bool isSessionPersistent() const;
+    QSslConfiguration contextConfiguration() const;
+    void storeSession(const QByteArray &asn1);
+    void storeSessionLifetimeHint(int hint);
+    void storeSessionInCache();
     QRingBufferRef &tlsWriteBuffer();
     QRingBufferRef &tlsBuffer();
     bool &tlsEmittedBytesWritten();
@@ -157,6 +166,19 @@ protected:
     bool paused;
     bool flushTriggered;
 
+    // A file handed over to the plain socket while kernel TLS encrypts it:
+    // the number of bytes queued in front of it, and what is left of it.
+    qint64 offloadedAhead = 0;
+    qint64 offloadedRemaining = 0;
+
+    // Where the session of a client connection goes in QTlsSessionCache, the
+    // session itself and the one found there that the handshake offered. Kept
+    // apart from the configuration, which may not want the session persisted.
+    QByteArray sessionCacheKey;
+    QByteArray cachedSession;
+    QByteArray offeredSession;
+    int cachedSessionLifetimeHint = -1;
+
     static inline QMutex backendMutex;
     static inline QString activeBackendName;
     static inline QTlsBackend *tlsBackend = nullptr;
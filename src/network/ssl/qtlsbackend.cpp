@@ -1057,17 +1057,20 @@ void QTlsBackend::setPeerSessionShared(QSslSocketPrivate *d, bool shared)
 void QTlsBackend::setSessionAsn1(QSslSocketPrivate *d, const QByteArray &asn1)
 {
     Q_ASSERT(d);
-    d->configuration.sslSession = asn1;
+    d->storeSession(asn1);
 }
 
 /*!
     \internal
     Sets TLS session lifetime hint in \a d to \a hint.
+
+    Backends call this after setSessionAsn1(); the session is then complete
+    and can be stored in the session cache.
 */
 void QTlsBackend::setSessionLifetimeHint(QSslSocketPrivate *d, int hint)
 {
     Q_ASSERT(d);
-    d->configuration.sslSessionTicketLifeTimeHint = hint;
+    d->storeSessionLifetimeHint(hint);
 }
 
 /*!
@@ -1904,6 +1907,20 @@ bool TlsCryptograph::hasUndecryptedData() const
     return false;
 }
 
+/*!
+    \internal
+
+    Returns \c true if the backend has handed record protection for outgoing
+    data over to the operating system (for example, kernel TLS on Linux). In
+    this case anything written to the plain socket is encrypted by the kernel,
+    which lets QSslSocket transmit files with sendfile(). The default
+    implementation returns \c false.
+*/
+bool TlsCryptograph::hasKernelTlsTransmit() const
+{
+    return false;
+}
+
 /*!
     \internal
 
@@ -176,6 +176,7 @@ public:
 
     virtual void transmit() = 0;
     virtual bool hasUndecryptedData() const;
+    virtual bool hasKernelTlsTransmit() const;
     virtual QList<QOcspResponse> ocsps() const;
 
     static bool isMatchingHostname(const QSslCertificate &cert, const QString &peerName);
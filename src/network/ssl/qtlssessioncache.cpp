@@ -0,0 +1,227 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qtlssessioncache_p.h"
+#include "qsslconfiguration_p.h"
+
+#include <QtNetwork/qsslcertificate.h>
+#include <QtNetwork/qsslcipher.h>
+#include <QtNetwork/qsslellipticcurve.h>
+
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qglobalstatic.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \internal
+    \class QTlsSessionCache
+    \brief The QTlsSessionCache class keeps TLS sessions of client connections
+    so that later connections to the same server can resume them.
+
+    Sessions are keyed by the peer they were established with and by the parts
+    of the QSslConfiguration that influence the handshake, so that a session
+    is never offered on a connection that was configured differently (for
+    example, one trusting another set of CA certificates). Entries expire when
+    the ticket lifetime hint sent by the server runs out; the least recently
+    used entries are dropped once capacity() is reached.
+
+    The cache is shared by all threads of the process; all functions are
+    thread-safe.
+*/
+
+Q_GLOBAL_STATIC(QTlsSessionCache, globalSessionCache)
+
+/*!
+    \internal
+
+    Returns the process-wide session cache.
+*/
+QTlsSessionCache *QTlsSessionCache::instance()
+{
+    return globalSessionCache();
+}
+
+/*!
+    \internal
+
+    Returns the key under which sessions for connections to \a peerName on
+    \a port, made with \a configuration, are stored.
+*/
+QByteArray QTlsSessionCache::keyFor(const QString &peerName, quint16 port,
+                                    const QSslConfigurationPrivate &configuration)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    const auto addInt = [&hash](qint64 value) {
+        hash.addData(QByteArrayView(reinterpret_cast<const char *>(&value), sizeof value));
+    };
+    const auto addBytes = [&hash, &addInt](QByteArrayView data) {
+        addInt(data.size());
+        hash.addData(data);
+    };
+
+    addBytes(peerName.toLower().toUtf8());
+    addInt(port);
+    addInt(int(configuration.protocol));
+    // The state of the cache itself and of persistence does not change what
+    // the session is valid for.
+    addInt((configuration.sslOptions
+            & ~(QSsl::SslOptionDisableSessionCache | QSsl::SslOptionDisableSessionPersistence)).toInt());
+    addInt(int(configuration.peerVerifyMode));
+    addInt(configuration.peerVerifyDepth);
+    addInt(configuration.allowRootCertOnDemandLoading);
+
+    addInt(configuration.caCertificates.size());
+    for (const QSslCertificate &certificate : configuration.caCertificates)
+        hash.addData(certificate.digest(QCryptographicHash::Sha256));
+    addInt(configuration.localCertificateChain.size());
+    for (const QSslCertificate &certificate : configuration.localCertificateChain)
+        hash.addData(certificate.digest(QCryptographicHash::Sha256));
+
+    addInt(configuration.ciphers.size());
+    for (const QSslCipher &cipher : configuration.ciphers)
+        addBytes(cipher.name().toLatin1());
+    addInt(configuration.ellipticCurves.size());
+    for (const QSslEllipticCurve &curve : configuration.ellipticCurves)
+        addBytes(curve.shortName().toLatin1());
+
+    addInt(configuration.nextAllowedProtocols.size());
+    for (const QByteArray &protocol : configuration.nextAllowedProtocols)
+        addBytes(protocol);
+    addInt(configuration.backendConfig.size());
+    for (auto it = configuration.backendConfig.cbegin(), end = configuration.backendConfig.cend();
+         it != end; ++it) {
+        addBytes(it.key());
+        addBytes(it.value().toString().toUtf8());
+    }
+    addBytes(configuration.preSharedKeyIdentityHint);
+
+    return hash.result();
+}
+
+/*!
+    \internal
+
+    Returns the session stored for \a key, or an empty byte array if there is
+    none or it has expired.
+*/
+QByteArray QTlsSessionCache::find(const QByteArray &key)
+{
+    QMutexLocker locker(&mutex);
+    ++stats.lookups;
+    const Entry *entry = entries.object(key);
+    if (!entry)
+        return {};
+    if (entry->expiry.hasExpired()) {
+        entries.remove(key);
+        ++stats.evictions;
+        return {};
+    }
+    ++stats.hits;
+    return entry->session;
+}
+
+/*!
+    \internal
+
+    Stores \a session under \a key, replacing any previous session. The entry
+    expires after \a lifetimeHint seconds; if the hint is not positive,
+    DefaultLifetimeHint is used instead.
+*/
+void QTlsSessionCache::insert(const QByteArray &key, const QByteArray &session, int lifetimeHint)
+{
+    if (session.isEmpty())
+        return;
+
+    const std::chrono::seconds lifetime(lifetimeHint > 0 ? lifetimeHint : DefaultLifetimeHint);
+    QMutexLocker locker(&mutex);
+    if (entries.maxCost() <= 0)
+        return;
+    if (entries.size() == entries.maxCost() && !entries.contains(key))
+        ++stats.evictions;
+    entries.insert(key, new Entry{session, QDeadlineTimer(lifetime)});
+    ++stats.insertions;
+}
+
+/*!
+    \internal
+
+    Removes the session stored for \a key if it is still \a session, for
+    example because the server refused to resume it. A session that replaced
+    it in the meantime, like the one established by that very handshake, is
+    kept.
+*/
+void QTlsSessionCache::remove(const QByteArray &key, const QByteArray &session)
+{
+    QMutexLocker locker(&mutex);
+    const Entry *entry = entries.object(key);
+    if (entry && entry->session == session)
+        entries.remove(key);
+}
+
+/*!
+    \internal
+
+    Records whether the server accepted a session that was found in the cache.
+*/
+void QTlsSessionCache::recordResumption(bool resumed)
+{
+    if (!resumed)
+        return;
+    QMutexLocker locker(&mutex);
+    ++stats.resumptions;
+}
+
+/*!
+    \internal
+
+    Removes all sessions from the cache. The statistics are kept.
+*/
+void QTlsSessionCache::clear()
+{
+    QMutexLocker locker(&mutex);
+    entries.clear();
+}
+
+/*!
+    \internal
+
+    Sets the maximum number of sessions kept to \a capacity. A capacity of 0
+    disables caching.
+*/
+void QTlsSessionCache::setCapacity(qsizetype capacity)
+{
+    QMutexLocker locker(&mutex);
+    entries.setMaxCost(qMax(capacity, qsizetype(0)));
+}
+
+qsizetype QTlsSessionCache::capacity() const
+{
+    QMutexLocker locker(&mutex);
+    return entries.maxCost();
+}
+
+qsizetype QTlsSessionCache::size() const
+{
+    QMutexLocker locker(&mutex);
+    return entries.size();
+}
+
+/*!
+    \internal
+
+    Returns the counters collected since the last call to resetStatistics().
+*/
+QTlsSessionCache::Statistics QTlsSessionCache::statistics() const
+{
+    QMutexLocker locker(&mutex);
+    return stats;
+}
+
+void QTlsSessionCache::resetStatistics()
+{
+    QMutexLocker locker(&mutex);
+    stats = {};
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,84 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QTLSSESSIONCACHE_P_H
+#define QTLSSESSIONCACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtNetwork/private/qtnetworkglobal_p.h>
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qcache.h>
+#include <QtCore/qdeadlinetimer.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qstring.h>
+
+QT_REQUIRE_CONFIG(ssl);
+
+QT_BEGIN_NAMESPACE
+
+class QSslConfigurationPrivate;
+
+class Q_NETWORK_EXPORT QTlsSessionCache
+{
+public:
+    static constexpr qsizetype DefaultCapacity = 256;
+    // Used when the server did not tell how long the session is valid for.
+    static constexpr int DefaultLifetimeHint = 2 * 60 * 60; // seconds
+
+    struct Statistics
+    {
+        quint64 lookups = 0;
+        quint64 hits = 0;
+        quint64 resumptions = 0;
+        quint64 insertions = 0;
+        quint64 evictions = 0;
+
+        // The share of lookups that found a session, and the share of those
+        // the server actually accepted.
+        double hitRate() const { return lookups ? double(hits) / lookups : 0.; }
+        double resumptionRate() const { return hits ? double(resumptions) / hits : 0.; }
+    };
+
+    static QTlsSessionCache *instance();
+    static QByteArray keyFor(const QString &peerName, quint16 port,
+                             const QSslConfigurationPrivate &configuration);
+
+    QByteArray find(const QByteArray &key);
+    void insert(const QByteArray &key, const QByteArray &session, int lifetimeHint);
+    void remove(const QByteArray &key, const QByteArray &session);
+    void recordResumption(bool resumed);
+    void clear();
+
+    void setCapacity(qsizetype capacity);
+    qsizetype capacity() const;
+    qsizetype size() const;
+
+    Statistics statistics() const;
+    void resetStatistics();
+
+private:
+    struct Entry
+    {
+        QByteArray session;
+        QDeadlineTimer expiry;
+    };
+
+    mutable QMutex mutex;
+    QCache<QByteArray, Entry> entries{DefaultCapacity};
+    Statistics stats;
+};
+
+QT_END_NAMESPACE
+
+#endif // QTLSSESSIONCACHE_P_H
@@ -32,6 +32,7 @@ public:
     int decode(QImage *image, const uchar* buffer, int length,
                int *nextFrameDelay, int *loopCount);
     static void scan(QIODevice *device, QList<QSize> *imageSizes, int *loopCount);
+    void setClipRows(int top, int bottom) { clipTop = top; clipBottom = bottom; }
 
     bool newFrame;
     bool partialNewFrame;
@@ -103,6 +104,10 @@ private:
     int frame;
     bool out_of_bounds;
     bool digress;
+    // Rows outside this range are decoded, but their pixels are not stored.
+    int clipTop;
+    int clipBottom;
+    bool isClipped(int row) const { return row < clipTop || row > clipBottom; }
     void nextY(unsigned char *bits, int bpl);
     void disposePrevious(QImage *image);
 };
@@ -128,6 +133,8 @@ QGIFFormat::QGIFFormat()
     table[0] = nullptr;
     table[1] = nullptr;
     stack = nullptr;
+    clipTop = 0;
+    clipBottom = INT_MAX;
 }
 
 /*!
@@ -480,7 +487,8 @@ int QGIFFormat::decode(QImage *image, const uchar *buffer, int length,
                 } else {
                     if (needfirst) {
                         firstcode=oldcode=code;
-                        if (!out_of_bounds && image->height() > y && ((frame == 0) || (firstcode != trans_index)))
+                        if (!out_of_bounds && image->height() > y && !isClipped(y)
+                            && ((frame == 0) || (firstcode != trans_index)))
                             ((QRgb*)FAST_SCAN_LINE(bits, bpl, y))[x] = color(firstcode);
                         x++;
                         if (x>=swidth) out_of_bounds = true;
@@ -533,11 +541,11 @@ int QGIFFormat::decode(QImage *image, const uchar *buffer, int length,
                         oldcode=incode;
                         const int h = image->height();
                         QRgb *line = nullptr;
-                        if (!out_of_bounds && h > y)
+                        if (!out_of_bounds && h > y && !isClipped(y))
                             line = (QRgb*)FAST_SCAN_LINE(bits, bpl, y);
                         while (sp>stack) {
                             const uchar index = *(--sp);
-                            if (!out_of_bounds && h > y && ((frame == 0) || (index != trans_index))) {
+                            if (line && !out_of_bounds && ((frame == 0) || (index != trans_index))) {
                                 line[x] = color(index);
                             }
                             x++;
@@ -546,7 +554,8 @@ int QGIFFormat::decode(QImage *image, const uchar *buffer, int length,
                                 x=left;
                                 out_of_bounds = left>=swidth || y>=sheight;
                                 nextY(bits, bpl);
-                                if (!out_of_bounds && h > y)
+                                line = nullptr;
+                                if (!out_of_bounds && h > y && !isClipped(y))
                                     line = (QRgb*)FAST_SCAN_LINE(bits, bpl, y);
                             }
                         }
@@ -1112,7 +1121,7 @@ bool QGifHandler::read(QImage *image)
         buffer.remove(0, decoded);
     }
     if (gifFormat->newFrame || (gifFormat->partialNewFrame && device()->atEnd())) {
-        *image = lastImage;
+        *image = clipRect.isValid() ? lastImage.copy(clipRect) : lastImage;
         ++frameNumber;
         gifFormat->newFrame = false;
         gifFormat->partialNewFrame = false;
@@ -1131,10 +1140,12 @@ bool QGifHandler::write(const QImage &image)
 bool QGifHandler::supportsOption(ImageOption option) const
 {
     if (!device() || device()->isSequential())
-        return option == Animation;
+        return option == Animation
+            || option == ClipRect;
     else
         return option == Size
-            || option == Animation;
+            || option == Animation
+            || option == ClipRect;
 }
 
 QVariant QGifHandler::option(ImageOption option) const
@@ -1154,14 +1165,23 @@ QVariant QGifHandler::option(ImageOption option) const
         return imageSizes.at(frameNumber + 1);
     } else if (option == Animation) {
         return true;
+    } else if (option == ClipRect) {
+        return clipRect;
     }
     return QVariant();
 }
 
 void QGifHandler::setOption(ImageOption option, const QVariant &value)
 {
-    Q_UNUSED(option);
-    Q_UNUSED(value);
+    if (option == ClipRect) {
+        // Frames are drawn onto the previous ones, so the clip rect has to
+        // apply to all of them.
+        clipRect = value.toRect();
+        if (clipRect.isValid())
+            gifFormat->setClipRows(clipRect.top(), clipRect.bottom());
+        else
+            gifFormat->setClipRows(0, INT_MAX);
+    }
 }
 
 int QGifHandler::nextImageDelay() const
@@ -18,6 +18,7 @@
 #include <QtGui/qimageiohandler.h>
 #include <QtGui/qimage.h>
 #include <QtCore/qbytearray.h>
+#include <QtCore/qrect.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -49,6 +50,7 @@ private:
     QString fileName;
     mutable QByteArray buffer;
     mutable QImage lastImage;
+    QRect clipRect;
 
     mutable int nextDelay;
     mutable int loopCnt;
@@ -740,6 +740,7 @@ public:
     enum State {
         Ready,
         ReadHeader,
+        ReadingScanlines,
         ReadingEnd,
         Error
     };
@@ -757,11 +758,21 @@ public:
             delete iod_src;
             iod_src = nullptr;
         }
+        if (iod_dest) {
+            jpeg_destroy_compress(&cinfo);
+            delete iod_dest;
+        }
     }
 
     bool readJpegHeader(QIODevice*);
     bool read(QImage *image);
 
+    bool beginScanlineRead(QSize *size, QImage::Format *format);
+    int readScanlines(uchar *buffer, qsizetype bytesPerLine, int count);
+    bool beginScanlineWrite(QSize size, QImage::Format *format);
+    bool writeScanlines(const uchar *buffer, qsizetype bytesPerLine, int count);
+    bool endScanlineWrite();
+
     int quality;
     QImageIOHandler::Transformations transformation;
     QVariant size;
@@ -791,6 +802,12 @@ public:
     struct jpeg_decompress_struct info;
     struct my_jpeg_source_mgr * iod_src;
     struct my_error_mgr err;
+    JSAMPARRAY scanlineRow = nullptr;
+
+    // Scanline writing
+    struct jpeg_compress_struct cinfo;
+    struct my_jpeg_destination_mgr *iod_dest = nullptr;
+    struct my_error_mgr cerr;
 
     Rgb888ToRgb32Converter rgb888ToRgb32ConverterPtr;
 
@@ -1045,6 +1062,192 @@ bool QJpegHandlerPrivate::read(QImage *image)
     return false;
 }
 
+bool QJpegHandlerPrivate::beginScanlineRead(QSize *size, QImage::Format *format)
+{
+    if (state == Ready)
+        readJpegHeader(q->device());
+
+    if (state != ReadHeader)
+        return false;
+
+    if (!setjmp(err.setjmp_buffer)) {
+        if (quality >= 0 && quality < HIGH_QUALITY_THRESHOLD) {
+            info.dct_method = JDCT_IFAST;
+            info.do_fancy_upsampling = FALSE;
+        }
+        (void) jpeg_calc_output_dimensions(&info);
+
+        switch (info.output_components) {
+        case 1:
+            *format = QImage::Format_Grayscale8;
+            break;
+        case 3:
+            *format = QImage::Format_RGB32;
+            break;
+        case 4:
+            if (info.out_color_space == JCS_CMYK) {
+                *format = QImage::Format_CMYK8888;
+                break;
+            }
+            Q_FALLTHROUGH();
+        default:
+            state = Error;
+            return false;
+        }
+
+        // Progressive images are buffered as coefficients by libjpeg, which
+        // is still much less than the decoded image.
+        scanlineRow = (info.mem->alloc_sarray)((j_common_ptr)&info, JPOOL_IMAGE,
+                                               info.output_width * info.output_components, 1);
+        (void) jpeg_start_decompress(&info);
+        *size = QSize(info.output_width, info.output_height);
+        state = ReadingScanlines;
+        return true;
+    } else {
+        my_output_message(j_common_ptr(&info));
+        state = Error;
+        return false;
+    }
+}
+
+int QJpegHandlerPrivate::readScanlines(uchar *buffer, qsizetype bytesPerLine, int count)
+{
+    if (state != ReadingScanlines)
+        return -1;
+
+    if (!setjmp(err.setjmp_buffer)) {
+        const bool invertCMYK = subType != QJpegHandlerPrivate::SubType::CMYK;
+        const int width = info.output_width;
+        count = qMin(count, int(info.output_height - info.output_scanline));
+        for (int y = 0; y < count; ++y) {
+            uchar *out = buffer + y * bytesPerLine;
+            if (info.output_components == 1) {
+                (void) jpeg_read_scanlines(&info, &out, 1);
+                continue;
+            }
+            (void) jpeg_read_scanlines(&info, scanlineRow, 1);
+            const uchar *in = scanlineRow[0];
+            if (info.output_components == 3) {
+                rgb888ToRgb32ConverterPtr(reinterpret_cast<quint32 *>(out), in, width);
+            } else if (invertCMYK) {
+                quint32 *cmyk = reinterpret_cast<quint32 *>(out);
+                for (int i = 0; i < width; ++i, in += 4)
+                    cmyk[i] = 0xffffffffu - (in[0] | in[1] << 8 | in[2] << 16 | in[3] << 24);
+            } else {
+                memcpy(out, in, width * 4);
+            }
+        }
+        if (info.output_scanline == info.output_height) {
+            (void) jpeg_finish_decompress(&info);
+            state = ReadingEnd;
+        }
+        return count;
+    } else {
+        my_output_message(j_common_ptr(&info));
+        state = Error;
+        return -1;
+    }
+}
+
+bool QJpegHandlerPrivate::beginScanlineWrite(QSize size, QImage::Format *format)
+{
+    // Rows are compressed as they are for gray and CMYK, everything else
+    // is written from RGB888 rows.
+    if (*format != QImage::Format_Grayscale8 && *format != QImage::Format_CMYK8888)
+        *format = QImage::Format_RGB888;
+
+    iod_dest = new my_jpeg_destination_mgr(q->device());
+    cinfo.err = jpeg_std_error(&cerr);
+    cerr.error_exit = my_error_exit;
+    cerr.output_message = my_output_message;
+
+    if (!setjmp(cerr.setjmp_buffer)) {
+        jpeg_create_compress(&cinfo);
+        cinfo.dest = iod_dest;
+        cinfo.image_width = size.width();
+        cinfo.image_height = size.height();
+        if (*format == QImage::Format_Grayscale8) {
+            cinfo.input_components = 1;
+            cinfo.in_color_space = JCS_GRAYSCALE;
+        } else if (*format == QImage::Format_CMYK8888) {
+            cinfo.input_components = 4;
+            cinfo.in_color_space = JCS_CMYK;
+        } else {
+            cinfo.input_components = 3;
+            cinfo.in_color_space = JCS_RGB;
+        }
+
+        jpeg_set_defaults(&cinfo);
+        if (optimize)
+            cinfo.optimize_coding = true;
+        if (progressive)
+            jpeg_simple_progression(&cinfo);
+        jpeg_set_quality(&cinfo, quality >= 0 ? qMin(quality, 100) : 75, TRUE);
+        jpeg_start_compress(&cinfo, TRUE);
+        return true;
+    } else {
+        my_output_message(j_common_ptr(&cinfo));
+        jpeg_destroy_compress(&cinfo);
+        delete iod_dest;
+        iod_dest = nullptr;
+        return false;
+    }
+}
+
+bool QJpegHandlerPrivate::writeScanlines(const uchar *buffer, qsizetype bytesPerLine, int count)
+{
+    if (!iod_dest)
+        return false;
+
+    if (!setjmp(cerr.setjmp_buffer)) {
+        const bool invertCMYK = cinfo.in_color_space == JCS_CMYK
+                && subType != QJpegHandlerPrivate::SubType::CMYK;
+        JSAMPARRAY cmykRow = nullptr;
+        if (invertCMYK) {
+            cmykRow = (cinfo.mem->alloc_sarray)((j_common_ptr)&cinfo, JPOOL_IMAGE,
+                                                cinfo.image_width * 4, 1);
+        }
+        for (int y = 0; y < count; ++y) {
+            JSAMPROW row = const_cast<JSAMPROW>(buffer + y * bytesPerLine);
+            if (invertCMYK) {
+                auto *cmykIn = reinterpret_cast<const quint32 *>(row);
+                auto *cmykOut = reinterpret_cast<quint32 *>(cmykRow[0]);
+                for (uint i = 0; i < cinfo.image_width; ++i)
+                    cmykOut[i] = 0xffffffffu - cmykIn[i];
+                row = cmykRow[0];
+            }
+            jpeg_write_scanlines(&cinfo, &row, 1);
+        }
+        return true;
+    } else {
+        my_output_message(j_common_ptr(&cinfo));
+        jpeg_destroy_compress(&cinfo);
+        delete iod_dest;
+        iod_dest = nullptr;
+        return false;
+    }
+}
+
+bool QJpegHandlerPrivate::endScanlineWrite()
+{
+    if (!iod_dest)
+        return false;
+
+    bool success = false;
+    if (!setjmp(cerr.setjmp_buffer)) {
+        if (cinfo.next_scanline == cinfo.image_height) {
+            jpeg_finish_compress(&cinfo);
+            success = true;
+        }
+    } else {
+        my_output_message(j_common_ptr(&cinfo));
+    }
+    jpeg_destroy_compress(&cinfo);
+    delete iod_dest;
+    iod_dest = nullptr;
+    return success;
+}
+
 Q_GUI_EXPORT void QT_FASTCALL qt_convert_rgb888_to_rgb32_neon(quint32 *dst, const uchar *src, int len);
 Q_GUI_EXPORT void QT_FASTCALL qt_convert_rgb888_to_rgb32_ssse3(quint32 *dst, const uchar *src, int len);
 extern "C" void qt_convert_rgb888_to_rgb32_mips_dspr2_asm(quint32 *dst, const uchar *src, int len);
@@ -1052,6 +1255,8 @@ extern "C" void qt_convert_rgb888_to_rgb32_mips_dspr2_asm(quint32 *dst, const uc
 QJpegHandler::QJpegHandler()
     : d(new QJpegHandlerPrivate(this))
 {
+    QImageIOHandlerPrivate::setScanlineHandler(this, this);
+
 #if defined(__ARM_NEON__)
     // from qimage_neon.cpp
     if (qCpuHasFeature(NEON))
@@ -1123,6 +1328,33 @@ bool QJpegHandler::write(const QImage &image)
     return write_jpeg_image(image, device(), d->quality, d->description, d->optimize, d->progressive, invertCMYK);
 }
 
+bool QJpegHandler::beginScanlineRead(QSize *size, QImage::Format *format, QList<QRgb> *)
+{
+    if (!canRead())
+        return false;
+    return d->beginScanlineRead(size, format);
+}
+
+int QJpegHandler::readScanlines(uchar *buffer, qsizetype bytesPerLine, int count)
+{
+    return d->readScanlines(buffer, bytesPerLine, count);
+}
+
+bool QJpegHandler::beginScanlineWrite(QSize size, QImage::Format *format)
+{
+    return d->beginScanlineWrite(size, format);
+}
+
+bool QJpegHandler::writeScanlines(const uchar *buffer, qsizetype bytesPerLine, int count)
+{
+    return d->writeScanlines(buffer, bytesPerLine, count);
+}
+
+bool QJpegHandler::endScanlineWrite()
+{
+    return d->endScanlineWrite();
+}
+
 bool QJpegHandler::supportsOption(ImageOption option) const
 {
     return option == Quality
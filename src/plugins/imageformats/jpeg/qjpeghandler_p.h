@@ -16,13 +16,14 @@
 //
 
 #include <QtGui/qimageiohandler.h>
+#include <QtGui/private/qimageiohandler_p.h>
 #include <QtCore/QSize>
 #include <QtCore/QRect>
 
 QT_BEGIN_NAMESPACE
 
 class QJpegHandlerPrivate;
-class QJpegHandler : public QImageIOHandler
+class QJpegHandler : public QImageIOHandler, public QImageScanlineHandler
 {
 public:
     QJpegHandler();
@@ -38,6 +39,12 @@ public:
     void setOption(ImageOption option, const QVariant &value) override;
     bool supportsOption(ImageOption option) const override;
 
+    bool beginScanlineRead(QSize *size, QImage::Format *format, QList<QRgb> *colorTable) override;
+    int readScanlines(uchar *buffer, qsizetype bytesPerLine, int count) override;
+    bool beginScanlineWrite(QSize size, QImage::Format *format) override;
+    bool writeScanlines(const uchar *buffer, qsizetype bytesPerLine, int count) override;
+    bool endScanlineWrite() override;
+
 private:
     QJpegHandlerPrivate *d;
 };
@@ -11,6 +11,7 @@
 #include "qsslcontext_openssl_p.h"
 #include "qtlsbackend_openssl_p.h"
 #include "qtlskey_openssl_p.h"
+#include "qtls_openssl_p.h"
 #include "qopenssl_p.h"
 
 #include <QtNetwork/private/qssl_p.h>
@@ -153,7 +154,7 @@ std::shared_ptr<QSslContext> QSslContext::sharedFromPrivateConfiguration(QSslSoc
 
 #ifndef OPENSSL_NO_NEXTPROTONEG
 
-static int next_proto_cb(SSL *, unsigned char **out, unsigned char *outlen,
+static int next_proto_cb(SSL *ssl, unsigned char **out, unsigned char *outlen,
                          const unsigned char *in, unsigned int inlen, void *arg)
 {
     QSslContext::NPNContext *ctx = reinterpret_cast<QSslContext::NPNContext *>(arg);
@@ -181,6 +182,11 @@ static int next_proto_cb(SSL *, unsigned char **out, unsigned char *outlen,
         qCWarning(lcTlsBackend, "OpenSSL sent unknown NPN status");
     }
 
+    // The context can be shared by several connections, see npnStatus().
+    q_SSL_set_ex_data(ssl, QTlsBackendOpenSSL::s_indexForSSLExtraData
+                           + QTlsPrivate::TlsCryptographOpenSSL::npnStatusOffsetInExData,
+                      reinterpret_cast<void *>(quintptr(ctx->status) + 1));
+
     return SSL_TLSEXT_ERR_OK;
 }
 
@@ -188,6 +194,18 @@ QSslContext::NPNContext QSslContext::npnContext() const
 {
     return m_npnContext;
 }
+
+// The outcome of NPN or ALPN on the connection \a ssl, unlike
+// npnContext().status, which is written by every connection using the
+// context.
+QSslConfiguration::NextProtocolNegotiationStatus QSslContext::npnStatus(SSL *ssl)
+{
+    const auto stored = quintptr(q_SSL_get_ex_data(ssl, QTlsBackendOpenSSL::s_indexForSSLExtraData
+                                                   + QTlsPrivate::TlsCryptographOpenSSL::npnStatusOffsetInExData));
+    if (!stored)
+        return QSslConfiguration::NextProtocolNegotiationNone;
+    return QSslConfiguration::NextProtocolNegotiationStatus(stored - 1);
+}
 #endif // !OPENSSL_NO_NEXTPROTONEG
 
 
@@ -672,6 +690,16 @@ QT_WARNING_POP
 
 #endif // TLS1_3_VERSION
 
+    // A server context shared by QSslServer keeps the sessions of earlier
+    // connections. OpenSSL refuses to resume them for clients it verified
+    // unless the context has a session id context.
+    if (mode == QSslSocket::SslServerMode && !isDtls
+        && !configuration.testSslOption(QSsl::SslOptionDisableSessionCache)) {
+        static const unsigned char sessionIdContext[] = "QSslServer";
+        q_SSL_CTX_set_session_id_context(sslContext->ctx, sessionIdContext,
+                                         sizeof sessionIdContext - 1);
+    }
+
 #if QT_CONFIG(dtls)
     // DTLS cookies:
     if (mode == QSslSocket::SslServerMode && isDtls && configuration.dtlsCookieVerificationEnabled()) {
@@ -65,6 +65,7 @@ public:
         QSslConfiguration::NextProtocolNegotiationStatus status;
     };
     NPNContext npnContext() const;
+    static QSslConfiguration::NextProtocolNegotiationStatus npnStatus(SSL *ssl);
 #endif // !OPENSSL_NO_NEXTPROTONEG
 
 protected:
@@ -135,11 +135,15 @@ DEFINEFUNC2(int, SSL_CTX_set_ciphersuites, SSL_CTX *ctx, ctx, const char *str, s
 DEFINEFUNC2(void, SSL_set_psk_use_session_callback, SSL *ssl, ssl, q_SSL_psk_use_session_cb_func_t callback, callback, return, DUMMYARG)
 DEFINEFUNC2(void, SSL_CTX_sess_set_new_cb, SSL_CTX *ctx, ctx, NewSessionCallback cb, cb, return, return)
 DEFINEFUNC(int, SSL_SESSION_is_resumable, const SSL_SESSION *s, s, return 0, return)
+DEFINEFUNC2(void, SSL_CTX_set_keylog_callback, SSL_CTX *ctx, ctx, KeylogCallback cb, cb, return, return)
+DEFINEFUNC(KeylogCallback, SSL_CTX_get_keylog_callback, const SSL_CTX *ctx, ctx, return nullptr, return)
+DEFINEFUNC2(void, SSL_set_msg_callback, SSL *ssl, ssl, MessageCallback cb, cb, return, return)
 #endif
 DEFINEFUNC3(size_t, SSL_get_client_random, SSL *a, a, unsigned char *out, out, size_t outlen, outlen, return 0, return)
 DEFINEFUNC3(size_t, SSL_SESSION_get_master_key, const SSL_SESSION *ses, ses, unsigned char *out, out, size_t outlen, outlen, return 0, return)
 DEFINEFUNC6(int, CRYPTO_get_ex_new_index, int class_index, class_index, long argl, argl, void *argp, argp, CRYPTO_EX_new *new_func, new_func, CRYPTO_EX_dup *dup_func, dup_func, CRYPTO_EX_free *free_func, free_func, return -1, return)
 DEFINEFUNC2(unsigned long, SSL_set_options, SSL *ssl, ssl, unsigned long op, op, return 0, return)
+DEFINEFUNC(qssloptions, SSL_get_options, const SSL *ssl, ssl, return 0, return)
 
 DEFINEFUNC(const SSL_METHOD *, TLS_method, DUMMYARG, DUMMYARG, return nullptr, return)
 DEFINEFUNC(const SSL_METHOD *, TLS_client_method, DUMMYARG, DUMMYARG, return nullptr, return)
@@ -284,6 +288,7 @@ DEFINEFUNC2(int, SSL_CTX_set_cipher_list, SSL_CTX *a, a, const char *b, b, retur
 DEFINEFUNC3(long, SSL_CTX_callback_ctrl, SSL_CTX *ctx, ctx, int dst, dst, GenericCallbackType cb, cb, return 0, return)
 DEFINEFUNC(int, SSL_CTX_set_default_verify_paths, SSL_CTX *a, a, return -1, return)
 DEFINEFUNC3(void, SSL_CTX_set_verify, SSL_CTX *a, a, int b, b, int (*c)(int, X509_STORE_CTX *), c, return, DUMMYARG)
+DEFINEFUNC3(int, SSL_CTX_set_session_id_context, SSL_CTX *a, a, const unsigned char *b, b, unsigned int c, c, return 0, return)
 DEFINEFUNC2(void, SSL_CTX_set_verify_depth, SSL_CTX *a, a, int b, b, return, DUMMYARG)
 DEFINEFUNC2(int, SSL_CTX_use_certificate, SSL_CTX *a, a, X509 *b, b, return -1, return)
 DEFINEFUNC3(int, SSL_CTX_use_certificate_file, SSL_CTX *a, a, const char *b, b, int c, c, return -1, return)
@@ -299,6 +304,7 @@ DEFINEFUNC3(int, SSL_CONF_cmd, SSL_CONF_CTX *a, a, const char *b, b, const char
 DEFINEFUNC(void, SSL_free, SSL *a, a, return, DUMMYARG)
 DEFINEFUNC(STACK_OF(SSL_CIPHER) *, SSL_get_ciphers, const SSL *a, a, return nullptr, return)
 DEFINEFUNC(const SSL_CIPHER *, SSL_get_current_cipher, SSL *a, a, return nullptr, return)
+DEFINEFUNC(uint32_t, SSL_CIPHER_get_id, const SSL_CIPHER *c, c, return 0, return)
 DEFINEFUNC(int, SSL_version, const SSL *a, a, return 0, return)
 DEFINEFUNC2(int, SSL_get_error, SSL *a, a, int b, b, return -1, return)
 DEFINEFUNC(STACK_OF(X509) *, SSL_get_peer_cert_chain, SSL *a, a, return nullptr, return)
@@ -307,6 +313,11 @@ DEFINEFUNC(STACK_OF(X509) *, SSL_get_peer_cert_chain, SSL *a, a, return nullptr,
 DEFINEFUNC(X509 *, SSL_get1_peer_certificate, SSL *a, a, return nullptr, return)
 DEFINEFUNC(int, EVP_PKEY_get_bits, const EVP_PKEY *pkey, pkey, return -1, return)
 DEFINEFUNC(int, EVP_PKEY_get_base_id, const EVP_PKEY *pkey, pkey, return -1, return)
+DEFINEFUNC3(EVP_KDF *, EVP_KDF_fetch, OSSL_LIB_CTX *libctx, libctx, const char *algorithm, algorithm, const char *properties, properties, return nullptr, return)
+DEFINEFUNC(void, EVP_KDF_free, EVP_KDF *kdf, kdf, return, return)
+DEFINEFUNC(EVP_KDF_CTX *, EVP_KDF_CTX_new, EVP_KDF *kdf, kdf, return nullptr, return)
+DEFINEFUNC(void, EVP_KDF_CTX_free, EVP_KDF_CTX *ctx, ctx, return, return)
+DEFINEFUNC4(int, EVP_KDF_derive, EVP_KDF_CTX *ctx, ctx, unsigned char *key, key, size_t keylen, keylen, const OSSL_PARAM *params, params, return 0, return)
 #else
 DEFINEFUNC(X509 *, SSL_get_peer_certificate, SSL *a, a, return nullptr, return)
 DEFINEFUNC(int, EVP_PKEY_base_id, EVP_PKEY *a, a, return NID_undef, return)
@@ -888,6 +899,9 @@ bool q_resolveOpenSslSymbols()
         RESOLVEFUNC(SSL_set_psk_use_session_callback)
         RESOLVEFUNC(SSL_CTX_sess_set_new_cb)
         RESOLVEFUNC(SSL_SESSION_is_resumable)
+        RESOLVEFUNC(SSL_CTX_set_keylog_callback)
+        RESOLVEFUNC(SSL_CTX_get_keylog_callback)
+        RESOLVEFUNC(SSL_set_msg_callback)
 #endif // TLS 1.3 or OpenSSL > 1.1.1
 
         RESOLVEFUNC(SSL_get_client_random)
@@ -895,6 +909,7 @@ bool q_resolveOpenSslSymbols()
         RESOLVEFUNC(SSL_session_reused)
         RESOLVEFUNC(SSL_get_session)
         RESOLVEFUNC(SSL_set_options)
+        RESOLVEFUNC(SSL_get_options)
         RESOLVEFUNC(CRYPTO_get_ex_new_index)
         RESOLVEFUNC(TLS_method)
         RESOLVEFUNC(TLS_client_method)
@@ -1053,6 +1068,7 @@ bool q_resolveOpenSslSymbols()
         RESOLVEFUNC(SSL_CTX_callback_ctrl)
         RESOLVEFUNC(SSL_CTX_set_default_verify_paths)
         RESOLVEFUNC(SSL_CTX_set_verify)
+        RESOLVEFUNC(SSL_CTX_set_session_id_context)
         RESOLVEFUNC(SSL_CTX_set_verify_depth)
         RESOLVEFUNC(SSL_CTX_use_certificate)
         RESOLVEFUNC(SSL_CTX_use_certificate_file)
@@ -1071,6 +1087,7 @@ bool q_resolveOpenSslSymbols()
         RESOLVEFUNC(SSL_free)
         RESOLVEFUNC(SSL_get_ciphers)
         RESOLVEFUNC(SSL_get_current_cipher)
+        RESOLVEFUNC(SSL_CIPHER_get_id)
         RESOLVEFUNC(SSL_version)
         RESOLVEFUNC(SSL_get_error)
         RESOLVEFUNC(SSL_get_peer_cert_chain)
@@ -1079,6 +1096,11 @@ bool q_resolveOpenSslSymbols()
         RESOLVEFUNC(SSL_get1_peer_certificate)
         RESOLVEFUNC(EVP_PKEY_get_bits)
         RESOLVEFUNC(EVP_PKEY_get_base_id)
+        RESOLVEFUNC(EVP_KDF_fetch)
+        RESOLVEFUNC(EVP_KDF_free)
+        RESOLVEFUNC(EVP_KDF_CTX_new)
+        RESOLVEFUNC(EVP_KDF_CTX_free)
+        RESOLVEFUNC(EVP_KDF_derive)
 #else
         RESOLVEFUNC(SSL_get_peer_certificate)
         RESOLVEFUNC(EVP_PKEY_base_id)
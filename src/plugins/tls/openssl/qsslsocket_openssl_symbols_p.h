@@ -253,6 +253,7 @@ const char *q_OpenSSL_version(int type);
 
 unsigned long q_SSL_SESSION_get_ticket_lifetime_hint(const SSL_SESSION *session);
 unsigned long q_SSL_set_options(SSL *s, unsigned long op);
+qssloptions q_SSL_get_options(const SSL *s);
 
 #ifdef TLS1_3_VERSION
 int q_SSL_CTX_set_ciphersuites(SSL_CTX *ctx, const char *str);
@@ -270,6 +271,21 @@ using NewSessionCallback = int (*)(SSL *, SSL_SESSION *);
 void q_SSL_CTX_sess_set_new_cb(SSL_CTX *ctx, NewSessionCallback cb);
 int q_SSL_SESSION_is_resumable(const SSL_SESSION *s);
 
+extern "C"
+{
+using KeylogCallback = void (*)(const SSL *, const char *);
+}
+
+void q_SSL_CTX_set_keylog_callback(SSL_CTX *ctx, KeylogCallback cb);
+KeylogCallback q_SSL_CTX_get_keylog_callback(const SSL_CTX *ctx);
+
+extern "C"
+{
+using MessageCallback = void (*)(int, int, int, const void *, size_t, SSL *, void *);
+}
+
+void q_SSL_set_msg_callback(SSL *ssl, MessageCallback cb);
+
 #define q_SSL_CTX_set_session_cache_mode(ctx,m) \
     q_SSL_CTX_ctrl(ctx,SSL_CTRL_SET_SESS_CACHE_MODE,m,NULL)
 
@@ -413,6 +429,7 @@ SSL_CTX *q_SSL_CTX_new(const SSL_METHOD *a);
 int q_SSL_CTX_set_cipher_list(SSL_CTX *a, const char *b);
 int q_SSL_CTX_set_default_verify_paths(SSL_CTX *a);
 void q_SSL_CTX_set_verify(SSL_CTX *a, int b, int (*c)(int, X509_STORE_CTX *));
+int q_SSL_CTX_set_session_id_context(SSL_CTX *a, const unsigned char *b, unsigned int c);
 void q_SSL_CTX_set_verify_depth(SSL_CTX *a, int b);
 extern "C" {
 typedef void (*GenericCallbackType)();
@@ -432,6 +449,7 @@ int q_SSL_CONF_cmd(SSL_CONF_CTX *a, const char *b, const char *c);
 void q_SSL_free(SSL *a);
 STACK_OF(SSL_CIPHER) *q_SSL_get_ciphers(const SSL *a);
 const SSL_CIPHER *q_SSL_get_current_cipher(SSL *a);
+uint32_t q_SSL_CIPHER_get_id(const SSL_CIPHER *c);
 int q_SSL_version(const SSL *a);
 int q_SSL_get_error(SSL *a, int b);
 STACK_OF(X509) *q_SSL_get_peer_cert_chain(SSL *a);
@@ -683,6 +701,11 @@ X509 *q_SSL_get1_peer_certificate(SSL *a);
 int q_EVP_PKEY_get_bits(const EVP_PKEY *pkey);
 int q_EVP_PKEY_get_base_id(const EVP_PKEY *pkey);
 #define q_EVP_PKEY_base_id q_EVP_PKEY_get_base_id
+EVP_KDF *q_EVP_KDF_fetch(OSSL_LIB_CTX *libctx, const char *algorithm, const char *properties);
+void q_EVP_KDF_free(EVP_KDF *kdf);
+EVP_KDF_CTX *q_EVP_KDF_CTX_new(EVP_KDF *kdf);
+void q_EVP_KDF_CTX_free(EVP_KDF_CTX *ctx);
+int q_EVP_KDF_derive(EVP_KDF_CTX *ctx, unsigned char *key, size_t keylen, const OSSL_PARAM params[]);
 #else
 X509 *q_SSL_get_peer_certificate(SSL *a);
 int q_EVP_PKEY_base_id(EVP_PKEY *a);
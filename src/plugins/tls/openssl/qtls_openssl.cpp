@@ -22,6 +22,25 @@
 #include <algorithm>
 #include <cstring>
 
+#if defined(Q_OS_LINUX) && defined(TLS1_3_VERSION) && defined(SSL_OP_ENABLE_KTLS) \
+    && __has_include(<linux/tls.h>)
+#  define QT_OPENSSL_KTLS
+#  include <QtNetwork/private/qabstractsocket_p.h>
+#  include <QtCore/private/qcore_unix_p.h>
+#  include <openssl/core_names.h>
+#  include <openssl/kdf.h>
+#  include <openssl/params.h>
+#  include <linux/tls.h>
+#  include <netinet/tcp.h>
+#  include <sys/socket.h>
+#  ifndef SOL_TLS
+#    define SOL_TLS 282
+#  endif
+#  ifndef TCP_ULP
+#    define TCP_ULP 31
+#  endif
+#endif
+
 QT_BEGIN_NAMESPACE
 
 using namespace Qt::StringLiterals;
@@ -358,6 +377,31 @@ void qt_AlertInfoCallback(const SSL *connection, int from, int value)
         crypto->alertMessageReceived(value);
 }
 
+#ifdef QT_OPENSSL_KTLS
+static void q_ssl_keylog_callback(const SSL *ssl, const char *line)
+{
+    // Installed with SSL_CTX_set_keylog_callback(), the context may be shared
+    // with connections that did not ask for kernel TLS. storeTrafficSecret()
+    // ignores the lines of those.
+    auto *tls = static_cast<TlsCryptographOpenSSL *>(q_SSL_get_ex_data(ssl, QTlsBackendOpenSSL::s_indexForSSLExtraData));
+    if (tls && line)
+        tls->storeTrafficSecret(QByteArrayView(line));
+}
+
+static void q_ssl_msg_callback(int writing, int, int contentType, const void *buf, size_t len,
+                               SSL *ssl, void *)
+{
+    // Set with SSL_set_msg_callback(), only on connections that asked for
+    // kernel TLS: tells us about handshake messages OpenSSL sends after the
+    // handshake, when the kernel protects our records.
+    if (!writing || contentType != SSL3_RT_HANDSHAKE || !len)
+        return;
+    auto *tls = static_cast<TlsCryptographOpenSSL *>(q_SSL_get_ex_data(ssl, QTlsBackendOpenSSL::s_indexForSSLExtraData));
+    if (tls)
+        tls->handshakeMessageSent(*static_cast<const unsigned char *>(buf));
+}
+#endif // QT_OPENSSL_KTLS
+
 } // extern "C"
 
 #if QT_CONFIG(ocsp)
@@ -471,6 +515,157 @@ bool qt_OCSP_certificate_match(OCSP_SINGLERESP *singleResponse, X509 *peerCert,
 } // unnamed namespace
 #endif // ocsp
 
+#ifdef QT_OPENSSL_KTLS
+namespace {
+
+// HKDF-Expand-Label (RFC 8446, 7.1) with an empty context.
+QByteArray hkdfExpandLabel(const char *digest, const QByteArray &secret, QByteArrayView label,
+                           int length)
+{
+    QByteArray info;
+    info.reserve(2 + 1 + 6 + label.size() + 1);
+    info.append(char(length >> 8)).append(char(length & 0xff));
+    info.append(char(6 + label.size())).append("tls13 ").append(label);
+    info.append(char(0)); // context
+
+    EVP_KDF *kdf = q_EVP_KDF_fetch(nullptr, OSSL_KDF_NAME_HKDF, nullptr);
+    if (!kdf)
+        return {};
+    EVP_KDF_CTX *context = q_EVP_KDF_CTX_new(kdf);
+    q_EVP_KDF_free(kdf);
+    if (!context)
+        return {};
+    const auto freeContext = qScopeGuard([context] { q_EVP_KDF_CTX_free(context); });
+
+    int mode = EVP_KDF_HKDF_MODE_EXPAND_ONLY;
+    const OSSL_PARAM params[] = {
+        OSSL_PARAM_int(OSSL_KDF_PARAM_MODE, &mode),
+        OSSL_PARAM_utf8_string(OSSL_KDF_PARAM_DIGEST, const_cast<char *>(digest), 0),
+        OSSL_PARAM_octet_string(OSSL_KDF_PARAM_KEY, const_cast<char *>(secret.constData()),
+                                size_t(secret.size())),
+        OSSL_PARAM_octet_string(OSSL_KDF_PARAM_INFO, info.data(), size_t(info.size())),
+        OSSL_PARAM_END
+    };
+    QByteArray out(length, Qt::Uninitialized);
+    if (q_EVP_KDF_derive(context, reinterpret_cast<unsigned char *>(out.data()), size_t(length),
+                         params) <= 0) {
+        return {};
+    }
+    return out;
+}
+
+template <typename CryptoInfo>
+socklen_t fillKernelCryptoInfo(CryptoInfo &info, quint16 cipherType, const QByteArray &key,
+                               const QByteArray &iv)
+{
+    // The kernel wants the 12 byte TLS 1.3 IV split into a salt (empty for
+    // ChaCha20) and the rest. The record sequence number stays zero: the
+    // application traffic keys have not been used yet.
+    Q_ASSERT(size_t(key.size()) == sizeof(info.key));
+    Q_ASSERT(size_t(iv.size()) == sizeof(info.salt) + sizeof(info.iv));
+    info.info.version = TLS_1_3_VERSION;
+    info.info.cipher_type = cipherType;
+    std::memcpy(info.key, key.constData(), sizeof(info.key));
+    std::memcpy(info.salt, iv.constData(), sizeof(info.salt));
+    std::memcpy(info.iv, iv.constData() + sizeof(info.salt), sizeof(info.iv));
+    return sizeof(info);
+}
+
+const char *kernelCipherDigest(quint32 cipherId)
+{
+    return cipherId == 0x03001302 ? "SHA384" : "SHA256";
+}
+
+bool setKernelTransmitKey(int fd, quint32 cipherId, const QByteArray &secret)
+{
+    const char *digest = kernelCipherDigest(cipherId);
+    int keyLength = 0;
+    switch (cipherId) {
+    case 0x03001301: // TLS_AES_128_GCM_SHA256
+        keyLength = TLS_CIPHER_AES_GCM_128_KEY_SIZE;
+        break;
+    case 0x03001302: // TLS_AES_256_GCM_SHA384
+        keyLength = TLS_CIPHER_AES_GCM_256_KEY_SIZE;
+        break;
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+    case 0x03001303: // TLS_CHACHA20_POLY1305_SHA256
+        keyLength = TLS_CIPHER_CHACHA20_POLY1305_KEY_SIZE;
+        break;
+#endif
+    default:
+        return false;
+    }
+
+    QByteArray key = hkdfExpandLabel(digest, secret, "key", keyLength);
+    QByteArray iv = hkdfExpandLabel(digest, secret, "iv", 12);
+    if (key.isEmpty() || iv.isEmpty())
+        return false;
+
+    union {
+        tls12_crypto_info_aes_gcm_128 aes128;
+        tls12_crypto_info_aes_gcm_256 aes256;
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+        tls12_crypto_info_chacha20_poly1305 chacha20;
+#endif
+    } info = {};
+    socklen_t infoSize = 0;
+    switch (cipherId) {
+    case 0x03001301:
+        infoSize = fillKernelCryptoInfo(info.aes128, TLS_CIPHER_AES_GCM_128, key, iv);
+        break;
+    case 0x03001302:
+        infoSize = fillKernelCryptoInfo(info.aes256, TLS_CIPHER_AES_GCM_256, key, iv);
+        break;
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+    case 0x03001303:
+        infoSize = fillKernelCryptoInfo(info.chacha20, TLS_CIPHER_CHACHA20_POLY1305, key, iv);
+        break;
+#endif
+    }
+
+    const bool ok = ::setsockopt(fd, SOL_TLS, TLS_TX, &info, infoSize) == 0;
+    if (!ok)
+        qCDebug(lcTlsBackend) << "TLS_TX failed:" << qt_error_string(errno);
+
+    key.fill('\0');
+    iv.fill('\0');
+    std::memset(static_cast<void *>(&info), 0, sizeof info);
+    return ok;
+}
+
+// With kernel TLS, records other than application data go out as plain text
+// through sendmsg(), with their content type in a control message.
+bool sendKernelRecord(int fd, unsigned char contentType, const char *data, size_t size)
+{
+    iovec iov = { const_cast<char *>(data), size };
+    char control[CMSG_SPACE(sizeof(unsigned char))] = {};
+
+    msghdr message = {};
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof control;
+
+    cmsghdr *header = CMSG_FIRSTHDR(&message);
+    header->cmsg_level = SOL_TLS;
+    header->cmsg_type = TLS_SET_RECORD_TYPE;
+    header->cmsg_len = CMSG_LEN(sizeof(unsigned char));
+    *CMSG_DATA(header) = contentType;
+
+    qint64 sent = 0;
+    QT_EINTR_LOOP(sent, ::sendmsg(fd, &message, MSG_NOSIGNAL));
+    return sent == qint64(size);
+}
+
+bool sendKernelCloseNotify(int fd)
+{
+    const char alert[2] = { 1 /* warning */, 0 /* close_notify */ };
+    return sendKernelRecord(fd, SSL3_RT_ALERT, alert, sizeof alert);
+}
+
+} // unnamed namespace
+#endif // QT_OPENSSL_KTLS
+
 TlsCryptographOpenSSL::~TlsCryptographOpenSSL()
 {
     destroySslContext();
@@ -801,13 +996,18 @@ void TlsCryptographOpenSSL::continueHandshake()
 #endif // QT_DECRYPT_SSL_TRAFFIC
 
     const auto &configuration = q->sslConfiguration();
+    // A server context shared by QSslServer keeps its sessions in OpenSSL's
+    // server-side cache; the single session slot of QSslContext is only for
+    // clients to resume from.
+    const bool sharedServerContext = mode == QSslSocket::SslServerMode
+            && !configuration.testSslOption(QSsl::SslOptionDisableSessionCache);
     // Cache this SSL session inside the QSslContext
-    if (!(configuration.testSslOption(QSsl::SslOptionDisableSessionSharing))) {
+    if (!sharedServerContext && !(configuration.testSslOption(QSsl::SslOptionDisableSessionSharing))) {
         if (!sslContextPointer->cacheSession(ssl)) {
             sslContextPointer.reset(); // we could not cache the session
         } else {
             // Cache the session for permanent usage as well
-            if (!(configuration.testSslOption(QSsl::SslOptionDisableSessionPersistence))) {
+            if (d->isSessionPersistent()) {
                 if (!sslContextPointer->sessionASN1().isEmpty())
                     QTlsBackend::setSessionAsn1(d, sslContextPointer->sessionASN1());
                 QTlsBackend::setSessionLifetimeHint(d, sslContextPointer->sessionTicketLifeTimeHint());
@@ -817,21 +1017,22 @@ void TlsCryptographOpenSSL::continueHandshake()
 
 #if !defined(OPENSSL_NO_NEXTPROTONEG)
 
-    QTlsBackend::setAlpnStatus(d, sslContextPointer->npnContext().status);
-    if (sslContextPointer->npnContext().status == QSslConfiguration::NextProtocolNegotiationUnsupported) {
+    const unsigned char *alpnProto = nullptr;
+    unsigned int alpnProtoLen = 0;
+    q_SSL_get0_alpn_selected(ssl, &alpnProto, &alpnProtoLen);
+    // The context is shared between the sockets of a QSslServer; its NPN
+    // callback stores the outcome with each connection as well.
+    const auto alpnStatus = alpnProtoLen ? QSslConfiguration::NextProtocolNegotiationNegotiated
+                                         : QSslContext::npnStatus(ssl);
+    QTlsBackend::setAlpnStatus(d, alpnStatus);
+    if (alpnStatus == QSslConfiguration::NextProtocolNegotiationUnsupported) {
         // we could not agree -> be conservative and use HTTP/1.1
         // T.P.: I have to admit, this is a really strange notion of 'conservative',
         // given the protocol-neutral nature of ALPN/NPN.
         QTlsBackend::setNegotiatedProtocol(d, QByteArrayLiteral("http/1.1"));
     } else {
-        const unsigned char *proto = nullptr;
-        unsigned int proto_len = 0;
-
-        q_SSL_get0_alpn_selected(ssl, &proto, &proto_len);
-        if (proto_len && mode == QSslSocket::SslClientMode) {
-            // Client does not have a callback that sets it ...
-            QTlsBackend::setAlpnStatus(d, QSslConfiguration::NextProtocolNegotiationNegotiated);
-        }
+        const unsigned char *proto = alpnProto;
+        unsigned int proto_len = alpnProtoLen;
 
         if (!proto_len) { // Test if NPN was more lucky ...
             q_SSL_get0_next_proto_negotiated(ssl, &proto, &proto_len);
@@ -850,6 +1051,8 @@ void TlsCryptographOpenSSL::continueHandshake()
             QTlsBackend::setEphemeralKey(d, QSslKey(key, QSsl::PublicKey));
     }
 
+    enableKernelTlsTransmit();
+
     d->setEncrypted(true);
     emit q->encrypted();
     if (d->isAutoStartingHandshake() && d->isPendingClose()) {
@@ -888,6 +1091,20 @@ void TlsCryptographOpenSSL::transmit()
             qint64 totalBytesWritten = 0;
             int nextDataBlockSize;
             while ((nextDataBlockSize = writeBuffer.nextDataBlockSize()) > 0) {
+                if (kernelTlsTransmit) {
+                    // The kernel encrypts whatever goes to the socket.
+                    const qint64 writtenBytes = plainSocket->write(writeBuffer.readPointer(),
+                                                                   nextDataBlockSize);
+                    if (writtenBytes < 0) {
+                        const ScopedBool bg(inSetAndEmitError, true);
+                        setErrorAndEmit(d, plainSocket->error(), plainSocket->errorString());
+                        return;
+                    }
+                    writeBuffer.free(writtenBytes);
+                    totalBytesWritten += writtenBytes;
+                    continue;
+                }
+
                 int writtenBytes = q_SSL_write(ssl, writeBuffer.readPointer(), nextDataBlockSize);
                 if (writtenBytes <= 0) {
                     int error = q_SSL_get_error(ssl, writtenBytes);
@@ -935,6 +1152,13 @@ void TlsCryptographOpenSSL::transmit()
         // Check if we've got any data to be written to the socket.
         QVarLengthArray<char, 4096> data;
         int pendingBytes;
+        if (kernelTlsTransmit && q_BIO_pending(writeBio) > 0 && !sendKernelHandshakeMessages()) {
+            const ScopedBool bg(inSetAndEmitError, true);
+            setErrorAndEmit(d, QAbstractSocket::SslInternalError,
+                            QSslSocket::tr("Unable to write data: %1").arg(
+                            QSslSocket::tr("Record protection was offloaded to the kernel")));
+            return;
+        }
         while (plainSocket->isValid() && (pendingBytes = q_BIO_pending(writeBio)) > 0
                 && plainSocket->openMode() != QIODevice::NotOpen) {
             // Read encrypted data from the write BIO into a buffer.
@@ -1113,6 +1337,24 @@ void TlsCryptographOpenSSL::transmit()
 
 void TlsCryptographOpenSSL::disconnectFromHost()
 {
+    if (ssl && kernelTlsTransmit) {
+#ifdef QT_OPENSSL_KTLS
+        auto *plainSocket = d->plainTcpSocket();
+        Q_ASSERT(plainSocket);
+        if (!shutdown && !systemOrSslErrorDetected) {
+            // close_notify must follow whatever the plain socket still has
+            // queued. QSslSocket calls us again every time it writes some.
+            plainSocket->flush();
+            if (plainSocket->bytesToWrite() > 0)
+                return;
+            if (!sendKernelCloseNotify(int(plainSocket->socketDescriptor())))
+                qCDebug(lcTlsBackend, "could not send close_notify through the kernel");
+            shutdown = true;
+        }
+        plainSocket->disconnectFromHost();
+        return;
+#endif // QT_OPENSSL_KTLS
+    }
     if (ssl) {
         if (!shutdown && !q_SSL_in_init(ssl) && !systemOrSslErrorDetected) {
             if (q_SSL_shutdown(ssl) != 1) {
@@ -1182,6 +1424,11 @@ QT_WARNING_POP
     return QSsl::UnknownProtocol;
 }
 
+bool TlsCryptographOpenSSL::hasKernelTlsTransmit() const
+{
+    return kernelTlsTransmit;
+}
+
 QList<QOcspResponse> TlsCryptographOpenSSL::ocsps() const
 {
     return ocspResponses;
@@ -1229,7 +1476,7 @@ int TlsCryptographOpenSSL::handleNewSessionTicket(SSL *connection)
     Q_ASSERT(q);
     Q_ASSERT(d);
 
-    if (q->sslConfiguration().testSslOption(QSsl::SslOptionDisableSessionPersistence)) {
+    if (!d->isSessionPersistent()) {
         // We silently ignore, do nothing, remove from cache.
         return 0;
     }
@@ -1368,7 +1615,7 @@ bool TlsCryptographOpenSSL::initSslContext()
     // If no external context was set (e.g. by QHttpNetworkConnection) we will
     // create a new one.
     const auto mode = d->tlsMode();
-    const auto configuration = q->sslConfiguration();
+    const auto configuration = d->contextConfiguration();
     if (!sslContextPointer)
         sslContextPointer = QSslContext::sharedFromConfiguration(mode, configuration, d->isRootsOnDemandAllowed());
 
@@ -1408,6 +1655,30 @@ bool TlsCryptographOpenSSL::initSslContext()
     // Clear the session.
     errorList.clear();
 
+    trafficSecret.clear();
+    kernelTlsTransmit = false;
+    wantsTrafficSecret = false;
+    pendingKeyUpdates = 0;
+    unsupportedPostHandshakeMessage = false;
+#ifdef QT_OPENSSL_KTLS
+    // OpenSSL itself can only use kernel TLS with socket BIOs, which we do
+    // not have; we honor SSL_OP_ENABLE_KTLS for the sending side of TLS 1.3
+    // client connections, see enableKernelTlsTransmit(). OpenSSL reports the
+    // secrets only to a key log callback of the context, which we never
+    // take away from somebody else.
+    if (mode == QSslSocket::SslClientMode && (q_SSL_get_options(ssl) & SSL_OP_ENABLE_KTLS)) {
+        SSL_CTX *context = q_SSL_get_SSL_CTX(ssl);
+        const KeylogCallback keylog = q_SSL_CTX_get_keylog_callback(context);
+        if (!keylog)
+            q_SSL_CTX_set_keylog_callback(context, &q_ssl_keylog_callback);
+        wantsTrafficSecret = !keylog || keylog == &q_ssl_keylog_callback;
+        if (wantsTrafficSecret)
+            q_SSL_set_msg_callback(ssl, &q_ssl_msg_callback);
+        else
+            qCDebug(lcTlsBackend, "the context has a key log callback, not using kernel TLS");
+    }
+#endif
+
     // Initialize memory BIOs for encryption and decryption.
     readBio = q_BIO_new(q_BIO_s_mem());
     writeBio = q_BIO_new(q_BIO_s_mem());
@@ -1503,6 +1774,168 @@ void TlsCryptographOpenSSL::destroySslContext()
         ssl = nullptr;
     }
     sslContextPointer.reset();
+    trafficSecret.fill('\0');
+    trafficSecret.clear();
+    kernelTlsTransmit = false;
+    wantsTrafficSecret = false;
+}
+
+/*!
+    \internal
+
+    Moves encryption of outgoing application data into the kernel (Linux
+    kernel TLS), once the handshake is done and before anything is written
+    with the new keys. Afterwards plain text is written to the plain socket,
+    which also allows sending files with sendfile(). Decryption stays with
+    OpenSSL.
+
+    This is only attempted for TLS 1.3 client connections using an AES-GCM or
+    ChaCha20-Poly1305 cipher suite, when the configuration enabled
+    SSL_OP_ENABLE_KTLS (for example, through the "Options" backend
+    configuration option set to "KTLS"). Returns \c false, leaving everything
+    to OpenSSL, if that is not the case or the kernel does not support it
+    (for example, because the tls module is not loaded).
+*/
+bool TlsCryptographOpenSSL::enableKernelTlsTransmit()
+{
+#ifdef QT_OPENSSL_KTLS
+    // The secret is kept for key updates, see sendKernelHandshakeMessages().
+    const auto wipeSecret = qScopeGuard([this] {
+        if (!kernelTlsTransmit) {
+            trafficSecret.fill('\0');
+            trafficSecret.clear();
+        }
+    });
+    if (trafficSecret.isEmpty() || kernelTlsTransmit || d->tlsMode() != QSslSocket::SslClientMode
+        || q_SSL_version(ssl) != TLS1_3_VERSION) {
+        return false;
+    }
+
+    auto *plainSocket = d->plainTcpSocket();
+    Q_ASSERT(plainSocket);
+#ifndef QT_NO_NETWORKPROXY
+    // Proxy socket engines have buffers of their own, we could never tell
+    // when the handshake has left them.
+    const auto *plainD = static_cast<const QAbstractSocketPrivate *>(QObjectPrivate::get(plainSocket));
+    if (plainD->proxyInUse.type() != QNetworkProxy::NoProxy)
+        return false;
+#endif
+    const qintptr descriptor = plainSocket->socketDescriptor();
+    if (descriptor == -1)
+        return false;
+
+    // Our Finished message must reach the kernel, encrypted by OpenSSL,
+    // before the kernel starts encrypting on its own.
+    QVarLengthArray<char, 4096> data;
+    int pendingBytes;
+    while ((pendingBytes = q_BIO_pending(writeBio)) > 0) {
+        data.resize(pendingBytes);
+        const int encryptedBytesRead = q_BIO_read(writeBio, data.data(), pendingBytes);
+        if (encryptedBytesRead <= 0 || plainSocket->write(data.constData(), encryptedBytesRead) < 0)
+            return false;
+    }
+    plainSocket->flush();
+    if (plainSocket->bytesToWrite() > 0)
+        return false;
+
+    const int fd = int(descriptor);
+    if (::setsockopt(fd, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) != 0) {
+        qCDebug(lcTlsBackend) << "kernel TLS is not available:" << qt_error_string(errno);
+        return false;
+    }
+    // Without keys the "tls" ULP passes data through unchanged, so failing
+    // here leaves the connection to OpenSSL as before.
+    const SSL_CIPHER *cipher = q_SSL_get_current_cipher(ssl);
+    if (!cipher || !setKernelTransmitKey(fd, q_SSL_CIPHER_get_id(cipher), trafficSecret)) {
+        qCDebug(lcTlsBackend, "could not offload the session's cipher to the kernel");
+        return false;
+    }
+
+    kernelCipherId = q_SSL_CIPHER_get_id(cipher);
+    kernelTlsTransmit = true;
+    return true;
+#else
+    return false;
+#endif // QT_OPENSSL_KTLS
+}
+
+/*!
+    \internal
+
+    Called with the key log lines of all connections that share our context.
+    Only keeps the secret if this connection asked for kernel TLS.
+*/
+void TlsCryptographOpenSSL::storeTrafficSecret(QByteArrayView keyLogLine)
+{
+    // "CLIENT_TRAFFIC_SECRET_0 <client random> <secret>", both in hex.
+    constexpr QByteArrayView label("CLIENT_TRAFFIC_SECRET_0 ");
+    if (!wantsTrafficSecret || kernelTlsTransmit || !keyLogLine.startsWith(label))
+        return;
+    const qsizetype separator = keyLogLine.lastIndexOf(' ');
+    trafficSecret = QByteArray::fromHex(keyLogLine.sliced(separator + 1).toByteArray());
+}
+
+/*!
+    \internal
+
+    Called with the type of every handshake message OpenSSL sends on a
+    connection that asked for kernel TLS.
+*/
+void TlsCryptographOpenSSL::handshakeMessageSent(int type)
+{
+    if (!kernelTlsTransmit)
+        return;
+    if (type == SSL3_MT_KEY_UPDATE)
+        ++pendingKeyUpdates;
+    else
+        unsupportedPostHandshakeMessage = true;
+}
+
+/*!
+    \internal
+
+    OpenSSL wrote a handshake message after the kernel took over record
+    protection, with keys and a record sequence number that do not match
+    the kernel's. Drops the record and sends what it stood for through the
+    kernel instead.
+
+    The only message a client sends after the handshake is a KeyUpdate, in
+    reply to a KeyUpdate of the server that requested one. We send our own
+    KeyUpdate with the current keys, then give the kernel the next traffic
+    secret (RFC 8446, 7.2). Returns \c false if OpenSSL sent anything else, or
+    the kernel does not support changing the keys (before Linux 6.14).
+*/
+bool TlsCryptographOpenSSL::sendKernelHandshakeMessages()
+{
+#ifdef QT_OPENSSL_KTLS
+    char discarded[4096];
+    while (q_BIO_pending(writeBio) > 0) {
+        if (q_BIO_read(writeBio, discarded, sizeof discarded) <= 0)
+            return false;
+    }
+    if (unsupportedPostHandshakeMessage)
+        return false;
+
+    auto *plainSocket = d->plainTcpSocket();
+    Q_ASSERT(plainSocket);
+    const int fd = int(plainSocket->socketDescriptor());
+    const char *digest = kernelCipherDigest(kernelCipherId);
+    const int secretLength = kernelCipherId == 0x03001302 ? 48 : 32; // the hash length
+    for (; pendingKeyUpdates > 0; --pendingKeyUpdates) {
+        // msg_type, a 24-bit length and request_update = update_not_requested
+        const char keyUpdate[5] = { SSL3_MT_KEY_UPDATE, 0, 0, 1, 0 };
+        if (!sendKernelRecord(fd, SSL3_RT_HANDSHAKE, keyUpdate, sizeof keyUpdate))
+            return false;
+        QByteArray next = hkdfExpandLabel(digest, trafficSecret, "traffic upd", secretLength);
+        trafficSecret.fill('\0');
+        trafficSecret = std::move(next);
+        if (trafficSecret.isEmpty() || !setKernelTransmitKey(fd, kernelCipherId, trafficSecret))
+            return false;
+    }
+    return true;
+#else
+    return false;
+#endif // QT_OPENSSL_KTLS
 }
 
 void TlsCryptographOpenSSL::storePeerCertificates()
@@ -38,7 +38,8 @@ class TlsCryptographOpenSSL : public TlsCryptograph
 public:
     enum ExDataOffset {
         errorOffsetInExData = 1,
-        socketOffsetInExData = 2
+        socketOffsetInExData = 2,
+        npnStatusOffsetInExData = 3
     };
 
     ~TlsCryptographOpenSSL();
@@ -60,6 +61,7 @@ public:
     void disconnected() override;
     QSslCipher sessionCipher() const override;
     QSsl::SslProtocol sessionProtocol() const override;
+    bool hasKernelTlsTransmit() const override;
     QList<QOcspResponse> ocsps() const override;
 
     bool checkSslErrors();
@@ -88,6 +90,9 @@ public:
     bool isInSslRead() const;
     void setRenegotiated(bool renegotiated);
 
+    void storeTrafficSecret(QByteArrayView keyLogLine);
+    void handshakeMessageSent(int type);
+
 #ifdef Q_OS_WIN
     void fetchCaRootForCert(const QSslCertificate &cert);
     void caRootLoaded(QSslCertificate certificate, QSslCertificate trustedRoot);
@@ -99,6 +104,8 @@ private:
     // easier (see qsslsocket_openssl.cpp, while it exists).
     bool initSslContext();
     void destroySslContext();
+    bool enableKernelTlsTransmit();
+    bool sendKernelHandshakeMessages();
 
     std::shared_ptr<QSslContext> sslContextPointer;
     SSL *ssl = nullptr; // TLSTODO: RAII.
@@ -130,6 +137,16 @@ private:
 
     bool inSslRead = false;
     bool renegotiated = false;
+
+    // Our current application traffic secret, recorded when kernel TLS was
+    // requested with SSL_OP_ENABLE_KTLS, and the key updates OpenSSL sent
+    // since the kernel took over.
+    QByteArray trafficSecret;
+    quint32 kernelCipherId = 0;
+    int pendingKeyUpdates = 0;
+    bool wantsTrafficSecret = false;
+    bool unsupportedPostHandshakeMessage = false;
+    bool kernelTlsTransmit = false;
 };
 
 } // namespace QTlsPrivate
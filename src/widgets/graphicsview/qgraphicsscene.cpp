@@ -157,6 +157,13 @@
     removing items is logarithmic. This approach is best for static scenes
     (i.e., scenes where most items do not move).
 
+    \value [since 6.9] RTreeIndex A bounding volume hierarchy (R-tree) is
+    applied. Item location is of logarithmic complexity, like with
+    BspTreeIndex, but the index is updated incrementally instead of being
+    rebuilt: adding, moving and removing an item is logarithmic as well, and
+    small moves are often free. This approach is best for large scenes in
+    which many items move or are added after the scene was populated.
+
     \value NoIndex No index is applied. Item location is of linear complexity,
     as all items on the scene are searched. Adding, moving and removing items,
     however, is done in constant time. This approach is ideal for dynamic
@@ -179,6 +186,7 @@
 #include "qgraphicssceneindex_p.h"
 #include "qgraphicsscenebsptreeindex_p.h"
 #include "qgraphicsscenelinearindex_p.h"
+#include "qgraphicsscenertreeindex_p.h"
 
 #include <QtCore/qdebug.h>
 #include <QtCore/qlist.h>
@@ -1825,7 +1833,9 @@ void QGraphicsScene::render(QPainter *painter, const QRectF &target, const QRect
 
     For the common case, the default index method BspTreeIndex works fine.  If
     your scene uses many animations and you are experiencing slowness, you can
-    disable indexing by calling \c setItemIndexMethod(NoIndex).
+    disable indexing by calling \c setItemIndexMethod(NoIndex). For large
+    scenes in which many items move, \c RTreeIndex keeps lookups fast without
+    rebuilding the index.
 
     \sa bspTreeDepth
 */
@@ -1846,6 +1856,8 @@ void QGraphicsScene::setItemIndexMethod(ItemIndexMethod method)
     delete d->index;
     if (method == BspTreeIndex)
         d->index = new QGraphicsSceneBspTreeIndex(this);
+    else if (method == RTreeIndex)
+        d->index = new QGraphicsSceneRTreeIndex(this);
     else
         d->index = new QGraphicsSceneLinearIndex(this);
     for (int i = oldItems.size() - 1; i >= 0; --i)
@@ -72,6 +72,7 @@ class Q_WIDGETS_EXPORT QGraphicsScene : public QObject
 public:
     enum ItemIndexMethod {
         BspTreeIndex,
+        RTreeIndex,
         NoIndex = -1
     };
     Q_ENUM(ItemIndexMethod)
@@ -0,0 +1,712 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+/*!
+    \class QGraphicsSceneRTreeIndex
+    \brief The QGraphicsSceneRTreeIndex class provides an index for
+    discovering items in QGraphicsScene that is updated incrementally.
+    \since 6.9
+    \ingroup graphicsview-api
+
+    \internal
+
+    QGraphicsSceneRTreeIndex keeps the items' bounding rectangles in a
+    bounding volume hierarchy (QGraphicsSceneRTree). Unlike
+    QGraphicsSceneBspTreeIndex, which throws away and rebuilds its tree when
+    many items were added or moved, this index only updates the parts of the
+    tree that changed: moving an item costs O(log n), and usually nothing at
+    all when the item stays within the margin its leaf was given. Items that
+    are added in bulk, such as when a scene is populated, are loaded into a
+    balanced tree in one go.
+
+    \sa QGraphicsScene, QGraphicsSceneBspTreeIndex, QGraphicsSceneIndex
+*/
+
+#include <private/qgraphicsscenertreeindex_p.h>
+#include <private/qgraphicsscenebsptreeindex_p.h>
+#include <private/qgraphicsscene_p.h>
+
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qthreadpool.h>
+
+#include <algorithm>
+
+using namespace std::chrono_literals;
+
+QT_BEGIN_NAMESPACE
+
+// Leaves are enlarged by this fraction of their size on every side.
+static constexpr qreal RTreeLeafMargin = 0.125;
+// Below this many entries, building a subtree on another thread costs more
+// than it saves.
+static constexpr qsizetype RTreeConcurrentEntries = 8192;
+
+/*!
+    \internal
+
+    Returns \a rect enlarged by the margin that is given to leaves.
+*/
+QRectF QGraphicsSceneRTree::fattened(const QRectF &rect)
+{
+    const QRectF normalized = rect.normalized();
+    const qreal margin = qMax(normalized.width(), normalized.height()) * RTreeLeafMargin;
+    return normalized.adjusted(-margin, -margin, margin, margin);
+}
+
+int QGraphicsSceneRTree::allocateNode()
+{
+    if (freeList == Null) {
+        nodes.append(Node());
+        return int(nodes.size() - 1);
+    }
+    const int node = freeList;
+    freeList = nodes.at(node).parent;
+    nodes[node] = Node();
+    return node;
+}
+
+void QGraphicsSceneRTree::freeNode(int node)
+{
+    Node &n = nodes[node];
+    n.item = nullptr;
+    n.height = -1;
+    n.children[0] = n.children[1] = Null;
+    n.parent = freeList;
+    freeList = node;
+}
+
+/*!
+    \internal
+
+    Adds a leaf for \a item with the bounding rectangle \a rect, and returns
+    the leaf.
+*/
+int QGraphicsSceneRTree::insert(QGraphicsItem *item, const QRectF &rect)
+{
+    const int leaf = allocateNode();
+    Node &node = nodes[leaf];
+    node.rect = fattened(rect);
+    node.item = item;
+    node.height = 0;
+    insertLeaf(leaf);
+    ++leaves;
+    return leaf;
+}
+
+/*!
+    \internal
+
+    Removes \a leaf from the tree.
+*/
+void QGraphicsSceneRTree::remove(int leaf)
+{
+    Q_ASSERT(leaf >= 0 && leaf < nodes.size() && nodes.at(leaf).height == 0);
+    removeLeaf(leaf);
+    freeNode(leaf);
+    --leaves;
+}
+
+/*!
+    \internal
+
+    Updates \a leaf for an item whose bounding rectangle is now \a rect.
+    Returns \c true if the leaf had to be moved within the tree, or \c false
+    if \a rect still lies within the enlarged rectangle of the leaf. The
+    leaf keeps its number either way.
+*/
+bool QGraphicsSceneRTree::move(int leaf, const QRectF &rect)
+{
+    Q_ASSERT(leaf >= 0 && leaf < nodes.size() && nodes.at(leaf).height == 0);
+    if (contains(nodes.at(leaf).rect, rect.normalized()))
+        return false;
+    removeLeaf(leaf);
+    nodes[leaf].rect = fattened(rect);
+    insertLeaf(leaf);
+    return true;
+}
+
+/*!
+    \internal
+
+    Replaces the contents of the tree with a balanced tree holding
+    \a entries. The rectangles of the entries are used as they are, without
+    adding a margin.
+
+    The tree is built top-down by splitting the entries at the median of the
+    longer axis. Large subtrees are built on idle threads of the global
+    thread pool; each subtree writes to its own, precomputed range of nodes.
+*/
+void QGraphicsSceneRTree::bulkLoad(QList<Entry> &&entries)
+{
+    clear();
+    if (entries.isEmpty())
+        return;
+    // A tree with n leaves has 2n - 1 nodes; build() lays them out in
+    // preorder, so the node of every subtree is known before it is built.
+    nodes.resize(2 * entries.size() - 1);
+    leaves = int(entries.size());
+    root = build(entries.data(), entries.data() + entries.size(), Null);
+}
+
+int QGraphicsSceneRTree::build(Entry *begin, Entry *end, int parent)
+{
+    Node *data = nodes.data();
+    const auto buildRange = [data](auto &self, Entry *first, Entry *last, int node,
+                                   int parentNode) -> void {
+        Node &n = data[node];
+        n.parent = parentNode;
+        const qsizetype count = last - first;
+        if (count == 1) {
+            n.rect = first->rect;
+            n.item = first->item;
+            n.height = 0;
+            return;
+        }
+
+        QRectF bounds = first->rect;
+        for (const Entry *entry = first + 1; entry != last; ++entry)
+            bounds = united(bounds, entry->rect);
+        const bool horizontal = bounds.width() >= bounds.height();
+        Entry *middle = first + count / 2;
+        std::nth_element(first, middle, last, [horizontal](const Entry &a, const Entry &b) {
+            return horizontal ? a.rect.center().x() < b.rect.center().x()
+                              : a.rect.center().y() < b.rect.center().y();
+        });
+
+        const int left = node + 1;
+        const int right = node + 2 * int(middle - first);
+        bool concurrent = false;
+#if QT_CONFIG(thread)
+        QSemaphore finished;
+        if (count >= 2 * RTreeConcurrentEntries) {
+            concurrent = QThreadPool::globalInstance()->tryStart([&] {
+                self(self, first, middle, left, node);
+                finished.release();
+            });
+        }
+#endif
+        if (!concurrent)
+            self(self, first, middle, left, node);
+        self(self, middle, last, right, node);
+#if QT_CONFIG(thread)
+        if (concurrent)
+            finished.acquire();
+#endif
+
+        n.children[0] = left;
+        n.children[1] = right;
+        n.rect = united(data[left].rect, data[right].rect);
+        n.height = 1 + qMax(data[left].height, data[right].height);
+    };
+    buildRange(buildRange, begin, end, 0, parent);
+    return 0;
+}
+
+/*!
+    \internal
+
+    Removes all leaves.
+*/
+void QGraphicsSceneRTree::clear()
+{
+    nodes.clear();
+    root = Null;
+    freeList = Null;
+    leaves = 0;
+}
+
+/*!
+    \internal
+
+    Returns the items in the tree with the enlarged rectangles of their
+    leaves, suitable for bulkLoad().
+*/
+QList<QGraphicsSceneRTree::Entry> QGraphicsSceneRTree::entries() const
+{
+    QList<Entry> result;
+    result.reserve(leaves);
+    forEachLeaf([&](QGraphicsItem *item, int leaf) {
+        result.append(Entry{nodes.at(leaf).rect, item});
+    });
+    return result;
+}
+
+void QGraphicsSceneRTree::replaceChild(int parent, int oldChild, int newChild)
+{
+    if (parent == Null) {
+        root = newChild;
+        return;
+    }
+    Node &p = nodes[parent];
+    if (p.children[0] == oldChild)
+        p.children[0] = newChild;
+    else
+        p.children[1] = newChild;
+}
+
+void QGraphicsSceneRTree::insertLeaf(int leaf)
+{
+    if (root == Null) {
+        root = leaf;
+        nodes[leaf].parent = Null;
+        return;
+    }
+
+    // Descend to the sibling that grows the tree's perimeter the least.
+    const QRectF leafRect = nodes.at(leaf).rect;
+    int index = root;
+    while (nodes.at(index).height > 0) {
+        const Node &node = nodes.at(index);
+        const qreal area = perimeter(node.rect);
+        const qreal combined = perimeter(united(node.rect, leafRect));
+        // The cost of pairing the leaf with this node, and the cost that
+        // descending adds to every level below.
+        const qreal cost = 2 * combined;
+        const qreal inheritance = 2 * (combined - area);
+        qreal childCosts[2];
+        for (int i = 0; i < 2; ++i) {
+            const Node &child = nodes.at(node.children[i]);
+            const qreal enlarged = perimeter(united(child.rect, leafRect));
+            childCosts[i] = (child.height == 0 ? enlarged : enlarged - perimeter(child.rect))
+                    + inheritance;
+        }
+        if (cost < childCosts[0] && cost < childCosts[1])
+            break;
+        index = node.children[childCosts[0] < childCosts[1] ? 0 : 1];
+    }
+
+    const int sibling = index;
+    const int oldParent = nodes.at(sibling).parent;
+    const int newParent = allocateNode();
+    {
+        Node &p = nodes[newParent];
+        p.parent = oldParent;
+        p.rect = united(leafRect, nodes.at(sibling).rect);
+        p.height = nodes.at(sibling).height + 1;
+        p.children[0] = sibling;
+        p.children[1] = leaf;
+    }
+    replaceChild(oldParent, sibling, newParent);
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+
+    refit(oldParent);
+}
+
+void QGraphicsSceneRTree::removeLeaf(int leaf)
+{
+    if (leaf == root) {
+        root = Null;
+        return;
+    }
+    const int parent = nodes.at(leaf).parent;
+    const int grandParent = nodes.at(parent).parent;
+    const Node &p = nodes.at(parent);
+    const int sibling = p.children[0] == leaf ? p.children[1] : p.children[0];
+
+    replaceChild(grandParent, parent, sibling);
+    nodes[sibling].parent = grandParent;
+    freeNode(parent);
+    nodes[leaf].parent = Null;
+
+    refit(grandParent);
+}
+
+// Rebalances and recomputes the rectangles and heights from \a node up to
+// the root.
+void QGraphicsSceneRTree::refit(int node)
+{
+    while (node != Null) {
+        node = balance(node);
+        Node &n = nodes[node];
+        const Node &left = nodes.at(n.children[0]);
+        const Node &right = nodes.at(n.children[1]);
+        n.height = 1 + qMax(left.height, right.height);
+        n.rect = united(left.rect, right.rect);
+        node = n.parent;
+    }
+}
+
+// If the subtrees of \a a differ in height by more than one, rotates the
+// higher child up, and returns the node that took the place of \a a.
+int QGraphicsSceneRTree::balance(int a)
+{
+    if (nodes.at(a).height < 2)
+        return a;
+
+    const int b = nodes.at(a).children[0];
+    const int c = nodes.at(a).children[1];
+    const int difference = nodes.at(c).height - nodes.at(b).height;
+    if (difference >= -1 && difference <= 1)
+        return a;
+
+    // Rotate the higher child up; its lower child takes its place under a.
+    const int slot = difference > 1 ? 1 : 0;
+    const int up = slot == 1 ? c : b;
+    const int other = slot == 1 ? b : c;
+    const int f = nodes.at(up).children[0];
+    const int g = nodes.at(up).children[1];
+    const bool keepF = nodes.at(f).height > nodes.at(g).height;
+    const int kept = keepF ? f : g;
+    const int moved = keepF ? g : f;
+
+    nodes[up].parent = nodes.at(a).parent;
+    replaceChild(nodes.at(up).parent, a, up);
+    nodes[a].parent = up;
+    nodes[up].children[0] = a;
+    nodes[up].children[1] = kept;
+    nodes[a].children[slot] = moved;
+    nodes[moved].parent = a;
+
+    Node &na = nodes[a];
+    na.rect = united(nodes.at(other).rect, nodes.at(moved).rect);
+    na.height = 1 + qMax(nodes.at(other).height, nodes.at(moved).height);
+    Node &nu = nodes[up];
+    nu.rect = united(na.rect, nodes.at(kept).rect);
+    nu.height = 1 + qMax(na.height, nodes.at(kept).height);
+    return up;
+}
+
+/*!
+    Constructs a private scene R-tree index.
+*/
+QGraphicsSceneRTreeIndexPrivate::QGraphicsSceneRTreeIndexPrivate(QGraphicsScene *scene)
+    : QGraphicsSceneIndexPrivate(scene)
+{
+}
+
+/*!
+    \internal
+
+    Brings the tree up to date: leaves of items whose bounding rect changed
+    are moved, and unindexed items are inserted. If more items are waiting
+    than the tree holds, the whole tree is bulk-loaded instead.
+*/
+void QGraphicsSceneRTreeIndexPrivate::updateIndex()
+{
+    indexTimer.stop();
+
+    for (QGraphicsItem *item : std::as_const(movedItems)) {
+        Q_ASSERT(item->d_ptr->index >= 0);
+        tree.move(item->d_ptr->index, item->d_ptr->sceneEffectiveBoundingRect());
+    }
+    movedItems.clear();
+
+    if (unindexedItems.isEmpty())
+        return;
+
+    QList<QGraphicsSceneRTree::Entry> entries;
+    entries.reserve(unindexedItems.size());
+    for (QGraphicsItem *item : std::as_const(unindexedItems)) {
+        if (item->d_ptr->itemIsUntransformable()) {
+            untransformableItems << item;
+        } else if (item->d_ptr->ancestorFlags & QGraphicsItemPrivate::AncestorClipsChildren
+                   || item->d_ptr->ancestorFlags & QGraphicsItemPrivate::AncestorContainsChildren) {
+            clippedItems << item;
+        } else {
+            entries.append({item->d_ptr->sceneEffectiveBoundingRect(), item});
+        }
+    }
+    unindexedItems.clear();
+
+    if (entries.size() > tree.leafCount()) {
+        for (auto &entry : entries)
+            entry.rect = QGraphicsSceneRTree::fattened(entry.rect);
+        entries += tree.entries();
+        tree.bulkLoad(std::move(entries));
+        tree.forEachLeaf([](QGraphicsItem *item, int leaf) { item->d_ptr->index = leaf; });
+    } else {
+        for (const auto &entry : std::as_const(entries))
+            entry.item->d_ptr->index = tree.insert(entry.item, entry.rect);
+    }
+}
+
+/*!
+    \internal
+*/
+void QGraphicsSceneRTreeIndexPrivate::startIndexTimer()
+{
+    Q_Q(QGraphicsSceneRTreeIndex);
+    if (!indexTimer.isActive())
+        indexTimer.start(0ms, q);
+}
+
+/*!
+    \internal
+
+    Resets the index bookkeeping of all items in the tree.
+*/
+void QGraphicsSceneRTreeIndexPrivate::resetItemIndexes()
+{
+    tree.forEachLeaf([](QGraphicsItem *item, int) {
+        Q_ASSERT(!item->d_ptr->itemDiscovered);
+        item->d_ptr->index = -1;
+    });
+}
+
+void QGraphicsSceneRTreeIndexPrivate::addItem(QGraphicsItem *item, bool recursive)
+{
+    if (!item)
+        return;
+
+    // Indexing requires sceneBoundingRect(), but because \a item might
+    // not be completely constructed at this point, we need to store it in
+    // a temporary list and schedule an indexing for later.
+    if (item->d_ptr->index == -1) {
+        Q_ASSERT(!unindexedItems.contains(item));
+        unindexedItems << item;
+        startIndexTimer();
+    } else {
+        qWarning("QGraphicsSceneRTreeIndex::addItem: item has already been added to this index");
+    }
+
+    if (recursive) {
+        for (int i = 0; i < item->d_ptr->children.size(); ++i)
+            addItem(item->d_ptr->children.at(i), recursive);
+    }
+}
+
+void QGraphicsSceneRTreeIndexPrivate::removeItem(QGraphicsItem *item, bool recursive,
+                                                 bool moveToUnindexedItems)
+{
+    if (!item)
+        return;
+
+    // The leaf is found through the item, so unlike with the BSP tree no
+    // virtual functions are called, even while the item is destroyed.
+    if (item->d_ptr->index != -1) {
+        tree.remove(item->d_ptr->index);
+        item->d_ptr->index = -1;
+        movedItems.remove(item);
+    } else if (!unindexedItems.removeOne(item) && !untransformableItems.removeOne(item)) {
+        clippedItems.removeOne(item);
+    }
+
+    if (moveToUnindexedItems)
+        addItem(item);
+
+    if (recursive) {
+        for (int i = 0; i < item->d_ptr->children.size(); ++i)
+            removeItem(item->d_ptr->children.at(i), recursive, moveToUnindexedItems);
+    }
+}
+
+QList<QGraphicsItem *> QGraphicsSceneRTreeIndexPrivate::estimateItems(const QRectF &rect,
+                                                                      Qt::SortOrder order,
+                                                                      bool onlyTopLevelItems)
+{
+    Q_Q(QGraphicsSceneRTreeIndex);
+    if (onlyTopLevelItems && rect.isNull())
+        return q->QGraphicsSceneIndex::estimateTopLevelItems(rect, order);
+
+    updateIndex();
+
+    QList<QGraphicsItem *> rectItems;
+    tree.query(rect.normalized(), [&rectItems, onlyTopLevelItems](QGraphicsItem *item) {
+        if (onlyTopLevelItems && item->d_ptr->parent)
+            item = item->topLevelItem();
+        if (!item->d_func()->itemDiscovered && item->d_ptr->visible) {
+            item->d_func()->itemDiscovered = 1;
+            rectItems << item;
+        }
+    });
+    // Reset discovery bits.
+    for (QGraphicsItem *item : std::as_const(rectItems))
+        item->d_ptr->itemDiscovered = 0;
+
+    if (onlyTopLevelItems) {
+        for (QGraphicsItem *item : std::as_const(untransformableItems)) {
+            if (!item->d_ptr->parent) {
+                rectItems << item;
+            } else {
+                item = item->topLevelItem();
+                if (!rectItems.contains(item))
+                    rectItems << item;
+            }
+        }
+    } else {
+        rectItems += untransformableItems;
+    }
+
+    QGraphicsSceneBspTreeIndexPrivate::sortItems(&rectItems, order, /*cached=*/false,
+                                                 onlyTopLevelItems);
+    return rectItems;
+}
+
+/*!
+    Constructs an R-tree scene index for the given \a scene.
+*/
+QGraphicsSceneRTreeIndex::QGraphicsSceneRTreeIndex(QGraphicsScene *scene)
+    : QGraphicsSceneIndex(*new QGraphicsSceneRTreeIndexPrivate(scene), scene)
+{
+}
+
+QGraphicsSceneRTreeIndex::~QGraphicsSceneRTreeIndex()
+{
+    Q_D(QGraphicsSceneRTreeIndex);
+    d->resetItemIndexes();
+}
+
+/*!
+    \internal
+    Clears the index.
+*/
+void QGraphicsSceneRTreeIndex::clear()
+{
+    Q_D(QGraphicsSceneRTreeIndex);
+    d->resetItemIndexes();
+    d->tree.clear();
+    d->indexTimer.stop();
+    d->unindexedItems.clear();
+    d->untransformableItems.clear();
+    d->clippedItems.clear();
+    d->movedItems.clear();
+}
+
+/*!
+    Add the \a item into the index.
+*/
+void QGraphicsSceneRTreeIndex::addItem(QGraphicsItem *item)
+{
+    Q_D(QGraphicsSceneRTreeIndex);
+    d->addItem(item);
+}
+
+/*!
+    Remove the \a item from the index.
+*/
+void QGraphicsSceneRTreeIndex::removeItem(QGraphicsItem *item)
+{
+    Q_D(QGraphicsSceneRTreeIndex);
+    d->removeItem(item);
+}
+
+/*!
+    \internal
+    Schedules an update of the leaf of \a item, whose bounding rect is about
+    to change, and of the leaves of its children.
+*/
+void QGraphicsSceneRTreeIndex::prepareBoundingRectChange(const QGraphicsItem *item)
+{
+    if (!item || item->d_ptr->index == -1)
+        return; // Item is not in the tree; nothing to do.
+
+    Q_D(QGraphicsSceneRTreeIndex);
+    d->movedItems.insert(const_cast<QGraphicsItem *>(item));
+    d->startIndexTimer();
+    for (QGraphicsItem *child : std::as_const(item->d_ptr->children))
+        prepareBoundingRectChange(child);
+}
+
+/*!
+    Returns an estimation visible items that are either inside or
+    intersect with the specified \a rect and return a list sorted using \a order.
+*/
+QList<QGraphicsItem *> QGraphicsSceneRTreeIndex::estimateItems(const QRectF &rect, Qt::SortOrder order) const
+{
+    Q_D(const QGraphicsSceneRTreeIndex);
+    return const_cast<QGraphicsSceneRTreeIndexPrivate *>(d)->estimateItems(rect, order);
+}
+
+QList<QGraphicsItem *> QGraphicsSceneRTreeIndex::estimateTopLevelItems(const QRectF &rect, Qt::SortOrder order) const
+{
+    Q_D(const QGraphicsSceneRTreeIndex);
+    return const_cast<QGraphicsSceneRTreeIndexPrivate *>(d)->estimateItems(rect, order, /*onlyTopLevels=*/true);
+}
+
+/*!
+    Return all items in the index and sort them using \a order.
+*/
+QList<QGraphicsItem *> QGraphicsSceneRTreeIndex::items(Qt::SortOrder order) const
+{
+    Q_D(const QGraphicsSceneRTreeIndex);
+    QList<QGraphicsItem *> itemList;
+    itemList.reserve(d->tree.leafCount() + d->unindexedItems.size()
+                     + d->untransformableItems.size() + d->clippedItems.size());
+    d->tree.forEachLeaf([&itemList](QGraphicsItem *item, int) { itemList << item; });
+    itemList += d->unindexedItems;
+    itemList += d->untransformableItems;
+    itemList += d->clippedItems;
+
+    QGraphicsSceneBspTreeIndexPrivate::sortItems(&itemList, order, /*cached=*/false);
+    return itemList;
+}
+
+/*!
+    \internal
+
+    This method react to the \a change of the \a item and use the \a value to
+    update the index if necessary.
+*/
+void QGraphicsSceneRTreeIndex::itemChange(const QGraphicsItem *item, QGraphicsItem::GraphicsItemChange change, const void *const value)
+{
+    Q_D(QGraphicsSceneRTreeIndex);
+    switch (change) {
+    case QGraphicsItem::ItemFlagsChange: {
+        // Handle ItemIgnoresTransformations
+        QGraphicsItem::GraphicsItemFlags newFlags = *static_cast<const QGraphicsItem::GraphicsItemFlags *>(value);
+        bool ignoredTransform = item->d_ptr->flags & QGraphicsItem::ItemIgnoresTransformations;
+        bool willIgnoreTransform = newFlags & QGraphicsItem::ItemIgnoresTransformations;
+        bool clipsChildren = item->d_ptr->flags & QGraphicsItem::ItemClipsChildrenToShape
+                             || item->d_ptr->flags & QGraphicsItem::ItemContainsChildrenInShape;
+        bool willClipChildren = newFlags & QGraphicsItem::ItemClipsChildrenToShape
+                                || newFlags & QGraphicsItem::ItemContainsChildrenInShape;
+        if ((ignoredTransform != willIgnoreTransform) || (clipsChildren != willClipChildren)) {
+            QGraphicsItem *thatItem = const_cast<QGraphicsItem *>(item);
+            // Remove item and its descendants from the index and append
+            // them to the list of unindexed items. Then, when the index
+            // is updated, they will be put into the tree or the lists of
+            // untransformable and clipped items.
+            d->removeItem(thatItem, /*recursive=*/true, /*moveToUnidexedItems=*/true);
+        }
+        break;
+    }
+    case QGraphicsItem::ItemParentChange: {
+        // Handle ItemIgnoresTransformations
+        const QGraphicsItem *newParent = static_cast<const QGraphicsItem *>(value);
+        bool ignoredTransform = item->d_ptr->itemIsUntransformable();
+        bool willIgnoreTransform = (item->d_ptr->flags & QGraphicsItem::ItemIgnoresTransformations)
+                                   || (newParent && newParent->d_ptr->itemIsUntransformable());
+        bool ancestorClippedChildren = item->d_ptr->ancestorFlags & QGraphicsItemPrivate::AncestorClipsChildren
+                                       || item->d_ptr->ancestorFlags & QGraphicsItemPrivate::AncestorContainsChildren;
+        bool ancestorWillClipChildren = newParent
+                            && ((newParent->d_ptr->flags & QGraphicsItem::ItemClipsChildrenToShape
+                                 || newParent->d_ptr->flags & QGraphicsItem::ItemContainsChildrenInShape)
+                                || (newParent->d_ptr->ancestorFlags & QGraphicsItemPrivate::AncestorClipsChildren
+                                    || newParent->d_ptr->ancestorFlags & QGraphicsItemPrivate::AncestorContainsChildren));
+        if ((ignoredTransform != willIgnoreTransform) || (ancestorClippedChildren != ancestorWillClipChildren)) {
+            QGraphicsItem *thatItem = const_cast<QGraphicsItem *>(item);
+            // Remove item and its descendants from the index and append
+            // them to the list of unindexed items. Then, when the index
+            // is updated, they will be put into the tree or the lists of
+            // untransformable and clipped items.
+            d->removeItem(thatItem, /*recursive=*/true, /*moveToUnidexedItems=*/true);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+/*!
+    \reimp
+
+    Used to catch the timer event.
+
+    \internal
+*/
+bool QGraphicsSceneRTreeIndex::event(QEvent *event)
+{
+    Q_D(QGraphicsSceneRTreeIndex);
+    if (event->type() == QEvent::Timer
+        && static_cast<QTimerEvent *>(event)->id() == d->indexTimer.id()) {
+        d->updateIndex();
+    }
+    return QObject::event(event);
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qgraphicsscenertreeindex_p.cpp"
@@ -0,0 +1,194 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#ifndef QGRAPHICSSCENERTREEINDEX_P_H
+#define QGRAPHICSSCENERTREEINDEX_P_H
+
+#include <QtWidgets/private/qtwidgetsglobal_p.h>
+
+#include "qgraphicssceneindex_p.h"
+#include "qgraphicsitem_p.h"
+
+#include <QtCore/qbasictimer.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qrect.h>
+#include <QtCore/qset.h>
+#include <QtCore/qvarlengtharray.h>
+
+QT_REQUIRE_CONFIG(graphicsview);
+
+QT_BEGIN_NAMESPACE
+
+class QGraphicsItem;
+class QGraphicsSceneRTreeIndexPrivate;
+
+// A dynamic bounding volume hierarchy over item rectangles. Leaves are
+// inserted where they enlarge the tree the least, and the tree is kept
+// height-balanced with rotations, so inserting, removing and moving a
+// leaf take O(log n). Leaf rectangles are enlarged by a margin, so that
+// small moves do not need to touch the tree at all.
+class Q_AUTOTEST_EXPORT QGraphicsSceneRTree
+{
+public:
+    struct Entry
+    {
+        QRectF rect;
+        QGraphicsItem *item;
+    };
+
+    static constexpr int Null = -1;
+
+    int insert(QGraphicsItem *item, const QRectF &rect);
+    void remove(int leaf);
+    bool move(int leaf, const QRectF &rect);
+    void bulkLoad(QList<Entry> &&entries);
+    void clear();
+
+    QList<Entry> entries() const;
+    int leafCount() const { return leaves; }
+    int height() const { return root == Null ? 0 : nodes.at(root).height; }
+    QRectF leafRect(int leaf) const { return nodes.at(leaf).rect; }
+
+    template <typename Visitor>
+    void forEachLeaf(Visitor visit) const
+    {
+        for (const Node &node : nodes) {
+            if (node.height == 0)
+                visit(node.item, int(&node - nodes.constData()));
+        }
+    }
+
+    template <typename Visitor>
+    void query(const QRectF &rect, Visitor visit) const
+    {
+        if (root == Null)
+            return;
+        QVarLengthArray<int, 64> stack;
+        stack.append(root);
+        while (!stack.isEmpty()) {
+            const Node &node = nodes.at(stack.last());
+            stack.removeLast();
+            if (!intersects(node.rect, rect))
+                continue;
+            if (node.height == 0) {
+                visit(node.item);
+            } else {
+                stack.append(node.children[0]);
+                stack.append(node.children[1]);
+            }
+        }
+    }
+
+    static QRectF fattened(const QRectF &rect);
+
+private:
+    struct Node
+    {
+        QRectF rect;
+        QGraphicsItem *item = nullptr;
+        int parent = Null; // the next free node while the node is unused
+        int children[2] = {Null, Null};
+        int height = -1; // 0 for leaves, -1 for unused nodes
+    };
+
+    static QRectF united(const QRectF &a, const QRectF &b)
+    {
+        const qreal left = qMin(a.left(), b.left());
+        const qreal top = qMin(a.top(), b.top());
+        return QRectF(left, top, qMax(a.right(), b.right()) - left,
+                      qMax(a.bottom(), b.bottom()) - top);
+    }
+    static bool intersects(const QRectF &a, const QRectF &b)
+    {
+        return a.left() <= b.right() && b.left() <= a.right()
+                && a.top() <= b.bottom() && b.top() <= a.bottom();
+    }
+    static bool contains(const QRectF &outer, const QRectF &inner)
+    {
+        return outer.left() <= inner.left() && outer.top() <= inner.top()
+                && inner.right() <= outer.right() && inner.bottom() <= outer.bottom();
+    }
+    static qreal perimeter(const QRectF &rect) { return 2 * (rect.width() + rect.height()); }
+
+    int allocateNode();
+    void freeNode(int node);
+    void insertLeaf(int leaf);
+    void removeLeaf(int leaf);
+    void refit(int node);
+    int balance(int node);
+    void replaceChild(int parent, int oldChild, int newChild);
+    int build(Entry *begin, Entry *end, int parent);
+
+    QList<Node> nodes;
+    int root = Null;
+    int freeList = Null;
+    int leaves = 0;
+};
+
+class Q_AUTOTEST_EXPORT QGraphicsSceneRTreeIndex : public QGraphicsSceneIndex
+{
+    Q_OBJECT
+public:
+    QGraphicsSceneRTreeIndex(QGraphicsScene *scene = nullptr);
+    ~QGraphicsSceneRTreeIndex();
+
+    QList<QGraphicsItem *> estimateItems(const QRectF &rect, Qt::SortOrder order) const override;
+    QList<QGraphicsItem *> estimateTopLevelItems(const QRectF &rect, Qt::SortOrder order) const override;
+    QList<QGraphicsItem *> items(Qt::SortOrder order = Qt::DescendingOrder) const override;
+
+protected:
+    bool event(QEvent *event) override;
+    void clear() override;
+
+    void addItem(QGraphicsItem *item) override;
+    void removeItem(QGraphicsItem *item) override;
+    void prepareBoundingRectChange(const QGraphicsItem *item) override;
+
+    void itemChange(const QGraphicsItem *item, QGraphicsItem::GraphicsItemChange change, const void *const value) override;
+
+private:
+    Q_DECLARE_PRIVATE(QGraphicsSceneRTreeIndex)
+    Q_DISABLE_COPY_MOVE(QGraphicsSceneRTreeIndex)
+};
+
+class QGraphicsSceneRTreeIndexPrivate : public QGraphicsSceneIndexPrivate
+{
+    Q_DECLARE_PUBLIC(QGraphicsSceneRTreeIndex)
+public:
+    QGraphicsSceneRTreeIndexPrivate(QGraphicsScene *scene);
+
+    QGraphicsSceneRTree tree;
+    QBasicTimer indexTimer;
+
+    // Items that were added but have not been put into the tree yet,
+    // because they might not be fully constructed when they are added.
+    QList<QGraphicsItem *> unindexedItems;
+    // Items that are not kept in the tree.
+    QList<QGraphicsItem *> untransformableItems;
+    QList<QGraphicsItem *> clippedItems;
+    // Items in the tree whose bounding rect is about to change.
+    QSet<QGraphicsItem *> movedItems;
+
+    void updateIndex();
+    void startIndexTimer();
+    void resetItemIndexes();
+    void addItem(QGraphicsItem *item, bool recursive = false);
+    void removeItem(QGraphicsItem *item, bool recursive = false, bool moveToUnindexedItems = false);
+    QList<QGraphicsItem *> estimateItems(const QRectF &rect, Qt::SortOrder order,
+                                         bool onlyTopLevelItems = false);
+};
+
+QT_END_NAMESPACE
+
+#endif // QGRAPHICSSCENERTREEINDEX_P_H
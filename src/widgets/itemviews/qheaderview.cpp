@@ -166,7 +166,10 @@ static const int maxSizeSection = 1048575; // since section size is in a bitfiel
     \value ResizeToContents QHeaderView will automatically resize the section
            to its optimal size based on the contents of the entire column or
            row. The size cannot be changed by the user or programmatically.
-           (This value was introduced in 4.2)
+           (This value was introduced in 4.2) When there are many such
+           sections, the ones in view are resized first, and the others
+           over the following passes of the event loop; resizeSections()
+           resizes all of them at once.
 
     The following values are obsolete:
     \value Custom Use Fixed instead.
@@ -2480,7 +2483,9 @@ bool QHeaderView::event(QEvent *e)
         QTimerEvent *te = static_cast<QTimerEvent*>(e);
         if (te->timerId() == d->delayedResize.timerId()) {
             d->delayedResize.stop();
-            resizeSections();
+            d->resizeSectionsIncrementally(false);
+        } else if (te->timerId() == d->incrementalResize.timerId()) {
+            d->resizeSectionsIncrementally(true);
         }
         break; }
     case QEvent::StyleChange:
@@ -3666,6 +3671,32 @@ void QHeaderViewPrivate::resizeSections(QHeaderView::ResizeMode globalMode, bool
     if (stretchLastSection && !useGlobalMode)
         stretchSection = lastSectionVisualIdx;
 
+    const bool incremental = !contentsHintsDeadline.isForever();
+    int measuredSections = 0;
+    contentsHintsPending = false;
+    if (!incremental) {
+        incrementalResize.stop();
+        contentsSizeHints.clear();
+    } else {
+        // measure the sections in view first, so that they are right early on
+        const int viewportLength = (orientation == Qt::Horizontal ? viewport->width() : viewport->height());
+        const int firstVisible = qMax(0, headerVisualIndexAt(headerOffset));
+        int lastVisible = headerVisualIndexAt(headerOffset + viewportLength - 1);
+        if (lastVisible < 0)
+            lastVisible = sectionCount() - 1;
+        for (int i = firstVisible; i <= lastVisible; ++i) {
+            if (i == stretchSection || isVisualIndexHidden(i)
+                || headerSectionResizeMode(i) != QHeaderView::ResizeToContents) {
+                continue;
+            }
+            int &hint = contentsSizeHints[q->logicalIndex(i)];
+            if (hint < 0) {
+                hint = contentsSizeHint(q->logicalIndex(i));
+                ++measuredSections;
+            }
+        }
+    }
+
     // count up the number of stretched sections and how much space left for them
     int lengthToStretch = (orientation == Qt::Horizontal ? viewport->width() : viewport->height());
     int numberOfStretchedSections = 0;
@@ -3690,10 +3721,22 @@ void QHeaderViewPrivate::resizeSections(QHeaderView::ResizeMode globalMode, bool
         int sectionSize = 0;
         if (resizeMode == QHeaderView::Interactive || resizeMode == QHeaderView::Fixed) {
             sectionSize = qBound(q->minimumSectionSize(), headerSectionSize(i), q->maximumSectionSize());
+        } else if (incremental) { // resizeMode == QHeaderView::ResizeToContents
+            int &hint = contentsSizeHints[q->logicalIndex(i)];
+            if (hint < 0 && (measuredSections < IncrementalResizeMinimum
+                             || !contentsHintsDeadline.hasExpired())) {
+                hint = contentsSizeHint(q->logicalIndex(i));
+                ++measuredSections;
+            }
+            if (hint < 0) {
+                // keep the current size until the section gets measured
+                contentsHintsPending = true;
+                sectionSize = headerSectionSize(i);
+            } else {
+                sectionSize = hint;
+            }
         } else { // resizeMode == QHeaderView::ResizeToContents
-            int logicalIndex = q->logicalIndex(i);
-            sectionSize = qMax(viewSectionSizeHint(logicalIndex),
-                               q->sectionSizeHint(logicalIndex));
+            sectionSize = contentsSizeHint(q->logicalIndex(i));
         }
         sectionSize = qBound(q->minimumSectionSize(),
                              sectionSize,
@@ -3797,9 +3840,59 @@ void QHeaderViewPrivate::removeSectionsFromSectionItems(int start, int end)
     sectionItems.remove(start, end - start + 1);
 }
 
+/*!
+    \internal
+
+    Resizes the sections like QHeaderView::resizeSections(), but if that
+    takes long because many sections are resized to their contents, only
+    measures as many of them as fit into IncrementalResizeInterval and
+    leaves the rest at their current size. The remaining sections are
+    measured in further passes of the event loop, so the section sizes, and
+    the scroll ranges of the view, get more accurate with each pass. The
+    sections in view are measured first.
+
+    If \a resume is false, all sections are measured again; this cancels
+    a pass that is in progress.
+*/
+void QHeaderViewPrivate::resizeSectionsIncrementally(bool resume)
+{
+    Q_Q(QHeaderView);
+    delayedResize.stop();
+    incrementalResize.stop();
+    if (!hasAutoResizeSections()) {
+        contentsSizeHints.clear();
+        return;
+    }
+    if (!resume || contentsSizeHints.size() != sectionCount())
+        contentsSizeHints.fill(-1, sectionCount());
+
+    contentsHintsPending = false;
+    contentsHintsDeadline = QDeadlineTimer(IncrementalResizeInterval);
+    resizeSections(QHeaderView::Interactive, false);
+    contentsHintsDeadline = QDeadlineTimer(QDeadlineTimer::Forever);
+
+    if (contentsHintsPending)
+        incrementalResize.start(0, q);
+    else
+        contentsSizeHints.clear();
+}
+
+/*!
+    \internal
+
+    Returns the size the section \a logical needs for its contents.
+*/
+int QHeaderViewPrivate::contentsSizeHint(int logical) const
+{
+    Q_Q(const QHeaderView);
+    return qMax(viewSectionSizeHint(logical), q->sectionSizeHint(logical));
+}
+
 void QHeaderViewPrivate::clear()
 {
     if (state != NoClear) {
+        incrementalResize.stop();
+        contentsSizeHints.clear();
         length = 0;
         countInNoSectionItemsMode = 0;
         visualIndices.clear();
@@ -20,6 +20,7 @@
 #include "private/qabstractitemview_p.h"
 
 #include "QtCore/qbitarray.h"
+#include "QtCore/qdeadlinetimer.h"
 #include "QtWidgets/qapplication.h"
 #if QT_CONFIG(label)
 #include "QtWidgets/qlabel.h"
@@ -97,6 +98,8 @@ public:
     void updateSectionIndicator(int section, int position);
     void updateHiddenSections(int logicalFirst, int logicalLast);
     void resizeSections(QHeaderView::ResizeMode globalMode, bool useGlobalMode = false);
+    void resizeSectionsIncrementally(bool resume);
+    int contentsSizeHint(int logical) const;
     void sectionsRemoved(const QModelIndex &,int,int);
     void sectionsAboutToBeMoved(const QModelIndex &sourceParent, int logicalStart,
                                 int logicalEnd, const QModelIndex &destinationParent,
@@ -224,6 +227,9 @@ public:
             delayedResize.start(0, q_func());
     }
 
+    // A resize that is only posted is done right away. Passes that are in
+    // progress are left to finish in the event loop; until then, the
+    // sections not measured yet keep their current size.
     inline void executePostedResize() const {
         if (delayedResize.isActive() && state == NoState) {
             const_cast<QHeaderView*>(q_func())->resizeSections();
@@ -258,6 +264,16 @@ public:
     mutable QSize cachedSizeHint;
     mutable QBasicTimer delayedResize;
 
+    // Resizing many sections to their contents is spread over several passes
+    // of the event loop; each pass measures at least IncrementalResizeMinimum
+    // sections, and more until IncrementalResizeInterval has passed.
+    static constexpr int IncrementalResizeMinimum = 1000;
+    static constexpr std::chrono::milliseconds IncrementalResizeInterval{10};
+    QBasicTimer incrementalResize;
+    QList<int> contentsSizeHints; // by logical index, -1 until measured
+    QDeadlineTimer contentsHintsDeadline{QDeadlineTimer::Forever};
+    bool contentsHintsPending = false;
+
     int firstCascadingSection;
     int lastCascadingSection;
 
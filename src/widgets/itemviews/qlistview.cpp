@@ -304,7 +304,10 @@ QListView::ResizeMode QListView::resizeMode() const
     When the mode is \l Batched, the items are laid out in batches of \l batchSize
     items, while processing events. This makes it possible to
     instantly view and interact with the visible items while the rest
-    are being laid out.
+    are being laid out. Since Qt 6.9, as many batches are laid out between
+    processing events as fit into a few milliseconds, and the scroll bars
+    grow with the items laid out so far. A new layout, for example after
+    the model was reset, cancels the one in progress.
 
     \sa viewMode
 */
@@ -813,11 +816,18 @@ void QListView::timerEvent(QTimerEvent *e)
 {
     Q_D(QListView);
     if (e->timerId() == d->batchLayoutTimer.timerId()) {
-        if (d->doItemsLayout(d->batchSize)) { // layout is done
+        // lay out as many batches as fit into the interval before
+        // processing events again
+        const QDeadlineTimer deadline(QListViewPrivate::BatchLayoutInterval);
+        bool done = false;
+        do {
+            done = d->doItemsLayout(d->batchSize);
+        } while (!done && !deadline.hasExpired());
+        if (done) // layout is done
             d->batchLayoutTimer.stop();
-            updateGeometries();
-            d->viewport->update();
-        }
+        // let the scroll bars grow with the items laid out so far
+        updateGeometries();
+        d->viewport->update();
     }
     QAbstractItemView::timerEvent(e);
 }
@@ -1546,11 +1556,13 @@ void QListView::doItemsLayout()
     // triggering another layout
     QAbstractItemView::State oldState = state();
     setState(ExpandingState);
+    // a new layout replaces the batched layout that might be in progress
+    d->batchLayoutTimer.stop();
     if (d->model->columnCount(d->root) > 0) { // no columns means no contents
         d->resetBatchStartRow();
         if (layoutMode() == SinglePass) {
             d->doItemsLayout(d->model->rowCount(d->root)); // layout everything
-        } else if (!d->batchLayoutTimer.isActive()) {
+        } else {
             if (!d->doItemsLayout(d->batchSize)) // layout is done
                 d->batchLayoutTimer.start(0, this); // do a new batch as fast as possible
         }
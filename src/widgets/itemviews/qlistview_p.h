@@ -20,6 +20,7 @@
 #include "private/qabstractitemview_p.h"
 #include "qbitarray.h"
 #include "qbsptree_p.h"
+#include <QtCore/qdeadlinetimer.h>
 #include <limits.h>
 #include <qscrollbar.h>
 
@@ -411,6 +412,8 @@ public:
 
     // timers
     QBasicTimer batchLayoutTimer;
+    // batches are laid out until this much time has passed in one go
+    static constexpr std::chrono::milliseconds BatchLayoutInterval{10};
 
     // used for hidden items
     QSet<QPersistentModelIndex> hiddenRows;
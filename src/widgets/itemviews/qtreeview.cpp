@@ -417,6 +417,7 @@ void QTreeView::setUniformRowHeights(bool uniform)
 {
     Q_D(QTreeView);
     d->uniformRowHeights = uniform;
+    d->heightIndex.clear();
 }
 
 /*!
@@ -3166,6 +3167,7 @@ void QTreeViewPrivate::expand(int item, bool emitSignal)
 
 void QTreeViewPrivate::insertViewItems(int pos, int count, const QTreeViewItem &viewItem)
 {
+    heightIndex.clear();
     viewItems.insert(pos, count, viewItem);
     QTreeViewItem *items = viewItems.data();
     for (int i = pos + count; i < viewItems.size(); i++)
@@ -3175,6 +3177,7 @@ void QTreeViewPrivate::insertViewItems(int pos, int count, const QTreeViewItem &
 
 void QTreeViewPrivate::removeViewItems(int pos, int count)
 {
+    heightIndex.clear();
     viewItems.remove(pos, count);
     QTreeViewItem *items = viewItems.data();
     for (int i = pos; i < viewItems.size(); i++)
@@ -3405,6 +3408,8 @@ void QTreeViewPrivate::layout(int i, bool recursiveExpanding, bool afterIsUninit
         return;
     }
 
+    heightIndex.clear();
+
 #if QT_CONFIG(accessibility)
     // QAccessibleTree's rowCount implementation uses viewItems.size(), so
     // we need to invalidate any cached accessibility data structures if
@@ -3584,12 +3589,9 @@ int QTreeViewPrivate::coordinateForItem(int item) const
     if (verticalScrollMode == QAbstractItemView::ScrollPerPixel) {
         if (uniformRowHeights)
             return (item * defaultItemHeight) - vbar->value();
-        // ### optimize (maybe do like QHeaderView by letting items have startposition)
-        int y = 0;
-        for (int i = 0; i < viewItems.size(); ++i) {
-            if (i == item)
-                return y - vbar->value();
-            y += itemHeight(i);
+        if (item >= 0 && item < viewItems.size()) {
+            updateHeightIndex();
+            return heightIndex.position(item) - vbar->value();
         }
     } else { // ScrollPerItem
         int topViewItemIndex = vbar->value();
@@ -3642,14 +3644,8 @@ int QTreeViewPrivate::itemAtCoordinate(int coordinate) const
             const int viewItemIndex = (coordinate + vbar->value()) / defaultItemHeight;
             return ((viewItemIndex >= itemCount || viewItemIndex < 0) ? -1 : viewItemIndex);
         }
-        // ### optimize
-        int viewItemCoordinate = 0;
-        const int contentsCoordinate = coordinate + vbar->value();
-        for (int viewItemIndex = 0; viewItemIndex < viewItems.size(); ++viewItemIndex) {
-            viewItemCoordinate += itemHeight(viewItemIndex);
-            if (viewItemCoordinate > contentsCoordinate)
-                return (viewItemIndex >= itemCount ? -1 : viewItemIndex);
-        }
+        updateHeightIndex();
+        return heightIndex.itemAt(coordinate + vbar->value());
     } else { // ScrollPerItem
         int topViewItemIndex = vbar->value();
         if (uniformRowHeights) {
@@ -3679,6 +3675,106 @@ int QTreeViewPrivate::itemAtCoordinate(int coordinate) const
     return -1;
 }
 
+/*!
+  \internal
+  Brings heightIndex up to date with the heights of viewItems.
+
+  The index is rebuilt after the items were laid out again, which measures
+  every row, as summing up the heights did before; rows whose height was
+  invalidated since are measured again and updated one by one.
+*/
+void QTreeViewPrivate::updateHeightIndex() const
+{
+    const int itemCount = viewItems.size();
+    if (heightIndex.size() != itemCount || staleHeights.size() > itemCount / 8) {
+        staleHeights.clear();
+        QList<int> heights(itemCount);
+        for (int i = 0; i < itemCount; ++i)
+            heights[i] = itemHeight(i);
+        heightIndex.reset(std::move(heights));
+        return;
+    }
+    const QList<int> stale = std::exchange(staleHeights, {});
+    for (int item : stale) {
+        if (item < itemCount)
+            heightIndex.setHeight(item, itemHeight(item));
+    }
+}
+
+/*!
+  \internal
+  \class QTreeViewHeightIndex
+
+  Keeps the heights of the view items of a QTreeView together with their
+  running sums in a Fenwick tree, so that the position of an item, the item
+  at a position and a change of the height of one item all take O(log n).
+*/
+
+/*!
+  \internal
+  Replaces the indexed heights with \a itemHeights.
+*/
+void QTreeViewHeightIndex::reset(QList<int> &&itemHeights)
+{
+    heights = std::move(itemHeights);
+    const qsizetype count = heights.size();
+    tree.resize(count + 1);
+    tree[0] = 0;
+    total = 0;
+    for (qsizetype i = 1; i <= count; ++i)
+        tree[i] = heights.at(i - 1);
+    for (qsizetype i = 1; i <= count; ++i) {
+        total += heights.at(i - 1);
+        const qsizetype next = i + (i & -i);
+        if (next <= count)
+            tree[next] += tree[i];
+    }
+}
+
+void QTreeViewHeightIndex::setHeight(int item, int height)
+{
+    const int delta = height - heights.at(item);
+    if (!delta)
+        return;
+    heights[item] = height;
+    total += delta;
+    for (qsizetype i = item + 1; i < tree.size(); i += i & -i)
+        tree[i] += delta;
+}
+
+/*!
+  \internal
+  Returns the sum of the heights of the items before \a item.
+*/
+int QTreeViewHeightIndex::position(int item) const
+{
+    int sum = 0;
+    for (qsizetype i = item; i > 0; i -= i & -i)
+        sum += tree.at(i);
+    return sum;
+}
+
+/*!
+  \internal
+  Returns the item that covers \a position, or -1 if the position is below
+  the last item. Positions above the first item return the first item.
+*/
+int QTreeViewHeightIndex::itemAt(int position) const
+{
+    const qsizetype count = heights.size();
+    if (!count)
+        return -1;
+    // find how many items end at or above position
+    qsizetype item = 0;
+    for (qsizetype step = qsizetype(1) << (63 - qCountLeadingZeroBits(quint64(count))); step; step >>= 1) {
+        if (item + step <= count && tree.at(item + step) <= position) {
+            item += step;
+            position -= tree.at(item);
+        }
+    }
+    return item < count ? int(item) : -1;
+}
+
 int QTreeViewPrivate::viewIndex(const QModelIndex &_index) const
 {
     if (!_index.isValid() || viewItems.isEmpty())
@@ -3751,16 +3847,11 @@ int QTreeViewPrivate::firstVisibleItem(int *offset) const
             *offset = -(value % defaultItemHeight);
         return value / defaultItemHeight;
     }
-    int y = 0; // ### (maybe do like QHeaderView by letting items have startposition)
-    for (int i = 0; i < viewItems.size(); ++i) {
-        y += itemHeight(i); // the height value is cached
-        if (y > value) {
-            if (offset)
-                *offset = y - value - itemHeight(i);
-            return i;
-        }
-    }
-    return -1;
+    updateHeightIndex();
+    const int i = heightIndex.itemAt(value);
+    if (i >= 0 && offset)
+        *offset = heightIndex.position(i) - value;
+    return i;
 }
 
 int QTreeViewPrivate::lastVisibleItem(int firstVisual, int offset) const
@@ -3824,9 +3915,9 @@ void QTreeViewPrivate::updateScrollBars()
         int contentsHeight = 0;
         if (uniformRowHeights) {
             contentsHeight = defaultItemHeight * viewItems.size();
-        } else { // ### (maybe do like QHeaderView by letting items have startposition)
-            for (int i = 0; i < viewItems.size(); ++i)
-                contentsHeight += itemHeight(i);
+        } else {
+            updateHeightIndex();
+            contentsHeight = heightIndex.totalHeight();
         }
         vbar->setRange(0, contentsHeight - viewportSize.height());
         vbar->setPageStep(viewportSize.height());
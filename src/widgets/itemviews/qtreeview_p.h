@@ -48,6 +48,27 @@ struct QTreeViewItem
 
 Q_DECLARE_TYPEINFO(QTreeViewItem, Q_RELOCATABLE_TYPE);
 
+// Prefix sums (a Fenwick tree) over the heights of the view items, to find
+// where an item starts and which item is at a position in O(log n) when the
+// rows do not all have the same height.
+class QTreeViewHeightIndex
+{
+public:
+    void reset(QList<int> &&itemHeights);
+    void clear() { heights.clear(); tree.clear(); total = 0; }
+
+    qsizetype size() const { return heights.size(); }
+    int totalHeight() const { return total; }
+    void setHeight(int item, int height);
+    int position(int item) const;
+    int itemAt(int position) const;
+
+private:
+    QList<int> heights;
+    QList<int> tree; // 1-based
+    int total = 0;
+};
+
 class Q_WIDGETS_EXPORT QTreeViewPrivate : public QAbstractItemViewPrivate
 {
     Q_DECLARE_PUBLIC(QTreeView)
@@ -117,6 +138,7 @@ public:
     int indentationForItem(int item) const;
     int coordinateForItem(int item) const;
     int itemAtCoordinate(int coordinate) const;
+    void updateHeightIndex() const;
 
     int viewIndex(const QModelIndex &index) const;
     QModelIndex modelIndex(int i, int column = 0) const;
@@ -175,6 +197,9 @@ public:
 
     mutable QList<QTreeViewItem> viewItems;
     mutable int lastViewedItem;
+    // built on demand when scrolling per pixel, cleared when viewItems change
+    mutable QTreeViewHeightIndex heightIndex;
+    mutable QList<int> staleHeights;
     int defaultItemHeight; // this is just a number; contentsHeight() / numItems
     bool uniformRowHeights; // used when all rows have the same height
     bool rootDecoration;
@@ -227,7 +252,11 @@ public:
     inline int below(int item) const
         { int i = item; while (isItemHiddenOrDisabled(++item)){} return item >= viewItems.size() ? i : item; }
     inline void invalidateHeightCache(int item) const
-        { viewItems[item].height = 0; }
+    {
+        viewItems[item].height = 0;
+        if (heightIndex.size())
+            staleHeights.append(item);
+    }
 
     inline int accessibleTable2Index(const QModelIndex &index) const {
         return (viewIndex(index) + (header ? 1 : 0)) * model->columnCount()+index.column();
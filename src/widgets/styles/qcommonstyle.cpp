@@ -81,8 +81,10 @@
 #include <qloggingcategory.h>
 
 #include <limits.h>
+#include <memory>
 
 #include <private/qtextengine_p.h>
+#include <private/qfont_p.h>
 #include <private/qstylehelper_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -973,10 +975,6 @@ QSize QCommonStylePrivate::viewItemSize(const QStyleOptionViewItem *option, int
         break;
     case Qt::DisplayRole:
         if (option->features & QStyleOptionViewItem::HasDisplay) {
-            QTextOption textOption;
-            textOption.setWrapMode(QTextOption::WordWrap);
-            QTextLayout textLayout(option->text, option->font);
-            textLayout.setTextOption(textOption);
             const bool wrapText = option->features & QStyleOptionViewItem::WrapText;
             const int textMargin = proxyStyle->pixelMetric(QStyle::PM_FocusFrameHMargin, option, widget) + 1;
             QRect bounds = option->rect;
@@ -1016,7 +1014,19 @@ QSize QCommonStylePrivate::viewItemSize(const QStyleOptionViewItem *option, int
                 bounds.setWidth(bounds.width() - proxyStyle->pixelMetric(QStyle::PM_IndicatorWidth, option, widget) - 2 * textMargin);
 
             const int lineWidth = bounds.width();
-            const QSizeF size = viewItemTextLayout(textLayout, lineWidth);
+            const ViewItemTextKey key{option->text, option->font, QSize(lineWidth, 0), -1,
+                                      qt_defaultDpiY()};
+            QSizeF size;
+            if (const QSizeF *cachedSize = viewItemTextSizes.object(key)) {
+                size = *cachedSize;
+            } else {
+                QTextOption textOption;
+                textOption.setWrapMode(QTextOption::WordWrap);
+                QTextLayout textLayout(option->text, option->font);
+                textLayout.setTextOption(textOption);
+                size = viewItemTextLayout(textLayout, lineWidth);
+                viewItemTextSizes.insert(key, new QSizeF(size), viewItemTextCost(key, 0));
+            }
             return QSize(qCeil(size.width()) + 2 * textMargin, qCeil(size.height()));
         }
         break;
@@ -1032,6 +1042,23 @@ QSize QCommonStylePrivate::viewItemSize(const QStyleOptionViewItem *option, int
     return QSize(0, 0);
 }
 
+/*! \internal
+    Returns an estimate of the bytes an entry for \a key takes in the view
+    item text caches. The key holds a copy of the text; a cached layout of
+    \a layoutLength characters adds its text engine, and for every character
+    the glyphs, the log clusters and the character attributes.
+*/
+qsizetype QCommonStylePrivate::viewItemTextCost(const ViewItemTextKey &key, qsizetype layoutLength)
+{
+    qsizetype cost = sizeof(ViewItemTextKey) + sizeof(QSizeF) + key.text.size() * sizeof(QChar);
+    if (layoutLength > 0) {
+        constexpr qsizetype BytesPerCharacter = QGlyphLayout::SpaceNeeded + sizeof(unsigned short)
+                + sizeof(QCharAttributes) + sizeof(QChar);
+        cost += sizeof(ViewItemText) + sizeof(QTextEngine) + layoutLength * BytesPerCharacter;
+    }
+    return cost;
+}
+
 void QCommonStylePrivate::viewItemDrawText(QPainter *p, const QStyleOptionViewItem *option, const QRect &rect) const
 {
     const QWidget *widget = option->widget;
@@ -1039,6 +1066,17 @@ void QCommonStylePrivate::viewItemDrawText(QPainter *p, const QStyleOptionViewIt
 
     QRect textRect = rect.adjusted(textMargin, 0, -textMargin, 0); // remove width padding
     const bool wrapText = option->features & QStyleOptionViewItem::WrapText;
+
+    // where the text ends up only depends on the size of the rectangle
+    const ViewItemTextKey key{option->text, option->font, textRect.size(),
+                              int(option->displayAlignment) | int(option->direction) << 12
+                              | int(wrapText) << 14 | int(option->textElideMode) << 16,
+                              qt_defaultDpiY()};
+    if (const ViewItemText *text = viewItemTexts.object(key)) {
+        text->layout.draw(p, textRect.topLeft() + text->position);
+        return;
+    }
+
     QTextOption textOption;
     textOption.setWrapMode(wrapText ? QTextOption::WordWrap : QTextOption::ManualWrap);
     textOption.setTextDirection(option->direction);
@@ -1050,10 +1088,14 @@ void QCommonStylePrivate::viewItemDrawText(QPainter *p, const QStyleOptionViewIt
                                                 option->textElideMode, 0,
                                                 true, &paintPosition);
 
-    QTextLayout textLayout(newText, option->font);
-    textLayout.setTextOption(textOption);
-    viewItemTextLayout(textLayout, textRect.width());
-    textLayout.draw(p, paintPosition);
+    auto text = std::make_unique<ViewItemText>();
+    text->layout.setText(newText);
+    text->layout.setFont(option->font);
+    text->layout.setTextOption(textOption);
+    viewItemTextLayout(text->layout, textRect.width());
+    text->layout.draw(p, paintPosition);
+    text->position = paintPosition - textRect.topLeft();
+    viewItemTexts.insert(key, text.release(), viewItemTextCost(key, newText.size()));
 }
 
 /*! \internal
@@ -7,6 +7,10 @@
 #include <QtWidgets/private/qtwidgetsglobal_p.h>
 #include <QtGui/private/qguiapplication_p.h>
 #include "qhash.h"
+#if QT_CONFIG(itemviews)
+#include <QtCore/qcache.h>
+#include <QtGui/qtextlayout.h>
+#endif
 #include "qcommonstyle.h"
 #include "qstyle_p.h"
 #if QT_CONFIG(animation)
@@ -80,6 +84,39 @@ public:
                && option.viewItemPosition == cachedOption->viewItemPosition
                && option.showDecorationSelected == cachedOption->showDecorationSelected);
     }
+
+    // Item view texts that were laid out before, so that repainting or
+    // measuring an item does not shape its text again. As they are looked up
+    // by everything the layout depends on, changed data never hits the cache.
+    struct ViewItemTextKey
+    {
+        QString text;
+        QFont font;
+        QSize size;
+        int options; // alignment, direction, wrapping and elide mode
+        int dpi;
+
+        friend bool operator==(const ViewItemTextKey &lhs, const ViewItemTextKey &rhs) noexcept
+        {
+            return lhs.options == rhs.options && lhs.size == rhs.size && lhs.dpi == rhs.dpi
+                   && lhs.text == rhs.text && lhs.font == rhs.font;
+        }
+        friend size_t qHash(const ViewItemTextKey &key, size_t seed = 0) noexcept
+        {
+            return qHashMulti(seed, key.text, key.font, key.size.width(), key.size.height(),
+                              key.options, key.dpi);
+        }
+    };
+    struct ViewItemText
+    {
+        QTextLayout layout; // of the elided text
+        QPointF position; // relative to the text rectangle
+    };
+    // costs are estimated in bytes
+    static constexpr qsizetype ViewItemTextCacheSize = 4 * 1024 * 1024;
+    static qsizetype viewItemTextCost(const ViewItemTextKey &key, qsizetype layoutLength);
+    mutable QCache<ViewItemTextKey, ViewItemText> viewItemTexts{ViewItemTextCacheSize};
+    mutable QCache<ViewItemTextKey, QSizeF> viewItemTextSizes{ViewItemTextCacheSize};
 #endif
 #if QT_CONFIG(toolbutton)
     QString toolButtonElideText(const QStyleOptionToolButton *toolbutton,
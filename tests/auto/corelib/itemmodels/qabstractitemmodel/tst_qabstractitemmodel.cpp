@@ -6,6 +6,8 @@
 #include <QtTest/private/qcomparisontesthelper_p.h>
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QRandomGenerator>
+#include <QtCore/QSet>
 #if QT_CONFIG(sortfilterproxymodel)
 #include <QtCore/QSortFilterProxyModel>
 #endif
@@ -62,6 +64,8 @@ private slots:
     void reset();
 
     void complexChangesWithPersistent();
+    void persistentIndexesInTree();
+    void persistentIndexesAfterLayoutChange();
     void modelIndexComparisons();
 
     void testMoveSameParentUp_data();
@@ -1020,6 +1024,160 @@ void tst_QAbstractItemModel::complexChangesWithPersistent()
         QVERIFY(e[i] == model.index(2, i-2 , QModelIndex()));
 }
 
+void tst_QAbstractItemModel::persistentIndexesInTree()
+{
+    // Every item has an id; a persistent index to it must keep pointing to it
+    // through any change, and become invalid once it is removed.
+    QStandardItemModel model;
+    QRandomGenerator random(42);
+    QList<QPersistentModelIndex> persistent;
+    QList<int> ids;
+    int nextId = 0;
+
+    const auto newRow = [&](int columns) {
+        QList<QStandardItem *> row;
+        for (int column = 0; column < columns; ++column) {
+            auto *item = new QStandardItem(QString::number(random.bounded(1000)));
+            item->setData(nextId++, Qt::UserRole);
+            row << item;
+        }
+        return row;
+    };
+    const auto track = [&](const QList<QStandardItem *> &items) {
+        for (const QStandardItem *item : items) {
+            persistent << QPersistentModelIndex(item->index());
+            ids << item->data(Qt::UserRole).toInt();
+        }
+    };
+    const auto allItems = [&]() {
+        QList<QStandardItem *> items = { model.invisibleRootItem() };
+        for (qsizetype i = 0; i < items.size(); ++i) {
+            for (int row = 0; row < items.at(i)->rowCount(); ++row) {
+                for (int column = 0; column < items.at(i)->columnCount(); ++column) {
+                    if (QStandardItem *child = items.at(i)->child(row, column))
+                        items << child;
+                }
+            }
+        }
+        return items;
+    };
+
+    for (int row = 0; row < 30; ++row) {
+        const QList<QStandardItem *> items = newRow(2);
+        model.appendRow(items);
+        for (int childRow = 0; childRow < 8; ++childRow) {
+            const QList<QStandardItem *> children = newRow(2);
+            items.first()->appendRow(children);
+            for (int grandChildRow = 0; grandChildRow < 3; ++grandChildRow)
+                children.first()->appendRow(newRow(2));
+        }
+    }
+    track(allItems().mid(1));
+
+    for (int step = 0; step < 300; ++step) {
+        const QList<QStandardItem *> items = allItems();
+        QStandardItem *parent = items.at(random.bounded(items.size()));
+        const int rows = parent->rowCount();
+        const int columns = qMax(parent->columnCount(), 1);
+        switch (random.bounded(5)) {
+        case 0: {
+            const QList<QStandardItem *> row = newRow(columns);
+            parent->insertRow(random.bounded(rows + 1), row);
+            track(row);
+            break;
+        }
+        case 1:
+            if (rows > 0) {
+                const int first = random.bounded(rows);
+                parent->removeRows(first, random.bounded(1, qMin(rows - first, 3) + 1));
+            }
+            break;
+        case 2: {
+            QList<QStandardItem *> column;
+            for (int row = 0; row < rows; ++row)
+                column << newRow(1);
+            parent->insertColumn(random.bounded(parent->columnCount() + 1), column);
+            track(column);
+            break;
+        }
+        case 3:
+            if (parent->columnCount() > 1)
+                parent->removeColumn(random.bounded(parent->columnCount()));
+            break;
+        case 4:
+            parent->sortChildren(0, random.bounded(2) ? Qt::AscendingOrder : Qt::DescendingOrder);
+            break;
+        }
+
+        QSet<int> alive;
+        const QList<QStandardItem *> after = allItems();
+        for (const QStandardItem *item : after.mid(1))
+            alive.insert(item->data(Qt::UserRole).toInt());
+        for (qsizetype i = 0; i < persistent.size(); ++i) {
+            if (persistent.at(i).isValid()) {
+                QCOMPARE(persistent.at(i).data(Qt::UserRole).toInt(), ids.at(i));
+                QCOMPARE(model.itemFromIndex(persistent.at(i))->index(), QModelIndex(persistent.at(i)));
+            } else {
+                QVERIFY(!alive.contains(ids.at(i)));
+            }
+        }
+    }
+}
+
+void tst_QAbstractItemModel::persistentIndexesAfterLayoutChange()
+{
+    class Model : public QStandardItemModel
+    {
+    public:
+        using QStandardItemModel::receivers;
+        using QStandardItemModel::parent;
+        QModelIndex parent(const QModelIndex &child) const override
+        {
+            ++parentCalls;
+            return QStandardItemModel::parent(child);
+        }
+        mutable int parentCalls = 0;
+    };
+
+    // Only the children are persistent; sorting the parents moves them
+    // without changing any persistent index.
+    Model model;
+    QList<QPersistentModelIndex> children;
+    for (int row = 0; row < 5; ++row) {
+        auto *parent = new QStandardItem(QString::number(4 - row));
+        model.appendRow(parent);
+        for (int childRow = 0; childRow < 3; ++childRow)
+            parent->appendRow(new QStandardItem(QStringLiteral("%1.%2").arg(4 - row).arg(childRow)));
+    }
+    for (int row = 0; row < 5; ++row)
+        children << QPersistentModelIndex(model.index(1, 0, model.index(row, 0)));
+
+    const int layoutReceivers = model.receivers(SIGNAL(layoutChanged(QList<QPersistentModelIndex>,QAbstractItemModel::LayoutChangeHint)));
+    model.insertRow(0, new QStandardItem(QStringLiteral("x")));
+    model.removeRow(0);
+    // keeping track of the persistent indexes does not connect to the model
+    QCOMPARE(model.receivers(SIGNAL(layoutChanged(QList<QPersistentModelIndex>,QAbstractItemModel::LayoutChangeHint))),
+             layoutReceivers);
+    // once the indexes are sorted in, inserting and removing rows does not
+    // ask the model for parents
+    model.parentCalls = 0;
+    model.insertRow(0, new QStandardItem(QStringLiteral("x")));
+    model.removeRow(0);
+    QCOMPARE(model.parentCalls, 0);
+
+    model.sort(0);
+    for (int row = 0; row < 5; ++row) {
+        QStandardItem *parent = model.item(row);
+        parent->insertRow(0, new QStandardItem(QStringLiteral("new")));
+        QCOMPARE(children.at(4 - row).row(), 2);
+        QCOMPARE(children.at(4 - row).data().toString(), QStringLiteral("%1.1").arg(row));
+    }
+    for (int row = 0; row < 5; ++row)
+        model.item(row)->removeRows(1, 2);
+    for (const QPersistentModelIndex &child : std::as_const(children))
+        QVERIFY(!child.isValid());
+}
+
 void tst_QAbstractItemModel::modelIndexComparisons()
 {
     QTestPrivate::testAllComparisonOperatorsCompile<QModelIndex>();
@@ -0,0 +1,242 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QTest>
+#include <QAbstractItemModelTester>
+#include <QSignalSpy>
+#include <QtCore/qpoint.h>
+#include <QtCore/qcolumnartablemodel.h>
+
+class tst_QColumnarTableModel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void columnsAndRows();
+    void typedValues();
+    void setColumnValues();
+    void roleColumns();
+    void replaceStrings();
+    void removeRows();
+    void sort();
+};
+
+void tst_QColumnarTableModel::columnsAndRows()
+{
+    QColumnarTableModel model;
+    QAbstractItemModelTester tester(&model);
+
+    QCOMPARE(model.appendColumn(QColumnarTableModel::ColumnType::Integer, "Id"), 0);
+    QCOMPARE(model.appendColumn(QColumnarTableModel::ColumnType::String), 1);
+    QCOMPARE(model.columnCount(), 2);
+    QCOMPARE(model.columnType(0), QColumnarTableModel::ColumnType::Integer);
+    QCOMPARE(model.columnType(1), QColumnarTableModel::ColumnType::String);
+    QCOMPARE(model.headerData(0, Qt::Horizontal).toString(), "Id");
+
+    QSignalSpy rowsInserted(&model, &QAbstractItemModel::rowsInserted);
+    model.appendRows(3);
+    QCOMPARE(model.rowCount(), 3);
+    QCOMPARE(rowsInserted.size(), 1);
+    QVERIFY(!model.index(1, 1).data().isValid());
+
+    QVERIFY(model.insertRows(1, 2));
+    QCOMPARE(model.rowCount(), 5);
+    QVERIFY(!model.insertRows(6, 1));
+
+    model.clear();
+    QCOMPARE(model.rowCount(), 0);
+    QCOMPARE(model.columnCount(), 2);
+    QCOMPARE(model.headerData(0, Qt::Horizontal).toString(), "Id");
+}
+
+void tst_QColumnarTableModel::typedValues()
+{
+    QColumnarTableModel model;
+    QAbstractItemModelTester tester(&model);
+    model.appendColumn(QColumnarTableModel::ColumnType::Integer);
+    model.appendColumn(QColumnarTableModel::ColumnType::Real);
+    model.appendColumn(QColumnarTableModel::ColumnType::String);
+    model.appendColumn(QColumnarTableModel::ColumnType::Variant);
+    model.appendRows(1);
+
+    QSignalSpy dataChanged(&model, &QAbstractItemModel::dataChanged);
+    QVERIFY(model.setData(model.index(0, 0), "42"));
+    QCOMPARE(model.index(0, 0).data().metaType(), QMetaType::fromType<qint64>());
+    QCOMPARE(model.index(0, 0).data(Qt::EditRole).toLongLong(), 42);
+    QVERIFY(!model.setData(model.index(0, 0), "forty-two"));
+    QCOMPARE(model.index(0, 0).data().toLongLong(), 42);
+
+    QVERIFY(model.setData(model.index(0, 1), 2.5));
+    QCOMPARE(model.index(0, 1).data().toDouble(), 2.5);
+    QVERIFY(model.setData(model.index(0, 2), 17));
+    QCOMPARE(model.index(0, 2).data(), QVariant(QStringLiteral("17")));
+    QVERIFY(model.setData(model.index(0, 3), QPoint(1, 2)));
+    QCOMPARE(model.index(0, 3).data().toPoint(), QPoint(1, 2));
+    QCOMPARE(dataChanged.size(), 4);
+
+    QVERIFY(!model.setData(model.index(0, 0), 1, Qt::ToolTipRole));
+    QVERIFY(!model.index(0, 0).data(Qt::ToolTipRole).isValid());
+
+    QVERIFY(model.setData(model.index(0, 1), QVariant()));
+    QVERIFY(!model.index(0, 1).data().isValid());
+    QVERIFY(model.clearItemData(model.index(0, 2)));
+    QVERIFY(!model.index(0, 2).data().isValid());
+}
+
+void tst_QColumnarTableModel::setColumnValues()
+{
+    QColumnarTableModel model;
+    QAbstractItemModelTester tester(&model);
+    model.appendColumn(QColumnarTableModel::ColumnType::Integer);
+    model.appendColumn(QColumnarTableModel::ColumnType::String);
+    model.appendRows(4);
+
+    QSignalSpy dataChanged(&model, &QAbstractItemModel::dataChanged);
+    const QList<qint64> numbers = {10, 20, 30};
+    QVERIFY(model.setColumnValues(0, 1, numbers));
+    QCOMPARE(dataChanged.size(), 1);
+    QCOMPARE(dataChanged.at(0).at(0).toModelIndex(), model.index(1, 0));
+    QCOMPARE(dataChanged.at(0).at(1).toModelIndex(), model.index(3, 0));
+    QVERIFY(!model.index(0, 0).data().isValid());
+    QCOMPARE(model.index(3, 0).data().toLongLong(), 30);
+
+    // Values of another type are converted, up to the first that fails.
+    const QList<QString> texts = {"1", "2", "three", "4"};
+    QVERIFY(!model.setColumnValues(0, 0, texts));
+    QCOMPARE(model.index(1, 0).data().toLongLong(), 2);
+    QCOMPARE(model.index(2, 0).data().toLongLong(), 20);
+
+    QVERIFY(model.setColumnValues(1, 0, texts));
+    QCOMPARE(model.index(2, 1).data().toString(), "three");
+
+    // The range must lie within the model.
+    QVERIFY(!model.setColumnValues(0, 2, numbers));
+    QVERIFY(!model.setColumnValues(2, 0, numbers));
+}
+
+void tst_QColumnarTableModel::roleColumns()
+{
+    QColumnarTableModel model;
+    QAbstractItemModelTester tester(&model);
+    model.appendColumn(QColumnarTableModel::ColumnType::String);
+    model.appendRows(2);
+
+    QVERIFY(model.addRoleColumn(0, Qt::ToolTipRole, QColumnarTableModel::ColumnType::String));
+    QVERIFY(model.addRoleColumn(0, Qt::UserRole, QColumnarTableModel::ColumnType::Integer));
+    QVERIFY(!model.addRoleColumn(0, Qt::ToolTipRole, QColumnarTableModel::ColumnType::String));
+    QVERIFY(!model.addRoleColumn(0, Qt::EditRole, QColumnarTableModel::ColumnType::String));
+    QCOMPARE(model.columnRoles(0), QList<int>({Qt::ToolTipRole, Qt::UserRole}));
+
+    QVERIFY(model.setData(model.index(1, 0), "text"));
+    QVERIFY(model.setData(model.index(1, 0), "tip", Qt::ToolTipRole));
+    QVERIFY(model.setColumnValues(0, 0, QList<qint64>{7, 8}, Qt::UserRole));
+
+    QModelRoleData roleData[] = {
+        QModelRoleData(Qt::DisplayRole),
+        QModelRoleData(Qt::ToolTipRole),
+        QModelRoleData(Qt::UserRole),
+        QModelRoleData(Qt::DecorationRole),
+    };
+    model.index(1, 0).multiData(roleData);
+    QCOMPARE(roleData[0].data().toString(), "text");
+    QCOMPARE(roleData[1].data().toString(), "tip");
+    QCOMPARE(roleData[2].data().toLongLong(), 8);
+    QVERIFY(!roleData[3].data().isValid());
+
+    // Inserted rows get empty values for all roles.
+    QVERIFY(model.insertRows(1, 1));
+    QVERIFY(!model.index(1, 0).data(Qt::ToolTipRole).isValid());
+    QCOMPARE(model.index(2, 0).data(Qt::ToolTipRole).toString(), "tip");
+    QCOMPARE(model.index(2, 0).data(Qt::UserRole).toLongLong(), 8);
+}
+
+void tst_QColumnarTableModel::replaceStrings()
+{
+    QColumnarTableModel model;
+    model.appendColumn(QColumnarTableModel::ColumnType::String);
+    constexpr int Rows = 100;
+    model.appendRows(Rows);
+
+    // Replace the texts often enough to have the arena compacted a few times.
+    for (int round = 0; round < 50; ++round) {
+        QList<QString> texts;
+        for (int row = 0; row < Rows; ++row)
+            texts.append(QString(round % 7 + 1, QChar(u'a' + round % 26)) + QString::number(row));
+        QVERIFY(model.setColumnValues(0, 0, texts));
+        for (int row = 0; row < Rows; ++row)
+            QCOMPARE(model.index(row, 0).data().toString(), texts.at(row));
+    }
+}
+
+void tst_QColumnarTableModel::removeRows()
+{
+    QColumnarTableModel model;
+    QAbstractItemModelTester tester(&model);
+    model.appendColumn(QColumnarTableModel::ColumnType::Integer);
+    model.appendColumn(QColumnarTableModel::ColumnType::String);
+    model.appendRows(5);
+    QVERIFY(model.setColumnValues(0, 0, QList<qint64>{0, 1, 2, 3, 4}));
+    QVERIFY(model.setColumnValues(1, 0, QList<QString>{"a", "b", "c", "d", "e"}));
+
+    QVERIFY(model.removeRows(1, 2));
+    QCOMPARE(model.rowCount(), 3);
+    QCOMPARE(model.index(1, 0).data().toLongLong(), 3);
+    QCOMPARE(model.index(1, 1).data().toString(), "d");
+    QVERIFY(!model.removeRows(2, 2));
+
+    QVERIFY(model.removeColumns(0, 1));
+    QCOMPARE(model.columnCount(), 1);
+    QCOMPARE(model.index(2, 0).data().toString(), "e");
+}
+
+void tst_QColumnarTableModel::sort()
+{
+    QColumnarTableModel model;
+    QAbstractItemModelTester tester(&model);
+    model.appendColumn(QColumnarTableModel::ColumnType::Real);
+    model.appendColumn(QColumnarTableModel::ColumnType::String);
+    model.appendRows(5);
+    QVERIFY(model.setColumnValues(0, 0, QList<double>{3., 1., 2., 1.}));
+    QVERIFY(model.setColumnValues(1, 0, QList<QString>{"c", "a1", "b", "a2", "none"}));
+
+    const QPersistentModelIndex persistent = model.index(0, 1);
+    model.sort(0);
+    const QStringList ascending = {"a1", "a2", "b", "c", "none"};
+    for (int row = 0; row < model.rowCount(); ++row)
+        QCOMPARE(model.index(row, 1).data().toString(), ascending.at(row));
+    QCOMPARE(persistent.row(), 3);
+    QCOMPARE(persistent.data().toString(), "c");
+
+    // Rows without a value stay last, equal values keep their order.
+    model.sort(0, Qt::DescendingOrder);
+    const QStringList descending = {"c", "b", "a1", "a2", "none"};
+    for (int row = 0; row < model.rowCount(); ++row)
+        QCOMPARE(model.index(row, 1).data().toString(), descending.at(row));
+    QCOMPARE(persistent.row(), 0);
+
+    model.sort(1, Qt::DescendingOrder);
+    QCOMPARE(model.index(0, 1).data().toString(), "none");
+    QCOMPARE(model.index(4, 1).data().toString(), "a1");
+    QCOMPARE(model.index(4, 0).data().toDouble(), 1.);
+
+    // NaN sorts after all numbers, but before rows without a value.
+    QColumnarTableModel reals;
+    reals.appendColumn(QColumnarTableModel::ColumnType::Real);
+    reals.appendRows(5);
+    QVERIFY(reals.setColumnValues(0, 0, QList<double>{2., qQNaN(), 1., qQNaN()}));
+    reals.sort(0);
+    QCOMPARE(reals.index(0, 0).data().toDouble(), 1.);
+    QCOMPARE(reals.index(1, 0).data().toDouble(), 2.);
+    QVERIFY(qIsNaN(reals.index(2, 0).data().toDouble()));
+    QVERIFY(qIsNaN(reals.index(3, 0).data().toDouble()));
+    QVERIFY(!reals.index(4, 0).data().isValid());
+    reals.sort(0, Qt::DescendingOrder);
+    QVERIFY(qIsNaN(reals.index(0, 0).data().toDouble()));
+    QVERIFY(qIsNaN(reals.index(1, 0).data().toDouble()));
+    QCOMPARE(reals.index(2, 0).data().toDouble(), 2.);
+    QCOMPARE(reals.index(3, 0).data().toDouble(), 1.);
+    QVERIFY(!reals.index(4, 0).data().isValid());
+}
+
+QTEST_GUILESS_MAIN(tst_QColumnarTableModel)
+#include "tst_qcolumnartablemodel.moc"
@@ -89,6 +89,8 @@ private slots:
 
     void testSignalsDisconnection();
     void destroyModel();
+    void largeFragmentedSelection();
+    void largeSelectionWithCurrent();
 
 private:
     static void messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg);
@@ -3033,5 +3035,97 @@ void tst_QItemSelectionModel::destroyModel()
     QVERIFY(selectionModel->selection().isEmpty());
 }
 
+void tst_QItemSelectionModel::largeFragmentedSelection()
+{
+    // enough ranges for the selection model to search them as intervals
+    class TableModel : public QAbstractTableModel
+    {
+    public:
+        int rowCount(const QModelIndex &parent = {}) const override { return parent.isValid() ? 0 : 3000; }
+        int columnCount(const QModelIndex &parent = {}) const override { return parent.isValid() ? 0 : 3; }
+        QVariant data(const QModelIndex &, int) const override { return {}; }
+    };
+    TableModel model;
+    const int rows = model.rowCount();
+    QItemSelectionModel selectionModel(&model);
+    QSignalSpy spy(&selectionModel, &QItemSelectionModel::selectionChanged);
+
+    selectionModel.select(QItemSelection(model.index(0, 0), model.index(rows - 1, 2)),
+                          QItemSelectionModel::Select);
+    QList<bool> expected(rows, true);
+    for (int row = 0; row < rows; row += 3) {
+        selectionModel.select(model.index(row, 1), QItemSelectionModel::Toggle | QItemSelectionModel::Rows);
+        expected[row] = false;
+    }
+
+    // the last change is reported as the one row that got deselected
+    const QItemSelection deselected = spy.constLast().at(1).value<QItemSelection>();
+    QCOMPARE(spy.constLast().at(0).value<QItemSelection>(), QItemSelection());
+    QCOMPARE(deselected, QItemSelection(model.index(rows - 3, 0), model.index(rows - 3, 2)));
+
+    for (int row = 0; row < rows; ++row) {
+        QCOMPARE(selectionModel.isSelected(model.index(row, 2)), expected.at(row));
+        QCOMPARE(selectionModel.isRowSelected(row), expected.at(row));
+        QCOMPARE(selectionModel.rowIntersectsSelection(row), expected.at(row));
+    }
+    QVERIFY(!selectionModel.isColumnSelected(0));
+    QVERIFY(selectionModel.columnIntersectsSelection(0));
+    QCOMPARE(selectionModel.selectedRows().size(), expected.count(true));
+    QCOMPARE(selectionModel.selectedIndexes().size(), 3 * expected.count(true));
+    // one range for each run of selected rows
+    QCOMPARE(selectionModel.selection().size(), rows / 3);
+
+    // selecting everything again only reports the rows that were not selected
+    spy.clear();
+    selectionModel.select(QItemSelection(model.index(0, 0), model.index(rows - 1, 2)),
+                          QItemSelectionModel::Select);
+    QCOMPARE(spy.size(), 1);
+    const QItemSelection selected = spy.constFirst().at(0).value<QItemSelection>();
+    QCOMPARE(selected.size(), rows / 3);
+    QCOMPARE(selected.indexes().size(), 3 * expected.count(false));
+    QVERIFY(spy.constFirst().at(1).value<QItemSelection>().isEmpty());
+    for (int row = 0; row < rows; ++row)
+        QVERIFY(selectionModel.isRowSelected(row));
+}
+
+void tst_QItemSelectionModel::largeSelectionWithCurrent()
+{
+    // every other row selected gives enough ranges for intervals
+    QStandardItemModel model;
+    for (int row = 0; row < 400; ++row)
+        model.appendRow({ new QStandardItem, new QStandardItem });
+    const int rows = model.rowCount();
+    QItemSelectionModel selectionModel(&model);
+    for (int row = 0; row < rows; row += 2)
+        selectionModel.select(model.index(row, 0), QItemSelectionModel::Select | QItemSelectionModel::Rows);
+    QVERIFY(selectionModel.hasSelection());
+
+    // extending a current selection replaces it, like dragging with the mouse
+    selectionModel.select(QItemSelection(model.index(1, 0), model.index(10, 1)),
+                          QItemSelectionModel::Select);
+    for (int last = 11; last < 20; ++last) {
+        selectionModel.select(QItemSelection(model.index(1, 0), model.index(last, 1)),
+                              QItemSelectionModel::SelectCurrent);
+    }
+    selectionModel.select(QItemSelection(model.index(1, 0), model.index(5, 1)),
+                          QItemSelectionModel::SelectCurrent);
+    for (int row = 0; row < rows; ++row)
+        QCOMPARE(selectionModel.isRowSelected(row), row <= 5 || row % 2 == 0);
+
+    // deselecting the current selection again keeps the other rows
+    selectionModel.select(QItemSelection(model.index(0, 0), model.index(9, 1)),
+                          QItemSelectionModel::Deselect | QItemSelectionModel::Current);
+    for (int row = 0; row < rows; ++row)
+        QCOMPARE(selectionModel.isRowSelected(row), row >= 10 && row % 2 == 0);
+    QVERIFY(selectionModel.hasSelection());
+
+    // items that cannot be selected do not count as a selection
+    for (int row = 0; row < rows; ++row) {
+        for (int column = 0; column < 2; ++column)
+            model.item(row, column)->setEnabled(false);
+    }
+    QVERIFY(!selectionModel.hasSelection());
+}
+
 QTEST_MAIN(tst_QItemSelectionModel)
 #include "tst_qitemselectionmodel.moc"
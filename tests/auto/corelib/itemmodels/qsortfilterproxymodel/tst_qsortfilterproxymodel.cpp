@@ -5556,5 +5556,235 @@ void tst_QSortFilterProxyModel::filterChangeEmitsModelChangedSignals()
     QCOMPARE(rowsRemovedSpy.count(), 1);
 }
 
+// A read-only model whose data() may be called from any thread.
+class VariantListModel : public QAbstractListModel
+{
+public:
+    explicit VariantListModel(const QVariantList &values) : values(values) {}
+
+    int rowCount(const QModelIndex &parent = {}) const override
+    {
+        return parent.isValid() ? 0 : int(values.size());
+    }
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override
+    {
+        return role == Qt::DisplayRole ? values.at(index.row()) : QVariant();
+    }
+
+private:
+    const QVariantList values;
+};
+
+void tst_QSortFilterProxyModel::sortFilterHints_data()
+{
+    QTest::addColumn<QVariantList>("values");
+    QTest::addColumn<Qt::CaseSensitivity>("caseSensitivity");
+
+    // Enough rows for the work to be split across threads.
+    constexpr int RowCount = 50000;
+    QVariantList ints, doubles, strings, dates;
+    quint32 seed = 1;
+    for (int i = 0; i < RowCount; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        const int value = int(seed >> 20);
+        ints.append(i % 97 ? QVariant(value) : QVariant());
+        doubles.append(value / 7.);
+        strings.append((i % 3 ? QStringLiteral("Item %1") : QStringLiteral("item %1")).arg(value));
+        dates.append(QDate(2000, 1, 1).addDays(value % 5000));
+    }
+
+    QTest::newRow("int") << ints << Qt::CaseSensitive;
+    QTest::newRow("double") << doubles << Qt::CaseSensitive;
+    QTest::newRow("string") << strings << Qt::CaseSensitive;
+    QTest::newRow("string-ci") << strings << Qt::CaseInsensitive;
+    QTest::newRow("date") << dates << Qt::CaseSensitive;
+}
+
+void tst_QSortFilterProxyModel::sortFilterHints()
+{
+    QFETCH(QVariantList, values);
+    QFETCH(Qt::CaseSensitivity, caseSensitivity);
+
+    VariantListModel model(values);
+    const auto rows = [](const QSortFilterProxyModel &proxy) {
+        QList<int> result;
+        for (int row = 0; row < proxy.rowCount(); ++row)
+            result.append(proxy.mapToSource(proxy.index(row, 0)).row());
+        return result;
+    };
+
+    QSortFilterProxyModel reference;
+    reference.setSortCaseSensitivity(caseSensitivity);
+    reference.setSourceModel(&model);
+    QSortFilterProxyModel proxy;
+    QCOMPARE(proxy.sortFilterHints(), QSortFilterProxyModel::NoSortFilterHints);
+    proxy.setSortFilterHints(QSortFilterProxyModel::ExtractSortKeys
+                             | QSortFilterProxyModel::ConcurrentFiltering);
+    proxy.setSortCaseSensitivity(caseSensitivity);
+    proxy.setSourceModel(&model);
+
+    for (Qt::SortOrder order : {Qt::AscendingOrder, Qt::DescendingOrder}) {
+        reference.sort(0, order);
+        proxy.sort(0, order);
+        QCOMPARE(rows(proxy), rows(reference));
+    }
+
+    reference.setFilterRegularExpression(QStringLiteral("1"));
+    proxy.setFilterRegularExpression(QStringLiteral("1"));
+    QVERIFY(proxy.rowCount() < model.rowCount());
+    QCOMPARE(rows(proxy), rows(reference));
+
+    reference.setFilterRegularExpression(QStringLiteral("2"));
+    proxy.setFilterRegularExpression(QStringLiteral("2"));
+    QCOMPARE(rows(proxy), rows(reference));
+
+    // Switching the hints off gives the same result.
+    proxy.setSortFilterHints(QSortFilterProxyModel::NoSortFilterHints);
+    QCOMPARE(rows(proxy), rows(reference));
+}
+
+void tst_QSortFilterProxyModel::sortFilterHintsNaN()
+{
+    const double nan = qQNaN();
+    VariantListModel model({3., nan, 1., nan, 2.});
+    QSortFilterProxyModel proxy;
+    proxy.setSortFilterHints(QSortFilterProxyModel::ExtractSortKeys);
+    proxy.setSourceModel(&model);
+
+    const auto values = [&proxy] {
+        QList<double> result;
+        for (int row = 0; row < proxy.rowCount(); ++row)
+            result.append(proxy.index(row, 0).data().toDouble());
+        return result;
+    };
+
+    proxy.sort(0, Qt::AscendingOrder);
+    QList<double> sorted = values();
+    QCOMPARE(sorted.mid(0, 3), QList<double>({1., 2., 3.}));
+    QVERIFY(qIsNaN(sorted.at(3)));
+    QVERIFY(qIsNaN(sorted.at(4)));
+
+    proxy.sort(0, Qt::DescendingOrder);
+    sorted = values();
+    QVERIFY(qIsNaN(sorted.at(0)));
+    QVERIFY(qIsNaN(sorted.at(1)));
+    QCOMPARE(sorted.mid(2), QList<double>({3., 2., 1.}));
+}
+
+void tst_QSortFilterProxyModel::sortFilterHintsLessThan()
+{
+    class ReverseProxy : public QSortFilterProxyModel
+    {
+    public:
+        mutable int lessThanCalls = 0;
+
+    protected:
+        bool lessThan(const QModelIndex &left, const QModelIndex &right) const override
+        {
+            ++lessThanCalls;
+            return QSortFilterProxyModel::lessThan(right, left);
+        }
+    };
+
+    VariantListModel model({2, 3, 1});
+    ReverseProxy proxy;
+    proxy.setSourceModel(&model);
+    proxy.sort(0);
+    QVERIFY(proxy.lessThanCalls > 0);
+    QCOMPARE(proxy.index(0, 0).data().toInt(), 3);
+
+    // The keys are sorted as the default lessThan() compares them, without
+    // calling the reimplementation.
+    proxy.lessThanCalls = 0;
+    proxy.setSortFilterHints(QSortFilterProxyModel::ExtractSortKeys);
+    QCOMPARE(proxy.lessThanCalls, 0);
+    QCOMPARE(proxy.index(0, 0).data().toInt(), 1);
+
+    proxy.setSortFilterHints(QSortFilterProxyModel::NoSortFilterHints);
+    QVERIFY(proxy.lessThanCalls > 0);
+    QCOMPARE(proxy.index(0, 0).data().toInt(), 3);
+}
+
+void tst_QSortFilterProxyModel::concurrentFilteringBinding()
+{
+    // Enough rows for filterAcceptsRow() to be called from other threads.
+    constexpr int RowCount = 50000;
+    QVariantList values;
+    for (int i = 0; i < RowCount; ++i)
+        values.append(QString::number(i));
+    VariantListModel model(values);
+
+    QProperty<QRegularExpression> filter(QRegularExpression(QStringLiteral("7$")));
+    QProperty<int> role(Qt::DisplayRole);
+    QSortFilterProxyModel proxy;
+    proxy.setSortFilterHints(QSortFilterProxyModel::ConcurrentFiltering);
+    proxy.bindableFilterRegularExpression().setBinding(Qt::makePropertyBinding(filter));
+    proxy.bindableFilterRole().setBinding(Qt::makePropertyBinding(role));
+    proxy.setSourceModel(&model);
+    QCOMPARE(proxy.rowCount(), RowCount / 10);
+
+    // Changing the bound property marks the binding dirty; the proxy has to
+    // evaluate it before handing rows to other threads.
+    filter = QRegularExpression(QStringLiteral("^1"));
+    proxy.invalidate();
+    QCOMPARE(proxy.rowCount(), 11111);
+}
+
+void tst_QSortFilterProxyModel::incrementalUpdates()
+{
+    QStandardItemModel model;
+    for (int i = 0; i < 100; ++i)
+        model.appendRow(new QStandardItem(QString::number(i * 10)));
+
+    const auto rows = [](const QSortFilterProxyModel &proxy) {
+        QList<int> result;
+        for (int row = 0; row < proxy.rowCount(); ++row)
+            result.append(proxy.mapToSource(proxy.index(row, 0)).row());
+        return result;
+    };
+
+    QSortFilterProxyModel reference;
+    reference.setSourceModel(&model);
+    reference.setFilterRegularExpression(QStringLiteral("[^5]$"));
+    reference.sort(0);
+
+    QSortFilterProxyModel proxy;
+    proxy.setSortFilterHints(QSortFilterProxyModel::IncrementalUpdates);
+    proxy.setSourceModel(&model);
+    proxy.setFilterRegularExpression(QStringLiteral("[^5]$"));
+    proxy.sort(0);
+    QAbstractItemModelTester tester(&proxy);
+    QCOMPARE(rows(proxy), rows(reference));
+
+    QSignalSpy rowsInsertedSpy(&proxy, &QSortFilterProxyModel::rowsInserted);
+    QSignalSpy rowsMovedSpy(&proxy, &QSortFilterProxyModel::rowsMoved);
+    QSignalSpy layoutChangedSpy(&proxy, &QSortFilterProxyModel::layoutChanged);
+
+    // Rows are inserted in one batch once control returns to the event loop,
+    // with one signal per range of adjacent proxy rows
+    const int rowCount = proxy.rowCount();
+    for (int i = 0; i < 20; ++i)
+        model.appendRow(new QStandardItem(QString::number(5001 + i)));
+    model.insertRow(0, new QStandardItem(QStringLiteral("999")));
+    QCOMPARE(proxy.rowCount(), rowCount);
+    QTRY_COMPARE(proxy.rowCount(), reference.rowCount());
+    QCOMPARE(rows(proxy), rows(reference));
+    QCOMPARE(rowsInsertedSpy.size(), 2);
+
+    // Rows whose sort data changed are moved instead of laying out all rows again
+    QPersistentModelIndex persistent = proxy.index(3, 0);
+    model.item(rows(proxy).at(3))->setText(QStringLiteral("5000"));
+    model.item(rows(proxy).at(0))->setText(QStringLiteral("499"));
+    QCOMPARE(rows(proxy), rows(reference));
+    QCOMPARE(rowsMovedSpy.size(), 2);
+    QCOMPARE(layoutChangedSpy.size(), 0);
+    QCOMPARE(persistent.data().toString(), QStringLiteral("5000"));
+
+    // Pending rows are added before the source model is changed otherwise
+    model.appendRow(new QStandardItem(QStringLiteral("7")));
+    model.removeRow(1);
+    QCOMPARE(rows(proxy), rows(reference));
+}
+
 QTEST_MAIN(tst_QSortFilterProxyModel)
 #include "tst_qsortfilterproxymodel.moc"
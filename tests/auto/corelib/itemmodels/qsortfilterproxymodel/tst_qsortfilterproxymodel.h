@@ -155,6 +155,13 @@ private slots:
 
     void filterChangeEmitsModelChangedSignals();
 
+    void sortFilterHints_data();
+    void sortFilterHints();
+    void sortFilterHintsNaN();
+    void sortFilterHintsLessThan();
+    void concurrentFilteringBinding();
+    void incrementalUpdates();
+
 protected:
     void buildHierarchy(const QStringList &data, QAbstractItemModel *model);
     void checkHierarchy(const QStringList &data, const QAbstractItemModel *model);
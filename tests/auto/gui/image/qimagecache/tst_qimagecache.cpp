@@ -0,0 +1,198 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QTest>
+#include <QtCore/qatomic.h>
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qthreadpool.h>
+#include <QtGui/qimagecache.h>
+
+#include <memory>
+#include <vector>
+
+class tst_QImageCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void insertAndFind();
+    void byteLimit();
+    void protectedSegment();
+    void statistics();
+    void sharedLoads();
+    void findOrCreateAsync();
+};
+
+// 400 bytes of image data
+static QImage testImage(uint color)
+{
+    QImage image(10, 10, QImage::Format_ARGB32);
+    image.fill(color);
+    return image;
+}
+
+void tst_QImageCache::insertAndFind()
+{
+    QImageCache cache(1024 * 1024, 4);
+    QCOMPARE(cache.shardCount(), 4);
+
+    QImage found;
+    QVERIFY(!cache.find("a", &found));
+    QVERIFY(cache.insert("a", testImage(0xffff0000)));
+    QVERIFY(cache.insert("b", testImage(0xff00ff00)));
+    QVERIFY(!cache.insert("c", QImage()));
+    QVERIFY(cache.find("a", &found));
+    QCOMPARE(found, testImage(0xffff0000));
+    QVERIFY(cache.contains("b"));
+    QVERIFY(!cache.contains("c"));
+
+    // Inserting with the same key replaces the image.
+    QVERIFY(cache.insert("a", testImage(0xff0000ff)));
+    QVERIFY(cache.find("a", &found));
+    QCOMPARE(found, testImage(0xff0000ff));
+    QCOMPARE(cache.statistics().count, 2);
+
+    QVERIFY(cache.remove("a"));
+    QVERIFY(!cache.remove("a"));
+    QVERIFY(!cache.contains("a"));
+    cache.clear();
+    QVERIFY(!cache.contains("b"));
+    QCOMPARE(cache.statistics().count, 0);
+    QCOMPARE(cache.statistics().totalCost, 0);
+}
+
+void tst_QImageCache::byteLimit()
+{
+    QImageCache cache(4000, 1);
+    for (int i = 0; i < 10; ++i)
+        QVERIFY(cache.insert(QString::number(i), testImage(0xff000000 | i)));
+    QCOMPARE(cache.statistics().totalCost, 4000);
+
+    // The least recently inserted image goes first.
+    QVERIFY(cache.insert("10", testImage(0xffffffff)));
+    QVERIFY(!cache.contains("0"));
+    QVERIFY(cache.contains("1"));
+    QCOMPARE(cache.statistics().evictions, 1);
+
+    // Images larger than the limit of a shard are not cached.
+    QVERIFY(!cache.insert("large", QImage(100, 100, QImage::Format_ARGB32)));
+    QVERIFY(!cache.contains("large"));
+    QCOMPARE(cache.statistics().count, 10);
+
+    cache.setByteLimit(2000);
+    QCOMPARE(cache.byteLimit(), 2000);
+    QCOMPARE(cache.statistics().count, 5);
+    QVERIFY(cache.contains("10"));
+    QVERIFY(!cache.contains("5"));
+}
+
+void tst_QImageCache::protectedSegment()
+{
+    QImageCache cache(4000, 1);
+    QVERIFY(cache.insert("a", testImage(0xffff0000)));
+    QVERIFY(cache.insert("b", testImage(0xff00ff00)));
+    QVERIFY(cache.find("a", nullptr));
+    QVERIFY(cache.find("b", nullptr));
+
+    // A scan over images that are used once does not evict images that
+    // were used again.
+    for (int i = 0; i < 50; ++i)
+        QVERIFY(cache.insert(QString::number(i), testImage(0xff000000 | i)));
+    QVERIFY(cache.contains("a"));
+    QVERIFY(cache.contains("b"));
+    QVERIFY(!cache.contains("0"));
+    QVERIFY(cache.contains("49"));
+    QCOMPARE(cache.statistics().totalCost, 4000);
+
+    // The protected segment is limited to four fifths of the shard. Its
+    // least recently used images go back to probation, and are the first to
+    // be evicted from there.
+    for (int i = 0; i < 50; ++i)
+        cache.find(QString::number(i), nullptr);
+    QVERIFY(cache.contains("a"));
+    QVERIFY(cache.insert("50", testImage(0xffffffff)));
+    QVERIFY(!cache.contains("a"));
+    QVERIFY(cache.contains("b"));
+    QVERIFY(cache.contains("42"));
+    QCOMPARE(cache.statistics().count, 10);
+}
+
+void tst_QImageCache::statistics()
+{
+    QImageCache cache(1024 * 1024);
+    QVERIFY(cache.insert("a", testImage(0xffff0000)));
+    QVERIFY(cache.find("a", nullptr));
+    QVERIFY(!cache.find("b", nullptr));
+    QCOMPARE(cache.findOrCreate("c", [] { return testImage(0xff0000ff); }), testImage(0xff0000ff));
+    QCOMPARE(cache.findOrCreate("c", [] { return QImage(); }), testImage(0xff0000ff));
+
+    QImageCache::Statistics statistics = cache.statistics();
+    QCOMPARE(statistics.hits, 2);
+    QCOMPARE(statistics.misses, 2);
+    QCOMPARE(statistics.insertions, 2);
+    QCOMPARE(statistics.evictions, 0);
+    QCOMPARE(statistics.sharedLoads, 0);
+    QCOMPARE(statistics.count, 2);
+    QCOMPARE(statistics.totalCost, 800);
+
+    cache.resetStatistics();
+    statistics = cache.statistics();
+    QCOMPARE(statistics.hits, 0);
+    QCOMPARE(statistics.misses, 0);
+    QCOMPARE(statistics.count, 2);
+}
+
+void tst_QImageCache::sharedLoads()
+{
+    QImageCache cache(1024 * 1024);
+    QAtomicInt creations;
+    QSemaphore release;
+    auto create = [&] {
+        creations.ref();
+        release.acquire();
+        return testImage(0xff00ff00);
+    };
+
+    constexpr int ThreadCount = 8;
+    std::vector<std::unique_ptr<QThread>> threads;
+    QList<QImage> results(ThreadCount);
+    for (int i = 0; i < ThreadCount; ++i) {
+        threads.emplace_back(QThread::create([&, i] {
+            results[i] = cache.findOrCreate("key", create);
+        }));
+        threads.back()->start();
+    }
+
+    // Only one thread creates the image, the others wait for it.
+    QTRY_COMPARE(cache.statistics().sharedLoads, ThreadCount - 1);
+    QCOMPARE(creations.loadRelaxed(), 1);
+    release.release();
+    for (const auto &thread : threads)
+        QVERIFY(thread->wait());
+
+    QCOMPARE(creations.loadRelaxed(), 1);
+    for (const QImage &result : std::as_const(results))
+        QCOMPARE(result, testImage(0xff00ff00));
+    QVERIFY(cache.contains("key"));
+}
+
+void tst_QImageCache::findOrCreateAsync()
+{
+    QImageCache cache(1024 * 1024);
+    QThreadPool pool;
+    QFuture<QImage> future = cache.findOrCreateAsync("a", [] {
+        return testImage(0xffff0000);
+    }, &pool);
+    QCOMPARE(future.result(), testImage(0xffff0000));
+    QVERIFY(cache.contains("a"));
+
+    // Cached images are returned without going through the pool.
+    future = cache.findOrCreateAsync("a", [] { return QImage(); }, &pool);
+    QVERIFY(future.isFinished());
+    QCOMPARE(future.result(), testImage(0xffff0000));
+    pool.waitForDone();
+}
+
+QTEST_GUILESS_MAIN(tst_QImageCache)
+#include "tst_qimagecache.moc"
@@ -16,6 +16,7 @@
 #include <QTimer>
 #include <QTemporaryDir>
 #include <QTemporaryFile>
+#include <QThreadPool>
 
 #include <algorithm>
 
@@ -156,6 +157,11 @@ private slots:
 
     void xbmBufferHandling();
 
+    void readAsync();
+
+    void readScanlines_data();
+    void readScanlines();
+
 private:
     QString prefix;
     QTemporaryDir m_temporaryDir;
@@ -489,6 +495,11 @@ void tst_QImageReader::setClipRect_data()
     QTest::newRow("BMP: 4bpp uncompressed") << "tst7.bmp" << QRect(0, 0, 31, 31) << QByteArray("bmp");
     QTest::newRow("XPM: marble") << "marble" << QRect(0, 0, 50, 50) << QByteArray("xpm");
     QTest::newRow("PNG: kollada") << "kollada" << QRect(0, 0, 50, 50) << QByteArray("png");
+    QTest::newRow("PNG: kollada, inner rect") << "kollada" << QRect(13, 21, 40, 30) << QByteArray("png");
+    QTest::newRow("PNG: kollada-16bpc, inner rect") << "kollada-16bpc" << QRect(13, 21, 40, 30) << QByteArray("png");
+    QTest::newRow("PNG: basn0g16, inner rect") << "basn0g16" << QRect(3, 5, 20, 10) << QByteArray("png");
+    QTest::newRow("PNG: tst7, inner rect") << "tst7.png" << QRect(2, 3, 20, 20) << QByteArray("png");
+    QTest::newRow("PNG: black, larger rect") << "black.png" << QRect(-5, -5, 50, 50) << QByteArray("png");
     QTest::newRow("PPM: teapot") << "teapot" << QRect(0, 0, 50, 50) << QByteArray("ppm");
     QTest::newRow("PPM: runners") << "runners.ppm" << QRect(0, 0, 50, 50) << QByteArray("ppm");
     QTest::newRow("PPM: test") << "test.ppm" << QRect(0, 0, 50, 50) << QByteArray("ppm");
@@ -498,6 +509,7 @@ void tst_QImageReader::setClipRect_data()
 
     QTest::newRow("GIF: earth") << "earth" << QRect(0, 0, 50, 50) << QByteArray("gif");
     QTest::newRow("GIF: trolltech") << "trolltech" << QRect(0, 0, 50, 50) << QByteArray("gif");
+    QTest::newRow("GIF: earth, inner rect") << "earth" << QRect(11, 17, 40, 30) << QByteArray("gif");
 
     QTest::newRow("SVG: rect") << "rect" << QRect(0, 0, 50, 50) << QByteArray("svg");
     QTest::newRow("SVGZ: rect") << "rect" << QRect(0, 0, 50, 50) << QByteArray("svgz");
@@ -515,7 +527,7 @@ void tst_QImageReader::setClipRect()
     reader.setClipRect(newRect);
     QImage image = reader.read();
     QVERIFY(!image.isNull());
-    QCOMPARE(image.rect(), newRect);
+    QCOMPARE(image.size(), newRect.size());
 
     QImageReader originalReader(prefix + fileName);
     QImage originalImage = originalReader.read();
@@ -1703,6 +1715,7 @@ void tst_QImageReader::supportsOption_data()
                                 QImageIOHandler::CompressionRatio,
                                 QImageIOHandler::Size,
                                 QImageIOHandler::ImageFormat,
+                                QImageIOHandler::ClipRect,
                             };
 }
 
@@ -2055,6 +2068,15 @@ void tst_QImageReader::readText()
     QImage img(prefix + fileName);
     QVERIFY(img.textKeys().contains(key));
     QCOMPARE(img.text(key), text);
+
+    // Texts after the image data are kept when only part of it is read.
+    QImageReader reader(prefix + fileName);
+    if (reader.supportsOption(QImageIOHandler::ClipRect)) {
+        reader.setClipRect(QRect(0, 0, 8, 8));
+        img = reader.read();
+        QCOMPARE(img.size(), QSize(8, 8));
+        QCOMPARE(img.text(key), text);
+    }
 }
 
 
@@ -2204,5 +2226,95 @@ void tst_QImageReader::xbmBufferHandling()
     QImage::fromData(buffer, "xbm");
 }
 
+void tst_QImageReader::readAsync()
+{
+    const QStringList fileNames = {
+        prefix + "kollada.png",
+        prefix + "earth.gif",
+        prefix + "doesnotexist.png",
+        prefix + "marble.xpm",
+    };
+    QThreadPool pool;
+    QFuture<QImage> future = QImageReader::readAsync(fileNames, {}, &pool);
+    future.waitForFinished();
+    QCOMPARE(future.resultCount(), fileNames.size());
+    for (qsizetype i = 0; i < fileNames.size(); ++i)
+        QCOMPARE(future.resultAt(int(i)), QImage(fileNames.at(i)));
+    QVERIFY(future.resultAt(2).isNull());
+
+    // The readers can be configured on the threads that use them.
+    future = QImageReader::readAsync(fileNames, [](QImageReader &reader) {
+        reader.setScaledSize(reader.size() / 2);
+    }, &pool);
+    QCOMPARE(future.resultAt(0).size(), QImage(fileNames.at(0)).size() / 2);
+    QCOMPARE(future.resultAt(1).size(), QImage(fileNames.at(1)).size() / 2);
+
+    future = QImageReader::readAsync({}, {}, &pool);
+    QVERIFY(future.isFinished());
+    QCOMPARE(future.resultCount(), 0);
+}
+
+void tst_QImageReader::readScanlines_data()
+{
+    QTest::addColumn<QString>("fileName");
+    QTest::addColumn<bool>("supported");
+
+    QTest::newRow("png") << "kollada.png" << true;
+    QTest::newRow("png 16bpc") << "kollada-16bpc.png" << true;
+    QTest::newRow("png gray16") << "basn0g16.png" << true;
+    QTest::newRow("png indexed") << "tst7.png" << true;
+    QTest::newRow("jpeg") << "beavis.jpg" << true;
+    QTest::newRow("jpeg rgb") << "YCbCr_rgb.jpg" << true;
+    QTest::newRow("jpeg cmyk") << "YCbCr_cmyk.jpg" << true;
+    QTest::newRow("bmp") << "colorful.bmp" << true;
+    QTest::newRow("bmp 4bpp") << "tst7.bmp" << true;
+    QTest::newRow("bmp negative height") << "negativeheight.bmp" << true;
+    QTest::newRow("bmp v5") << "test32v5.bmp" << true;
+    QTest::newRow("bmp rle") << "4bpp-rle.bmp" << false;
+    QTest::newRow("pbm") << "image.pbm" << true;
+    QTest::newRow("pgm") << "image.pgm" << true;
+    QTest::newRow("ppm") << "image.ppm" << true;
+    QTest::newRow("ppm raw") << "runners.ppm" << true;
+    QTest::newRow("gif") << "earth.gif" << false;
+}
+
+void tst_QImageReader::readScanlines()
+{
+    QFETCH(QString, fileName);
+    QFETCH(bool, supported);
+
+    QImageReader reader(prefix + fileName);
+    QCOMPARE(reader.beginScanlineRead(), supported);
+    if (!supported) {
+        QCOMPARE(reader.error(), QImageReader::UnsupportedFormatError);
+        QCOMPARE(reader.scanlineFormat(), QImage::Format_Invalid);
+        return;
+    }
+
+    // Read the image in strips of seven rows and put them together again.
+    const QImage expected = QImage(prefix + fileName);
+    QImage image;
+    QImage rows(1, 7, reader.scanlineFormat());
+    int y = 0;
+    int count;
+    while ((count = reader.readScanlines(&rows)) > 0) {
+        QCOMPARE(rows.size(), QSize(expected.width(), 7));
+        QCOMPARE(rows.format(), reader.scanlineFormat());
+        if (image.isNull()) {
+            image = QImage(expected.size(), rows.format());
+            image.setColorTable(rows.colorTable());
+        }
+        for (int i = 0; i < count; ++i)
+            memcpy(image.scanLine(y + i), rows.constScanLine(i), rows.bytesPerLine());
+        y += count;
+    }
+    QCOMPARE(count, 0);
+    QCOMPARE(y, expected.height());
+    // only the pixels are read row by row
+    image.setColorSpace(expected.colorSpace());
+    QCOMPARE(image.convertToFormat(QImage::Format_ARGB32),
+             expected.convertToFormat(QImage::Format_ARGB32));
+}
+
 QTEST_MAIN(tst_QImageReader)
 #include "tst_qimagereader.moc"
@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
 
 #include <QTest>
+#include <QBuffer>
+#include <QColorSpace>
 #include <QDebug>
 #include <QFile>
 #include <QImage>
@@ -59,6 +61,10 @@ private slots:
 
     void writeEmpty();
 
+    void writeScanlines_data();
+    void writeScanlines();
+    void writeScanlinesPngOptions();
+
 private:
     QTemporaryDir m_temporaryDir;
     QString prefix;
@@ -578,5 +584,81 @@ void tst_QImageWriter::writeEmpty()
     QVERIFY(!QFileInfo(fileName).exists());
 }
 
+void tst_QImageWriter::writeScanlines_data()
+{
+    QTest::addColumn<QByteArray>("format");
+    QTest::addColumn<QImage::Format>("imageFormat");
+    QTest::addColumn<bool>("lossless");
+
+    QTest::newRow("png") << QByteArray("png") << QImage::Format_RGB32 << true;
+    QTest::newRow("png alpha") << QByteArray("png") << QImage::Format_ARGB32 << true;
+    QTest::newRow("png gray") << QByteArray("png") << QImage::Format_Grayscale8 << true;
+    QTest::newRow("jpeg") << QByteArray("jpeg") << QImage::Format_RGB32 << false;
+    QTest::newRow("jpeg gray") << QByteArray("jpeg") << QImage::Format_Grayscale8 << false;
+    QTest::newRow("bmp") << QByteArray("bmp") << QImage::Format_RGB32 << true;
+    QTest::newRow("ppm") << QByteArray("ppm") << QImage::Format_RGB32 << true;
+    QTest::newRow("pgm") << QByteArray("pgm") << QImage::Format_Grayscale8 << true;
+    QTest::newRow("pbm") << QByteArray("pbm") << QImage::Format_Grayscale8 << false;
+}
+
+void tst_QImageWriter::writeScanlines()
+{
+    QFETCH(QByteArray, format);
+    QFETCH(QImage::Format, imageFormat);
+    QFETCH(bool, lossless);
+    SKIP_IF_UNSUPPORTED(format);
+
+    QImage image = QImage(prefix + "kollada.png").convertToFormat(imageFormat);
+    QVERIFY(!image.isNull());
+
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    QImageWriter writer(&buffer, format);
+    QVERIFY(writer.beginScanlineWrite(image.size(), image.format()));
+    for (int y = 0; y < image.height(); y += 10)
+        QVERIFY(writer.writeScanlines(image.copy(0, y, image.width(), qMin(10, image.height() - y))));
+    QVERIFY(!writer.writeScanlines(image.copy(0, 0, image.width(), 1)));
+    QVERIFY(writer.endScanlineWrite());
+    buffer.close();
+
+    QImage written = QImage::fromData(buffer.data(), format);
+    QCOMPARE(written.size(), image.size());
+    // only the pixels are written row by row
+    written.setColorSpace(image.colorSpace());
+    if (lossless) {
+        QCOMPARE(written.convertToFormat(image.format()), image);
+    } else if (format == "pbm") {
+        QCOMPARE(written.format(), QImage::Format_Mono);
+    }
+
+    // All rows need to be written.
+    buffer.setData(QByteArray());
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    QVERIFY(writer.beginScanlineWrite(image.size(), image.format()));
+    QVERIFY(writer.writeScanlines(image.copy(0, 0, image.width(), 1)));
+    QVERIFY(!writer.endScanlineWrite());
+    QCOMPARE(writer.error(), QImageWriter::InvalidImageError);
+}
+
+void tst_QImageWriter::writeScanlinesPngOptions()
+{
+    SKIP_IF_UNSUPPORTED(QByteArray("png"));
+
+    QImage image(16, 16, QImage::Format_RGB32);
+    image.fill(Qt::red);
+
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    QImageWriter writer(&buffer, "png");
+    writer.setText("Title", "Rows");
+    QVERIFY(writer.beginScanlineWrite(image.size(), image.format()));
+    QVERIFY(writer.writeScanlines(image));
+    QVERIFY(writer.endScanlineWrite());
+    buffer.close();
+
+    QImageReader reader(&buffer, "png");
+    QCOMPARE(reader.text("Title"), QLatin1String("Rows"));
+}
+
 QTEST_MAIN(tst_QImageWriter)
 #include "tst_qimagewriter.moc"
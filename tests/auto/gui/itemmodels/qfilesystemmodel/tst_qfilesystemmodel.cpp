@@ -90,6 +90,8 @@ private slots:
     void setData();
 
     void sortPersistentIndex();
+    void largeDirectoryRows();
+    void sortArrivingFiles();
     void sort_data();
     void sort();
 
@@ -846,6 +848,79 @@ void tst_QFileSystemModel::sortPersistentIndex()
     QVERIFY(idx.column() != 0);
 }
 
+void tst_QFileSystemModel::largeDirectoryRows()
+{
+    const QTemporaryDir dir(flatDirTestPath + QStringLiteral("/largeDirectoryRows-XXXXXX"));
+    QVERIFY2(dir.isValid(), qPrintable(dir.errorString()));
+    constexpr int FileCount = 2000;
+    for (int i = 0; i < FileCount; ++i) {
+        QFile file(dir.filePath(QString::asprintf("file%04d", i)));
+        QVERIFY2(file.open(QIODevice::WriteOnly), qPrintable(file.errorString()));
+    }
+
+    QFileSystemModel model;
+    model.setReadOnly(false);
+    const QModelIndex root = model.setRootPath(dir.path());
+    QTRY_COMPARE(model.rowCount(root), FileCount);
+    model.sort(0, Qt::DescendingOrder);
+
+    // Rows are looked up through the nodes, check that they stay in sync
+    // with the rows the model hands out while entries come and go.
+    const auto verifyRows = [&] {
+        for (int row = 0; row < model.rowCount(root); ++row) {
+            const QModelIndex index = model.index(row, 0, root);
+            if (model.index(model.filePath(index)).row() != row)
+                return false;
+        }
+        return true;
+    };
+    QVERIFY(verifyRows());
+
+    QVERIFY(QFile::remove(dir.filePath("file1000")));
+    QTRY_COMPARE(model.rowCount(root), FileCount - 1);
+    QVERIFY(verifyRows());
+    QVERIFY(!model.index(dir.filePath("file1000")).isValid());
+
+    const QModelIndex renamed = model.index(dir.filePath("file0500"));
+    QVERIFY(model.setData(renamed, "file9999"));
+    QCOMPARE(model.index(dir.filePath("file9999")).row(), renamed.row());
+    QVERIFY(verifyRows());
+}
+
+void tst_QFileSystemModel::sortArrivingFiles()
+{
+    const QTemporaryDir dir(flatDirTestPath + QStringLiteral("/sortArrivingFiles-XXXXXX"));
+    QVERIFY2(dir.isValid(), qPrintable(dir.errorString()));
+    const auto createFiles = [&](int first) {
+        for (int i = first; i < 200; i += 2) {
+            QFile file(dir.filePath(QString::asprintf("file%03d", i)));
+            if (!file.open(QIODevice::WriteOnly))
+                return false;
+        }
+        return true;
+    };
+    QVERIFY(createFiles(0));
+
+    QFileSystemModel model;
+    const QModelIndex root = model.setRootPath(dir.path());
+    QTRY_COMPARE(model.rowCount(root), 100);
+    model.sort(0, Qt::DescendingOrder);
+
+    // Files that arrive later are merged into the sorted ones, and
+    // directories still sort before files
+    QVERIFY(createFiles(1));
+    QVERIFY(QDir(dir.path()).mkdir("dir"));
+    QTRY_COMPARE(model.rowCount(root), 201);
+    QTRY_COMPARE(model.index(200, 0, root).data().toString(), QStringLiteral("dir"));
+    for (int row = 0; row < 200; ++row)
+        QCOMPARE(model.index(row, 0, root).data().toString(), QString::asprintf("file%03d", 199 - row));
+
+    model.sort(0, Qt::AscendingOrder);
+    QCOMPARE(model.index(0, 0, root).data().toString(), QStringLiteral("dir"));
+    for (int row = 1; row < 201; ++row)
+        QCOMPARE(model.index(row, 0, root).data().toString(), QString::asprintf("file%03d", row - 1));
+}
+
 class MyFriendFileSystemModel : public QFileSystemModel
 {
     friend class tst_QFileSystemModel;
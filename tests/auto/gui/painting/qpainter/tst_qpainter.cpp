@@ -17,8 +17,11 @@
 #include <qpaintengine.h>
 #include <qpixmap.h>
 #include <qrandom.h>
+#include <qscopeguard.h>
 
 #include <private/qdrawhelper_p.h>
+#include <private/qpaintengineex_p.h>
+#include <private/qthreadpool_p.h>
 #include <qpainter.h>
 #include <qpainterpath.h>
 #include <qqueue.h>
@@ -286,6 +289,9 @@ private slots:
 #if QT_CONFIG(raster_fp)
     void hdrColors();
 #endif
+#ifdef QT_BUILD_INTERNAL
+    void parallelStrokeAndFill();
+#endif
 
 private:
     void fillData();
@@ -5573,6 +5579,54 @@ void tst_QPainter::hdrColors()
 }
 #endif
 
+#ifdef QT_BUILD_INTERNAL
+void tst_QPainter::parallelStrokeAndFill()
+{
+    QThreadPool *threadPool = QThreadPoolPrivate::qtGuiInstance();
+    QVERIFY(threadPool);
+    const int maxThreadCount = threadPool->maxThreadCount();
+    const int threshold = qt_parallelPaintThreshold();
+    auto cleanup = qScopeGuard([&] {
+        threadPool->setMaxThreadCount(maxThreadCount);
+        qt_setParallelPaintThreshold(threshold);
+    });
+    threadPool->setMaxThreadCount(qMax(maxThreadCount, 4));
+
+    // Many small curved subpaths spread over the whole image
+    QPainterPath path;
+    for (int i = 0; i < 4000; ++i) {
+        const qreal x = (i * 37) % 400;
+        const qreal y = (i * 53) % 400;
+        path.moveTo(x, y);
+        path.cubicTo(x + 20, y - 10, x + 30, y + 40, x + 5, y + 25);
+        path.lineTo(x - 10, y + 5);
+        path.closeSubpath();
+    }
+    QVERIFY(path.elementCount() > 16 * 1024);
+
+    auto render = [&path](bool stroke) {
+        QImage image(400, 400, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::white);
+        QPainter p(&image);
+        p.setRenderHint(QPainter::Antialiasing);
+        if (stroke)
+            p.strokePath(path, QPen(Qt::blue, 3.5, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
+        else
+            p.fillPath(path, QColor(255, 0, 0, 128));
+        p.end();
+        return image;
+    };
+
+    for (bool stroke : { true, false }) {
+        qt_setParallelPaintThreshold(0);
+        const QImage serial = render(stroke);
+        qt_setParallelPaintThreshold(1);
+        const QImage parallel = render(stroke);
+        QCOMPARE(parallel, serial);
+    }
+}
+#endif
+
 QTEST_MAIN(tst_QPainter)
 
 #include "tst_qpainter.moc"
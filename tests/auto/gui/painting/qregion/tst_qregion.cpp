@@ -4,11 +4,13 @@
 
 #include <QTest>
 #include <qregion.h>
+#include <private/qregion_p.h>
 
 #include <qbitmap.h>
 #include <qpainter.h>
 #include <qpainterpath.h>
 #include <qpolygon.h>
+#include <qrandom.h>
 
 #ifdef Q_OS_WIN
 #  include <qt_windows.h>
@@ -65,6 +67,9 @@ private slots:
     void regionToPath_data();
     void regionToPath();
 #endif
+    void regionFromRects_data();
+    void regionFromRects();
+    void regionSimplified();
 
 #ifdef Q_OS_WIN
     void winConversion();
@@ -1066,6 +1071,84 @@ void tst_QRegion::regionToPath()
 }
 #endif // QT_BUILD_INTERNAL
 
+void tst_QRegion::regionFromRects_data()
+{
+    QTest::addColumn<QList<QRect>>("rects");
+
+    QTest::newRow("empty") << QList<QRect>();
+    QTest::newRow("single") << QList<QRect>{ QRect(10, 10, 20, 20) };
+    QTest::newRow("invalid") << QList<QRect>{ QRect(), QRect(10, 10, -5, 20), QRect(0, 0, 4, 4) };
+    QTest::newRow("nested") << QList<QRect>{ QRect(0, 0, 100, 100), QRect(10, 10, 20, 20) };
+    QTest::newRow("adjacent") << QList<QRect>{ QRect(0, 0, 10, 10), QRect(10, 0, 10, 10),
+                                               QRect(0, 10, 20, 10) };
+    QTest::newRow("cross") << QList<QRect>{ QRect(40, 0, 20, 100), QRect(0, 40, 100, 20) };
+
+    QList<QRect> grid;
+    for (int y = 0; y < 20; ++y) {
+        for (int x = 0; x < 20; ++x) {
+            if ((x + y) % 3)
+                grid << QRect(x * 10, y * 10, 8, 10);
+        }
+    }
+    QTest::newRow("grid") << grid;
+
+    QRandomGenerator generator(42);
+    QList<QRect> random;
+    for (int i = 0; i < 500; ++i) {
+        random << QRect(generator.bounded(1000), generator.bounded(1000),
+                        generator.bounded(1, 100), generator.bounded(1, 100));
+    }
+    QTest::newRow("random") << random;
+}
+
+void tst_QRegion::regionFromRects()
+{
+    QFETCH(QList<QRect>, rects);
+
+    QRegion expected;
+    for (const QRect &rect : std::as_const(rects))
+        expected += rect;
+
+    const QRegion region = qt_regionFromRects(rects);
+    QCOMPARE(region.boundingRect(), expected.boundingRect());
+    QVERIFY(region.xored(expected).isEmpty());
+    QCOMPARE(region, expected);
+}
+
+void tst_QRegion::regionSimplified()
+{
+    // many small widgets with one pixel gaps between them
+    QRegion grid;
+    for (int y = 0; y < 40; ++y) {
+        for (int x = 0; x < 40; ++x)
+            grid += QRect(x * 10, y * 10, 9, 9);
+    }
+    QRandomGenerator generator(42);
+    QRegion random;
+    for (int i = 0; i < 2000; ++i) {
+        random += QRect(generator.bounded(2000), generator.bounded(2000),
+                        generator.bounded(1, 40), generator.bounded(1, 40));
+    }
+
+    QCOMPARE(qt_regionSimplified(grid, 0), grid);
+    QCOMPARE(qt_regionSimplified(random, 0), random);
+
+    for (qreal maxWaste : { 0.1, 0.25, 0.5 }) {
+        const QRegion simplifiedGrid = qt_regionSimplified(grid, maxWaste);
+        QVERIFY(grid.subtracted(simplifiedGrid).isEmpty());
+        QVERIFY(simplifiedGrid.rectCount() < grid.rectCount());
+        QCOMPARE(simplifiedGrid.boundingRect(), grid.boundingRect());
+
+        const QRegion simplifiedRandom = qt_regionSimplified(random, maxWaste);
+        QVERIFY(random.subtracted(simplifiedRandom).isEmpty());
+        QVERIFY(simplifiedRandom.rectCount() <= random.rectCount());
+    }
+
+    const QRegion notched = QRegion(0, 0, 100, 100) + QRegion(100, 0, 2, 98);
+    QCOMPARE(qt_regionSimplified(notched, 0.01), QRegion(0, 0, 102, 100));
+    QCOMPARE(qt_regionSimplified(notched, 0.0001), notched);
+}
+
 #ifdef Q_OS_WIN
 void tst_QRegion::winConversion()
 {
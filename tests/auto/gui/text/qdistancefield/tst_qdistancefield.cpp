@@ -0,0 +1,180 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QTest>
+#include <QBuffer>
+#include <QTemporaryDir>
+#include <QtEndian>
+
+#include <qrawfont.h>
+#include <private/qdistancefield_p.h>
+
+class tst_QDistanceField : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void atlas_data();
+    void atlas();
+    void atlasCache();
+    void atlasLoadInvalid();
+
+private:
+    QRawFont font;
+    QList<glyph_t> glyphs;
+};
+
+void tst_QDistanceField::initTestCase()
+{
+    const QString fileName = QFINDTESTDATA("testfont.ttf");
+    QVERIFY(!fileName.isEmpty());
+    font = QRawFont(fileName, 16);
+    QVERIFY(font.isValid());
+
+    const QList<quint32> indexes = font.glyphIndexesForString(QStringLiteral("The quick brown fox jumps over the lazy dog"));
+    for (quint32 index : indexes)
+        glyphs.append(index);
+}
+
+void tst_QDistanceField::atlas_data()
+{
+    QTest::addColumn<bool>("doubleResolution");
+    QTest::addColumn<int>("width");
+
+    QTest::newRow("default") << false << 1024;
+    QTest::newRow("narrow") << false << 64;
+    QTest::newRow("doubleResolution") << true << 256;
+}
+
+void tst_QDistanceField::atlas()
+{
+    QFETCH(bool, doubleResolution);
+    QFETCH(int, width);
+
+    const QDistanceFieldAtlas atlas = QDistanceFieldAtlas::create(font, glyphs, doubleResolution, width);
+    QVERIFY(!atlas.isNull());
+    QCOMPARE(atlas.image().format(), QImage::Format_Alpha8);
+    QVERIFY(atlas.image().width() >= width);
+
+    QList<glyph_t> expectedGlyphs = glyphs;
+    std::sort(expectedGlyphs.begin(), expectedGlyphs.end());
+    expectedGlyphs.erase(std::unique(expectedGlyphs.begin(), expectedGlyphs.end()), expectedGlyphs.end());
+    QCOMPARE(atlas.glyphs().size(), expectedGlyphs.size());
+
+    const QImage image = atlas.image();
+    const QList<QDistanceFieldAtlas::Glyph> atlasGlyphs = atlas.glyphs();
+    for (qsizetype i = 0; i < atlasGlyphs.size(); ++i) {
+        const QDistanceFieldAtlas::Glyph glyph = atlasGlyphs.at(i);
+        QCOMPARE(glyph.glyph, expectedGlyphs.at(i));
+        QCOMPARE(atlas.glyph(glyph.glyph).rect, glyph.rect);
+        QVERIFY(image.rect().contains(glyph.rect));
+        for (qsizetype j = i + 1; j < atlasGlyphs.size(); ++j)
+            QVERIFY(!glyph.rect.intersects(atlasGlyphs.at(j).rect));
+
+        // the same distance field as when generating the glyph on its own
+        const QDistanceField field(font, glyph.glyph, doubleResolution);
+        QCOMPARE(glyph.rect.size(), QSize(field.width(), field.height()));
+        for (int y = 0; y < field.height(); ++y) {
+            QVERIFY(memcmp(image.constScanLine(glyph.rect.y() + y) + glyph.rect.x(),
+                           field.constScanLine(y), field.width()) == 0);
+        }
+    }
+
+    QVERIFY(atlas.glyph(0xffff).rect.isNull());
+}
+
+void tst_QDistanceField::atlasCache()
+{
+    QTemporaryDir cacheDir;
+    QVERIFY(cacheDir.isValid());
+    const QString directory = cacheDir.filePath(QStringLiteral("distancefields"));
+
+    const QDistanceFieldAtlas generated = QDistanceFieldAtlas::create(font, glyphs, false, 512, directory);
+    QVERIFY(!generated.isNull());
+
+    const QByteArray key = QDistanceFieldAtlas::cacheKey(font, glyphs, false, 512);
+    const QString fileName = directory + u'/' + QString::fromLatin1(key) + QStringLiteral(".qdfa");
+    QVERIFY(QFile::exists(fileName));
+
+    // a different set of glyphs is cached separately
+    QVERIFY(QDistanceFieldAtlas::cacheKey(font, glyphs.mid(1), false, 512) != key);
+    QVERIFY(QDistanceFieldAtlas::cacheKey(font, glyphs, true, 512) != key);
+
+    const QDistanceFieldAtlas cached = QDistanceFieldAtlas::create(font, glyphs, false, 512, directory);
+    QVERIFY(!cached.isNull());
+    QCOMPARE(cached.image(), generated.image());
+    QCOMPARE(cached.glyphs().size(), generated.glyphs().size());
+    for (qsizetype i = 0; i < generated.glyphs().size(); ++i) {
+        QCOMPARE(cached.glyphs().at(i).glyph, generated.glyphs().at(i).glyph);
+        QCOMPARE(cached.glyphs().at(i).rect, generated.glyphs().at(i).rect);
+        QCOMPARE(cached.glyphs().at(i).boundingRect, generated.glyphs().at(i).boundingRect);
+    }
+
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QVERIFY(QDistanceFieldAtlas::load(&file, QByteArrayLiteral("other key")).isNull());
+}
+
+void tst_QDistanceField::atlasLoadInvalid()
+{
+    QByteArray data;
+    {
+        QBuffer buffer(&data);
+        QVERIFY(buffer.open(QIODevice::WriteOnly));
+        const QDistanceFieldAtlas atlas = QDistanceFieldAtlas::create(font, glyphs.mid(0, 3));
+        QVERIFY(atlas.save(&buffer));
+    }
+
+    {
+        QBuffer buffer(&data);
+        QVERIFY(buffer.open(QIODevice::ReadOnly));
+        QVERIFY(!QDistanceFieldAtlas::load(&buffer).isNull());
+    }
+
+    // truncated
+    QByteArray truncated = data.left(data.size() / 2);
+    QBuffer buffer(&truncated);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QVERIFY(QDistanceFieldAtlas::load(&buffer).isNull());
+
+    // find the glyph count, which follows the header
+    qint64 glyphCountOffset = 0;
+    {
+        QBuffer header(&data);
+        QVERIFY(header.open(QIODevice::ReadOnly));
+        QDataStream stream(&header);
+        stream.setVersion(QDataStream::Qt_6_0);
+        quint32 magic, version;
+        QByteArray key;
+        qint32 width, height;
+        stream >> magic >> version >> key >> width >> height;
+        QCOMPARE(stream.status(), QDataStream::Ok);
+        glyphCountOffset = header.pos();
+    }
+    constexpr qint64 glyphEntrySize = 4 + 4 * 4 + 4 * 8;
+
+    // more glyphs than the file can hold
+    QByteArray tooManyGlyphs = data;
+    qToBigEndian<quint32>(0xffffffff, tooManyGlyphs.data() + glyphCountOffset);
+    buffer.close();
+    buffer.setBuffer(&tooManyGlyphs);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QVERIFY(QDistanceFieldAtlas::load(&buffer).isNull());
+
+    // glyphs out of order
+    QByteArray unsorted = data;
+    const qint64 firstGlyph = glyphCountOffset + 4;
+    std::swap_ranges(unsorted.begin() + firstGlyph, unsorted.begin() + firstGlyph + glyphEntrySize,
+                     unsorted.begin() + firstGlyph + glyphEntrySize);
+    buffer.close();
+    buffer.setBuffer(&unsorted);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QVERIFY(QDistanceFieldAtlas::load(&buffer).isNull());
+
+    QVERIFY(QDistanceFieldAtlas::create(QRawFont(), glyphs).isNull());
+}
+
+QTEST_MAIN(tst_QDistanceField)
+#include "tst_qdistancefield.moc"
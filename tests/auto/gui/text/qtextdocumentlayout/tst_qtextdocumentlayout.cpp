@@ -9,11 +9,16 @@
 #include <qdebug.h>
 #include <qpainter.h>
 #include <qtexttable.h>
+#include <private/qtextdocumentlayout_p.h>
 #ifndef QT_NO_WIDGETS
 #include <qtextedit.h>
 #include <qscrollbar.h>
 #endif
 
+#ifdef QT_BUILD_INTERNAL
+Q_AUTOTEST_EXPORT int qt_textDocumentLayout_prelaidOutBlockCount();
+#endif
+
 class tst_QTextDocumentLayout : public QObject
 {
     Q_OBJECT
@@ -37,6 +42,8 @@ private slots:
     void floatingTablePageBreak();
     void imageAtRightAlignedTab();
     void blockVisibility();
+    void parallelLayout_data();
+    void parallelLayout();
 #ifndef QT_NO_TEXTHTMLPARSER
     void testHitTest();
 
@@ -333,6 +340,93 @@ void tst_QTextDocumentLayout::blockVisibility()
     QCOMPARE(doc->size(), halfSize);
 }
 
+void tst_QTextDocumentLayout::parallelLayout_data()
+{
+    QTest::addColumn<bool>("lazy");
+    QTest::addColumn<qreal>("textIndent");
+
+    QTest::newRow("full") << false << qreal(0);
+    QTest::newRow("lazy") << true << qreal(0);
+    QTest::newRow("textIndent") << false << qreal(40);
+}
+
+void tst_QTextDocumentLayout::parallelLayout()
+{
+    QFETCH(bool, lazy);
+    QFETCH(qreal, textIndent);
+
+    QString text;
+    for (int i = 0; i < 300; ++i) {
+        text += QStringLiteral("Paragraph %1: ").arg(i);
+        for (int j = 0; j < i % 23 + 5; ++j)
+            text += QStringLiteral("lorem ipsum dolor sit amet ");
+        if (i % 37 == 0)
+            text += QString(120, QLatin1Char('x'));
+        text += QLatin1Char('\n');
+    }
+
+    const auto layOut = [&](QTextDocument *document, bool parallel) {
+        auto *layout = qobject_cast<QTextDocumentLayout *>(document->documentLayout());
+        QVERIFY(layout);
+        layout->setParallelLayoutEnabled(parallel);
+        QCOMPARE(layout->isParallelLayoutEnabled(), parallel);
+        document->setTextWidth(300);
+        document->setPlainText(text);
+        if (textIndent != 0) {
+            QTextBlockFormat format;
+            format.setTextIndent(textIndent);
+            QTextCursor cursor(document);
+            cursor.select(QTextCursor::Document);
+            cursor.mergeBlockFormat(format);
+        }
+        if (lazy) {
+            // lay out a step at a time, as when painting the visible part
+            QImage image(300, 300, QImage::Format_ARGB32_Premultiplied);
+            QPainter painter(&image);
+            QAbstractTextDocumentLayout::PaintContext context;
+            for (int y = 0; y < 20000; y += 300) {
+                context.clip = QRectF(0, y, 300, 300);
+                layout->draw(&painter, context);
+            }
+        }
+        document->size();
+    };
+
+#ifdef QT_BUILD_INTERNAL
+    int prelaidOutBlocks = qt_textDocumentLayout_prelaidOutBlockCount();
+#endif
+    QTextDocument sequential;
+    layOut(&sequential, false);
+#ifdef QT_BUILD_INTERNAL
+    QCOMPARE(qt_textDocumentLayout_prelaidOutBlockCount(), prelaidOutBlocks);
+#endif
+    QTextDocument parallel;
+    layOut(&parallel, true);
+#ifdef QT_BUILD_INTERNAL
+    // the blocks must have been broken into lines on the thread pool
+    QVERIFY(qt_textDocumentLayout_prelaidOutBlockCount() > prelaidOutBlocks);
+#endif
+
+    QCOMPARE(parallel.blockCount(), sequential.blockCount());
+    QCOMPARE(parallel.size(), sequential.size());
+    for (QTextBlock a = sequential.begin(), b = parallel.begin(); a.isValid(); a = a.next(), b = b.next()) {
+        QTextLayout *expected = a.layout();
+        QTextLayout *actual = b.layout();
+        QCOMPARE(actual->lineCount(), expected->lineCount());
+        QCOMPARE(actual->position(), expected->position());
+        for (int i = 0; i < expected->lineCount(); ++i) {
+            const QTextLine e = expected->lineAt(i);
+            const QTextLine l = actual->lineAt(i);
+            QCOMPARE(l.textStart(), e.textStart());
+            QCOMPARE(l.textLength(), e.textLength());
+            QCOMPARE(l.position(), e.position());
+            QCOMPARE(l.width(), e.width());
+        }
+        QCOMPARE(parallel.documentLayout()->blockBoundingRect(b),
+                 sequential.documentLayout()->blockBoundingRect(a));
+    }
+}
+
 #ifndef QT_NO_TEXTHTMLPARSER
 void tst_QTextDocumentLayout::largeImage()
 {
@@ -9,10 +9,12 @@
     silently convert to a series of question marks.
  */
 #include <QTest>
+#include <QScopeGuard>
 
 
 
 #include <private/qtextengine_p.h>
+#include <private/qtextshapingcache_p.h>
 #include <qtextlayout.h>
 
 #include <qdebug.h>
@@ -128,6 +130,9 @@ private slots:
     void min_maximumWidth_data();
     void min_maximumWidth();
     void negativeLineWidth();
+    void shapingCache_data();
+    void shapingCache();
+    void shapingCacheKey();
 
 private:
     QFont testFont;
@@ -2761,5 +2766,95 @@ void tst_QTextLayout::negativeLineWidth()
     }
 }
 
+static QList<QGlyphRun> layoutGlyphRuns(const QString &text, const QFont &font, qreal *width)
+{
+    QTextLayout layout(text, font);
+    layout.beginLayout();
+    layout.createLine();
+    layout.endLayout();
+    *width = layout.lineAt(0).naturalTextWidth();
+    return layout.glyphRuns();
+}
+
+void tst_QTextLayout::shapingCache_data()
+{
+    QTest::addColumn<QString>("text");
+
+    QTest::newRow("latin") << QString::fromLatin1("Hello World");
+    QTest::newRow("arabic") << QString::fromUtf8("\xd8\xa7\xd9\x84\xd8\xb9\xd8\xb1\xd8\xa8\xd9\x8a\xd8\xa9");
+    QTest::newRow("mixed") << QString::fromUtf8("abc \xd7\x90\xd7\x91\xd7\x92 def");
+    QTest::newRow("surrogates") << QStringLiteral(u"a\U0001F600b");
+}
+
+void tst_QTextLayout::shapingCache()
+{
+    QFETCH(QString, text);
+
+    const qint64 byteLimit = QTextShapingCache::byteLimit();
+    auto restoreLimit = qScopeGuard([byteLimit] { QTextShapingCache::setByteLimit(byteLimit); });
+
+    QTextShapingCache::setByteLimit(0);
+    qreal uncachedWidth = 0;
+    const QList<QGlyphRun> uncached = layoutGlyphRuns(text, testFont, &uncachedWidth);
+
+    QTextShapingCache::setByteLimit(1024 * 1024);
+    QTextShapingCache::clear();
+    QTextShapingCache::resetStatistics();
+
+    qreal firstWidth = 0;
+    const QList<QGlyphRun> first = layoutGlyphRuns(text, testFont, &firstWidth);
+    // glyphRuns() shapes the items again, which may already hit the cache
+    const QTextShapingCache::Statistics firstStats = QTextShapingCache::statistics();
+    QVERIFY(firstStats.insertions > 0);
+    QCOMPARE(qint64(firstStats.count), firstStats.insertions);
+
+    qreal secondWidth = 0;
+    const QList<QGlyphRun> second = layoutGlyphRuns(text, testFont, &secondWidth);
+    const QTextShapingCache::Statistics secondStats = QTextShapingCache::statistics();
+    QCOMPARE(secondStats.insertions, firstStats.insertions);
+    QCOMPARE(secondStats.misses, firstStats.misses);
+    QVERIFY(secondStats.hits > firstStats.hits);
+
+    QCOMPARE(first, uncached);
+    QCOMPARE(second, uncached);
+    QCOMPARE(firstWidth, uncachedWidth);
+    QCOMPARE(secondWidth, uncachedWidth);
+}
+
+void tst_QTextLayout::shapingCacheKey()
+{
+    const qint64 byteLimit = QTextShapingCache::byteLimit();
+    auto restoreLimit = qScopeGuard([byteLimit] { QTextShapingCache::setByteLimit(byteLimit); });
+    QTextShapingCache::setByteLimit(1024 * 1024);
+    QTextShapingCache::clear();
+
+    const QString text = QStringLiteral("Spacing");
+    qreal plainWidth = 0;
+    layoutGlyphRuns(text, testFont, &plainWidth);
+
+    // Letter spacing is applied while shaping, so it must not reuse the
+    // run shaped without it
+    QFont spacedFont = testFont;
+    spacedFont.setLetterSpacing(QFont::AbsoluteSpacing, 10);
+    qreal spacedWidth = 0;
+    layoutGlyphRuns(text, spacedFont, &spacedWidth);
+    QVERIFY(spacedWidth > plainWidth);
+
+    QTextShapingCache::setByteLimit(0);
+    QVERIFY(!QTextShapingCache::isEnabled());
+    qreal uncachedWidth = 0;
+    layoutGlyphRuns(text, spacedFont, &uncachedWidth);
+    QCOMPARE(spacedWidth, uncachedWidth);
+
+    QTextShapingCache::setByteLimit(1024 * 1024);
+    QTextShapingCache::resetStatistics();
+    layoutGlyphRuns(text, testFont, &plainWidth);
+    const QTextShapingCache::Statistics stats = QTextShapingCache::statistics();
+    QCOMPARE(stats.insertions, qint64(1));
+    layoutGlyphRuns(text, testFont, &plainWidth);
+    QCOMPARE(QTextShapingCache::statistics().insertions, qint64(1));
+    QVERIFY(QTextShapingCache::statistics().hits > stats.hits);
+}
+
 QTEST_MAIN(tst_QTextLayout)
 #include "tst_qtextlayout.moc"
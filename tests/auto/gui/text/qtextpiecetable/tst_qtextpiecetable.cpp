@@ -72,6 +72,9 @@ private slots:
     void removeWithChildFrame();
     void clearWithFrames();
 
+    void largeBuffer_data();
+    void largeBuffer();
+
 private:
     QTextDocument *doc;
     QTextDocumentPrivate *table;
@@ -1108,8 +1111,59 @@ void tst_QTextPieceTable::clearWithFrames()
     QVERIFY(true);
 }
 
+void tst_QTextPieceTable::largeBuffer_data()
+{
+    QTest::addColumn<bool>("undo");
+
+    QTest::newRow("undo") << true;
+    QTest::newRow("no undo") << false;
+}
+
+void tst_QTextPieceTable::largeBuffer()
+{
+    QFETCH(bool, undo);
+    doc->setUndoRedoEnabled(undo);
+
+    // edits that fill several chunks of the text buffer, including strings
+    // that are larger than a chunk
+    const int chunkSize = QTextDocumentBuffer::ChunkSize;
+    QString expected;
+    QRandomGenerator rng(42);
+    for (int i = 0; i < 400; ++i) {
+        const int length = i % 50 == 0 ? chunkSize + 100 : int(rng.bounded(1, 700));
+        const QString str(length, QChar(u'a' + i % 26));
+        const int pos = int(rng.bounded(expected.size() + 1));
+        table->insert(pos, str, charFormatIndex);
+        expected.insert(pos, str);
+
+        if (i % 3 == 0 && expected.size() > 100) {
+            const int removePos = int(rng.bounded(expected.size() - 50));
+            const int removeLength = int(rng.bounded(1, 50));
+            table->remove(removePos, removeLength);
+            expected.remove(removePos, removeLength);
+        }
+    }
+    QCOMPARE(table->plainText(), expected);
+    QCOMPARE(doc->characterAt(expected.size() / 2), expected.at(expected.size() / 2));
+
+    // removing most of the text makes the piece table drop the garbage
+    // when there is no undo stack that still refers to it
+    table->remove(0, expected.size() / 4 * 3);
+    expected.remove(0, expected.size() / 4 * 3);
+    QCOMPARE(table->plainText(), expected);
+    if (!undo)
+        QVERIFY(table->buffer().size() < qsizetype(expected.size()) * 2 + chunkSize);
+
+    if (undo) {
+        doc->undo();
+        doc->undo();
+        doc->redo();
+        table->remove(0, 10);
+        QCOMPARE(table->plainText().size(), table->length() - 1);
+    }
+}
+
 QTEST_MAIN(tst_QTextPieceTable)
 
 
 #include "tst_qtextpiecetable.moc"
-
@@ -29,6 +29,7 @@ private Q_SLOTS:
     void bitstreamWrite();
     void bitstreamReadWrite();
     void bitstreamCompression();
+    void huffmanAllOctets();
     void bitstreamErrors();
 
     void lookupTableConstructor();
@@ -293,6 +294,49 @@ void tst_Hpack::bitstreamCompression()
     }
 }
 
+void tst_Hpack::huffmanAllOctets()
+{
+    // Every octet value, including the ones with 25 - 30 bit long codes
+    // and the ones that are negative as a (signed) char:
+    QByteArray allOctets(256, Qt::Uninitialized);
+    for (int i = 0; i < 256; ++i)
+        allOctets[i] = char(i);
+
+    for (int repeat : {1, 7, 64}) {
+        const QByteArray input = allOctets.repeated(repeat);
+        std::vector<uchar> buffer;
+        BitOStream out(buffer);
+        out.write(input, true);
+        QVERIFY(out.byteLength() > 0);
+        QCOMPARE(out.bitLength() % 8, 0u);
+
+        BitIStream in(out.begin(), out.end());
+        QByteArray decoded;
+        QVERIFY(in.read(&decoded));
+        QCOMPARE(in.error(), StreamError::NoError);
+        QCOMPARE(decoded, input);
+        QVERIFY(!in.hasMoreBits());
+    }
+
+    {
+        // A string made of EOS is a compression error (HPACK, 5.2):
+        const uchar bytes[] = {0x84, 0xff, 0xff, 0xff, 0xff};
+        BitIStream in(bytes, bytes + sizeof bytes);
+        QByteArray decoded;
+        QVERIFY(!in.read(&decoded));
+        QCOMPARE(in.error(), StreamError::CompressionError);
+    }
+
+    {
+        // 'a' (00011) padded with zeros instead of EOS bits:
+        const uchar bytes[] = {0x81, 0x18};
+        BitIStream in(bytes, bytes + sizeof bytes);
+        QByteArray decoded;
+        QVERIFY(!in.read(&decoded));
+        QCOMPARE(in.error(), StreamError::CompressionError);
+    }
+}
+
 void tst_Hpack::bitstreamErrors()
 {
     {
@@ -18,10 +18,15 @@
 
 #include <QCoreApplication>
 #include <QDebug>
+#include <QNetworkDatagram>
+#include <QScopeGuard>
+#include <QSet>
 #include <QTcpServer>
 #include <QTcpSocket>
 #include <QTest>
 #include <QTestEventLoop>
+#include <QUdpSocket>
+#include <QtEndian>
 
 #include <private/qthread_p.h>
 
@@ -83,6 +88,9 @@ private slots:
     void multipleDifferentLookups();
 
     void cache();
+#if QT_CONFIG(dnslookup) && QT_CONFIG(libresolv)
+    void dnsResolver();
+#endif
 
     void abortHostLookup();
 
@@ -607,6 +615,166 @@ void tst_QHostInfo::cache()
     QCOMPARE(helper.lookupsDoneCounter, 2);
 }
 
+#if QT_CONFIG(dnslookup) && QT_CONFIG(libresolv)
+// Answers A and AAAA queries for the names in its zone, and NXDOMAIN for all
+// other names. Negative answers carry an SOA record, unless they are for one
+// of typesWithoutSoa.
+class DnsStubServer : public QObject
+{
+    Q_OBJECT
+public:
+    enum Type : quint16 { A = 1, SOA = 6, AAAA = 28 };
+    struct Record
+    {
+        Type type;
+        quint32 timeToLive;
+        QByteArray data;
+    };
+
+    DnsStubServer()
+    {
+        connect(&socket, &QUdpSocket::readyRead, this, &DnsStubServer::answerQueries);
+    }
+
+    QHash<QByteArray, QList<Record>> zone;
+    QSet<quint16> typesWithoutSoa;
+    QUdpSocket socket;
+    int queries = 0;
+
+private slots:
+    void answerQueries();
+};
+
+void DnsStubServer::answerQueries()
+{
+    while (socket.hasPendingDatagrams()) {
+        const QNetworkDatagram datagram = socket.receiveDatagram();
+        const QByteArray query = datagram.data();
+        if (query.size() < 12)
+            continue;
+        ++queries;
+
+        qsizetype offset = 12;
+        QByteArray name;
+        while (offset < query.size() && query.at(offset)) {
+            const int length = quint8(query.at(offset));
+            if (!name.isEmpty())
+                name += '.';
+            name += query.mid(offset + 1, length);
+            offset += length + 1;
+        }
+        const qsizetype questionEnd = offset + 5;  // root label, type and class
+        if (questionEnd > query.size())
+            continue;
+        const quint16 type = qFromBigEndian<quint16>(query.constData() + offset + 1);
+
+        const auto records = zone.constFind(name);
+        QList<Record> answers;
+        if (records != zone.cend()) {
+            for (const Record &record : *records) {
+                if (record.type == type)
+                    answers.append(record);
+            }
+        }
+        if (answers.isEmpty() && !typesWithoutSoa.contains(type)) {
+            answers.append({ SOA, 30, QByteArray(2, '\0')     // root MNAME and RNAME
+                                      + QByteArray::fromHex("00000001000038400000025800093a800000001e") });
+        }
+
+        QByteArray reply = query.left(2);              // ID
+        const auto append16 = [&reply](quint16 value) {
+            reply.append(char(value >> 8)).append(char(value));
+        };
+        append16(records == zone.cend() ? 0x8183 : 0x8180);    // QR, RD, RA and RCODE
+        const bool negative = answers.isEmpty() || answers.first().type == SOA;
+        append16(1);
+        append16(negative ? 0 : answers.size());
+        append16(negative ? answers.size() : 0);
+        append16(0);
+        reply += query.mid(12, questionEnd - 12);
+        for (const Record &record : std::as_const(answers)) {
+            append16(0xc00c);                           // pointer to the question name
+            append16(record.type);
+            append16(1);                                // class IN
+            append16(record.timeToLive >> 16);
+            append16(record.timeToLive);
+            append16(record.data.size());
+            reply += record.data;
+        }
+        socket.writeDatagram(datagram.makeReply(reply));
+    }
+}
+
+void tst_QHostInfo::dnsResolver()
+{
+    QFETCH_GLOBAL(bool, cache);
+
+    DnsStubServer server;
+    QVERIFY(server.socket.bind(QHostAddress::LocalHost));
+    server.zone["dual.example"] = {
+        { DnsStubServer::AAAA, 300, QByteArray::fromHex("20010db8000000000000000000000001") },
+        { DnsStubServer::A, 300, QByteArray::fromHex("c0000201") },
+        { DnsStubServer::A, 60, QByteArray::fromHex("c0000202") },
+    };
+    server.zone["ipv4.example"] = {
+        { DnsStubServer::A, 120, QByteArray::fromHex("c0000203") },
+    };
+
+    qt_qhostinfo_use_dns_resolver(true, QHostAddress::LocalHost, server.socket.localPort());
+    const auto restore = qScopeGuard([] { qt_qhostinfo_use_dns_resolver(false); });
+
+    tst_QHostInfo_Helper helper("dual.example");
+    const auto lookup = [&helper](const char *hostName) {
+        helper.hostname = QString::fromLatin1(hostName);
+        helper.lookupDone = false;
+        helper.lookupHostNewStyle();
+        return helper.waitForResults();
+    };
+
+    // A and AAAA are asked for at the same time, and the addresses alternate
+    // between the families, starting with IPv6
+    QVERIFY(lookup("dual.example"));
+    QCOMPARE(helper.lookupResults.error(), QHostInfo::NoError);
+    const QList<QHostAddress> dualAddresses = { QHostAddress("2001:db8::1"),
+                                                QHostAddress("192.0.2.1"),
+                                                QHostAddress("192.0.2.2") };
+    QCOMPARE(helper.lookupResults.addresses(), dualAddresses);
+    QCOMPARE(server.queries, 2);
+
+    QVERIFY(lookup("dual.example"));
+    QCOMPARE(helper.lookupResults.addresses(), dualAddresses);
+    QCOMPARE(server.queries, cache ? 2 : 4);
+
+    QVERIFY(lookup("ipv4.example"));
+    QCOMPARE(helper.lookupResults.error(), QHostInfo::NoError);
+    QCOMPARE(helper.lookupResults.addresses(), QList<QHostAddress>{ QHostAddress("192.0.2.3") });
+    QCOMPARE(server.queries, cache ? 4 : 6);
+
+    // Names that don't exist are remembered too
+    QVERIFY(lookup("missing.example"));
+    QCOMPARE(helper.lookupResults.error(), QHostInfo::HostNotFound);
+    QVERIFY(lookup("missing.example"));
+    QCOMPARE(helper.lookupResults.error(), QHostInfo::HostNotFound);
+    QCOMPARE(server.queries, cache ? 6 : 10);
+
+    // NXDOMAIN applies to all types, the SOA in one of the answers is enough
+    server.typesWithoutSoa.insert(DnsStubServer::AAAA);
+    QVERIFY(lookup("gone.example"));
+    QCOMPARE(helper.lookupResults.error(), QHostInfo::HostNotFound);
+    QVERIFY(lookup("gone.example"));
+    QCOMPARE(helper.lookupResults.error(), QHostInfo::HostNotFound);
+    QCOMPARE(server.queries, cache ? 8 : 14);
+
+    // So are names without addresses, instead of being found with none.
+    // Only the hosts file and the search list could still resolve them.
+    server.zone["empty.example"] = {};
+    QVERIFY(lookup("empty.example"));
+    QCOMPARE(helper.lookupResults.error(), QHostInfo::HostNotFound);
+    QVERIFY(helper.lookupResults.addresses().isEmpty());
+    QCOMPARE(server.queries, cache ? 10 : 16);
+}
+#endif // dnslookup && libresolv
+
 void tst_QHostInfo_Helper::resultsReady(const QHostInfo &hi)
 {
     QVERIFY(QThread::currentThread() == thread());
@@ -33,6 +33,7 @@
 #endif
 #include <QRandomGenerator>
 #include <QStringList>
+#include <QTemporaryFile>
 #include <QTcpServer>
 #include <QTcpSocket>
 #ifndef QT_NO_SSL
@@ -177,6 +178,7 @@ private slots:
     void socketDiscardDataInWriteMode();
     void writeOnReadBufferOverflow();
     void readNotificationsAfterBind();
+    void transmitFile();
 
 protected slots:
     void nonBlockingIMAP_hostFound();
@@ -3217,5 +3219,60 @@ void tst_QTcpSocket::readNotificationsAfterBind()
     QCOMPARE(spyReadyRead.size(), 0);
 }
 
+void tst_QTcpSocket::transmitFile()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    QByteArray contents(3 * 1024 * 1024 + 17, Qt::Uninitialized);
+    for (qsizetype i = 0; i < contents.size(); ++i)
+        contents[i] = char(i * 7 + (i >> 12));
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(contents), contents.size());
+    QVERIFY(file.flush());
+
+    QTcpServer tcpServer;
+    QVERIFY(tcpServer.listen(QHostAddress::LocalHost));
+    std::unique_ptr<QTcpSocket> socket(newSocket());
+    socket->connectToHost(tcpServer.serverAddress(), tcpServer.serverPort());
+    QVERIFY(socket->waitForConnected(5000));
+    QVERIFY2(tcpServer.waitForNewConnection(5000), "Network timeout");
+    std::unique_ptr<QTcpSocket> peer(tcpServer.nextPendingConnection());
+    QVERIFY(peer);
+
+    QByteArray received;
+    connect(peer.get(), &QIODevice::readyRead, this, [&] { received += peer->readAll(); });
+    qint64 written = 0;
+    connect(socket.get(), &QIODevice::bytesWritten, this, [&](qint64 bytes) { written += bytes; });
+
+    const qint64 offset = 1000;
+    const qint64 length = contents.size() - 2 * offset;
+    QTest::ignoreMessage(QtWarningMsg,
+                         "QAbstractSocket::transmitFile() requires a file open for reading");
+    QVERIFY(!socket->transmitFile(nullptr));
+    QTest::ignoreMessage(QtWarningMsg,
+                         "QAbstractSocket::transmitFile() called with an invalid offset");
+    QVERIFY(!socket->transmitFile(&file, contents.size() + 1));
+
+    QCOMPARE(socket->write("head", 4), 4);
+    QVERIFY(socket->transmitFile(&file, offset, length));
+    QVERIFY(socket->bytesToWrite() >= length);
+    QTest::ignoreMessage(QtWarningMsg,
+                         "QAbstractSocket::transmitFile() called while a transmission is in progress");
+    QVERIFY(!socket->transmitFile(&file));
+    // written while the transmission is in progress, must arrive after the file
+    QCOMPARE(socket->write("tail", 4), 4);
+    socket->disconnectFromHost();
+
+    const QByteArray expected = "head" + contents.mid(offset, length) + "tail";
+    QTRY_COMPARE_WITH_TIMEOUT(received.size(), expected.size(), 30000);
+    QCOMPARE(received, expected);
+    QCOMPARE(written, expected.size());
+    QTRY_COMPARE(socket->state(), QAbstractSocket::UnconnectedState);
+    QCOMPARE(socket->bytesToWrite(), 0);
+}
+
 QTEST_MAIN(tst_QTcpSocket)
 #include "tst_qtcpsocket.moc"
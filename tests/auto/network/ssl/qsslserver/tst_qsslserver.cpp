@@ -9,6 +9,8 @@
 #include <QtNetwork/QSslServer>
 #include <QtNetwork/QSslKey>
 #include "private/qtlsbackend_p.h"
+#include "private/qtlssessioncache_p.h"
+#include "private/qsslconfiguration_p.h"
 
 class tst_QSslServer : public QObject
 {
@@ -26,6 +28,8 @@ private slots:
     void plaintextClient();
     void quietClient();
     void twoGoodAndManyBadClients();
+    void sessionResumption();
+    void refusedSessionIsRemoved();
 
 private:
     QString testDataDir;
@@ -526,6 +530,80 @@ void tst_QSslServer::twoGoodAndManyBadClients()
     QTRY_COMPARE(server.pendingConnectionAvailableSpy.size(), 2);
 }
 
+void tst_QSslServer::sessionResumption()
+{
+    if (!isTestingOpenSsl)
+        QSKIP("The session cache is only supported by the OpenSSL backend");
+
+    QSslConfiguration serverConfiguration = selfSignedServerQSslConfiguration();
+    serverConfiguration.setSslOption(QSsl::SslOptionDisableSessionCache, false);
+    SslServerSpy server(serverConfiguration);
+    QVERIFY(server.server.listen());
+
+    // Sessions of connections that only went through because errors were
+    // ignored are not cached, so the client has to trust the server:
+    QSslConfiguration clientConfiguration = QSslConfiguration::defaultConfiguration();
+    clientConfiguration.setCaCertificates(serverConfiguration.localCertificateChain());
+    clientConfiguration.setSslOption(QSsl::SslOptionDisableSessionCache, false);
+
+    QTlsSessionCache *cache = QTlsSessionCache::instance();
+    cache->clear();
+    cache->resetStatistics();
+
+    for (int i = 0; i < 2; ++i) {
+        QSslSocket client;
+        client.setSslConfiguration(clientConfiguration);
+        client.connectToHostEncrypted("127.0.0.1", server.server.serverPort(), "Qt");
+        QTRY_VERIFY(client.isEncrypted());
+        QTRY_COMPARE(server.pendingConnectionAvailableSpy.size(), i + 1);
+        // With TLS 1.3 the session only arrives after the handshake:
+        QTRY_COMPARE(cache->size(), 1);
+        QCOMPARE(QSslConfigurationPrivate::peerSessionWasShared(client.sslConfiguration()), i == 1);
+        // The cache keeps its sessions to itself:
+        QVERIFY(client.sslConfiguration().testSslOption(QSsl::SslOptionDisableSessionPersistence));
+        QVERIFY(client.sslConfiguration().sessionTicket().isEmpty());
+        delete server.server.nextPendingConnection();
+    }
+
+    const QTlsSessionCache::Statistics statistics = cache->statistics();
+    QCOMPARE(statistics.lookups, quint64(2));
+    QCOMPARE(statistics.hits, quint64(1));
+    QCOMPARE(statistics.resumptions, quint64(1));
+    QCOMPARE(statistics.hitRate(), 0.5);
+
+    // After the ticket keys were replaced, the server cannot resume the
+    // session any more:
+    server.server.rotateSessionTicketKeys();
+    QSslSocket client;
+    client.setSslConfiguration(clientConfiguration);
+    client.connectToHostEncrypted("127.0.0.1", server.server.serverPort(), "Qt");
+    QTRY_VERIFY(client.isEncrypted());
+    QVERIFY(!QSslConfigurationPrivate::peerSessionWasShared(client.sslConfiguration()));
+    QCOMPARE(cache->statistics().hits, quint64(2));
+    QCOMPARE(cache->statistics().resumptions, quint64(1));
+}
+
+void tst_QSslServer::refusedSessionIsRemoved()
+{
+    QTlsSessionCache *cache = QTlsSessionCache::instance();
+    cache->clear();
+
+    const QByteArray key = QByteArrayLiteral("key");
+    const QByteArray refused = QByteArrayLiteral("refused");
+    const QByteArray established = QByteArrayLiteral("established");
+
+    // A handshake that refused the session it was offered may already have
+    // stored the session it established instead; that one is kept:
+    cache->insert(key, established, 0);
+    cache->remove(key, refused);
+    QCOMPARE(cache->find(key), established);
+
+    cache->insert(key, refused, 0);
+    cache->remove(key, refused);
+    QVERIFY(cache->find(key).isEmpty());
+    QCOMPARE(cache->size(), 0);
+}
+
 QTEST_MAIN(tst_QSslServer)
 
 #include "tst_qsslserver.moc"
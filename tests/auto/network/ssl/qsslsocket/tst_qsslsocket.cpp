@@ -18,6 +18,7 @@
 #include <QtNetwork/qsslsocket.h>
 #include <QtNetwork/qtcpserver.h>
 #include <QtNetwork/qsslpresharedkeyauthenticator.h>
+#include <QtNetwork/qsslserver.h>
 
 #include <QtTest/private/qemulationdetector_p.h>
 
@@ -27,6 +28,7 @@
 #include <QTestEventLoop>
 #include <QSignalSpy>
 #include <QSemaphore>
+#include <QTemporaryFile>
 
 #include "private/qhostinfo_p.h"
 #include "private/qiodevice_p.h" // for QIODEVICE_BUFFERSIZE
@@ -43,6 +45,18 @@
 #include "private/qsslsocket_p.h"
 #include "private/qsslconfiguration_p.h"
 
+#ifdef Q_OS_LINUX
+#include <linux/tls.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#endif
+
 using namespace std::chrono_literals;
 
 QT_WARNING_PUSH
@@ -212,6 +226,7 @@ private slots:
     void abortOnSslErrors();
     void readFromClosedSocket();
     void writeBigChunk();
+    void kernelTlsTransmitFile();
     void blacklistedCertificates();
     void versionAccessors();
     void encryptWithoutConnecting();
@@ -3066,6 +3081,101 @@ void tst_QSslSocket::writeBigChunk()
     socket->close();
 }
 
+#ifdef Q_OS_LINUX
+static bool kernelTlsAvailable()
+{
+    // The "tls" upper layer protocol can only be set on a connected socket.
+    QTcpServer server;
+    if (!server.listen(QHostAddress::LocalHost))
+        return false;
+    QTcpSocket socket;
+    socket.connectToHost(QHostAddress::LocalHost, server.serverPort());
+    if (!socket.waitForConnected(5000))
+        return false;
+    return ::setsockopt(int(socket.socketDescriptor()), SOL_TCP, TCP_ULP, "tls",
+                        sizeof("tls")) == 0;
+}
+
+static bool hasKernelTlsTransmitKey(qintptr descriptor)
+{
+    tls12_crypto_info_aes_gcm_256 info = {};
+    socklen_t size = sizeof info;
+    return ::getsockopt(int(descriptor), SOL_TLS, TLS_TX, &info, &size) == 0
+           && info.info.version == TLS_1_3_VERSION;
+}
+#endif // Q_OS_LINUX
+
+void tst_QSslSocket::kernelTlsTransmitFile()
+{
+    if (!isTestingOpenSsl)
+        QSKIP("kernel TLS is only supported by the OpenSSL backend");
+
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    QByteArray fileData(1024 * 1024 + 12, Qt::Uninitialized);
+    QRandomGenerator::global()->fillRange(reinterpret_cast<quint32 *>(fileData.data()),
+                                          fileData.size() / int(sizeof(quint32)));
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(fileData), fileData.size());
+    QVERIFY(file.flush());
+
+    QFile keyFile(testDataDir + "certs/fluke.key");
+    QVERIFY(keyFile.open(QIODevice::ReadOnly));
+    const QList<QSslCertificate> localCert = QSslCertificate::fromPath(testDataDir + "certs/fluke.cert");
+    QVERIFY(!localCert.isEmpty());
+    QSslConfiguration serverConfiguration = QSslConfiguration::defaultConfiguration();
+    serverConfiguration.setPrivateKey(QSslKey(keyFile.readAll(), QSsl::Rsa, QSsl::Pem, QSsl::PrivateKey));
+    serverConfiguration.setLocalCertificate(localCert.first());
+    serverConfiguration.setPeerVerifyMode(QSslSocket::VerifyNone);
+
+    QSslServer server;
+    server.setSslConfiguration(serverConfiguration);
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    // Without kernel support (no tls module loaded, other platforms, TLS 1.2)
+    // this has to work exactly like a normal connection.
+    QSslSocket client;
+    QSslConfiguration configuration = client.sslConfiguration();
+    configuration.setBackendConfigurationOption("Options", QByteArray("KTLS"));
+    client.setSslConfiguration(configuration);
+    connect(&client, &QSslSocket::sslErrors, &client, [&client] { client.ignoreSslErrors(); });
+    qint64 written = 0;
+    connect(&client, &QIODevice::bytesWritten, &client, [&written](qint64 bytes) { written += bytes; });
+
+    client.connectToHostEncrypted(QHostAddress(QHostAddress::LocalHost).toString(),
+                                  server.serverPort());
+    QTRY_VERIFY_WITH_TIMEOUT(client.isEncrypted(), 10000);
+    QTRY_VERIFY(server.hasPendingConnections());
+    auto *receiver = qobject_cast<QSslSocket *>(server.nextPendingConnection());
+    QVERIFY(receiver);
+    QTRY_VERIFY(receiver->isEncrypted());
+
+#ifdef Q_OS_LINUX
+    const bool offloaded = hasKernelTlsTransmitKey(client.socketDescriptor());
+    if (client.sessionProtocol() == QSsl::TlsV1_3 && kernelTlsAvailable())
+        QVERIFY2(offloaded, "kernel TLS is available, but was not used");
+    else
+        QVERIFY(!offloaded);
+#endif
+
+    QByteArray received;
+    connect(receiver, &QIODevice::readyRead, receiver, [&] { received += receiver->readAll(); });
+
+    client.write("head");
+    QVERIFY(client.transmitFile(&file, 100));
+    client.write("tail");
+    client.disconnectFromHost();
+
+    const QByteArray expected = "head" + fileData.mid(100) + "tail";
+    QTRY_COMPARE_WITH_TIMEOUT(received.size(), expected.size(), 20000);
+    QCOMPARE(received, expected);
+    QTRY_COMPARE(written, expected.size());
+    QTRY_COMPARE(client.state(), QAbstractSocket::UnconnectedState);
+}
+
 void tst_QSslSocket::blacklistedCertificates()
 {
     QFETCH_GLOBAL(bool, setProxy);
@@ -8,6 +8,8 @@
 #include <private/qgraphicsscenebsptreeindex_p.h>
 #include <private/qgraphicssceneindex_p.h>
 #include <private/qgraphicsscenelinearindex_p.h>
+#include <private/qgraphicsscenertreeindex_p.h>
+#include <QtCore/qrandom.h>
 #include <QtWidgets/private/qapplication_p.h>
 
 class tst_QGraphicsSceneIndex : public QObject
@@ -29,10 +31,12 @@ private slots:
     void boundingRectPointIntersection();
     void removeItems();
     void clear();
+    void rtreeUpdates();
 
 private:
     void common_data();
     QGraphicsSceneIndex *createIndex(const QString &name);
+    static QGraphicsScene::ItemIndexMethod itemIndexMethod(const QString &name);
 };
 
 void tst_QGraphicsSceneIndex::initTestCase()
@@ -45,6 +49,7 @@ void tst_QGraphicsSceneIndex::common_data()
 
     QTest::newRow("BSP") << QString("bsp");
     QTest::newRow("Linear") << QString("linear");
+    QTest::newRow("RTree") << QString("rtree");
 }
 
 QGraphicsSceneIndex *tst_QGraphicsSceneIndex::createIndex(const QString &indexMethod)
@@ -57,9 +62,21 @@ QGraphicsSceneIndex *tst_QGraphicsSceneIndex::createIndex(const QString &indexMe
     if (indexMethod == "linear")
         index = new QGraphicsSceneLinearIndex(scene);
 
+    if (indexMethod == "rtree")
+        index = new QGraphicsSceneRTreeIndex(scene);
+
     return index;
 }
 
+QGraphicsScene::ItemIndexMethod tst_QGraphicsSceneIndex::itemIndexMethod(const QString &name)
+{
+    if (name == "linear")
+        return QGraphicsScene::NoIndex;
+    if (name == "rtree")
+        return QGraphicsScene::RTreeIndex;
+    return QGraphicsScene::BspTreeIndex;
+}
+
 void tst_QGraphicsSceneIndex::scatteredItems_data()
 {
     common_data();
@@ -70,7 +87,7 @@ void tst_QGraphicsSceneIndex::scatteredItems()
     QFETCH(QString, indexMethod);
 
     QGraphicsScene scene;
-    scene.setItemIndexMethod(indexMethod == "linear" ? QGraphicsScene::NoIndex : QGraphicsScene::BspTreeIndex);
+    scene.setItemIndexMethod(itemIndexMethod(indexMethod));
 
     for (int i = 0; i < 10; ++i)
         scene.addRect(i*50, i*50, 40, 35);
@@ -94,7 +111,7 @@ void tst_QGraphicsSceneIndex::overlappedItems()
     QFETCH(QString, indexMethod);
 
     QGraphicsScene scene;
-    scene.setItemIndexMethod(indexMethod == "linear" ? QGraphicsScene::NoIndex : QGraphicsScene::BspTreeIndex);
+    scene.setItemIndexMethod(itemIndexMethod(indexMethod));
 
     for (int i = 0; i < 10; ++i)
         for (int j = 0; j < 10; ++j)
@@ -123,7 +140,7 @@ void tst_QGraphicsSceneIndex::movingItems()
     QFETCH(QString, indexMethod);
 
     QGraphicsScene scene;
-    scene.setItemIndexMethod(indexMethod == "linear" ? QGraphicsScene::NoIndex : QGraphicsScene::BspTreeIndex);
+    scene.setItemIndexMethod(itemIndexMethod(indexMethod));
 
     for (int i = 0; i < 10; ++i)
         scene.addRect(i*50, i*50, 40, 35);
@@ -333,5 +350,64 @@ void tst_QGraphicsSceneIndex::clear()
     QTRY_VERIFY(item->numPaints > 0);
 }
 
+void tst_QGraphicsSceneIndex::rtreeUpdates()
+{
+    QRandomGenerator random(42);
+    const auto randomRect = [&random] {
+        return QRectF(random.bounded(10000), random.bounded(10000),
+                      random.bounded(1, 50), random.bounded(1, 50));
+    };
+
+    // Bulk loading and incremental updates must keep the tree balanced and
+    // every leaf must cover its item.
+    QGraphicsScene scene;
+    scene.setItemIndexMethod(QGraphicsScene::RTreeIndex);
+    QList<QGraphicsRectItem *> rects;
+    for (int i = 0; i < 2000; ++i)
+        rects << scene.addRect(randomRect());
+    QCOMPARE(scene.items(QRectF(-1, -1, 10100, 10100)).size(), 2000);
+
+    for (int round = 0; round < 5; ++round) {
+        for (int i = 0; i < 500; ++i)
+            rects.at(random.bounded(rects.size()))->setRect(randomRect());
+        for (int i = 0; i < 100; ++i)
+            delete rects.takeAt(random.bounded(rects.size()));
+        for (int i = 0; i < 100; ++i)
+            rects << scene.addRect(randomRect());
+
+        for (int i = 0; i < 50; ++i) {
+            const QRectF area = randomRect().adjusted(0, 0, 500, 500);
+            QSet<QGraphicsItem *> expected;
+            for (QGraphicsRectItem *rect : std::as_const(rects)) {
+                if (rect->sceneBoundingRect().intersects(area))
+                    expected.insert(rect);
+            }
+            const QList<QGraphicsItem *> found = scene.items(area, Qt::IntersectsItemBoundingRect);
+            QCOMPARE(QSet<QGraphicsItem *>(found.cbegin(), found.cend()), expected);
+        }
+    }
+
+    QGraphicsSceneRTree tree;
+    QList<QGraphicsSceneRTree::Entry> entries;
+    for (int i = 0; i < 1000; ++i)
+        entries.append({randomRect(), reinterpret_cast<QGraphicsItem *>(quintptr(i + 1) * 8)});
+    tree.bulkLoad(std::move(entries));
+    QCOMPARE(tree.leafCount(), 1000);
+    QList<int> leaves;
+    tree.forEachLeaf([&leaves](QGraphicsItem *, int leaf) { leaves.append(leaf); });
+    QCOMPARE(leaves.size(), 1000);
+    for (int i = 0; i < 700; ++i)
+        tree.remove(leaves.takeAt(random.bounded(leaves.size())));
+    for (int i = 0; i < 5000; ++i) {
+        const QRectF rect = randomRect();
+        const int leaf = leaves.at(random.bounded(leaves.size()));
+        tree.move(leaf, rect);
+        QVERIFY(tree.leafRect(leaf).contains(rect));
+    }
+    QCOMPARE(tree.leafCount(), 300);
+    // An AVL balanced tree with n leaves has a height below 1.44 * log2(n).
+    QVERIFY2(tree.height() <= 12, QByteArray::number(tree.height()));
+}
+
 QTEST_MAIN(tst_QGraphicsSceneIndex)
 #include "tst_qgraphicssceneindex.moc"
@@ -239,6 +239,7 @@ private slots:
     void setSectionResizeModeWithSectionWillTakeMemory();
 
     void setDefaultSectionSizeRespectsColumnWidth();
+    void resizeManySectionsToContents();
 
 protected:
     void setupTestData(bool use_reset_model = false);
@@ -3856,5 +3857,65 @@ void tst_QHeaderView::setDefaultSectionSizeRespectsColumnWidth()
         QTRY_COMPARE(tree.columnWidth(c), columnWidths[c]);
 }
 
+void tst_QHeaderView::resizeManySectionsToContents()
+{
+    // more sections than are measured in one pass
+    const int rowCount = 10 * QHeaderViewPrivate::IncrementalResizeMinimum;
+    QStandardItemModel model(rowCount, 1);
+    for (int row = 0; row < rowCount; ++row)
+        model.setData(model.index(row, 0), QSize(40, 60 + (row % 3) * 10), Qt::SizeHintRole);
+
+    QTableView view;
+    view.setModel(&model);
+    QHeaderView *header = view.verticalHeader();
+    header->setSectionResizeMode(QHeaderView::ResizeToContents);
+    view.resize(200, 300);
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    const auto expectedSize = [&](int row) {
+        return qMax(static_cast<QAbstractItemView &>(view).sizeHintForRow(row), header->sectionSizeHint(row));
+    };
+    auto *d = static_cast<QHeaderViewPrivate *>(QObjectPrivate::get(header));
+    QTRY_VERIFY(!d->delayedResize.isActive() && !d->incrementalResize.isActive());
+    int length = 0;
+    for (int row = 0; row < rowCount; ++row) {
+        QCOMPARE(header->sectionSize(row), expectedSize(row));
+        length += expectedSize(row);
+    }
+    QCOMPARE(header->length(), length);
+
+    // a posted resize measures the sections in passes of the event loop, the
+    // sections in view first; the view itself asks for section sizes as soon
+    // as the model changes, so post it directly and run the first pass only
+    {
+        const QSignalBlocker blocker(&model);
+        model.setData(model.index(rowCount - 1, 0), QSize(40, 100), Qt::SizeHintRole);
+    }
+    d->doDelayedResizeSections();
+    QTimerEvent firstPass(d->delayedResize.timerId());
+    QCoreApplication::sendEvent(header, &firstPass);
+    QVERIFY(!d->delayedResize.isActive());
+    QVERIFY(d->incrementalResize.isActive());
+    QCOMPARE(header->sectionSize(0), expectedSize(0));
+
+    // asking for sizes does not finish the passes
+    header->length();
+    QVERIFY(d->incrementalResize.isActive());
+    QTRY_VERIFY(!d->incrementalResize.isActive());
+    QCOMPARE(header->sectionSize(rowCount - 1), expectedSize(rowCount - 1));
+    QCOMPARE_GE(header->sectionSize(rowCount - 1), 100);
+
+    // but a resize that is only posted is done right away
+    {
+        const QSignalBlocker blocker(&model);
+        model.setData(model.index(0, 0), QSize(40, 100), Qt::SizeHintRole);
+    }
+    d->doDelayedResizeSections();
+    QCOMPARE(header->sectionSize(0), expectedSize(0));
+    QCOMPARE_GE(header->sectionSize(0), 100);
+    QVERIFY(!d->incrementalResize.isActive());
+}
+
 QTEST_MAIN(tst_QHeaderView)
 #include "tst_qheaderview.moc"
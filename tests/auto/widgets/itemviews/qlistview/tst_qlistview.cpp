@@ -103,6 +103,7 @@ private slots:
     void modelColumn();
     void hideFirstRow();
     void batchedMode();
+    void batchedModeScrollRange();
     void setCurrentIndex();
     void selection_data();
     void selection();
@@ -888,6 +889,38 @@ void tst_QListView::batchedMode()
     QTRY_COMPARE(modelIndexCount(&view), rowCount);
 }
 
+void tst_QListView::batchedModeScrollRange()
+{
+    QStringListModel model(generateList(QLatin1String("item "), 5000));
+    QListView reference;
+    reference.setModel(&model);
+    reference.setUniformItemSizes(true);
+    reference.resize(200, 300);
+    reference.show();
+
+    QListView view;
+    view.setModel(&model);
+    view.setUniformItemSizes(true);
+    view.setLayoutMode(QListView::Batched);
+    view.setBatchSize(10);
+    view.resize(200, 300);
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&reference));
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    QTRY_COMPARE(view.verticalScrollBar()->maximum(), reference.verticalScrollBar()->maximum());
+    QCOMPARE(modelIndexCount(&view), modelIndexCount(&reference));
+
+    // a reset while items are laid out starts the layout over
+    model.setStringList(generateList(QLatin1String("other "), 3000));
+    QCoreApplication::processEvents();
+    model.setStringList(generateList(QLatin1String("item "), 800));
+    // lay out the reference now, so that its scroll range is not the old one
+    reference.doItemsLayout();
+    QTRY_COMPARE(view.verticalScrollBar()->maximum(), reference.verticalScrollBar()->maximum());
+    QCOMPARE(modelIndexCount(&view), modelIndexCount(&reference));
+}
+
 void tst_QListView::setCurrentIndex()
 {
     QStringListModel model(generateList(QLatin1String("item "), 20));
@@ -231,6 +231,7 @@ private slots:
     void testInitialFocus();
     void fetchUntilScreenFull();
     void expandAfterTake();
+    void variableRowHeightsPerPixel();
 };
 
 class QtTestModel: public QAbstractItemModel
@@ -5264,5 +5265,60 @@ void tst_QTreeView::expandAfterTake()
     populateModel(&model); // populate model again, having corrupted items inside QTreeViewPrivate::expandedIndexes
     view.expandAll(); // adding new items to QTreeViewPrivate::expandedIndexes with corrupted persistent indices, causing crash sometimes
 }
+
+void tst_QTreeView::variableRowHeightsPerPixel()
+{
+    QStandardItemModel model;
+    for (int i = 0; i < 40; ++i) {
+        auto parent = new QStandardItem(QString::number(i));
+        parent->setData(QSize(50, 10 + (i % 7) * 3), Qt::SizeHintRole);
+        for (int j = 0; j < 25; ++j) {
+            auto child = new QStandardItem(QString::number(j));
+            child->setData(QSize(50, 12 + (j % 5) * 4), Qt::SizeHintRole);
+            parent->appendRow(child);
+        }
+        model.appendRow(parent);
+    }
+
+    QTreeView view;
+    view.setModel(&model);
+    view.setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    view.resize(300, 400);
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    const auto verifyPositions = [&] {
+        view.verticalScrollBar()->setValue(view.verticalScrollBar()->maximum() / 2);
+        const int offset = view.verticalScrollBar()->value();
+        int y = 0;
+        for (QModelIndex index = model.index(0, 0); index.isValid(); index = view.indexBelow(index)) {
+            const QRect rect = view.visualRect(index);
+            QCOMPARE(rect.top(), y - offset);
+            QCOMPARE(rect.height(), index.data(Qt::SizeHintRole).toSize().height());
+            if (rect.bottom() >= 0 && rect.top() < view.viewport()->height())
+                QCOMPARE(view.indexAt(QPoint(5, rect.center().y())), index);
+            y += rect.height();
+        }
+        QCOMPARE(view.verticalScrollBar()->maximum(), y - view.viewport()->height());
+        QVERIFY(!view.indexAt(QPoint(5, y - offset)).isValid());
+    };
+
+    verifyPositions();
+    view.expand(model.index(3, 0));
+    view.expand(model.index(17, 0));
+    verifyPositions();
+    model.item(17)->child(4)->setData(QSize(50, 70), Qt::SizeHintRole);
+    model.item(30)->setData(QSize(50, 45), Qt::SizeHintRole);
+    verifyPositions();
+    view.collapse(model.index(3, 0));
+    model.item(2)->removeRow(0);
+    auto inserted = new QStandardItem("new");
+    inserted->setData(QSize(50, 33), Qt::SizeHintRole);
+    model.item(17)->insertRow(0, inserted);
+    verifyPositions();
+    view.expandAll();
+    verifyPositions();
+}
+
 QTEST_MAIN(tst_QTreeView)
 #include "tst_qtreeview.moc"
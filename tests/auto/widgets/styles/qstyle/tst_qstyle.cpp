@@ -73,6 +73,9 @@ private slots:
     void sliderPositionFromValue();
     void sliderValueFromPosition_data();
     void sliderValueFromPosition();
+
+    void viewItemTextCache_data();
+    void viewItemTextCache();
 private:
     bool testAllFunctions(QStyle *);
     bool testScrollBarSubControls(const QStyle *style);
@@ -751,5 +754,69 @@ void tst_QStyle::sliderValueFromPosition()
     QCOMPARE(QStyle::sliderValueFromPosition(min, max, position, span, upsideDown), value);
 }
 
+void tst_QStyle::viewItemTextCache_data()
+{
+    QTest::addColumn<QString>("text");
+    QTest::addColumn<bool>("wrapText");
+    QTest::addColumn<Qt::Alignment>("alignment");
+    QTest::addColumn<Qt::LayoutDirection>("direction");
+    QTest::addColumn<Qt::TextElideMode>("elideMode");
+
+    const QString longText = QStringLiteral("The quick brown fox jumps over the lazy dog");
+    QTest::newRow("short") << QStringLiteral("Item") << false
+                           << Qt::Alignment(Qt::AlignLeft | Qt::AlignVCenter)
+                           << Qt::LeftToRight << Qt::ElideRight;
+    QTest::newRow("elided") << longText << false
+                            << Qt::Alignment(Qt::AlignLeft | Qt::AlignVCenter)
+                            << Qt::LeftToRight << Qt::ElideMiddle;
+    QTest::newRow("wrapped") << longText << true
+                             << Qt::Alignment(Qt::AlignHCenter | Qt::AlignTop)
+                             << Qt::LeftToRight << Qt::ElideRight;
+    QTest::newRow("right-to-left") << longText << false
+                                   << Qt::Alignment(Qt::AlignRight | Qt::AlignBottom)
+                                   << Qt::RightToLeft << Qt::ElideLeft;
+}
+
+void tst_QStyle::viewItemTextCache()
+{
+    QFETCH(QString, text);
+    QFETCH(bool, wrapText);
+    QFETCH(Qt::Alignment, alignment);
+    QFETCH(Qt::LayoutDirection, direction);
+    QFETCH(Qt::TextElideMode, elideMode);
+
+    QStyleOptionViewItem option;
+    option.text = text;
+    option.features = QStyleOptionViewItem::HasDisplay;
+    if (wrapText)
+        option.features |= QStyleOptionViewItem::WrapText;
+    option.displayAlignment = alignment;
+    option.direction = direction;
+    option.textElideMode = elideMode;
+    option.state = QStyle::State_Enabled;
+    option.palette = QApplication::palette();
+    option.font = QApplication::font();
+    option.fontMetrics = QFontMetrics(option.font);
+
+    const auto draw = [&option](const QStyle &style, const QPoint &position) {
+        QImage image(200, 100, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::white);
+        QPainter painter(&image);
+        option.rect = QRect(position, QSize(120, 40));
+        style.drawControl(QStyle::CE_ItemViewItem, &option, &painter);
+        return image;
+    };
+
+    // the first drawing lays the text out, the others draw the cached layout
+    QCommonStyle style;
+    const QImage uncached = draw(style, QPoint(10, 10));
+    QCOMPARE(draw(style, QPoint(10, 10)), uncached);
+
+    // the cached layout is placed relative to the item
+    const QImage moved = draw(style, QPoint(60, 50));
+    QCOMPARE(moved.copy(60, 50, 120, 40), uncached.copy(10, 10, 120, 40));
+    QCOMPARE(draw(QCommonStyle(), QPoint(60, 50)), moved);
+}
+
 QTEST_MAIN(tst_QStyle)
 #include "tst_qstyle.moc"
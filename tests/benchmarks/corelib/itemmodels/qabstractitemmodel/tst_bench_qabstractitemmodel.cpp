@@ -0,0 +1,144 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QAbstractItemModel>
+#include <QList>
+#include <QPersistentModelIndex>
+#include <QTest>
+
+// Groups of rows below the root. The internal id of a row is the row of its
+// group plus one; the groups themselves have the id 0.
+class GroupModel : public QAbstractItemModel
+{
+public:
+    GroupModel(int groups, int rowsPerGroup) : sizes(groups, rowsPerGroup) {}
+
+    QModelIndex index(int row, int column, const QModelIndex &parent = {}) const override
+    {
+        if (!hasIndex(row, column, parent))
+            return {};
+        return createIndex(row, column, parent.isValid() ? quintptr(parent.row() + 1) : quintptr(0));
+    }
+    QModelIndex parent(const QModelIndex &child) const override
+    {
+        if (!child.isValid() || child.internalId() == 0)
+            return {};
+        return createIndex(int(child.internalId() - 1), 0, quintptr(0));
+    }
+    int rowCount(const QModelIndex &parent = {}) const override
+    {
+        if (!parent.isValid())
+            return int(sizes.size());
+        return parent.internalId() == 0 && parent.column() == 0 ? sizes.at(parent.row()) : 0;
+    }
+    int columnCount(const QModelIndex & = {}) const override { return 1; }
+    QVariant data(const QModelIndex &, int) const override { return {}; }
+
+    void insertRowsInGroup(int group, int row, int count)
+    {
+        beginInsertRows(index(group, 0), row, row + count - 1);
+        sizes[group] += count;
+        endInsertRows();
+    }
+    void removeRowsFromGroup(int group, int row, int count)
+    {
+        beginRemoveRows(index(group, 0), row, row + count - 1);
+        sizes[group] -= count;
+        endRemoveRows();
+    }
+    void moveRowInGroup(int group, int from, int to)
+    {
+        const QModelIndex parent = index(group, 0);
+        beginMoveRows(parent, from, from, parent, to);
+        endMoveRows();
+    }
+
+private:
+    QList<int> sizes;
+};
+
+class tst_QAbstractItemModel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void insertRemoveRows_data() { addPersistentColumns(); }
+    void insertRemoveRows();
+    void moveRows_data() { addPersistentColumns(); }
+    void moveRows();
+
+private:
+    static void addPersistentColumns();
+    static QList<QPersistentModelIndex> makePersistent(const GroupModel &model, int count);
+
+    static constexpr int Groups = 1000;
+    static constexpr int RowsPerGroup = 200;
+};
+
+void tst_QAbstractItemModel::addPersistentColumns()
+{
+    QTest::addColumn<int>("persistentCount");
+
+    QTest::newRow("no persistent indexes") << 0;
+    QTest::newRow("1K persistent indexes") << 1'000;
+    QTest::newRow("200K persistent indexes") << Groups * RowsPerGroup;
+}
+
+// Makes persistent indexes for \a count rows, spread over all groups.
+QList<QPersistentModelIndex> tst_QAbstractItemModel::makePersistent(const GroupModel &model, int count)
+{
+    QList<QPersistentModelIndex> persistent;
+    persistent.reserve(count);
+    const int perGroup = count / Groups;
+    for (int group = 0; group < Groups; ++group) {
+        const QModelIndex parent = model.index(group, 0);
+        persistent << QPersistentModelIndex(parent);
+        for (int row = 0; row < perGroup; ++row)
+            persistent << QPersistentModelIndex(model.index(row * RowsPerGroup / perGroup, 0, parent));
+    }
+    return persistent;
+}
+
+void tst_QAbstractItemModel::insertRemoveRows()
+{
+    QFETCH(int, persistentCount);
+
+    GroupModel model(Groups, RowsPerGroup);
+    const QList<QPersistentModelIndex> persistent = makePersistent(model, persistentCount);
+    const QModelIndex last = persistent.last();
+
+    int group = 0;
+    QBENCHMARK {
+        for (int i = 0; i < 100; ++i) {
+            group = (group + 7) % Groups;
+            model.insertRowsInGroup(group, RowsPerGroup / 2, 1);
+            model.removeRowsFromGroup(group, RowsPerGroup / 2, 1);
+        }
+    }
+
+    QCOMPARE(persistent.last(), last);
+}
+
+void tst_QAbstractItemModel::moveRows()
+{
+    QFETCH(int, persistentCount);
+
+    GroupModel model(Groups, RowsPerGroup);
+    const QList<QPersistentModelIndex> persistent = makePersistent(model, persistentCount);
+    const QModelIndex last = persistent.last();
+
+    int group = 0;
+    QBENCHMARK {
+        for (int i = 0; i < 100; ++i) {
+            group = (group + 7) % Groups;
+            model.moveRowInGroup(group, 10, 20);
+            model.moveRowInGroup(group, 19, 10);
+        }
+    }
+
+    QCOMPARE(persistent.last(), last);
+}
+
+QTEST_MAIN(tst_QAbstractItemModel)
+
+#include "tst_bench_qabstractitemmodel.moc"
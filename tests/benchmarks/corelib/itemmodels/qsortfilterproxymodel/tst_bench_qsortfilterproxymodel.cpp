@@ -1,6 +1,8 @@
 // Copyright (C) 2021 Igor Kushnir <igorkuo@gmail.com>
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
 
+#include <QAbstractListModel>
+#include <QCoreApplication>
 #include <QSortFilterProxyModel>
 #include <QString>
 #include <QStringList>
@@ -25,6 +27,41 @@ static void resizeNumberList(QStringList &numberList, int size)
         QCOMPARE(numberList.constLast(), QString::number(numberList.size()));
 }
 
+// A list of numbers that grows at the end, like the model of a log viewer.
+class NumberLogModel : public QAbstractListModel
+{
+public:
+    int rowCount(const QModelIndex &parent = {}) const override
+    {
+        return parent.isValid() ? 0 : int(numbers.size());
+    }
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override
+    {
+        return role == Qt::DisplayRole ? QVariant(numbers.at(index.row())) : QVariant();
+    }
+
+    void append(int number)
+    {
+        beginInsertRows({}, int(numbers.size()), int(numbers.size()));
+        numbers.append(number);
+        endInsertRows();
+    }
+    void replace(int row, int number)
+    {
+        numbers[row] = number;
+        emit dataChanged(index(row), index(row));
+    }
+
+private:
+    QList<int> numbers;
+};
+
+static int pseudoRandom(quint32 &seed)
+{
+    seed = seed * 1664525u + 1013904223u;
+    return int(seed >> 8);
+}
+
 class tst_QSortFilterProxyModel : public QObject
 {
     Q_OBJECT
@@ -32,6 +69,10 @@ private slots:
     void clearFilter_data();
     void clearFilter();
     void setSourceModel();
+    void streamingInserts_data();
+    void streamingInserts();
+    void resortChangedRows_data();
+    void resortChangedRows();
 
 private:
     QStringList m_numberList; ///< Cache the strings for efficiency.
@@ -107,6 +148,77 @@ void tst_QSortFilterProxyModel::setSourceModel()
     }
 }
 
+void tst_QSortFilterProxyModel::streamingInserts_data()
+{
+    QTest::addColumn<int>("itemCount");
+    QTest::addColumn<QSortFilterProxyModel::SortFilterHints>("hints");
+
+    for (int thousandItemCount : { 10, 100, 1000 }) {
+        QTest::addRow("%dK", thousandItemCount)
+                << thousandItemCount * 1000 << QSortFilterProxyModel::SortFilterHints();
+        QTest::addRow("%dK, incremental", thousandItemCount)
+                << thousandItemCount * 1000
+                << QSortFilterProxyModel::SortFilterHints(QSortFilterProxyModel::IncrementalUpdates);
+    }
+}
+
+void tst_QSortFilterProxyModel::streamingInserts()
+{
+    QFETCH(const int, itemCount);
+    QFETCH(const QSortFilterProxyModel::SortFilterHints, hints);
+
+    quint32 seed = 1;
+    NumberLogModel model;
+    for (int i = 0; i < itemCount; ++i)
+        model.append(pseudoRandom(seed));
+
+    QSortFilterProxyModel proxy;
+    proxy.setSortFilterHints(hints);
+    proxy.setSourceModel(&model);
+    proxy.sort(0);
+    QCOMPARE(proxy.rowCount(), itemCount);
+
+    // One second of a log that gets a thousand lines per second, delivered
+    // in batches of 50 rows per event loop pass.
+    QBENCHMARK_ONCE {
+        for (int batch = 0; batch < 20; ++batch) {
+            for (int i = 0; i < 50; ++i)
+                model.append(pseudoRandom(seed));
+            QCoreApplication::processEvents();
+        }
+    }
+    QCOMPARE(proxy.rowCount(), itemCount + 1000);
+}
+
+void tst_QSortFilterProxyModel::resortChangedRows_data()
+{
+    streamingInserts_data();
+}
+
+void tst_QSortFilterProxyModel::resortChangedRows()
+{
+    QFETCH(const int, itemCount);
+    QFETCH(const QSortFilterProxyModel::SortFilterHints, hints);
+
+    quint32 seed = 1;
+    NumberLogModel model;
+    for (int i = 0; i < itemCount; ++i)
+        model.append(pseudoRandom(seed));
+
+    QSortFilterProxyModel proxy;
+    proxy.setSortFilterHints(hints);
+    proxy.setSourceModel(&model);
+    proxy.sort(0);
+    // Keep some persistent indexes alive, as views and selections do
+    QList<QPersistentModelIndex> persistent;
+    for (int row = 0; row < itemCount; row += 100)
+        persistent.append(proxy.index(row, 0));
+
+    QBENCHMARK {
+        model.replace(pseudoRandom(seed) % itemCount, pseudoRandom(seed));
+    }
+}
+
 QTEST_MAIN(tst_QSortFilterProxyModel)
 
 #include "tst_bench_qsortfilterproxymodel.moc"
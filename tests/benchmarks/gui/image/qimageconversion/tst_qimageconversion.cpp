@@ -3,6 +3,7 @@
 
 #include <qtest.h>
 #include <QImage>
+#include <QMetaEnum>
 
 Q_DECLARE_METATYPE(QImage::Format)
 
@@ -31,6 +32,9 @@ private slots:
     void convertGenericInplace_data();
     void convertGenericInplace();
 
+    void convertAllFormats_data();
+    void convertAllFormats();
+
 private:
     QImage generateImageRgb888(int width, int height);
     QImage generateImageRgb16(int width, int height);
@@ -368,6 +372,41 @@ void tst_QImageConversion::convertGenericInplace()
     }
 }
 
+void tst_QImageConversion::convertAllFormats_data()
+{
+    QTest::addColumn<QImage>("inputImage");
+    QTest::addColumn<QImage::Format>("outputFormat");
+
+    // A smaller image than the other tests, as this covers every pair of
+    // formats. Odd sizes also run the scalar tails of the SIMD converters.
+    const QImage argb32 = generateImageArgb32(255, 255);
+    const QMetaEnum formats = QMetaEnum::fromType<QImage::Format>();
+
+    for (int i = QImage::Format_Mono; i < QImage::NImageFormats; ++i) {
+        const QImage::Format inputFormat = QImage::Format(i);
+        const QImage inputImage = argb32.convertToFormat(inputFormat);
+        for (int j = QImage::Format_Mono; j < QImage::NImageFormats; ++j) {
+            const QImage::Format outputFormat = QImage::Format(j);
+            if (inputFormat == outputFormat)
+                continue;
+            QTest::addRow("%s -> %s", formats.valueToKey(inputFormat),
+                          formats.valueToKey(outputFormat))
+                    << inputImage << outputFormat;
+        }
+    }
+}
+
+void tst_QImageConversion::convertAllFormats()
+{
+    QFETCH(QImage, inputImage);
+    QFETCH(QImage::Format, outputFormat);
+
+    QBENCHMARK {
+        QImage output = inputImage.convertToFormat(outputFormat);
+        output.constBits();
+    }
+}
+
 /*
  Fill a RGB888 image with "random" pixel values.
  */
@@ -3,7 +3,9 @@
 // This file contains benchmarks for QRegion functions.
 
 #include <QDebug>
+#include <qrandom.h>
 #include <qtest.h>
+#include <private/qregion_p.h>
 
 class tst_qregion : public QObject
 {
@@ -14,8 +16,44 @@ private slots:
 
     void intersects_data();
     void intersects();
+
+    void united_data();
+    void united();
+    void fromRects_data();
+    void fromRects();
+    void intersected_data();
+    void intersected();
+    void simplified_data();
+    void simplified();
 };
 
+// The dirty rectangles of many small, independently updated widgets
+static QList<QRect> dirtyRects(int count, bool overlapping)
+{
+    QRandomGenerator generator(42);
+    QList<QRect> rects;
+    rects.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        if (overlapping) {
+            rects << QRect(generator.bounded(1920), generator.bounded(1080),
+                           generator.bounded(8, 64), generator.bounded(8, 32));
+        } else {
+            rects << QRect((i % 80) * 24, (i / 80) * 18, 22, 16);
+        }
+    }
+    return rects;
+}
+
+static void addDirtyRectsData()
+{
+    QTest::addColumn<QList<QRect>>("rects");
+
+    for (int count : { 100, 1000, 4000 }) {
+        QTest::addRow("grid %d", count) << dirtyRects(count, false);
+        QTest::addRow("overlapping %d", count) << dirtyRects(count, true);
+    }
+}
+
 
 void tst_qregion::map_data()
 {
@@ -96,6 +134,79 @@ void tst_qregion::intersects()
     }
 }
 
+void tst_qregion::united_data()
+{
+    addDirtyRectsData();
+}
+
+void tst_qregion::united()
+{
+    QFETCH(QList<QRect>, rects);
+
+    QBENCHMARK {
+        QRegion region;
+        for (const QRect &rect : std::as_const(rects))
+            region += rect;
+    }
+}
+
+void tst_qregion::fromRects_data()
+{
+    addDirtyRectsData();
+}
+
+void tst_qregion::fromRects()
+{
+    QFETCH(QList<QRect>, rects);
+
+    QRegion region;
+    QBENCHMARK {
+        region = qt_regionFromRects(rects);
+    }
+}
+
+void tst_qregion::intersected_data()
+{
+    addDirtyRectsData();
+}
+
+void tst_qregion::intersected()
+{
+    QFETCH(QList<QRect>, rects);
+
+    const QRegion region = qt_regionFromRects(rects);
+    const QRegion other = region.translated(5, 3);
+    QRegion result;
+    QBENCHMARK {
+        result = region.intersected(other);
+    }
+}
+
+void tst_qregion::simplified_data()
+{
+    QTest::addColumn<QList<QRect>>("rects");
+    QTest::addColumn<qreal>("maxWaste");
+
+    for (int count : { 1000, 4000 }) {
+        for (qreal maxWaste : { 0.1, 0.5 }) {
+            QTest::addRow("grid %d, %g", count, maxWaste) << dirtyRects(count, false) << maxWaste;
+            QTest::addRow("overlapping %d, %g", count, maxWaste) << dirtyRects(count, true) << maxWaste;
+        }
+    }
+}
+
+void tst_qregion::simplified()
+{
+    QFETCH(QList<QRect>, rects);
+    QFETCH(qreal, maxWaste);
+
+    const QRegion region = qt_regionFromRects(rects);
+    QRegion simplified;
+    QBENCHMARK {
+        simplified = qt_regionSimplified(region, maxWaste);
+    }
+}
+
 QTEST_MAIN(tst_qregion)
 
 #include "main.moc"
@@ -0,0 +1,156 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtNetwork/private/bitstreams_p.h>
+#include <QtNetwork/private/hpack_p.h>
+
+#include <QtCore/qbytearray.h>
+#include <QTest>
+
+#include <vector>
+
+using namespace HPack;
+
+class tst_Hpack : public QObject
+{
+    Q_OBJECT
+private slots:
+    void huffmanEncode_data() { stringData(); }
+    void huffmanEncode();
+    void huffmanDecode_data() { stringData(); }
+    void huffmanDecode();
+
+    void encodeRequest_data() { requestData(); }
+    void encodeRequest();
+    void decodeRequest_data() { requestData(); }
+    void decodeRequest();
+
+private:
+    void stringData();
+    void requestData();
+
+    static HttpHeader grpcRequest(int streamNumber);
+};
+
+void tst_Hpack::stringData()
+{
+    QTest::addColumn<QByteArray>("string");
+
+    QTest::newRow("short-token") << QByteArray("application/grpc");
+    QTest::newRow("path") << QByteArray("/helloworld.Greeter/SayHello");
+    QTest::newRow("user-agent")
+            << QByteArray("grpc-c++/1.62.0 grpc-c/39.0.0 (linux; chttp2; gnarly)");
+    QTest::newRow("cookie")
+            << QByteArray("session=8f2e0b3c9a7d4e6f1a2b3c4d5e6f7a8b; theme=dark; "
+                          "_ga=GA1.2.1234567890.1234567890; consent=yes").repeated(4);
+    QByteArray binary(1024, Qt::Uninitialized);
+    for (qsizetype i = 0; i < binary.size(); ++i)
+        binary[i] = char(i * 31);
+    QTest::newRow("binary-1k") << binary;
+}
+
+void tst_Hpack::huffmanEncode()
+{
+    QFETCH(const QByteArray, string);
+
+    std::vector<uchar> buffer;
+    BitOStream out(buffer);
+    QBENCHMARK {
+        out.clear();
+        for (int i = 0; i < 100; ++i)
+            out.write(string, true);
+    }
+}
+
+void tst_Hpack::huffmanDecode()
+{
+    QFETCH(const QByteArray, string);
+
+    std::vector<uchar> buffer;
+    BitOStream out(buffer);
+    for (int i = 0; i < 100; ++i)
+        out.write(string, true);
+
+    QByteArray decoded;
+    QBENCHMARK {
+        BitIStream in(out.begin(), out.end());
+        for (int i = 0; i < 100; ++i) {
+            if (!in.read(&decoded))
+                QFAIL("decoding failed");
+        }
+    }
+    QCOMPARE(decoded, string);
+}
+
+HttpHeader tst_Hpack::grpcRequest(int streamNumber)
+{
+    // What a unary gRPC call over a shared connection typically sends:
+    return {
+        {":method", "POST"},
+        {":scheme", "https"},
+        {":path", "/helloworld.Greeter/SayHello"},
+        {":authority", "backend.example.com:443"},
+        {"content-type", "application/grpc"},
+        {"user-agent", "grpc-c++/1.62.0 grpc-c/39.0.0 (linux; chttp2)"},
+        {"te", "trailers"},
+        {"grpc-accept-encoding", "identity, deflate, gzip"},
+        {"grpc-timeout", "99948m"},
+        {"x-request-id", QByteArray::number(0x5eed0000 + streamNumber, 16)},
+    };
+}
+
+void tst_Hpack::requestData()
+{
+    QTest::addColumn<bool>("compressStrings");
+
+    QTest::newRow("huffman") << true;
+    QTest::newRow("plain") << false;
+}
+
+void tst_Hpack::encodeRequest()
+{
+    QFETCH(const bool, compressStrings);
+
+    std::vector<HttpHeader> requests;
+    for (int i = 0; i < 1000; ++i)
+        requests.push_back(grpcRequest(i));
+
+    std::vector<uchar> buffer;
+    BitOStream out(buffer);
+    QBENCHMARK {
+        Encoder encoder(FieldLookupTable::DefaultSize, compressStrings);
+        for (const HttpHeader &request : requests) {
+            out.clear();
+            if (!encoder.encodeRequest(out, request))
+                QFAIL("encoding failed");
+        }
+    }
+}
+
+void tst_Hpack::decodeRequest()
+{
+    QFETCH(const bool, compressStrings);
+
+    // A connection's header blocks, as they arrive one after another:
+    std::vector<std::vector<uchar>> blocks(1000);
+    {
+        Encoder encoder(FieldLookupTable::DefaultSize, compressStrings);
+        for (int i = 0; i < int(blocks.size()); ++i) {
+            BitOStream out(blocks[i]);
+            QVERIFY(encoder.encodeRequest(out, grpcRequest(i)));
+        }
+    }
+
+    QBENCHMARK {
+        Decoder decoder(FieldLookupTable::DefaultSize);
+        for (const std::vector<uchar> &block : blocks) {
+            BitIStream in(block.data(), block.data() + block.size());
+            if (!decoder.decodeHeaderFields(in))
+                QFAIL("decoding failed");
+        }
+    }
+}
+
+QTEST_MAIN(tst_Hpack)
+
+#include "tst_bench_hpack.moc"
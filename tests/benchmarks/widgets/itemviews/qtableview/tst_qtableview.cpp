@@ -114,6 +114,7 @@ private slots:
     void columnRemoval_data();
     void columnRemoval();
     void sizeHintForColumnWhenHidden();
+    void drawScrolledCells();
 private:
     static inline void spanInit_helper(QTableView *);
 };
@@ -344,5 +345,27 @@ void tst_QTableView::sizeHintForColumnWhenHidden()
 
 }
 
+void tst_QTableView::drawScrolledCells()
+{
+    // 40 rows and 60 columns in view, scrolled back and forth
+    QtTestTableModel model(400, 60);
+    QTableView view;
+    view.setModel(&model);
+    view.horizontalHeader()->setDefaultSectionSize(40);
+    view.verticalHeader()->setDefaultSectionSize(20);
+    view.horizontalHeader()->hide();
+    view.verticalHeader()->hide();
+    view.resize(60 * 40, 40 * 20);
+
+    QImage image(view.size(), QImage::Format_ARGB32_Premultiplied);
+    QPainter painter(&image);
+    QBENCHMARK {
+        for (int row = 0; row < 20; ++row) {
+            view.scrollTo(model.index(row % 2 ? 0 : 80, 0), QAbstractItemView::PositionAtTop);
+            view.render(&painter);
+        }
+    }
+}
+
 QTEST_MAIN(tst_QTableView)
 #include "tst_qtableview.moc"
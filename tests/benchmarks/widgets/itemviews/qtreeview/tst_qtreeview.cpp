@@ -0,0 +1,74 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <qtest.h>
+#include <QAbstractItemModel>
+#include <QScrollBar>
+#include <QTreeView>
+
+// A flat list of rows with different heights, without the cost of storing items.
+class HeightsModel : public QAbstractItemModel
+{
+public:
+    explicit HeightsModel(int rows) : rows(rows) {}
+
+    QModelIndex index(int row, int column, const QModelIndex &parent = {}) const override
+    {
+        return parent.isValid() ? QModelIndex() : createIndex(row, column);
+    }
+    QModelIndex parent(const QModelIndex &) const override { return {}; }
+    int rowCount(const QModelIndex &parent = {}) const override { return parent.isValid() ? 0 : rows; }
+    int columnCount(const QModelIndex & = {}) const override { return 1; }
+    QVariant data(const QModelIndex &index, int role) const override
+    {
+        if (role == Qt::SizeHintRole)
+            return QSize(100, 16 + (index.row() % 4) * 4);
+        if (role == Qt::DisplayRole)
+            return index.row();
+        return {};
+    }
+
+private:
+    int rows;
+};
+
+class tst_QTreeView : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void scrollPerPixel_data();
+    void scrollPerPixel();
+};
+
+void tst_QTreeView::scrollPerPixel_data()
+{
+    QTest::addColumn<int>("rows");
+    QTest::newRow("10K") << 10'000;
+    QTest::newRow("200K") << 200'000;
+}
+
+void tst_QTreeView::scrollPerPixel()
+{
+    QFETCH(int, rows);
+    HeightsModel model(rows);
+    QTreeView view;
+    view.setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    view.setModel(&model);
+    view.resize(300, 500);
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    QScrollBar *scrollBar = view.verticalScrollBar();
+    QBENCHMARK {
+        for (int step = 0; step < 100; ++step) {
+            scrollBar->setValue(scrollBar->maximum() / 100 * step);
+            const QModelIndex index = view.indexAt(QPoint(5, 5));
+            view.scrollTo(model.index(index.row() + 50, 0));
+            view.viewport()->repaint();
+        }
+    }
+}
+
+QTEST_MAIN(tst_QTreeView)
+#include "tst_qtreeview.moc"